@@ -45,6 +45,7 @@
 
 #include "Reverb.h"
 
+#include <algorithm>
 #include <cmath>
 #include "basics.h"
 #include "dsp/FPTruncateMode.h"
@@ -435,13 +436,33 @@ Descriptor<PlateX2>::setup()
 
 
 #include <util/rampingvalue.h>
+
+void MixxxPlateX2::init(float sampleRate) {
+    fs = sampleRate;
+    PlateStub::init();
+    PlateStub::activate();
+
+    // The block length is limited by the shortest delay of any stage
+    maxBlockFrames = MAX_BLOCK_FRAMES;
+    for (int i = 0; i < 4; ++i) {
+        maxBlockFrames = std::min(maxBlockFrames, input.lattice[i].length());
+        maxBlockFrames = std::min(maxBlockFrames, tank.delay[i].length());
+    }
+    for (int i = 0; i < 2; ++i) {
+        maxBlockFrames = std::min(maxBlockFrames, tank.mlattice[i].min_length());
+        maxBlockFrames = std::min(maxBlockFrames, tank.lattice[i].length());
+    }
+    maxBlockFrames = std::max(maxBlockFrames, 1u);
+}
+
 // (timrae) we have our left / right samples interleaved in the same array, so use slightly modified version of PlateX2::cycle
 void MixxxPlateX2::processBuffer(const sample_t* in, sample_t* out, const uint frames,
                                  const sample_t bandwidthParam,
                                  const sample_t decayParam,
                                  const sample_t dampingParam,
                                  const sample_t currentSend,
-                                 const sample_t previousSend) {
+                                 const sample_t previousSend,
+                                 const bool modulation) {
     // set bandwidth
     input.bandwidth.set(exp(-M_PI * (1. - (.005 + .994*bandwidthParam))));
     // set decay
@@ -452,13 +473,96 @@ void MixxxPlateX2::processBuffer(const sample_t* in, sample_t* out, const uint f
     tank.damping[1].set(damp);
     RampingValue<sample_t> send(pow(currentSend, 1.53), previousSend, frames);
 
-    // the modulated lattices interpolate, which needs truncated float
-    DSP::FPTruncateMode _truncate;
+    sample_t x[MAX_BLOCK_FRAMES];
+    sample_t xl[MAX_BLOCK_FRAMES];
+    sample_t xr[MAX_BLOCK_FRAMES];
+    const uint totalFrames = frames / 2;
+    for (uint start = 0; start < totalFrames; start += maxBlockFrames) {
+        const uint blockFrames = std::min(maxBlockFrames, totalFrames - start);
+        const sample_t* pIn = &in[start * 2];
+        // note: LOOP VECTORIZED.
+        for (uint i = 0; i < blockFrames; ++i) {
+            x[i] = send.getNth(start + i) * (pIn[i * 2] + pIn[i * 2 + 1]) / 2;
+        }
+
+        processBlock(x, xl, xr, blockFrames, decay, modulation);
+
+        sample_t* pOut = &out[start * 2];
+        // note: LOOP VECTORIZED.
+        for (uint i = 0; i < blockFrames; ++i) {
+            pOut[i * 2] = xl[i];
+            pOut[i * 2 + 1] = xr[i];
+        }
+    }
+}
+
+// Same as PlateStub::process() for a block of frames
+void MixxxPlateX2::processBlock(sample_t* x, sample_t* xl, sample_t* xr,
+                                const uint frames,
+                                const sample_t decay,
+                                const bool modulation) {
+    for (uint i = 0; i < frames; ++i) {
+        x[i] = input.bandwidth.process(x[i]);
+    }
 
-    // loop through the buffer, processing each sample
-    for (uint i = 0; i + 1 < frames; i += 2) {
-        sample_t mono_sample = send.getNth(i / 2) * (in[i] + in[i + 1]) / 2;
-        PlateStub::process(mono_sample, decay, &out[i], &out[i+1]);
+    /* lh */
+    input.lattice[0].process(x, frames, indiff1);
+    input.lattice[1].process(x, frames, indiff1);
+
+    /* rh */
+    input.lattice[2].process(x, frames, indiff2);
+    input.lattice[3].process(x, frames, indiff2);
+
+    /* summation point */
+    tank.delay[3].get(xl, frames);
+    tank.delay[1].get(xr, frames);
+    // note: LOOP VECTORIZED.
+    for (uint i = 0; i < frames; ++i) {
+        xl[i] = x[i] + decay * xl[i];
+        xr[i] = x[i] + decay * xr[i];
     }
- }
 
+    /* lh */
+    tank.mlattice[0].process(xl, frames, dediff1, modulation);
+    tank.delay[0].get(x, frames);
+    tank.delay[0].put(xl, frames);
+    for (uint i = 0; i < frames; ++i) {
+        xl[i] = decay * tank.damping[0].process(x[i]);
+    }
+    tank.lattice[0].process(xl, frames, dediff2);
+    tank.delay[1].put(xl, frames);
+
+    /* rh */
+    tank.mlattice[1].process(xr, frames, dediff1, modulation);
+    tank.delay[2].get(x, frames);
+    tank.delay[2].put(xr, frames);
+    for (uint i = 0; i < frames; ++i) {
+        xr[i] = decay * tank.damping[1].process(x[i]);
+    }
+    tank.lattice[1].process(xr, frames, dediff2);
+    tank.delay[3].put(xr, frames);
+
+    /* gather output */
+    sample_t taps[12][MAX_BLOCK_FRAMES];
+    tank.delay[2].tap(tank.taps[0], taps[0], frames);
+    tank.delay[2].tap(tank.taps[1], taps[1], frames);
+    tank.lattice[1].tap(tank.taps[2], taps[2], frames);
+    tank.delay[3].tap(tank.taps[3], taps[3], frames);
+    tank.delay[0].tap(tank.taps[4], taps[4], frames);
+    tank.lattice[0].tap(tank.taps[5], taps[5], frames);
+
+    tank.delay[0].tap(tank.taps[6], taps[6], frames);
+    tank.delay[0].tap(tank.taps[7], taps[7], frames);
+    tank.lattice[0].tap(tank.taps[8], taps[8], frames);
+    tank.delay[1].tap(tank.taps[9], taps[9], frames);
+    tank.delay[2].tap(tank.taps[10], taps[10], frames);
+    tank.lattice[1].tap(tank.taps[11], taps[11], frames);
+
+    // note: LOOP VECTORIZED.
+    for (uint i = 0; i < frames; ++i) {
+        xl[i] = .6f * (taps[0][i] + taps[1][i] - taps[2][i] +
+                              taps[3][i] - taps[4][i] + taps[5][i]);
+        xr[i] = .6f * (taps[6][i] + taps[7][i] - taps[8][i] +
+                              taps[9][i] - taps[10][i] + taps[11][i]);
+    }
+}
@@ -56,6 +56,9 @@
 #include "dsp/Sine.h"
 #include "dsp/util.h"
 
+/* (mixxx) longest block that is processed by one stage of MixxxPlateX2 */
+#define MAX_BLOCK_FRAMES 128
+
 /* both reverbs use this */
 class Lattice
 : public DSP::Delay
@@ -68,6 +71,18 @@ class Lattice
 				put(x);
 				return d*x + y;
 			}
+
+		/* (mixxx) in place, n must not exceed length() */
+		void process (sample_t * x, uint n, sample_t d)
+			{
+				sample_t y[MAX_BLOCK_FRAMES];
+				get (y, n);
+				for (uint i = 0; i < n; ++i)
+					x[i] -= d*y[i];
+				put (x, n);
+				for (uint i = 0; i < n; ++i)
+					x[i] = d*x[i] + y[i];
+			}
 };
 
 /* helper for JVRev */
@@ -144,6 +159,40 @@ class ModLattice
 				delay.put (x);
 				return y - d * x; /* note sign */
 			}
+
+		/* (mixxx) in place, n must not exceed min_length(). Without
+		 * modulation, the delay is fixed to n0 and the lfo is not run. */
+		void process (sample_t * x, uint n, sample_t d, bool modulate)
+			{
+				sample_t y[MAX_BLOCK_FRAMES];
+				if (modulate)
+				{
+					/* the lfo is recursive, so it is run ahead */
+					float f[MAX_BLOCK_FRAMES];
+					for (uint i = 0; i < n; ++i)
+						f[i] = n0 + width * static_cast<float>(lfo.get());
+
+					/* same as get_linear() before each put() */
+					for (uint i = 0; i < n; ++i)
+					{
+						int k = static_cast<int>(f[i]);
+						sample_t a = f[i] - k;
+						uint w = delay.write + i - k;
+						y[i] = (1 - a) * delay.data[w & delay.size] +
+								a * delay.data[(w - 1) & delay.size];
+					}
+				}
+				else
+					delay.copy_out (delay.write - static_cast<uint>(n0), y, n);
+
+				for (uint i = 0; i < n; ++i)
+					x[i] += d * y[i];
+				delay.put (x, n);
+				for (uint i = 0; i < n; ++i)
+					x[i] = y[i] - d * x[i];
+			}
+
+		uint min_length() { return static_cast<uint>(n0 - width); }
 };
 
 class PlateStub
@@ -222,6 +271,12 @@ class PlateX2
 #endif
 
 /// (timrae) Define our own interface instead of using the original LADSPA plugin interface
+///
+/// processBuffer() runs each stage of PlateStub::process() on a block of
+/// frames before passing it on to the next one, which lets the compiler
+/// vectorize the allpasses, delay lines and output taps. This is exact as
+/// long as a block is not longer than the shortest delay, because no sample
+/// of a block then depends on another sample of the same block.
  class MixxxPlateX2 : public PlateStub {
     public:
         void processBuffer(const sample_t* in, sample_t* out, const uint frames,
@@ -229,13 +284,18 @@ class PlateX2
                            const sample_t decayParam,
                            const sample_t dampingParam,
                            const sample_t currentSend,
-                           const sample_t previousSend);
+                           const sample_t previousSend,
+                           const bool modulation = true);
+
+        void init(float sampleRate);
+
+    private:
+        void processBlock(sample_t* x, sample_t* xl, sample_t* xr,
+                          const uint frames,
+                          const sample_t decay,
+                          const bool modulation);
 
-        void init(float sampleRate) {
-            fs = sampleRate;
-            PlateStub::init();
-            PlateStub::activate();
-        }
+        uint maxBlockFrames = 1;
  };
 
 #endif /* REVERB_H */
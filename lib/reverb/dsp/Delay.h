@@ -32,7 +32,7 @@
 #ifndef _DSP_DELAY_H_
 #define _DSP_DELAY_H_
 
-#include <cstring> // for memset
+#include <cstring> // for memset, memcpy
 
 #include "util.h"
 #include "FPTruncateMode.h"
@@ -81,6 +81,46 @@ class Delay
 		inline sample_t peek() { return data [read]; }
 		inline sample_t putget (sample_t x) {put(x); return get();}
 
+		/* (mixxx) block access in at most two contiguous segments, for
+		 * the block processing in MixxxPlateX2 */
+		inline void copy_out (uint i, sample_t * x, uint n)
+			{
+				i &= size;
+				uint n1 = n < size + 1 - i ? n : size + 1 - i;
+				memcpy (x, data + i, n1 * sizeof (sample_t));
+				memcpy (x + n1, data, (n - n1) * sizeof (sample_t));
+			}
+
+		inline void copy_in (uint i, const sample_t * x, uint n)
+			{
+				i &= size;
+				uint n1 = n < size + 1 - i ? n : size + 1 - i;
+				memcpy (data + i, x, n1 * sizeof (sample_t));
+				memcpy (data, x + n1, (n - n1) * sizeof (sample_t));
+			}
+
+		inline void put (const sample_t * x, uint n)
+			{
+				copy_in (write, x, n);
+				write = (write + n) & size;
+			}
+
+		inline void get (sample_t * x, uint n)
+			{
+				copy_out (read, x, n);
+				read = (read + n) & size;
+			}
+
+		/* x[j] = (*this) [i] as it was after putting the j-th of the
+		 * last n samples */
+		inline void tap (int i, sample_t * x, uint n)
+			{
+				copy_out (write - n + 1 - i, x, n);
+			}
+
+		/* number of samples between put() and get() */
+		inline uint length() { return (write - read) & size; }
+
 		/* fractional lookup, linear interpolation */
 		inline sample_t get_linear (float f)
 			{
@@ -0,0 +1,283 @@
+#include "analyzer/analysiscache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QMutex>
+#include <QSaveFile>
+#include <atomic>
+
+#include "util/assert.h"
+#include "util/cachedirectory.h"
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+#include "util/math.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("AnalysisCache");
+
+constexpr quint32 kEncodingMagic = 0x414E4143; // "ANAC"
+// Version 2 added the content digest
+constexpr quint16 kEncodingVersion = 2;
+
+// Evenly spread across the stream, including the first and
+// the last frames.
+constexpr int kContentKeyRegionCount = 4;
+
+// An entry with both waveforms occupies a few hundred KB. Analysis results
+// are also stored in the library, so the cache only needs to cover files
+// that are imported again or copied within some months.
+constexpr CacheDirectory::Limits kStorageLimits{
+        10000,               // maxFileCount
+        512 * 1024 * 1024LL, // maxTotalBytes
+        180,                 // maxAgeDays
+};
+
+// Listing the directory is too expensive for every new entry
+constexpr int kPurgeIntervalSaves = 100;
+
+std::atomic<int> s_saveCount = 0;
+
+QMutex s_storageDirectoryMutex;
+QString s_storageDirectory;
+
+QString storageFilePath(const QString& storageDirectory, cache_key_t contentKey) {
+    return QDir(storageDirectory)
+            .filePath(QStringLiteral("%1").arg(contentKey, 16, 16, QLatin1Char('0')));
+}
+
+double encodeFramePos(audio::FramePos position) {
+    return position.isValid() ? position.value() : -1.0;
+}
+
+audio::FramePos decodeFramePos(double value) {
+    return value >= 0.0 ? audio::FramePos(value) : audio::kInvalidFramePos;
+}
+
+} // anonymous namespace
+
+QByteArray AnalysisCacheEntry::encode() const {
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << kEncodingMagic
+           << kEncodingVersion
+           << contentDigest
+           << waveformVersion
+           << waveform
+           << waveformSummaryVersion
+           << waveformSummary
+           << beatsVersion
+           << beatsSubVersion
+           << beats
+           << keysVersion
+           << keysSubVersion
+           << keys
+           << replayGain1Ratio
+           << replayGain2Ratio
+           << encodeFramePos(firstSoundPosition)
+           << encodeFramePos(lastSoundPosition);
+    return qCompress(data);
+}
+
+// static
+std::optional<AnalysisCacheEntry> AnalysisCacheEntry::decode(
+        const QByteArray& compressedData) {
+    const QByteArray data = qUncompress(compressedData);
+    QDataStream stream(data);
+    quint32 magic = 0;
+    quint16 version = 0;
+    stream >> magic >> version;
+    if (stream.status() != QDataStream::Ok ||
+            magic != kEncodingMagic ||
+            version != kEncodingVersion) {
+        return std::nullopt;
+    }
+    AnalysisCacheEntry entry;
+    double firstSoundPosition = -1.0;
+    double lastSoundPosition = -1.0;
+    stream >> entry.contentDigest >> entry.waveformVersion >> entry.waveform >> entry.waveformSummaryVersion >>
+            entry.waveformSummary >> entry.beatsVersion >> entry.beatsSubVersion >>
+            entry.beats >> entry.keysVersion >> entry.keysSubVersion >>
+            entry.keys >> entry.replayGain1Ratio >> entry.replayGain2Ratio >>
+            firstSoundPosition >> lastSoundPosition;
+    if (stream.status() != QDataStream::Ok) {
+        return std::nullopt;
+    }
+    entry.firstSoundPosition = decodeFramePos(firstSoundPosition);
+    entry.lastSoundPosition = decodeFramePos(lastSoundPosition);
+    return entry;
+}
+
+AnalysisContentDigest::AnalysisContentDigest(
+        const audio::SignalInfo& signalInfo,
+        SINT firstFrameIndex)
+        : m_hash(QCryptographicHash::Sha256),
+          m_firstFrameIndex(firstFrameIndex),
+          m_nextFrameIndex(firstFrameIndex),
+          m_missingFrames(false) {
+    QByteArray header;
+    QDataStream(&header, QIODevice::WriteOnly)
+            << static_cast<quint32>(signalInfo.getChannelCount())
+            << static_cast<quint32>(signalInfo.getSampleRate());
+    m_hash.addData(header);
+}
+
+void AnalysisContentDigest::addFrames(const ReadableSampleFrames& sampleFrames) {
+    const IndexRange frameIndexRange = sampleFrames.frameIndexRange();
+    if (frameIndexRange.empty()) {
+        return;
+    }
+    if (frameIndexRange.start() != m_nextFrameIndex) {
+        // Missing or repeated frames, e.g. after a decoding error
+        m_missingFrames = true;
+        return;
+    }
+    m_hash.addData(QByteArray::fromRawData(
+            reinterpret_cast<const char*>(sampleFrames.readableData()),
+            static_cast<int>(sampleFrames.readableLength() * sizeof(CSAMPLE))));
+    m_nextFrameIndex = frameIndexRange.end();
+}
+
+QByteArray AnalysisContentDigest::finish(const IndexRange& frameIndexRange) {
+    if (m_missingFrames ||
+            frameIndexRange.empty() ||
+            frameIndexRange.start() != m_firstFrameIndex ||
+            frameIndexRange.end() != m_nextFrameIndex) {
+        return QByteArray();
+    }
+    return m_hash.result();
+}
+
+// static
+void AnalysisCache::setStorageDirectory(const QString& path) {
+    if (!path.isEmpty() && !QDir().mkpath(path)) {
+        kLogger.warning()
+                << "Failed to create storage directory"
+                << path;
+    }
+    const auto locker = lockMutex(&s_storageDirectoryMutex);
+    s_storageDirectory = path;
+}
+
+// static
+QString AnalysisCache::storageDirectory() {
+    const auto locker = lockMutex(&s_storageDirectoryMutex);
+    return s_storageDirectory;
+}
+
+// static
+cache_key_t AnalysisCache::contentKey(
+        AudioSource* pAudioSource,
+        const SampleBuffer::WritableSlice& buffer) {
+    VERIFY_OR_DEBUG_ASSERT(pAudioSource) {
+        return invalidCacheKey();
+    }
+    const auto signalInfo = pAudioSource->getSignalInfo();
+    const IndexRange frameIndexRange = pAudioSource->frameIndexRange();
+    const SINT regionFrames = math_min(
+            signalInfo.samples2frames(buffer.length()),
+            frameIndexRange.length());
+    if (regionFrames <= 0) {
+        return invalidCacheKey();
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    QByteArray header;
+    QDataStream(&header, QIODevice::WriteOnly)
+            << static_cast<quint32>(signalInfo.getChannelCount())
+            << static_cast<quint32>(signalInfo.getSampleRate())
+            << static_cast<qint64>(frameIndexRange.length());
+    hash.addData(header);
+    for (int i = 0; i < kContentKeyRegionCount; ++i) {
+        const auto regionFrameIndexRange = IndexRange::forward(
+                frameIndexRange.start() +
+                        (frameIndexRange.length() - regionFrames) * i /
+                                (kContentKeyRegionCount - 1),
+                regionFrames);
+        const auto readableSampleFrames = pAudioSource->readSampleFrames(
+                WritableSampleFrames(regionFrameIndexRange, buffer));
+        if (readableSampleFrames.frameIndexRange() != regionFrameIndexRange) {
+            // Decoding errors are not necessarily reproducible
+            return invalidCacheKey();
+        }
+        hash.addData(QByteArray::fromRawData(
+                reinterpret_cast<const char*>(readableSampleFrames.readableData()),
+                static_cast<int>(readableSampleFrames.readableLength() * sizeof(CSAMPLE))));
+    }
+    return cacheKeyFromMessageDigest(hash.result());
+}
+
+// static
+std::optional<AnalysisCacheEntry> AnalysisCache::load(
+        cache_key_t contentKey) {
+    const QString directory = storageDirectory();
+    if (directory.isEmpty() || !isValidCacheKey(contentKey)) {
+        return std::nullopt;
+    }
+    QFile file(storageFilePath(directory, contentKey));
+    if (!file.open(QIODevice::ReadOnly)) {
+        // Not analyzed yet
+        return std::nullopt;
+    }
+    auto entry = AnalysisCacheEntry::decode(file.readAll());
+    if (!entry) {
+        kLogger.warning()
+                << "Discarding invalid entry"
+                << file.fileName();
+        return std::nullopt;
+    }
+    return entry;
+}
+
+// static
+bool AnalysisCache::save(
+        cache_key_t contentKey,
+        const AnalysisCacheEntry& entry) {
+    const QString directory = storageDirectory();
+    if (directory.isEmpty()) {
+        return false;
+    }
+    VERIFY_OR_DEBUG_ASSERT(isValidCacheKey(contentKey)) {
+        return false;
+    }
+    VERIFY_OR_DEBUG_ASSERT(!entry.contentDigest.isEmpty()) {
+        return false;
+    }
+    if (s_saveCount.fetch_add(1) % kPurgeIntervalSaves == 0) {
+        // Also when saving the first entry after startup
+        CacheDirectory::purge(directory, kStorageLimits);
+    }
+    // Multiple analyzer threads might store the results of identical
+    // audio content simultaneously.
+    QSaveFile file(storageFilePath(directory, contentKey));
+    if (!file.open(QIODevice::WriteOnly) ||
+            file.write(entry.encode()) < 0 ||
+            !file.commit()) {
+        kLogger.warning()
+                << "Failed to write entry"
+                << file.fileName();
+        return false;
+    }
+    return true;
+}
+
+// static
+void AnalysisCache::purge() {
+    CacheDirectory::purge(storageDirectory(), kStorageLimits);
+}
+
+// static
+bool AnalysisCache::clear() {
+    return CacheDirectory::clear(storageDirectory());
+}
+
+// static
+qint64 AnalysisCache::diskUsageInBytes() {
+    return CacheDirectory::diskUsageInBytes(storageDirectory());
+}
+
+} // namespace mixxx
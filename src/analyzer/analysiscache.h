@@ -0,0 +1,123 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <optional>
+
+#include <QCryptographicHash>
+
+#include "audio/frame.h"
+#include "audio/signalinfo.h"
+#include "sources/audiosource.h"
+#include "track/replaygain.h"
+#include "util/cache.h"
+#include "util/samplebuffer.h"
+
+namespace mixxx {
+
+/// The results of analyzing some audio content that are reused for
+/// other tracks with identical audio content, e.g. copies of the same
+/// file in different locations or with different tags.
+///
+/// Each analyzer only stores and restores its own results. Results of
+/// analyzers that have not been active are missing, i.e. empty or invalid.
+struct AnalysisCacheEntry {
+    // AnalysisContentDigest of the analyzed audio content
+    QByteArray contentDigest;
+
+    // Waveform::toByteArray()
+    QString waveformVersion;
+    QByteArray waveform;
+    QString waveformSummaryVersion;
+    QByteArray waveformSummary;
+
+    // Beats::toByteArray()
+    QString beatsVersion;
+    QString beatsSubVersion;
+    QByteArray beats;
+
+    // Keys::toByteArray()
+    QString keysVersion;
+    QString keysSubVersion;
+    QByteArray keys;
+
+    // Both ReplayGain versions are stored independently
+    double replayGain1Ratio = ReplayGain::kRatioUndefined;
+    double replayGain2Ratio = ReplayGain::kRatioUndefined;
+
+    audio::FramePos firstSoundPosition;
+    audio::FramePos lastSoundPosition;
+
+    /// Compressed encoding
+    QByteArray encode() const;
+    static std::optional<AnalysisCacheEntry> decode(const QByteArray& data);
+};
+
+/// Calculates a digest of the signal properties and all decoded samples of
+/// an audio stream while it is decoded. The frames must be added in order,
+/// the digest is invalid if any frames are missing.
+class AnalysisContentDigest {
+  public:
+    AnalysisContentDigest(
+            const audio::SignalInfo& signalInfo,
+            SINT firstFrameIndex);
+
+    void addFrames(const ReadableSampleFrames& sampleFrames);
+
+    /// Returns an empty digest if some frames of the range are missing.
+    QByteArray finish(const IndexRange& frameIndexRange);
+
+  private:
+    QCryptographicHash m_hash;
+    SINT m_firstFrameIndex;
+    SINT m_nextFrameIndex;
+    bool m_missingFrames;
+};
+
+/// File based storage of AnalysisCacheEntry below the analysis directory.
+///
+/// Entries are looked up by contentKey(), a fingerprint of a few regions
+/// of the decoded audio content, instead of a track id or file path. They
+/// contain the AnalysisContentDigest of the whole audio content that must
+/// be compared before reusing the results, because different edits of the
+/// same recording might share the same content key.
+///
+/// The number and total size of the entries are limited, the least recently
+/// written entries are purged. All functions are thread-safe once the storage
+/// directory has been set during startup. The cache is disabled while no
+/// directory is set.
+class AnalysisCache {
+  public:
+    static void setStorageDirectory(const QString& path);
+    static QString storageDirectory();
+    static bool isEnabled() {
+        return !storageDirectory().isEmpty();
+    }
+
+    /// Calculates the fingerprint of the audio content from the signal
+    /// properties, the length, and the decoded samples of a few regions
+    /// that are spread across the whole stream. The buffer is used for
+    /// decoding. Returns invalidCacheKey() if the regions are not readable.
+    ///
+    /// The key is only used for looking up entries and does not rule out
+    /// collisions, see AnalysisCacheEntry::contentDigest.
+    static cache_key_t contentKey(
+            AudioSource* pAudioSource,
+            const SampleBuffer::WritableSlice& buffer);
+
+    static std::optional<AnalysisCacheEntry> load(
+            cache_key_t contentKey);
+    /// Entries without a content digest are not stored
+    static bool save(
+            cache_key_t contentKey,
+            const AnalysisCacheEntry& entry);
+
+    /// Removes the least recently written entries exceeding the limits.
+    /// This is done regularly while saving new entries.
+    static void purge();
+    /// Removes all entries, e.g. together with all cached waveforms
+    static bool clear();
+    static qint64 diskUsageInBytes();
+};
+
+} // namespace mixxx
@@ -1,9 +1,15 @@
 #pragma once
 
+#include <QString>
+#include <limits>
+
+#include "analyzer/analyzerchunk.h"
 #include "analyzer/analyzertrack.h"
 #include "audio/signalinfo.h"
 #include "audio/types.h"
 #include "util/assert.h"
+#include "util/duration.h"
+#include "util/performancetimer.h"
 #include "util/types.h"
 
 /*
@@ -16,6 +22,10 @@
 
 #include "track/track_decl.h"
 
+namespace mixxx {
+struct AnalysisCacheEntry;
+} // namespace mixxx
+
 class Analyzer {
   public:
     virtual ~Analyzer() = default;
@@ -29,17 +39,82 @@ class Analyzer {
             mixxx::audio::ChannelCount channelCount,
             SINT frameLength) = 0;
 
+    // Optionally publish results that have been stored previously, e.g.
+    // cached waveforms, on the track. This is invoked before the audio
+    // source of the track has been opened and must not depend on it.
+    // Opening the audio source might take a considerable amount of time
+    // that does not need to be spent before displaying stored results.
+    virtual void loadStoredResults(const AnalyzerTrack& track) {
+        Q_UNUSED(track);
+    }
+
     // Analyze the next chunk of audio samples and return true if successful.
     // If processing fails the analysis can be aborted early by returning
     // false. After aborting the analysis only cleanup() will be invoked,
     // but not finalize()!
     virtual bool processSamples(const CSAMPLE* pIn, SINT count) = 0;
 
+    // Analyze the next chunk of audio data that is shared with all other
+    // analyzers. Analyzers that need derived signals like the stereo mix of
+    // a stem file should override this to reuse the data that has been
+    // computed once for all analyzers instead of deriving it again.
+    virtual bool processChunk(const AnalyzerChunk& chunk) {
+        return processSamples(chunk.samples(), chunk.sampleCount());
+    }
+
+    // Optionally declare how many of the frames following the previously
+    // processed chunk are not needed, e.g. when only sampling some regions
+    // of the track. Those frames are neither decoded nor passed to
+    // processChunk() if none of the active analyzers needs them.
+    virtual SINT framesToSkip() const {
+        return 0;
+    }
+
+    // Skip the given number of frames instead of processing them. This
+    // is only invoked with at most framesToSkip() frames.
+    virtual void skipFrames(SINT frameCount) {
+        Q_UNUSED(frameCount);
+        DEBUG_ASSERT(!"Frames must not be skipped");
+    }
+
+    // Optionally analyze a chunk of the region of interest in advance,
+    // before all chunks are passed to processChunk() in order. Chunks are
+    // passed in arbitrary order, each starting at the given frame index.
+    // This is only used for publishing preliminary results early, e.g.
+    // the waveform near the play position of a deck. Those results must
+    // be replaced while processing all chunks afterwards.
+    virtual void processPreviewChunk(const AnalyzerChunk& chunk, SINT frameIndex) {
+        Q_UNUSED(chunk);
+        Q_UNUSED(frameIndex);
+    }
+
     // Update the track object with the analysis results after
     // processing finished successfully, i.e. all available audio
     // samples have been processed.
     virtual void storeResults(TrackPointer pTrack) = 0;
 
+    // Optionally restore the results from the analysis of a track with
+    // identical audio content instead of processing any samples. Returns
+    // true if the results have been stored on the track. This is invoked
+    // after a successful initialize() and before processing any samples.
+    virtual bool restoreCachedResults(
+            const mixxx::AnalysisCacheEntry& cacheEntry,
+            TrackPointer pTrack) {
+        Q_UNUSED(cacheEntry);
+        Q_UNUSED(pTrack);
+        return false;
+    }
+
+    // Optionally add the results that have been stored on the track
+    // to the cache for reusing them for identical audio content. This
+    // is invoked after storeResults() and before cleanup().
+    virtual void storeCachedResults(
+            mixxx::AnalysisCacheEntry* pCacheEntry,
+            TrackPointer pTrack) const {
+        Q_UNUSED(pCacheEntry);
+        Q_UNUSED(pTrack);
+    }
+
     // Discard any temporary results or free allocated memory.
     // This function will be invoked after the results have been
     // stored or if processing aborted preliminary.
@@ -50,8 +125,9 @@ typedef std::unique_ptr<Analyzer> AnalyzerPtr;
 
 class AnalyzerWithState final {
   public:
-    explicit AnalyzerWithState(AnalyzerPtr analyzer)
+    AnalyzerWithState(AnalyzerPtr analyzer, QString name)
             : m_analyzer(std::move(analyzer)),
+              m_name(std::move(name)),
               m_active(false) {
         DEBUG_ASSERT(m_analyzer);
     }
@@ -67,17 +143,35 @@ class AnalyzerWithState final {
         return m_active;
     }
 
+    const QString& name() const {
+        return m_name;
+    }
+
+    // The time spent in processChunk() for the current track
+    mixxx::Duration processDuration() const {
+        return m_processDuration;
+    }
+
     bool initialize(const AnalyzerTrack& track,
             mixxx::audio::SampleRate sampleRate,
             mixxx::audio::ChannelCount channelCount,
             SINT frameLength) {
         DEBUG_ASSERT(!m_active);
+        m_processDuration = mixxx::Duration();
         return m_active = m_analyzer->initialize(track, sampleRate, channelCount, frameLength);
     }
 
-    void processSamples(const CSAMPLE* pIn, const int count) {
+    void loadStoredResults(const AnalyzerTrack& track) {
+        DEBUG_ASSERT(!m_active);
+        m_analyzer->loadStoredResults(track);
+    }
+
+    void processChunk(const AnalyzerChunk& chunk) {
         if (m_active) {
-            m_active = m_analyzer->processSamples(pIn, count);
+            PerformanceTimer timer;
+            timer.start();
+            m_active = m_analyzer->processChunk(chunk);
+            m_processDuration += timer.elapsed();
             if (!m_active) {
                 // Ensure that cleanup() is invoked after processing
                 // failed and the analyzer became inactive!
@@ -86,9 +180,45 @@ class AnalyzerWithState final {
         }
     }
 
-    void finish(const AnalyzerTrack& track) {
+    // Inactive analyzers don't need any frames
+    SINT framesToSkip() const {
+        return m_active ? m_analyzer->framesToSkip() : std::numeric_limits<SINT>::max();
+    }
+
+    void skipFrames(SINT frameCount) {
+        if (m_active) {
+            m_analyzer->skipFrames(frameCount);
+        }
+    }
+
+    void processPreviewChunk(const AnalyzerChunk& chunk, SINT frameIndex) {
+        if (m_active) {
+            m_analyzer->processPreviewChunk(chunk, frameIndex);
+        }
+    }
+
+    // Returns true if the analyzer became inactive, because its
+    // results have been restored from the cache entry.
+    bool restoreCachedResults(
+            const AnalyzerTrack& track,
+            const mixxx::AnalysisCacheEntry& cacheEntry) {
+        if (m_active && m_analyzer->restoreCachedResults(cacheEntry, track.getTrack())) {
+            m_analyzer->cleanup();
+            m_active = false;
+            return true;
+        }
+        return false;
+    }
+
+    // The results are added to the optional cache entry after
+    // they have been stored on the track.
+    void finish(const AnalyzerTrack& track,
+            mixxx::AnalysisCacheEntry* pCacheEntry = nullptr) {
         if (m_active) {
             m_analyzer->storeResults(track.getTrack());
+            if (pCacheEntry) {
+                m_analyzer->storeCachedResults(pCacheEntry, track.getTrack());
+            }
             m_analyzer->cleanup();
             m_active = false;
         }
@@ -103,5 +233,7 @@ class AnalyzerWithState final {
 
   private:
     AnalyzerPtr m_analyzer;
+    QString m_name;
     bool m_active;
+    mixxx::Duration m_processDuration;
 };
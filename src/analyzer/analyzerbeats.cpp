@@ -5,13 +5,16 @@
 #include <QVector>
 #include <QtDebug>
 
+#include "analyzer/analysiscache.h"
 #include "analyzer/analyzertrack.h"
 #include "analyzer/constants.h"
 #include "analyzer/plugins/analyzerqueenmarybeats.h"
 #include "analyzer/plugins/analyzersoundtouchbeats.h"
 #include "library/rekordbox/rekordboxconstants.h"
+#include "mixer/playerinfo.h"
 #include "track/beatfactory.h"
 #include "track/track.h"
+#include "util/math.h"
 
 // static
 QList<mixxx::AnalyzerPluginInfo> AnalyzerBeats::availablePlugins() {
@@ -36,8 +39,9 @@ AnalyzerBeats::AnalyzerBeats(UserSettingsPointer pConfig, bool enforceBpmDetecti
           m_bPreferencesReanalyzeImported(false),
           m_bPreferencesFixedTempo(true),
           m_bPreferencesFastAnalysis(false),
-          m_maxFramesToProcess(0),
-          m_currentFrame(0) {
+          m_bSampledAnalysis(false),
+          m_currentFrame(0),
+          m_windowIndex(0) {
 }
 
 bool AnalyzerBeats::initialize(const AnalyzerTrack& track,
@@ -66,6 +70,7 @@ bool AnalyzerBeats::initialize(const AnalyzerTrack& track,
     m_bPreferencesReanalyzeOldBpm = m_bpmSettings.getReanalyzeWhenSettingsChange();
     m_bPreferencesReanalyzeImported = m_bpmSettings.getReanalyzeImported();
     m_bPreferencesFastAnalysis = m_bpmSettings.getFastAnalysis();
+    m_bSampledAnalysis = m_bPreferencesFastAnalysis && !track.getOptions().fullAnalysis;
 
     const auto plugins = availablePlugins();
     if (!plugins.isEmpty()) {
@@ -84,50 +89,67 @@ bool AnalyzerBeats::initialize(const AnalyzerTrack& track,
              << "\nFixed tempo assumption:" << m_bPreferencesFixedTempo
              << "\nRe-analyze when settings change:" << m_bPreferencesReanalyzeOldBpm
              << "\nRe-analyze imported from other software:" << m_bPreferencesReanalyzeImported
-             << "\nFast analysis:" << m_bPreferencesFastAnalysis;
+             << "\nFast analysis:" << m_bPreferencesFastAnalysis
+             << "\nSampled analysis:" << m_bSampledAnalysis;
 
     m_sampleRate = sampleRate;
     m_channelCount = channelCount;
-    // In fast analysis mode, skip processing after
-    // kFastAnalysisSecondsToAnalyze seconds are analyzed.
-    if (m_bPreferencesFastAnalysis) {
-        m_maxFramesToProcess =
-                mixxx::kFastAnalysisSecondsToAnalyze * m_sampleRate;
+    m_currentFrame = 0;
+    if (m_channelCount == mixxx::audio::ChannelCount::stem() &&
+            m_bpmSettings.getStemStrategy() == BeatDetectionSettings::StemStrategy::Enforced) {
+        // The chunks of the AnalyzerThread fit without reallocation
+        reserveStemBuffer(mixxx::kAnalysisFramesPerChunk *
+                mixxx::audio::ChannelCount::stereo());
+    }
+    // In fast analysis mode, only some windows spread across the track
+    // are analyzed and the results are combined into a provisional
+    // constant tempo.
+    if (m_bSampledAnalysis) {
+        m_windows = mixxx::SampledAnalysisWindows(m_sampleRate,
+                frameLength,
+                mixxx::kFastAnalysisWindowCount,
+                mixxx::kFastAnalysisSecondsPerWindow);
     } else {
-        m_maxFramesToProcess = frameLength;
+        m_windows = mixxx::SampledAnalysisWindows();
     }
-    m_currentFrame = 0;
+    m_windowIndex = 0;
+    m_sampledTempos.clear();
 
     // if we can load a stored track don't reanalyze it
     bool bShouldAnalyze = shouldAnalyze(track.getTrack());
 
     DEBUG_ASSERT(!m_pPlugin);
     if (bShouldAnalyze) {
-        if (m_pluginId == mixxx::AnalyzerQueenMaryBeats::pluginInfo().id()) {
-            m_pPlugin = std::make_unique<mixxx::AnalyzerQueenMaryBeats>();
-        } else if (m_pluginId == mixxx::AnalyzerSoundTouchBeats::pluginInfo().id()) {
-            m_pPlugin = std::make_unique<mixxx::AnalyzerSoundTouchBeats>();
-        } else {
-            // This must not happen, because we have already verified above
-            // that the PlugInId is valid
-            DEBUG_ASSERT(false);
-        }
-
+        // In sampled mode this plugin instance analyzes the first window
+        m_pPlugin = createPlugin();
         if (m_pPlugin) {
-            if (m_pPlugin->initialize(m_sampleRate)) {
-                qDebug() << "Beat calculation started with plugin" << m_pluginId;
-            } else {
-                qDebug() << "Beat calculation will not start.";
-                m_pPlugin.reset();
-                bShouldAnalyze = false;
-            }
+            qDebug() << "Beat calculation started with plugin" << m_pluginId;
         } else {
+            qDebug() << "Beat calculation will not start.";
             bShouldAnalyze = false;
         }
     }
     return bShouldAnalyze;
 }
 
+std::unique_ptr<mixxx::AnalyzerBeatsPlugin> AnalyzerBeats::createPlugin() const {
+    std::unique_ptr<mixxx::AnalyzerBeatsPlugin> pPlugin;
+    if (m_pluginId == mixxx::AnalyzerQueenMaryBeats::pluginInfo().id()) {
+        pPlugin = std::make_unique<mixxx::AnalyzerQueenMaryBeats>();
+    } else if (m_pluginId == mixxx::AnalyzerSoundTouchBeats::pluginInfo().id()) {
+        pPlugin = std::make_unique<mixxx::AnalyzerSoundTouchBeats>();
+    } else {
+        // This must not happen, because we have already verified
+        // that the PlugInId is valid
+        DEBUG_ASSERT(false);
+        return nullptr;
+    }
+    if (!pPlugin->initialize(m_sampleRate)) {
+        return nullptr;
+    }
+    return pPlugin;
+}
+
 bool AnalyzerBeats::shouldAnalyze(TrackPointer pTrack) const {
     bool bpmLock = pTrack->isBpmLocked();
     if (bpmLock) {
@@ -174,9 +196,9 @@ bool AnalyzerBeats::shouldAnalyze(TrackPointer pTrack) const {
     QString version = pBeats->getVersion();
     QHash<QString, QString> extraVersionInfo = getExtraVersionInfo(
             pluginID,
-            m_bPreferencesFastAnalysis);
+            m_bSampledAnalysis);
     QString newVersion = BeatFactory::getPreferredVersion(
-            m_bPreferencesFixedTempo);
+            assumeFixedTempo());
     QString newSubVersion = BeatFactory::getPreferredSubVersion(
             extraVersionInfo);
 
@@ -185,6 +207,23 @@ bool AnalyzerBeats::shouldAnalyze(TrackPointer pTrack) const {
         // sane, re-analyzing will do nothing.
         return false;
     }
+    if (m_bSampledAnalysis) {
+        if (subVersion == BeatFactory::getPreferredSubVersion(
+                                  getExtraVersionInfo(pluginID, false))) {
+            // Don't replace the results of a full analysis by
+            // provisional results.
+            return false;
+        }
+    } else if (subVersion == BeatFactory::getPreferredSubVersion(
+                                     getExtraVersionInfo(pluginID, true))) {
+        if (PlayerInfo::instance().isTrackLoaded(pTrack)) {
+            // Replacing the beats would move the beat grid of the deck
+            qDebug() << "Keeping provisional beats of a track that is loaded into a deck.";
+            return false;
+        }
+        qDebug() << "Replacing provisional beats of a fast analysis.";
+        return true;
+    }
     // Beat grid exists but version and settings differ
     if (!m_bPreferencesReanalyzeOldBpm) {
         qDebug() << "Beat calculation skips analyzing because the track has"
@@ -197,57 +236,144 @@ bool AnalyzerBeats::shouldAnalyze(TrackPointer pTrack) const {
 }
 
 bool AnalyzerBeats::processSamples(const CSAMPLE* pIn, SINT count) {
-    VERIFY_OR_DEBUG_ASSERT(m_pPlugin) {
+    return processChunk(AnalyzerChunk(pIn, count, m_channelCount));
+}
+
+bool AnalyzerBeats::processChunk(const AnalyzerChunk& chunk) {
+    // In sampled mode the plugins are created per window
+    VERIFY_OR_DEBUG_ASSERT(m_pPlugin || m_bSampledAnalysis) {
+        return false;
+    }
+    DEBUG_ASSERT(chunk.channelCount() == m_channelCount);
+
+    if (m_channelCount > mixxx::audio::ChannelCount::stereo() &&
+            m_channelCount != mixxx::audio::ChannelCount::stem()) {
+        DEBUG_ASSERT(!"Unsupported channel count");
         return false;
     }
 
-    SINT numFrames = count / m_channelCount;
-    const CSAMPLE* pBeatInput = pIn;
-    CSAMPLE* pDrumChannel = nullptr;
+    const SINT numFrames = chunk.frameCount();
+    const SINT firstFrame = m_currentFrame;
+    m_currentFrame += numFrames;
+    if (m_bSampledAnalysis && m_windowIndex >= m_windows.size()) {
+        return true; // silently ignore all remaining samples
+    }
 
-    if (m_channelCount == mixxx::audio::ChannelCount::stem()) {
+    if (m_channelCount == mixxx::audio::ChannelCount::stem() &&
+            m_bpmSettings.getStemStrategy() == BeatDetectionSettings::StemStrategy::Enforced) {
         // We have an 8 channel soundsource. The only implemented soundsource with
         // 8ch is the NI STEM file format.
         // TODO: If we add other soundsources with 8ch, we need to rework this condition.
         //
-        // For NI STEM we mix all the stems together except the first one,
-        // which contains drums or beats by convention.
-        count = numFrames * mixxx::audio::ChannelCount::stereo();
-        pDrumChannel = SampleUtil::alloc(count);
-
-        VERIFY_OR_DEBUG_ASSERT(pDrumChannel) {
+        // For NI STEM the first stem contains drums or beats by convention.
+        reserveStemBuffer(chunk.stereoSampleCount());
+        VERIFY_OR_DEBUG_ASSERT(m_stemBuffer.data()) {
             return false;
         }
+        SampleUtil::copyOneStereoFromMulti(
+                m_stemBuffer.data(), chunk.samples(), numFrames, m_channelCount, 0);
+        return processStereoSamples(m_stemBuffer.data(), firstFrame, numFrames);
+    }
 
-        if (m_bpmSettings.getStemStrategy() == BeatDetectionSettings::StemStrategy::Enforced) {
-            SampleUtil::copyOneStereoFromMulti(pDrumChannel, pIn, numFrames, m_channelCount, 0);
-        } else {
-            SampleUtil::mixMultichannelToStereo(pDrumChannel, pIn, numFrames, m_channelCount);
-        }
+    // Otherwise all stems are mixed together, which is shared with the
+    // other analyzers.
+    return processStereoSamples(chunk.stereoMix(), firstFrame, numFrames);
+}
 
-        pBeatInput = pDrumChannel;
-    } else if (m_channelCount > mixxx::audio::ChannelCount::stereo()) {
-        DEBUG_ASSERT(!"Unsupported channel count");
-        return false;
+void AnalyzerBeats::reserveStemBuffer(SINT sampleCount) {
+    if (m_stemBuffer.size() < sampleCount) {
+        mixxx::SampleBuffer(sampleCount).swap(m_stemBuffer);
     }
+}
 
-    m_currentFrame += numFrames;
-    if (m_currentFrame > m_maxFramesToProcess) {
-        return true; // silently ignore all remaining samples
+bool AnalyzerBeats::processStereoSamples(
+        const CSAMPLE* pIn, SINT firstFrame, SINT frameCount) {
+    if (!m_bSampledAnalysis) {
+        return m_pPlugin->processSamples(
+                pIn, frameCount * mixxx::audio::ChannelCount::stereo());
     }
 
-    bool ret = m_pPlugin->processSamples(pBeatInput, count);
-    if (pDrumChannel) {
-        SampleUtil::free(pDrumChannel);
+    const auto frameRange = mixxx::IndexRange::forward(firstFrame, frameCount);
+    for (; m_windowIndex < m_windows.size(); ++m_windowIndex) {
+        const mixxx::IndexRange window = m_windows.at(m_windowIndex);
+        if (frameRange.end() <= window.start()) {
+            // The next window has not been reached yet
+            return true;
+        }
+        if (frameRange.start() < window.end()) {
+            if (!m_pPlugin) {
+                m_pPlugin = createPlugin();
+                VERIFY_OR_DEBUG_ASSERT(m_pPlugin) {
+                    return false;
+                }
+            }
+            const SINT start = math_max(frameRange.start(), window.start());
+            const SINT end = math_min(frameRange.end(), window.end());
+            if (!m_pPlugin->processSamples(
+                        pIn + (start - firstFrame) * mixxx::audio::ChannelCount::stereo(),
+                        (end - start) * mixxx::audio::ChannelCount::stereo())) {
+                return false;
+            }
+            if (end < window.end()) {
+                // The window continues in the next chunk
+                return true;
+            }
+        }
+        finishWindow();
     }
-    return ret;
+    return true;
+}
+
+void AnalyzerBeats::finishWindow() {
+    DEBUG_ASSERT(m_windowIndex < m_windows.size());
+    if (!m_pPlugin) {
+        // No frames of this window have been processed
+        return;
+    }
+    const mixxx::IndexRange window = m_windows.at(m_windowIndex);
+    if (m_pPlugin->finalize()) {
+        mixxx::SampledTempo tempo;
+        if (m_pPlugin->supportsBeatTracking()) {
+            // The beats are detected relative to the start of the window
+            QVector<mixxx::audio::FramePos> beats = m_pPlugin->getBeats();
+            for (auto& beat : beats) {
+                beat += window.start();
+            }
+            tempo = mixxx::estimateSampledTempo(beats, m_sampleRate);
+        } else {
+            tempo.bpm = m_pPlugin->getBpm();
+            tempo.confidence = tempo.bpm.isValid() ? 1.0 : 0.0;
+        }
+        m_sampledTempos.push_back(tempo);
+    } else {
+        qWarning() << "Beat/BPM analysis failed in window" << window;
+    }
+    m_pPlugin.reset();
+}
+
+SINT AnalyzerBeats::framesToSkip() const {
+    if (!m_bSampledAnalysis) {
+        return 0;
+    }
+    return m_windows.framesToSkip(m_currentFrame);
+}
+
+void AnalyzerBeats::skipFrames(SINT frameCount) {
+    DEBUG_ASSERT(frameCount <= framesToSkip());
+    m_currentFrame += frameCount;
 }
 
 void AnalyzerBeats::cleanup() {
     m_pPlugin.reset();
+    m_sampledTempos.clear();
 }
 
 void AnalyzerBeats::storeResults(TrackPointer pTrack) {
+    if (m_bSampledAnalysis) {
+        storeSampledResults(pTrack);
+        return;
+    }
+
     VERIFY_OR_DEBUG_ASSERT(m_pPlugin) {
         return;
     }
@@ -261,7 +387,7 @@ void AnalyzerBeats::storeResults(TrackPointer pTrack) {
     if (m_pPlugin->supportsBeatTracking()) {
         QVector<mixxx::audio::FramePos> beats = m_pPlugin->getBeats();
         QHash<QString, QString> extraVersionInfo = getExtraVersionInfo(
-                m_pluginId, m_bPreferencesFastAnalysis);
+                m_pluginId, false);
         pBeats = BeatFactory::makePreferredBeats(
                 beats,
                 extraVersionInfo,
@@ -281,9 +407,88 @@ void AnalyzerBeats::storeResults(TrackPointer pTrack) {
         pBeats = mixxx::Beats::fromConstTempo(m_sampleRate, mixxx::audio::kStartFramePos, bpm);
     }
 
+    // The track might have been loaded into a deck during the analysis
+    const mixxx::BeatsPointer pProvisionalBeats = pTrack->getBeats();
+    if (pProvisionalBeats &&
+            pProvisionalBeats->getSubVersion() ==
+                    BeatFactory::getPreferredSubVersion(
+                            getExtraVersionInfo(m_pluginId, true)) &&
+            PlayerInfo::instance().isTrackLoaded(pTrack)) {
+        qDebug() << "Keeping provisional beats of a track that is loaded into a deck.";
+        return;
+    }
+
     pTrack->trySetBeats(pBeats);
 }
 
+void AnalyzerBeats::storeSampledResults(TrackPointer pTrack) {
+    if (m_windowIndex < m_windows.size()) {
+        // The last window extends up to the end of the track
+        finishWindow();
+    }
+    const auto tempo = mixxx::combineSampledTempos(m_sampledTempos);
+    if (!tempo) {
+        qWarning() << "Beat/BPM analysis failed";
+        return;
+    }
+    qDebug() << "AnalyzerBeats detected provisional BPM" << tempo->bpm
+             << "in" << m_sampledTempos.size()
+             << "windows with confidence" << tempo->confidence;
+    const auto firstBeat = tempo->firstBeat.isValid()
+            ? tempo->firstBeat.toNearestFrameBoundary()
+            : mixxx::audio::kStartFramePos;
+    const QString subVersion = BeatFactory::getPreferredSubVersion(
+            getExtraVersionInfo(m_pluginId, true));
+    pTrack->trySetBeats(mixxx::Beats::fromConstTempo(
+            m_sampleRate, firstBeat, tempo->bpm, subVersion));
+}
+
+bool AnalyzerBeats::restoreCachedResults(
+        const mixxx::AnalysisCacheEntry& cacheEntry,
+        TrackPointer pTrack) {
+    // Only reuse beats that have been detected with the current settings
+    const QString version = BeatFactory::getPreferredVersion(assumeFixedTempo());
+    const QString subVersion = BeatFactory::getPreferredSubVersion(
+            getExtraVersionInfo(m_pluginId, m_bSampledAnalysis));
+    if (cacheEntry.beats.isEmpty() ||
+            cacheEntry.beatsVersion != version ||
+            cacheEntry.beatsSubVersion != subVersion) {
+        return false;
+    }
+    const auto pBeats = mixxx::Beats::fromByteArray(m_sampleRate,
+            cacheEntry.beatsVersion,
+            cacheEntry.beatsSubVersion,
+            cacheEntry.beats);
+    if (!pBeats) {
+        return false;
+    }
+    pTrack->trySetBeats(pBeats);
+    return true;
+}
+
+void AnalyzerBeats::storeCachedResults(
+        mixxx::AnalysisCacheEntry* pCacheEntry,
+        TrackPointer pTrack) const {
+    const auto pBeats = pTrack->getBeats();
+    if (!pBeats) {
+        return;
+    }
+    pCacheEntry->beatsVersion = pBeats->getVersion();
+    pCacheEntry->beatsSubVersion = pBeats->getSubVersion();
+    pCacheEntry->beats = pBeats->toByteArray();
+}
+
+// static
+bool AnalyzerBeats::hasProvisionalResults(const Track& track) {
+    const mixxx::BeatsPointer pBeats = track.getBeats();
+    if (!pBeats) {
+        return false;
+    }
+    // The fragment of the sub-version from getExtraVersionInfo()
+    return pBeats->getSubVersion().split(QChar('|')).contains(
+            QStringLiteral("fast_analysis=1"));
+}
+
 // static
 QHash<QString, QString> AnalyzerBeats::getExtraVersionInfo(
         const QString& pluginId, bool bPreferencesFastAnalysis) {
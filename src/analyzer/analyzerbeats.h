@@ -3,11 +3,14 @@
 #include <QHash>
 #include <QList>
 #include <memory>
+#include <vector>
 
 #include "analyzer/analyzer.h"
 #include "analyzer/plugins/analyzerplugin.h"
+#include "analyzer/sampledanalysis.h"
 #include "preferences/beatdetectionsettings.h"
 #include "preferences/usersettings.h"
+#include "util/samplebuffer.h"
 
 class AnalyzerBeats : public Analyzer {
   public:
@@ -19,19 +22,43 @@ class AnalyzerBeats : public Analyzer {
     static QList<mixxx::AnalyzerPluginInfo> availablePlugins();
     static mixxx::AnalyzerPluginInfo defaultPlugin();
 
+    /// Returns true if the beats of the track are the provisional results
+    /// of a sampled analysis, i.e. a full analysis is still pending.
+    static bool hasProvisionalResults(const Track& track);
+
     bool initialize(const AnalyzerTrack& track,
             mixxx::audio::SampleRate sampleRate,
             mixxx::audio::ChannelCount channelCount,
             SINT frameLength) override;
     bool processSamples(const CSAMPLE* pIn, SINT count) override;
+    bool processChunk(const AnalyzerChunk& chunk) override;
+    SINT framesToSkip() const override;
+    void skipFrames(SINT frameCount) override;
     void storeResults(TrackPointer tio) override;
+    bool restoreCachedResults(
+            const mixxx::AnalysisCacheEntry& cacheEntry,
+            TrackPointer pTrack) override;
+    void storeCachedResults(
+            mixxx::AnalysisCacheEntry* pCacheEntry,
+            TrackPointer pTrack) const override;
     void cleanup() override;
 
   private:
     bool shouldAnalyze(TrackPointer pTrack) const;
+    void reserveStemBuffer(SINT sampleCount);
     static QHash<QString, QString> getExtraVersionInfo(
             const QString& pluginId, bool bPreferencesFastAnalysis);
 
+    // The sampled analysis always results in a constant tempo
+    bool assumeFixedTempo() const {
+        return m_bPreferencesFixedTempo || m_bSampledAnalysis;
+    }
+
+    std::unique_ptr<mixxx::AnalyzerBeatsPlugin> createPlugin() const;
+    bool processStereoSamples(const CSAMPLE* pIn, SINT firstFrame, SINT frameCount);
+    void finishWindow();
+    void storeSampledResults(TrackPointer pTrack);
+
     BeatDetectionSettings m_bpmSettings;
     std::unique_ptr<mixxx::AnalyzerBeatsPlugin> m_pPlugin;
     const bool m_enforceBpmDetection;
@@ -40,9 +67,18 @@ class AnalyzerBeats : public Analyzer {
     bool m_bPreferencesReanalyzeImported;
     bool m_bPreferencesFixedTempo;
     bool m_bPreferencesFastAnalysis;
+    // Fast analysis unless a full analysis has been requested
+    bool m_bSampledAnalysis;
 
     mixxx::audio::SampleRate m_sampleRate;
     mixxx::audio::ChannelCount m_channelCount;
-    SINT m_maxFramesToProcess;
     SINT m_currentFrame;
+    // The stereo signal of the selected stems, which is not shared with
+    // the other analyzers
+    mixxx::SampleBuffer m_stemBuffer;
+
+    // Each window is analyzed by a separate plugin instance
+    mixxx::SampledAnalysisWindows m_windows;
+    int m_windowIndex;
+    std::vector<mixxx::SampledTempo> m_sampledTempos;
 };
@@ -0,0 +1,32 @@
+#include "analyzer/analyzerchunk.h"
+
+#include "util/assert.h"
+#include "util/sample.h"
+
+void AnalyzerChunk::assign(const CSAMPLE* pSamples,
+        SINT sampleCount,
+        mixxx::audio::ChannelCount channelCount) {
+    DEBUG_ASSERT(channelCount.isValid());
+    DEBUG_ASSERT(sampleCount % channelCount == 0);
+    m_pSamples = pSamples;
+    m_sampleCount = sampleCount;
+    m_channelCount = channelCount;
+    m_stereoMixValid = false;
+}
+
+const CSAMPLE* AnalyzerChunk::stereoMix() const {
+    if (m_channelCount == mixxx::audio::ChannelCount::stereo()) {
+        return m_pSamples;
+    }
+    DEBUG_ASSERT(m_channelCount % mixxx::audio::ChannelCount::stereo() == 0);
+    if (!m_stereoMixValid) {
+        const SINT stereoSamples = stereoSampleCount();
+        if (m_stereoMixBuffer.size() < stereoSamples) {
+            mixxx::SampleBuffer(stereoSamples).swap(m_stereoMixBuffer);
+        }
+        SampleUtil::mixMultichannelToStereo(
+                m_stereoMixBuffer.data(), m_pSamples, frameCount(), m_channelCount);
+        m_stereoMixValid = true;
+    }
+    return m_stereoMixBuffer.data();
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "audio/types.h"
+#include "util/samplebuffer.h"
+#include "util/types.h"
+
+/// A chunk of decoded audio data that is passed to all analyzers.
+///
+/// Signals derived from the decoded samples, like the stereo mix of a
+/// multi-channel (stem) source, are computed lazily on first access and
+/// then shared read-only by all analyzers that process the chunk. The
+/// internal buffers are reused when a chunk is reassigned.
+class AnalyzerChunk {
+  public:
+    AnalyzerChunk() = default;
+    AnalyzerChunk(const CSAMPLE* pSamples,
+            SINT sampleCount,
+            mixxx::audio::ChannelCount channelCount) {
+        assign(pSamples, sampleCount, channelCount);
+    }
+    AnalyzerChunk(const AnalyzerChunk&) = delete;
+    AnalyzerChunk& operator=(const AnalyzerChunk&) = delete;
+
+    void assign(const CSAMPLE* pSamples,
+            SINT sampleCount,
+            mixxx::audio::ChannelCount channelCount);
+
+    /// The interleaved samples of all channels as decoded.
+    const CSAMPLE* samples() const {
+        return m_pSamples;
+    }
+    SINT sampleCount() const {
+        return m_sampleCount;
+    }
+    mixxx::audio::ChannelCount channelCount() const {
+        return m_channelCount;
+    }
+    SINT frameCount() const {
+        return m_channelCount.isValid() ? m_sampleCount / m_channelCount : 0;
+    }
+
+    /// All channels mixed down to interleaved stereo. Identical to
+    /// samples() if the source is already stereo.
+    const CSAMPLE* stereoMix() const;
+    SINT stereoSampleCount() const {
+        return frameCount() * mixxx::audio::ChannelCount::stereo();
+    }
+
+  private:
+    const CSAMPLE* m_pSamples{};
+    SINT m_sampleCount{};
+    mixxx::audio::ChannelCount m_channelCount;
+
+    mutable mixxx::SampleBuffer m_stereoMixBuffer;
+    mutable bool m_stereoMixValid{};
+};
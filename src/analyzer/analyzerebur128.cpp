@@ -2,8 +2,10 @@
 
 #include <QtDebug>
 
+#include "analyzer/analysiscache.h"
 #include "analyzer/analyzertrack.h"
 #include "analyzer/constants.h"
+#include "analyzer/integratedloudnessmeter.h"
 #include "track/track.h"
 #include "util/math.h"
 #include "util/timer.h"
@@ -13,8 +15,7 @@ constexpr double kReplayGain2ReferenceLUFS = -18;
 } // anonymous namespace
 
 AnalyzerEbur128::AnalyzerEbur128(UserSettingsPointer pConfig)
-        : m_rgSettings(pConfig),
-          m_pState(nullptr) {
+        : m_rgSettings(pConfig) {
 }
 
 AnalyzerEbur128::~AnalyzerEbur128() {
@@ -30,50 +31,45 @@ bool AnalyzerEbur128::initialize(
         qDebug() << "Skipping AnalyzerEbur128";
         return false;
     }
-    DEBUG_ASSERT(m_pState == nullptr);
-    m_pState = ebur128_init(
-            channelCount,
-            sampleRate,
-            EBUR128_MODE_I);
-    return m_pState != nullptr;
+    if (channelCount % mixxx::kAnalysisChannels != 0) {
+        qWarning() << "AnalyzerEbur128: Unsupported channel count" << channelCount;
+        return false;
+    }
+    DEBUG_ASSERT(!m_pMeter);
+    m_channelCount = channelCount;
+    m_pMeter = std::make_unique<mixxx::IntegratedLoudnessMeter>(
+            sampleRate, mixxx::kAnalysisChannels);
+    return true;
 }
 
 void AnalyzerEbur128::cleanup() {
-    if (m_pState) {
-        ebur128_destroy(&m_pState);
-        // ebur128_destroy clears the pointer but let's not rely on that.
-        m_pState = nullptr;
-    }
+    m_pMeter.reset();
 }
 
 bool AnalyzerEbur128::processSamples(const CSAMPLE* pIn, SINT count) {
-    VERIFY_OR_DEBUG_ASSERT(m_pState) {
+    return processChunk(AnalyzerChunk(pIn, count, m_channelCount));
+}
+
+bool AnalyzerEbur128::processChunk(const AnalyzerChunk& chunk) {
+    VERIFY_OR_DEBUG_ASSERT(m_pMeter) {
         return false;
     }
     ScopedTimer t(QStringLiteral("AnalyzerEbur128::processSamples()"));
-    size_t frames = count / m_pState->channels;
-    int e = ebur128_add_frames_float(m_pState, pIn, frames);
-    VERIFY_OR_DEBUG_ASSERT(e == EBUR128_SUCCESS) {
-        qWarning() << "AnalyzerEbur128::processSamples() failed with" << e;
-        return false;
-    }
+    DEBUG_ASSERT(chunk.channelCount() == m_channelCount);
+    // For NI STEM all stems are mixed together, which is shared with the
+    // other analyzers.
+    m_pMeter->process(chunk.stereoMix(), chunk.frameCount());
     return true;
 }
 
 void AnalyzerEbur128::storeResults(TrackPointer pTrack) {
-    VERIFY_OR_DEBUG_ASSERT(m_pState) {
-        return;
-    }
-    double averageLufs;
-    int e = ebur128_loudness_global(m_pState, &averageLufs);
-    VERIFY_OR_DEBUG_ASSERT(e == EBUR128_SUCCESS) {
-        qWarning() << "AnalyzerEbur128::storeResults() failed with" << e;
+    VERIFY_OR_DEBUG_ASSERT(m_pMeter) {
         return;
     }
+    const double averageLufs = m_pMeter->integratedLoudness();
     if (averageLufs == -HUGE_VAL ||
             averageLufs == HUGE_VAL ||
-            // This catches 0 and abnormal values inf and -inf (that may have
-            // slipped through in libebur128 for some reason.
+            // This catches 0 and abnormal values inf and -inf
             !util_isnormal(averageLufs)) {
         qWarning() << "AnalyzerEbur128::storeResults() averageLufs invalid:"
                    << averageLufs;
@@ -84,6 +80,27 @@ void AnalyzerEbur128::storeResults(TrackPointer pTrack) {
     mixxx::ReplayGain replayGain(pTrack->getReplayGain());
     replayGain.setRatio(db2ratio(fReplayGain2));
     pTrack->setReplayGain(replayGain);
-    qDebug() << "ReplayGain 2.0 (libebur128) result is" << fReplayGain2
+    qDebug() << "ReplayGain 2.0 (EBU R128) result is" << fReplayGain2
              << "dB for" << pTrack->getFileInfo();
 }
+
+bool AnalyzerEbur128::restoreCachedResults(
+        const mixxx::AnalysisCacheEntry& cacheEntry,
+        TrackPointer pTrack) {
+    if (!mixxx::ReplayGain::isValidRatio(cacheEntry.replayGain2Ratio)) {
+        return false;
+    }
+    mixxx::ReplayGain replayGain(pTrack->getReplayGain());
+    replayGain.setRatio(cacheEntry.replayGain2Ratio);
+    pTrack->setReplayGain(replayGain);
+    return true;
+}
+
+void AnalyzerEbur128::storeCachedResults(
+        mixxx::AnalysisCacheEntry* pCacheEntry,
+        TrackPointer pTrack) const {
+    const mixxx::ReplayGain replayGain = pTrack->getReplayGain();
+    if (replayGain.hasRatio()) {
+        pCacheEntry->replayGain2Ratio = replayGain.getRatio();
+    }
+}
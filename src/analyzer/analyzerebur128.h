@@ -1,10 +1,14 @@
 #pragma once
 
-#include <ebur128.h>
+#include <memory>
 
 #include "analyzer/analyzer.h"
 #include "preferences/replaygainsettings.h"
 
+namespace mixxx {
+class IntegratedLoudnessMeter;
+} // namespace mixxx
+
 class AnalyzerEbur128 : public Analyzer {
   public:
     AnalyzerEbur128(UserSettingsPointer pConfig);
@@ -19,10 +23,18 @@ class AnalyzerEbur128 : public Analyzer {
             mixxx::audio::ChannelCount channelCount,
             SINT frameLength) override;
     bool processSamples(const CSAMPLE* pIn, SINT count) override;
+    bool processChunk(const AnalyzerChunk& chunk) override;
     void storeResults(TrackPointer pTrack) override;
+    bool restoreCachedResults(
+            const mixxx::AnalysisCacheEntry& cacheEntry,
+            TrackPointer pTrack) override;
+    void storeCachedResults(
+            mixxx::AnalysisCacheEntry* pCacheEntry,
+            TrackPointer pTrack) const override;
     void cleanup() override;
 
   private:
     ReplayGainSettings m_rgSettings;
-    ebur128_state* m_pState;
+    mixxx::audio::ChannelCount m_channelCount;
+    std::unique_ptr<mixxx::IntegratedLoudnessMeter> m_pMeter;
 };
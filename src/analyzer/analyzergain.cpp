@@ -4,6 +4,7 @@
 
 #include <QtDebug>
 
+#include "analyzer/analysiscache.h"
 #include "analyzer/analyzertrack.h"
 #include "analyzer/constants.h"
 #include "track/track.h"
@@ -36,32 +37,24 @@ void AnalyzerGain::cleanup() {
 }
 
 bool AnalyzerGain::processSamples(const CSAMPLE* pIn, SINT count) {
+    return processChunk(AnalyzerChunk(pIn, count, m_channelCount));
+}
+
+bool AnalyzerGain::processChunk(const AnalyzerChunk& chunk) {
     ScopedTimer t(QStringLiteral("AnalyzerGain::process()"));
+    DEBUG_ASSERT(chunk.channelCount() == m_channelCount);
 
-    SINT numFrames = count / m_channelCount;
-
-    const CSAMPLE* pGainInput = pIn;
-    CSAMPLE* pMixedChannel = nullptr;
-
-    if (m_channelCount == mixxx::audio::ChannelCount::stem()) {
-        // We have an 8 channel soundsource. The only implemented soundsource with
-        // 8ch is the NI STEM file format.
-        // TODO: If we add other soundsources with 8ch, we need to rework this condition.
-        //
-        // For NI STEM we mix all the stems together except the first one,
-        // which contains drums or beats by convention.
-        count = numFrames * mixxx::audio::ChannelCount::stereo();
-        pMixedChannel = SampleUtil::alloc(count);
-        VERIFY_OR_DEBUG_ASSERT(pMixedChannel) {
-            return false;
-        }
-        SampleUtil::mixMultichannelToStereo(pMixedChannel, pIn, numFrames, m_channelCount);
-        pGainInput = pMixedChannel;
-    } else if (m_channelCount > mixxx::audio::ChannelCount::stereo()) {
+    if (m_channelCount > mixxx::audio::ChannelCount::stereo() &&
+            m_channelCount != mixxx::audio::ChannelCount::stem()) {
         DEBUG_ASSERT(!"Unsupported channel count");
         return false;
     }
 
+    const SINT numFrames = chunk.frameCount();
+    // For NI STEM all stems are mixed together, which is shared with the
+    // other analyzers.
+    const CSAMPLE* pGainInput = chunk.stereoMix();
+
     if (numFrames > static_cast<SINT>(m_pLeftTempBuffer.size())) {
         m_pLeftTempBuffer.resize(numFrames);
         m_pRightTempBuffer.resize(numFrames);
@@ -72,12 +65,8 @@ bool AnalyzerGain::processSamples(const CSAMPLE* pIn, SINT count) {
             numFrames);
     SampleUtil::applyGain(m_pLeftTempBuffer.data(), 32767, numFrames);
     SampleUtil::applyGain(m_pRightTempBuffer.data(), 32767, numFrames);
-    bool ret = m_pReplayGain->process(
+    return m_pReplayGain->process(
             m_pLeftTempBuffer.data(), m_pRightTempBuffer.data(), numFrames);
-    if (pMixedChannel) {
-        SampleUtil::free(pMixedChannel);
-    }
-    return ret;
 }
 
 void AnalyzerGain::storeResults(TrackPointer pTrack) {
@@ -99,3 +88,24 @@ void AnalyzerGain::storeResults(TrackPointer pTrack) {
     qDebug() << "ReplayGain 1.0 result is" << fReplayGainOutput << "dB for"
              << pTrack->getLocation();
 }
+
+bool AnalyzerGain::restoreCachedResults(
+        const mixxx::AnalysisCacheEntry& cacheEntry,
+        TrackPointer pTrack) {
+    if (!mixxx::ReplayGain::isValidRatio(cacheEntry.replayGain1Ratio)) {
+        return false;
+    }
+    mixxx::ReplayGain replayGain(pTrack->getReplayGain());
+    replayGain.setRatio(cacheEntry.replayGain1Ratio);
+    pTrack->setReplayGain(replayGain);
+    return true;
+}
+
+void AnalyzerGain::storeCachedResults(
+        mixxx::AnalysisCacheEntry* pCacheEntry,
+        TrackPointer pTrack) const {
+    const mixxx::ReplayGain replayGain = pTrack->getReplayGain();
+    if (replayGain.hasRatio()) {
+        pCacheEntry->replayGain1Ratio = replayGain.getRatio();
+    }
+}
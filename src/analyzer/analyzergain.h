@@ -29,7 +29,14 @@ class AnalyzerGain : public Analyzer {
             mixxx::audio::ChannelCount channelCount,
             SINT frameLength) override;
     bool processSamples(const CSAMPLE* pIn, SINT count) override;
+    bool processChunk(const AnalyzerChunk& chunk) override;
     void storeResults(TrackPointer tio) override;
+    bool restoreCachedResults(
+            const mixxx::AnalysisCacheEntry& cacheEntry,
+            TrackPointer pTrack) override;
+    void storeCachedResults(
+            mixxx::AnalysisCacheEntry* pCacheEntry,
+            TrackPointer pTrack) const override;
     void cleanup() override;
 
   private:
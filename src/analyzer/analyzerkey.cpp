@@ -2,15 +2,18 @@
 
 #include <QtDebug>
 
+#include "analyzer/analysiscache.h"
 #include "analyzer/analyzertrack.h"
 #include "analyzer/constants.h"
 #if defined __KEYFINDER__
 #include "analyzer/plugins/analyzerkeyfinder.h"
 #endif
 #include "analyzer/plugins/analyzerqueenmarykey.h"
+#include "mixer/playerinfo.h"
 #include "proto/keys.pb.h"
 #include "track/keyfactory.h"
 #include "track/track.h"
+#include "util/math.h"
 
 namespace {
 constexpr int excludeFirstChannelMask = 0x1;
@@ -38,11 +41,12 @@ AnalyzerKey::AnalyzerKey(const KeyDetectionSettings& keySettings)
         : m_keySettings(keySettings),
           m_sampleRate(0),
           m_totalFrames(0),
-          m_maxFramesToProcess(0),
           m_currentFrame(0),
+          m_windowIndex(0),
           m_bPreferencesKeyDetectionEnabled(true),
           m_bPreferencesFastAnalysisEnabled(false),
-          m_bPreferencesReanalyzeEnabled(false) {
+          m_bPreferencesReanalyzeEnabled(false),
+          m_bSampledAnalysis(false) {
 }
 
 bool AnalyzerKey::initialize(const AnalyzerTrack& track,
@@ -61,6 +65,7 @@ bool AnalyzerKey::initialize(const AnalyzerTrack& track,
 
     m_bPreferencesFastAnalysisEnabled = m_keySettings.getFastAnalysis();
     m_bPreferencesReanalyzeEnabled = m_keySettings.getReanalyzeWhenSettingsChange();
+    m_bSampledAnalysis = m_bPreferencesFastAnalysisEnabled && !track.getOptions().fullAnalysis;
 
     const auto plugins = availablePlugins();
     if (!plugins.isEmpty()) {
@@ -77,54 +82,71 @@ bool AnalyzerKey::initialize(const AnalyzerTrack& track,
     qDebug() << "AnalyzerKey preference settings:"
              << "\nPlugin:" << m_pluginId
              << "\nRe-analyze when settings change:" << m_bPreferencesReanalyzeEnabled
-             << "\nFast analysis:" << m_bPreferencesFastAnalysisEnabled;
+             << "\nFast analysis:" << m_bPreferencesFastAnalysisEnabled
+             << "\nSampled analysis:" << m_bSampledAnalysis;
 
     m_sampleRate = sampleRate;
     m_channelCount = channelCount;
     m_totalFrames = frameLength;
-    // In fast analysis mode, skip processing after
-    // kFastAnalysisSecondsToAnalyze seconds are analyzed.
-    if (m_bPreferencesFastAnalysisEnabled) {
-        m_maxFramesToProcess = mixxx::kFastAnalysisSecondsToAnalyze * m_sampleRate;
+    m_currentFrame = 0;
+    if (m_channelCount == mixxx::audio::ChannelCount::stem() &&
+            m_keySettings.getStemStrategy() == KeyDetectionSettings::StemStrategy::Enforced) {
+        // The chunks of the AnalyzerThread fit without reallocation
+        reserveStemBuffer(mixxx::kAnalysisFramesPerChunk *
+                mixxx::audio::ChannelCount::stereo());
+    }
+    // In fast analysis mode, only some windows spread across the track
+    // are analyzed and the predominant key of all windows is stored as
+    // a provisional result.
+    if (m_bSampledAnalysis) {
+        m_windows = mixxx::SampledAnalysisWindows(m_sampleRate,
+                frameLength,
+                mixxx::kFastAnalysisWindowCount,
+                mixxx::kFastAnalysisSecondsPerWindow);
     } else {
-        m_maxFramesToProcess = frameLength;
+        m_windows = mixxx::SampledAnalysisWindows();
     }
-    m_currentFrame = 0;
+    m_windowIndex = 0;
+    m_sampledKeys.clear();
 
     // if we can't load a stored track reanalyze it
     bool bShouldAnalyze = shouldAnalyze(track.getTrack());
 
     DEBUG_ASSERT(!m_pPlugin);
     if (bShouldAnalyze) {
-        if (m_pluginId == mixxx::AnalyzerQueenMaryKey::pluginInfo().id()) {
-            m_pPlugin = std::make_unique<mixxx::AnalyzerQueenMaryKey>();
-#if defined __KEYFINDER__
-        } else if (m_pluginId == mixxx::AnalyzerKeyFinder::pluginInfo().id()) {
-            m_pPlugin = std::make_unique<mixxx::AnalyzerKeyFinder>();
-#endif
-        } else {
-            // This must not happen, because we have already verified above
-            // that the PlugInId is valid
-            DEBUG_ASSERT(false);
-        }
-
+        // In sampled mode this plugin instance analyzes the first window
+        m_pPlugin = createPlugin();
         if (m_pPlugin) {
-            if (m_pPlugin->initialize(mixxx::audio::SampleRate(m_sampleRate))) {
-                qDebug() << "Key calculation started with plugin" << m_pluginId;
-            } else {
-                qDebug() << "Key calculation will not start.";
-                m_pPlugin.reset();
-                bShouldAnalyze = false;
-            }
+            qDebug() << "Key calculation started with plugin" << m_pluginId;
         } else {
+            qDebug() << "Key calculation will not start.";
             bShouldAnalyze = false;
         }
     }
     return bShouldAnalyze;
 }
 
+std::unique_ptr<mixxx::AnalyzerKeyPlugin> AnalyzerKey::createPlugin() const {
+    std::unique_ptr<mixxx::AnalyzerKeyPlugin> pPlugin;
+    if (m_pluginId == mixxx::AnalyzerQueenMaryKey::pluginInfo().id()) {
+        pPlugin = std::make_unique<mixxx::AnalyzerQueenMaryKey>();
+#if defined __KEYFINDER__
+    } else if (m_pluginId == mixxx::AnalyzerKeyFinder::pluginInfo().id()) {
+        pPlugin = std::make_unique<mixxx::AnalyzerKeyFinder>();
+#endif
+    } else {
+        // This must not happen, because we have already verified
+        // that the PlugInId is valid
+        DEBUG_ASSERT(false);
+        return nullptr;
+    }
+    if (!pPlugin->initialize(mixxx::audio::SampleRate(m_sampleRate))) {
+        return nullptr;
+    }
+    return pPlugin;
+}
+
 bool AnalyzerKey::shouldAnalyze(TrackPointer pTrack) const {
-    bool bPreferencesFastAnalysisEnabled = m_keySettings.getFastAnalysis();
     QString pluginID = m_keySettings.getKeyPluginId();
     if (pluginID.isEmpty()) {
         pluginID = defaultPlugin().id();
@@ -136,7 +158,7 @@ bool AnalyzerKey::shouldAnalyze(TrackPointer pTrack) const {
         QString subVersion = keys.getSubVersion();
 
         QHash<QString, QString> extraVersionInfo = getExtraVersionInfo(
-                pluginID, bPreferencesFastAnalysisEnabled);
+                pluginID, m_bSampledAnalysis);
         QString newVersion = KeyFactory::getPreferredVersion();
         QString newSubVersion = KeyFactory::getPreferredSubVersion(extraVersionInfo);
 
@@ -146,6 +168,24 @@ bool AnalyzerKey::shouldAnalyze(TrackPointer pTrack) const {
             qDebug() << "Keys version/sub-version unchanged since previous analysis. Not analyzing.";
             return false;
         }
+        if (m_bSampledAnalysis) {
+            if (subVersion == KeyFactory::getPreferredSubVersion(
+                                      getExtraVersionInfo(pluginID, false))) {
+                // Don't replace the results of a full analysis by
+                // provisional results.
+                return false;
+            }
+        } else if (subVersion == KeyFactory::getPreferredSubVersion(
+                                         getExtraVersionInfo(pluginID, true))) {
+            if (PlayerInfo::instance().isTrackLoaded(pTrack)) {
+                // Replacing the key would affect key matching and sync
+                // of the deck
+                qDebug() << "Keeping provisional keys of a track that is loaded into a deck.";
+                return false;
+            }
+            qDebug() << "Replacing provisional keys of a fast analysis.";
+            return true;
+        }
         if (!m_bPreferencesReanalyzeEnabled) {
             qDebug() << "Track has previous key detection result that is not up"
                      << "to date with latest settings but user preferences"
@@ -157,62 +197,140 @@ bool AnalyzerKey::shouldAnalyze(TrackPointer pTrack) const {
 }
 
 bool AnalyzerKey::processSamples(const CSAMPLE* pIn, SINT count) {
-    VERIFY_OR_DEBUG_ASSERT(m_pPlugin) {
+    return processChunk(AnalyzerChunk(pIn, count, m_channelCount));
+}
+
+bool AnalyzerKey::processChunk(const AnalyzerChunk& chunk) {
+    // In sampled mode the plugins are created per window
+    VERIFY_OR_DEBUG_ASSERT(m_pPlugin || m_bSampledAnalysis) {
         return false;
     }
+    DEBUG_ASSERT(chunk.channelCount() == m_channelCount);
 
-    SINT numFrames = count / m_channelCount;
+    const SINT numFrames = chunk.frameCount();
+    const SINT firstFrame = m_currentFrame;
     m_currentFrame += numFrames;
 
-    if (m_currentFrame > m_maxFramesToProcess) {
+    if (m_bSampledAnalysis && m_windowIndex >= m_windows.size()) {
         return true; // silently ignore remaining samples
     }
 
-    const CSAMPLE* pKeyInput = pIn;
-    CSAMPLE* pHarmonicMixedChannel = nullptr;
+    if (m_channelCount > mixxx::audio::ChannelCount::stereo() &&
+            m_channelCount != mixxx::audio::ChannelCount::stem()) {
+        DEBUG_ASSERT(!"Unsupported channel count");
+        return false;
+    }
 
-    if (m_channelCount == mixxx::audio::ChannelCount::stem()) {
+    if (m_channelCount == mixxx::audio::ChannelCount::stem() &&
+            m_keySettings.getStemStrategy() == KeyDetectionSettings::StemStrategy::Enforced) {
         // We have an 8 channel soundsource. The only implemented soundsource with
         // 8ch is the NI STEM file format.
         // TODO: If we add other soundsources with 8ch, we need to rework this condition.
         //
         // For NI STEM we mix all the stems together except the first one,
         // which contains drums or beats by convention.
-        count = numFrames * mixxx::audio::ChannelCount::stereo();
-        pHarmonicMixedChannel = SampleUtil::alloc(count);
-        VERIFY_OR_DEBUG_ASSERT(pHarmonicMixedChannel) {
+        reserveStemBuffer(chunk.stereoSampleCount());
+        VERIFY_OR_DEBUG_ASSERT(m_stemBuffer.data()) {
             return false;
         }
+        SampleUtil::mixMultichannelToStereo(m_stemBuffer.data(),
+                chunk.samples(),
+                numFrames,
+                m_channelCount,
+                excludeFirstChannelMask);
+        return processStereoSamples(m_stemBuffer.data(), firstFrame, numFrames);
+    }
 
-        if (m_keySettings.getStemStrategy() == KeyDetectionSettings::StemStrategy::Enforced) {
-            SampleUtil::mixMultichannelToStereo(pHarmonicMixedChannel,
-                    pIn,
-                    numFrames,
-                    m_channelCount,
-                    excludeFirstChannelMask);
-        } else {
-            SampleUtil::mixMultichannelToStereo(
-                    pHarmonicMixedChannel, pIn, numFrames, m_channelCount);
+    // Otherwise all stems are mixed together, which is shared with the
+    // other analyzers.
+    return processStereoSamples(chunk.stereoMix(), firstFrame, numFrames);
+}
+
+void AnalyzerKey::reserveStemBuffer(SINT sampleCount) {
+    if (m_stemBuffer.size() < sampleCount) {
+        mixxx::SampleBuffer(sampleCount).swap(m_stemBuffer);
+    }
+}
+
+bool AnalyzerKey::processStereoSamples(
+        const CSAMPLE* pIn, SINT firstFrame, SINT frameCount) {
+    if (!m_bSampledAnalysis) {
+        return m_pPlugin->processSamples(
+                pIn, frameCount * mixxx::audio::ChannelCount::stereo());
+    }
+
+    const auto frameRange = mixxx::IndexRange::forward(firstFrame, frameCount);
+    for (; m_windowIndex < m_windows.size(); ++m_windowIndex) {
+        const mixxx::IndexRange window = m_windows.at(m_windowIndex);
+        if (frameRange.end() <= window.start()) {
+            // The next window has not been reached yet
+            return true;
+        }
+        if (frameRange.start() < window.end()) {
+            if (!m_pPlugin) {
+                m_pPlugin = createPlugin();
+                VERIFY_OR_DEBUG_ASSERT(m_pPlugin) {
+                    return false;
+                }
+            }
+            const SINT start = math_max(frameRange.start(), window.start());
+            const SINT end = math_min(frameRange.end(), window.end());
+            if (!m_pPlugin->processSamples(
+                        pIn + (start - firstFrame) * mixxx::audio::ChannelCount::stereo(),
+                        (end - start) * mixxx::audio::ChannelCount::stereo())) {
+                return false;
+            }
+            if (end < window.end()) {
+                // The window continues in the next chunk
+                return true;
+            }
         }
+        finishWindow();
+    }
+    return true;
+}
 
-        pKeyInput = pHarmonicMixedChannel;
-    } else if (m_channelCount > mixxx::audio::ChannelCount::stereo()) {
-        DEBUG_ASSERT(!"Unsupported channel count");
-        return false;
+void AnalyzerKey::finishWindow() {
+    DEBUG_ASSERT(m_windowIndex < m_windows.size());
+    if (!m_pPlugin) {
+        // No frames of this window have been processed
+        return;
+    }
+    const mixxx::IndexRange window = m_windows.at(m_windowIndex);
+    if (m_pPlugin->finalize()) {
+        // The key changes are detected relative to the start of the window
+        m_sampledKeys.push_back(mixxx::estimateSampledKey(
+                m_pPlugin->getKeyChanges(),
+                math_min(window.length(), m_currentFrame - window.start())));
+    } else {
+        qWarning() << "Key detection failed in window" << window;
     }
+    m_pPlugin.reset();
+}
 
-    bool ret = m_pPlugin->processSamples(pKeyInput, count);
-    if (pHarmonicMixedChannel) {
-        SampleUtil::free(pHarmonicMixedChannel);
+SINT AnalyzerKey::framesToSkip() const {
+    if (!m_bSampledAnalysis) {
+        return 0;
     }
-    return ret;
+    return m_windows.framesToSkip(m_currentFrame);
+}
+
+void AnalyzerKey::skipFrames(SINT frameCount) {
+    DEBUG_ASSERT(frameCount <= framesToSkip());
+    m_currentFrame += frameCount;
 }
 
 void AnalyzerKey::cleanup() {
     m_pPlugin.reset();
+    m_sampledKeys.clear();
 }
 
 void AnalyzerKey::storeResults(TrackPointer tio) {
+    if (m_bSampledAnalysis) {
+        storeSampledResults(tio);
+        return;
+    }
+
     VERIFY_OR_DEBUG_ASSERT(m_pPlugin) {
         return;
     }
@@ -224,12 +342,89 @@ void AnalyzerKey::storeResults(TrackPointer tio) {
 
     KeyChangeList key_changes = m_pPlugin->getKeyChanges();
     QHash<QString, QString> extraVersionInfo = getExtraVersionInfo(
-            m_pluginId, m_bPreferencesFastAnalysisEnabled);
+            m_pluginId, false);
     Keys track_keys = KeyFactory::makePreferredKeys(
             key_changes, extraVersionInfo, m_sampleRate, m_totalFrames);
+
+    // The track might have been loaded into a deck during the analysis
+    const Keys provisionalKeys = tio->getKeys();
+    if (provisionalKeys.getGlobalKey() != mixxx::track::io::key::INVALID &&
+            provisionalKeys.getSubVersion() ==
+                    KeyFactory::getPreferredSubVersion(
+                            getExtraVersionInfo(m_pluginId, true)) &&
+            PlayerInfo::instance().isTrackLoaded(tio)) {
+        qDebug() << "Keeping provisional keys of a track that is loaded into a deck.";
+        return;
+    }
+
     tio->setKeys(track_keys);
 }
 
+void AnalyzerKey::storeSampledResults(TrackPointer pTrack) {
+    if (m_windowIndex < m_windows.size()) {
+        // The last window extends up to the end of the track
+        finishWindow();
+    }
+    const auto key = mixxx::combineSampledKeys(m_sampledKeys);
+    if (key == mixxx::track::io::key::INVALID) {
+        qWarning() << "Key detection failed";
+        return;
+    }
+    // The provisional result only consists of the predominant key
+    KeyChangeList key_changes;
+    key_changes.push_back(qMakePair(key, 0.0));
+    Keys track_keys = KeyFactory::makePreferredKeys(key_changes,
+            getExtraVersionInfo(m_pluginId, true),
+            m_sampleRate,
+            m_totalFrames);
+    pTrack->setKeys(track_keys);
+}
+
+bool AnalyzerKey::restoreCachedResults(
+        const mixxx::AnalysisCacheEntry& cacheEntry,
+        TrackPointer pTrack) {
+    // Only reuse keys that have been detected with the current settings
+    const QString version = KeyFactory::getPreferredVersion();
+    const QString subVersion = KeyFactory::getPreferredSubVersion(
+            getExtraVersionInfo(m_pluginId, m_bSampledAnalysis));
+    if (cacheEntry.keys.isEmpty() ||
+            cacheEntry.keysVersion != version ||
+            cacheEntry.keysSubVersion != subVersion) {
+        return false;
+    }
+    QByteArray keysSerialized = cacheEntry.keys;
+    const Keys keys = KeyFactory::loadKeysFromByteArray(
+            cacheEntry.keysVersion, cacheEntry.keysSubVersion, &keysSerialized);
+    if (keys.getGlobalKey() == mixxx::track::io::key::INVALID) {
+        return false;
+    }
+    pTrack->setKeys(keys);
+    return true;
+}
+
+void AnalyzerKey::storeCachedResults(
+        mixxx::AnalysisCacheEntry* pCacheEntry,
+        TrackPointer pTrack) const {
+    const Keys keys = pTrack->getKeys();
+    if (keys.getGlobalKey() == mixxx::track::io::key::INVALID) {
+        return;
+    }
+    pCacheEntry->keysVersion = keys.getVersion();
+    pCacheEntry->keysSubVersion = keys.getSubVersion();
+    pCacheEntry->keys = keys.toByteArray();
+}
+
+// static
+bool AnalyzerKey::hasProvisionalResults(const Track& track) {
+    const Keys keys = track.getKeys();
+    if (keys.getGlobalKey() == mixxx::track::io::key::INVALID) {
+        return false;
+    }
+    // The fragment of the sub-version from getExtraVersionInfo()
+    return keys.getSubVersion().split(QChar('|')).contains(
+            QStringLiteral("fast_analysis=1"));
+}
+
 // static
 QHash<QString, QString> AnalyzerKey::getExtraVersionInfo(
         const QString& pluginId, bool bPreferencesFastAnalysis) {
@@ -4,11 +4,14 @@
 #include <QList>
 #include <QString>
 #include <memory>
+#include <vector>
 
 #include "analyzer/analyzer.h"
 #include "analyzer/plugins/analyzerplugin.h"
+#include "analyzer/sampledanalysis.h"
 #include "preferences/keydetectionsettings.h"
 #include "track/track_decl.h"
+#include "util/samplebuffer.h"
 
 class AnalyzerKey : public Analyzer {
   public:
@@ -18,12 +21,25 @@ class AnalyzerKey : public Analyzer {
     static QList<mixxx::AnalyzerPluginInfo> availablePlugins();
     static mixxx::AnalyzerPluginInfo defaultPlugin();
 
+    /// Returns true if the keys of the track are the provisional results
+    /// of a sampled analysis, i.e. a full analysis is still pending.
+    static bool hasProvisionalResults(const Track& track);
+
     bool initialize(const AnalyzerTrack& track,
             mixxx::audio::SampleRate sampleRate,
             mixxx::audio::ChannelCount channelCount,
             SINT frameLength) override;
     bool processSamples(const CSAMPLE* pIn, SINT count) override;
+    bool processChunk(const AnalyzerChunk& chunk) override;
+    SINT framesToSkip() const override;
+    void skipFrames(SINT frameCount) override;
     void storeResults(TrackPointer tio) override;
+    bool restoreCachedResults(
+            const mixxx::AnalysisCacheEntry& cacheEntry,
+            TrackPointer pTrack) override;
+    void storeCachedResults(
+            mixxx::AnalysisCacheEntry* pCacheEntry,
+            TrackPointer pTrack) const override;
     void cleanup() override;
 
   private:
@@ -31,6 +47,12 @@ class AnalyzerKey : public Analyzer {
             const QString& pluginId, bool bPreferencesFastAnalysis);
 
     bool shouldAnalyze(TrackPointer tio) const;
+    void reserveStemBuffer(SINT sampleCount);
+
+    std::unique_ptr<mixxx::AnalyzerKeyPlugin> createPlugin() const;
+    bool processStereoSamples(const CSAMPLE* pIn, SINT firstFrame, SINT frameCount);
+    void finishWindow();
+    void storeSampledResults(TrackPointer pTrack);
 
     KeyDetectionSettings m_keySettings;
     std::unique_ptr<mixxx::AnalyzerKeyPlugin> m_pPlugin;
@@ -38,10 +60,19 @@ class AnalyzerKey : public Analyzer {
     mixxx::audio::SampleRate m_sampleRate;
     mixxx::audio::ChannelCount m_channelCount;
     SINT m_totalFrames;
-    SINT m_maxFramesToProcess;
     SINT m_currentFrame;
+    // The stereo signal of the selected stems, which is not shared with
+    // the other analyzers
+    mixxx::SampleBuffer m_stemBuffer;
+
+    // Each window is analyzed by a separate plugin instance
+    mixxx::SampledAnalysisWindows m_windows;
+    int m_windowIndex;
+    std::vector<mixxx::SampledKey> m_sampledKeys;
 
     bool m_bPreferencesKeyDetectionEnabled;
     bool m_bPreferencesFastAnalysisEnabled;
     bool m_bPreferencesReanalyzeEnabled;
+    // Fast analysis unless a full analysis has been requested
+    bool m_bSampledAnalysis;
 };
@@ -1,5 +1,6 @@
 #include "analyzer/analyzersilence.h"
 
+#include "analyzer/analysiscache.h"
 #include "analyzer/analyzertrack.h"
 #include "analyzer/constants.h"
 #include "track/track.h"
@@ -115,9 +116,38 @@ void AnalyzerSilence::storeResults(TrackPointer pTrack) {
         m_signalEnd = m_framesProcessed;
     }
 
-    const auto firstSoundPosition = mixxx::audio::FramePos(m_signalStart);
-    const auto lastSoundPosition = mixxx::audio::FramePos(m_signalEnd);
+    storeSoundPositions(pTrack,
+            mixxx::audio::FramePos(m_signalStart),
+            mixxx::audio::FramePos(m_signalEnd));
+}
+
+bool AnalyzerSilence::restoreCachedResults(
+        const mixxx::AnalysisCacheEntry& cacheEntry,
+        TrackPointer pTrack) {
+    if (!cacheEntry.firstSoundPosition.isValid() ||
+            !cacheEntry.lastSoundPosition.isValid()) {
+        return false;
+    }
+    storeSoundPositions(pTrack,
+            cacheEntry.firstSoundPosition,
+            cacheEntry.lastSoundPosition);
+    return true;
+}
+
+void AnalyzerSilence::storeCachedResults(
+        mixxx::AnalysisCacheEntry* pCacheEntry,
+        TrackPointer pTrack) const {
+    Q_UNUSED(pTrack);
+    // Adjusted by storeResults()
+    DEBUG_ASSERT(m_signalStart >= 0);
+    DEBUG_ASSERT(m_signalEnd >= 0);
+    pCacheEntry->firstSoundPosition = mixxx::audio::FramePos(m_signalStart);
+    pCacheEntry->lastSoundPosition = mixxx::audio::FramePos(m_signalEnd);
+}
 
+void AnalyzerSilence::storeSoundPositions(TrackPointer pTrack,
+        mixxx::audio::FramePos firstSoundPosition,
+        mixxx::audio::FramePos lastSoundPosition) {
     CuePointer pN60dBSound = pTrack->findCueByType(mixxx::CueType::N60dBSound);
     if (pN60dBSound == nullptr) {
         pN60dBSound = pTrack->createAndAddCue(
@@ -27,6 +27,12 @@ class AnalyzerSilence : public Analyzer {
             SINT frameLength) override;
     bool processSamples(const CSAMPLE* pIn, SINT count) override;
     void storeResults(TrackPointer pTrack) override;
+    bool restoreCachedResults(
+            const mixxx::AnalysisCacheEntry& cacheEntry,
+            TrackPointer pTrack) override;
+    void storeCachedResults(
+            mixxx::AnalysisCacheEntry* pCacheEntry,
+            TrackPointer pTrack) const override;
     void cleanup() override;
 
     static void setupMainAndIntroCue(Track* pTrack,
@@ -51,6 +57,10 @@ class AnalyzerSilence : public Analyzer {
             mixxx::audio::ChannelCount channelCount);
 
   private:
+    void storeSoundPositions(TrackPointer pTrack,
+            mixxx::audio::FramePos firstSoundPosition,
+            mixxx::audio::FramePos lastSoundPosition);
+
     UserSettingsPointer m_pConfig;
     mixxx::audio::ChannelCount m_channelCount;
     SINT m_framesProcessed;
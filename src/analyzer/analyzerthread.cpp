@@ -2,6 +2,7 @@
 
 #include <mutex>
 
+#include "analyzer/analysiscache.h"
 #include "analyzer/analyzerbeats.h"
 #include "analyzer/analyzerebur128.h"
 #include "analyzer/analyzergain.h"
@@ -34,6 +35,12 @@ mixxx::Logger kLogger("AnalyzerThread");
 // continuous feedback.
 const mixxx::Duration kBusyProgressInhibitDuration = mixxx::Duration::fromMillis(60);
 
+// The region around the priority position of a track that is analyzed
+// in advance. It is divided into blocks that are analyzed alternately
+// forward and backward of the position.
+constexpr SINT kPriorityRegionRadiusSeconds = 16;
+constexpr SINT kPriorityRegionBlockChunks = 8;
+
 void deleteAnalyzerThread(AnalyzerThread* plainPtr) {
     if (plainPtr) {
         plainPtr->deleteAfterFinished();
@@ -101,22 +108,38 @@ void AnalyzerThread::doRun() {
             return;
         }
         QSqlDatabase dbConnection = mixxx::DbConnectionPooled(m_dbConnectionPool);
-        m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerWaveform>(m_pConfig, dbConnection)));
+        m_analyzers.push_back(AnalyzerWithState(
+                std::make_unique<AnalyzerWaveform>(m_pConfig, dbConnection),
+                QStringLiteral("AnalyzerWaveform")));
     }
     if (AnalyzerGain::isEnabled(ReplayGainSettings(m_pConfig))) {
-        m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerGain>(m_pConfig)));
+        m_analyzers.push_back(AnalyzerWithState(
+                std::make_unique<AnalyzerGain>(m_pConfig),
+                QStringLiteral("AnalyzerGain")));
     }
     if (AnalyzerEbur128::isEnabled(ReplayGainSettings(m_pConfig))) {
-        m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerEbur128>(m_pConfig)));
+        m_analyzers.push_back(AnalyzerWithState(
+                std::make_unique<AnalyzerEbur128>(m_pConfig),
+                QStringLiteral("AnalyzerEbur128")));
     }
     // BPM detection might be disabled in the config, but can be overridden
     // and enabled by explicitly setting the mode flag.
     const bool enforceBpmDetection = (m_modeFlags & AnalyzerModeFlags::WithBeats) != 0;
-    m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerBeats>(m_pConfig, enforceBpmDetection)));
-    m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerKey>(m_pConfig)));
-    m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerSilence>(m_pConfig)));
+    m_analyzers.push_back(AnalyzerWithState(
+            std::make_unique<AnalyzerBeats>(m_pConfig, enforceBpmDetection),
+            QStringLiteral("AnalyzerBeats")));
+    m_analyzers.push_back(AnalyzerWithState(
+            std::make_unique<AnalyzerKey>(m_pConfig),
+            QStringLiteral("AnalyzerKey")));
+    m_analyzers.push_back(AnalyzerWithState(
+            std::make_unique<AnalyzerSilence>(m_pConfig),
+            QStringLiteral("AnalyzerSilence")));
     DEBUG_ASSERT(!m_analyzers.empty());
     kLogger.debug() << "Activated" << m_analyzers.size() << "analyzers";
+    const AnalyzerWithState* pWaveformAnalyzer =
+            (m_modeFlags & AnalyzerModeFlags::WithWaveform)
+            ? &m_analyzers.front()
+            : nullptr;
 
     m_lastBusyProgressEmittedTimer.start();
 
@@ -127,6 +150,12 @@ void AnalyzerThread::doRun() {
         DEBUG_ASSERT(m_currentTrack.has_value());
         kLogger.debug() << "Analyzing" << m_currentTrack->getTrack()->getLocation();
 
+        // Publish stored results like cached waveforms before opening the
+        // audio source, which might take a while for long or compressed files.
+        for (auto&& analyzer : m_analyzers) {
+            analyzer.loadStoredResults(*m_currentTrack);
+        }
+
         // Get the audio
         mixxx::AudioSourcePointer audioSource =
                 SoundSourceProxy(m_currentTrack->getTrack()).openAudioSource(openParams);
@@ -155,10 +184,55 @@ void AnalyzerThread::doRun() {
                         audioSource->frameLength())) {
                 processTrack = true;
             }
+            if (&analyzer == pWaveformAnalyzer &&
+                    analyzer.isActive() &&
+                    !m_currentTrack->getOptions().fullAnalysis) {
+                // Generating the waveform needs all frames, so sampling
+                // beats and key in windows would hardly save any time.
+                // They are analyzed fully instead, which leaves no
+                // provisional results for a deferred full analysis.
+                auto options = m_currentTrack->getOptions();
+                options.fullAnalysis = true;
+                TrackPointer pTrack = m_currentTrack->getTrack();
+                m_currentTrack.emplace(std::move(pTrack), options);
+            }
+        }
+
+        // Reuse the results of a previous analysis of identical audio
+        // content, e.g. a copy of the same file with different tags.
+        mixxx::cache_key_t contentKey = mixxx::invalidCacheKey();
+        std::optional<mixxx::AnalysisCacheEntry> cacheEntry;
+        QByteArray contentDigest;
+        if (processTrack && mixxx::AnalysisCache::isEnabled()) {
+            contentKey = mixxx::AnalysisCache::contentKey(
+                    audioSource.get(),
+                    mixxx::SampleBuffer::WritableSlice(m_sampleBuffer));
+            cacheEntry = mixxx::AnalysisCache::load(contentKey);
+            if (cacheEntry) {
+                // The content key only covers a few regions, the entry
+                // might belong to a different edit of the same recording.
+                contentDigest = decodeContentDigest(audioSource);
+                if (!contentDigest.isEmpty() &&
+                        contentDigest == cacheEntry->contentDigest) {
+                    processTrack = restoreCachedResults(*cacheEntry);
+                } else {
+                    cacheEntry.reset();
+                }
+            }
         }
 
         if (processTrack) {
-            const auto analysisResult = analyzeAudioSource(audioSource);
+            analyzePriorityRegion(audioSource);
+            // Calculate the content digest for storing the results while
+            // decoding the audio source anyway
+            std::optional<mixxx::AnalysisContentDigest> pendingContentDigest;
+            if (mixxx::isValidCacheKey(contentKey) && contentDigest.isEmpty()) {
+                pendingContentDigest.emplace(
+                        audioSource->getSignalInfo(),
+                        audioSource->frameIndexRange().start());
+            }
+            const auto analysisResult = analyzeAudioSource(audioSource,
+                    pendingContentDigest ? &*pendingContentDigest : nullptr);
             DEBUG_ASSERT(analysisResult != AnalysisResult::Pending);
             if (analysisResult == AnalysisResult::Finished) {
                 // The analysis has been finished, and is either complete without
@@ -168,9 +242,36 @@ void AnalyzerThread::doRun() {
                 // and again, because it is very unlikely that the error vanishes
                 // suddenly.
                 emitBusyProgress(kAnalyzerProgressFinalizing);
-                // This takes around 3 sec on a Atom Netbook
-                for (auto&& analyzer : m_analyzers) {
-                    analyzer.finish(*m_currentTrack);
+                if (kLogger.debugEnabled()) {
+                    for (const auto& analyzer : m_analyzers) {
+                        if (analyzer.isActive()) {
+                            kLogger.debug()
+                                    << analyzer.name()
+                                    << "spent"
+                                    << analyzer.processDuration().formatMillisWithUnit()
+                                    << "processing samples";
+                        }
+                    }
+                }
+                if (pendingContentDigest) {
+                    contentDigest = pendingContentDigest->finish(
+                            audioSource->frameIndexRange());
+                }
+                if (!contentDigest.isEmpty()) {
+                    // Results of analyzers that have not been active are
+                    // preserved.
+                    auto updatedCacheEntry = cacheEntry.value_or(mixxx::AnalysisCacheEntry{});
+                    updatedCacheEntry.contentDigest = contentDigest;
+                    // This takes around 3 sec on a Atom Netbook
+                    for (auto&& analyzer : m_analyzers) {
+                        analyzer.finish(*m_currentTrack, &updatedCacheEntry);
+                    }
+                    mixxx::AnalysisCache::save(contentKey, updatedCacheEntry);
+                } else {
+                    // This takes around 3 sec on a Atom Netbook
+                    for (auto&& analyzer : m_analyzers) {
+                        analyzer.finish(*m_currentTrack);
+                    }
                 }
                 emitDoneProgress(kAnalyzerProgressDone);
             } else {
@@ -180,7 +281,7 @@ void AnalyzerThread::doRun() {
                 emitDoneProgress(kAnalyzerProgressUnknown);
             }
         } else {
-            kLogger.debug() << "Skipping track analysis because no analyzer initialized.";
+            kLogger.debug() << "Skipping track analysis because no analyzer is active.";
             emitDoneProgress(kAnalyzerProgressDone);
         }
     }
@@ -225,7 +326,8 @@ WorkerThread::TryFetchWorkItemsResult AnalyzerThread::tryFetchWorkItems() {
 }
 
 AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
-        const mixxx::AudioSourcePointer& audioSource) {
+        const mixxx::AudioSourcePointer& audioSource,
+        mixxx::AnalysisContentDigest* pContentDigest) {
     DEBUG_ASSERT(m_currentTrack.has_value());
 
     DEBUG_ASSERT(
@@ -241,6 +343,28 @@ AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
             return AnalysisResult::Cancelled;
         }
 
+        // Skip all frames that are not needed by any active analyzer
+        SINT framesToSkip = remainingFrameRange.length();
+        for (const auto& analyzer : m_analyzers) {
+            framesToSkip = math_min(framesToSkip, analyzer.framesToSkip());
+        }
+        if (framesToSkip > 0) {
+            if (pContentDigest &&
+                    !decodeContentDigestFrames(audioSource,
+                            mixxx::IndexRange::forward(
+                                    remainingFrameRange.start(), framesToSkip),
+                            pContentDigest)) {
+                return AnalysisResult::Cancelled;
+            }
+            remainingFrameRange.shrinkFront(framesToSkip);
+            for (auto&& analyzer : m_analyzers) {
+                analyzer.skipFrames(framesToSkip);
+            }
+            if (remainingFrameRange.empty()) {
+                break;
+            }
+        }
+
         // 1st step: Decode next chunk of audio data
 
         // Split the range for the next chunk from the remaining (= to-be-analyzed) frames
@@ -297,12 +421,18 @@ AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
             return AnalysisResult::Cancelled;
         }
 
-        // 2nd: step: Analyze chunk of decoded audio data
+        if (pContentDigest) {
+            pContentDigest->addFrames(readableSampleFrames);
+        }
+
+        // 2nd: step: Analyze chunk of decoded audio data. Derived signals
+        // of the chunk are computed at most once and shared by all analyzers.
         if (!readableSampleFrames.frameIndexRange().empty()) {
+            m_chunk.assign(readableSampleFrames.readableData(),
+                    readableSampleFrames.readableLength(),
+                    audioSource->getSignalInfo().getChannelCount());
             for (auto&& analyzer : m_analyzers) {
-                analyzer.processSamples(
-                        readableSampleFrames.readableData(),
-                        readableSampleFrames.readableLength());
+                analyzer.processChunk(m_chunk);
             }
         }
 
@@ -331,6 +461,121 @@ AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
     return AnalysisResult::Finished;
 }
 
+QByteArray AnalyzerThread::decodeContentDigest(
+        const mixxx::AudioSourcePointer& audioSource) {
+    mixxx::AnalysisContentDigest contentDigest(
+            audioSource->getSignalInfo(),
+            audioSource->frameIndexRange().start());
+    if (!decodeContentDigestFrames(audioSource,
+                audioSource->frameIndexRange(),
+                &contentDigest)) {
+        return QByteArray();
+    }
+    return contentDigest.finish(audioSource->frameIndexRange());
+}
+
+bool AnalyzerThread::decodeContentDigestFrames(
+        const mixxx::AudioSourcePointer& audioSource,
+        mixxx::IndexRange frameIndexRange,
+        mixxx::AnalysisContentDigest* pContentDigest) {
+    while (!frameIndexRange.empty()) {
+        sleepWhileSuspended();
+        if (isStopping()) {
+            return false;
+        }
+        const auto chunkFrameRange =
+                frameIndexRange.splitAndShrinkFront(
+                        math_min(mixxx::kAnalysisFramesPerChunk,
+                                frameIndexRange.length()));
+        const auto readableSampleFrames =
+                audioSource->readSampleFrames(
+                        mixxx::WritableSampleFrames(
+                                chunkFrameRange,
+                                mixxx::SampleBuffer::WritableSlice(m_sampleBuffer)));
+        if (readableSampleFrames.frameIndexRange().empty()) {
+            // Unreadable, the digest remains incomplete
+            break;
+        }
+        pContentDigest->addFrames(readableSampleFrames);
+    }
+    return true;
+}
+
+bool AnalyzerThread::restoreCachedResults(
+        const mixxx::AnalysisCacheEntry& cacheEntry) {
+    DEBUG_ASSERT(m_currentTrack.has_value());
+    bool remainingAnalyzers = false;
+    for (auto&& analyzer : m_analyzers) {
+        if (analyzer.restoreCachedResults(*m_currentTrack, cacheEntry)) {
+            kLogger.debug()
+                    << analyzer.name()
+                    << "restored cached results";
+        } else if (analyzer.isActive()) {
+            remainingAnalyzers = true;
+        }
+    }
+    return remainingAnalyzers;
+}
+
+void AnalyzerThread::analyzePriorityRegion(
+        const mixxx::AudioSourcePointer& audioSource) {
+    DEBUG_ASSERT(m_currentTrack.has_value());
+    const auto priorityPosition = m_currentTrack->getOptions().priorityPosition;
+    if (!priorityPosition.isValid()) {
+        return;
+    }
+    const mixxx::IndexRange frameIndexRange = audioSource->frameIndexRange();
+    const SINT radius = kPriorityRegionRadiusSeconds *
+            audioSource->getSignalInfo().getSampleRate();
+    const SINT center = static_cast<SINT>(priorityPosition.toLowerFrameBoundary().value());
+    if (center - frameIndexRange.start() < 2 * radius ||
+            center >= frameIndexRange.end()) {
+        // The region will be analyzed soon enough in order
+        return;
+    }
+
+    emitBusyProgress(kAnalyzerProgressNone);
+
+    constexpr SINT kBlockFrames = kPriorityRegionBlockChunks * mixxx::kAnalysisFramesPerChunk;
+    const SINT blockCount = radius / kBlockFrames;
+    for (SINT i = 0; i < 2 * blockCount; ++i) {
+        // Alternate between the blocks forward and backward of the center
+        const SINT distance = i / 2;
+        const SINT blockStart = (i % 2 == 0)
+                ? center + distance * kBlockFrames
+                : center - (distance + 1) * kBlockFrames;
+        auto remainingFrameRange = intersect(
+                mixxx::IndexRange::forward(blockStart, kBlockFrames),
+                audioSource->frameIndexRange());
+        while (!remainingFrameRange.empty()) {
+            sleepWhileSuspended();
+            if (isStopping()) {
+                return;
+            }
+            const auto chunkFrameRange =
+                    remainingFrameRange.splitAndShrinkFront(
+                            math_min(mixxx::kAnalysisFramesPerChunk,
+                                    remainingFrameRange.length()));
+            const auto readableSampleFrames =
+                    audioSource->readSampleFrames(
+                            mixxx::WritableSampleFrames(
+                                    chunkFrameRange,
+                                    mixxx::SampleBuffer::WritableSlice(m_sampleBuffer)));
+            if (readableSampleFrames.frameIndexRange().empty()) {
+                // Unreadable, e.g. if the audio source has shrunk
+                break;
+            }
+            m_chunk.assign(readableSampleFrames.readableData(),
+                    readableSampleFrames.readableLength(),
+                    audioSource->getSignalInfo().getChannelCount());
+            for (auto&& analyzer : m_analyzers) {
+                analyzer.processPreviewChunk(
+                        m_chunk, readableSampleFrames.frameIndexRange().start());
+            }
+        }
+    }
+}
+
 void AnalyzerThread::emitBusyProgress(AnalyzerProgress busyProgress) {
     DEBUG_ASSERT(m_currentTrack.has_value());
     if ((m_emittedState == AnalyzerThreadState::Busy) &&
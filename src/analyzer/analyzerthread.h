@@ -17,11 +17,18 @@
 #include "util/samplebuffer.h"
 #include "util/workerthread.h"
 
+namespace mixxx {
+class AnalysisContentDigest;
+} // namespace mixxx
+
 enum AnalyzerModeFlags {
     None = 0x00,
     WithBeats = 0x01,
     WithWaveform = 0x02,
     LowPriority = 0x04,
+    // Library batch runs follow up a fast analysis with a full analysis
+    // after all other tracks have been analyzed
+    DeferFullAnalysis = 0x08,
     All = WithBeats | WithWaveform,
 };
 
@@ -119,6 +126,7 @@ class AnalyzerThread : public WorkerThread {
     std::vector<AnalyzerWithState> m_analyzers;
 
     mixxx::SampleBuffer m_sampleBuffer;
+    AnalyzerChunk m_chunk;
 
     std::optional<AnalyzerTrack> m_currentTrack;
 
@@ -131,7 +139,31 @@ class AnalyzerThread : public WorkerThread {
         Finished,
         Cancelled,
     };
+    // The optional content digest is calculated from all decoded frames,
+    // including those that are skipped by the analyzers.
     AnalysisResult analyzeAudioSource(
+            const mixxx::AudioSourcePointer& audioSource,
+            mixxx::AnalysisContentDigest* pContentDigest = nullptr);
+
+    // Decodes the whole audio source. Returns an empty digest if the
+    // audio source is not completely readable or the thread is stopping.
+    QByteArray decodeContentDigest(
+            const mixxx::AudioSourcePointer& audioSource);
+    // Returns false if the thread is stopping
+    bool decodeContentDigestFrames(
+            const mixxx::AudioSourcePointer& audioSource,
+            mixxx::IndexRange frameIndexRange,
+            mixxx::AnalysisContentDigest* pContentDigest);
+
+    // Restores the results of all active analyzers from the cache entry
+    // if possible. Returns true if some analyzers are still active and
+    // need to process the audio source.
+    bool restoreCachedResults(
+            const mixxx::AnalysisCacheEntry& cacheEntry);
+
+    // Analyzes the region around the priority position of the current
+    // track in advance, starting at the position and continuing outward.
+    void analyzePriorityRegion(
             const mixxx::AudioSourcePointer& audioSource);
 
     // Blocks the worker thread until a next track becomes available
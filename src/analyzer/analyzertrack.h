@@ -2,6 +2,7 @@
 
 #include <optional>
 
+#include "audio/frame.h"
 #include "track/track_decl.h"
 
 /// A scheduled not-null track with additional options for analysis.
@@ -10,6 +11,18 @@ class AnalyzerTrack {
     struct Options {
         /// If set, overrides whether the analysis should assume constant BPM.
         std::optional<bool> useFixedTempo;
+        /// If set, the track is analyzed before all other queued tracks,
+        /// e.g. when it has been loaded into a deck.
+        bool highPriority = false;
+        /// If valid, the region around this position is analyzed first to
+        /// publish preliminary results near the play position of a deck
+        /// early, before the whole track is analyzed.
+        mixxx::audio::FramePos priorityPosition;
+        /// If set, beats and key are detected in the whole track even if
+        /// fast analysis is enabled. This replaces the provisional results
+        /// of a previous fast analysis. The AnalyzerThread also sets it
+        /// while generating the waveform, which needs all frames anyway.
+        bool fullAnalysis = false;
     };
 
     explicit AnalyzerTrack(TrackPointer track, Options options = Options());
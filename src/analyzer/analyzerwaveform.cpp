@@ -3,9 +3,10 @@
 #include <memory>
 #include <vector>
 
+#include "analyzer/analysiscache.h"
 #include "analyzer/analyzertrack.h"
 #include "analyzer/constants.h"
-#include "engine/filters/enginefilterbessel4.h"
+#include "engine/filters/enginefilteriir.h"
 #include "track/track.h"
 #include "util/logger.h"
 #include "waveform/waveform.h"
@@ -19,6 +20,21 @@ constexpr double kLowMidFreqHz = 600.0;
 
 constexpr double kMidHighFreqHz = 4000.0;
 
+// Designs the Bessel 4 coefficients of EngineFilterIIR<SIZE, PASS>
+// for pCascade
+template<unsigned int SIZE, enum IIRPass PASS, typename Cascade>
+void designBessel4(Cascade* pCascade,
+        mixxx::filterdesign::Pass pass,
+        double freq0,
+        double freq1 = 0) {
+    static_assert(Cascade::kSectionCount == EngineFilterIIR<SIZE, PASS>::kSectionCount);
+    double coef[SIZE + 1];
+    coef[0] = mixxx::filterdesign::bessel(coef + 1, 4, pass, freq0, freq1);
+    EngineFilterSection sections[Cascade::kSectionCount];
+    EngineFilterIIR<SIZE, PASS>::coefsToSections(coef, sections);
+    pCascade->setSections(sections);
+}
+
 } // namespace
 
 AnalyzerWaveform::AnalyzerWaveform(
@@ -29,7 +45,10 @@ AnalyzerWaveform::AnalyzerWaveform(
           m_waveformSummaryData(nullptr),
           m_stride(0, 0, 0),
           m_currentStride(0),
-          m_currentSummaryStride(0) {
+          m_currentSummaryStride(0),
+          m_previewStride(0, 0, 0),
+          m_previewNextFrameIndex(0),
+          m_previewStrideAligned(false) {
     m_analysisDao.initialize(dbConnection);
 }
 
@@ -56,7 +75,7 @@ bool AnalyzerWaveform::initialize(const AnalyzerTrack& track,
 
     // Now actually initialize the AnalyzerWaveform:
     destroyFilters();
-    createFilters(sampleRate);
+    m_filters = createFilters(sampleRate);
 
     //TODO (vrince) Do we want to expose this as settings or whatever ?
     constexpr int mainWaveformSampleRate = 441;
@@ -87,6 +106,7 @@ bool AnalyzerWaveform::initialize(const AnalyzerTrack& track,
     m_currentStride = 0;
     m_currentSummaryStride = 0;
     m_channelCount = channelCount;
+    m_sampleRate = sampleRate;
 
     //debug
     //m_waveform->dump();
@@ -99,6 +119,65 @@ bool AnalyzerWaveform::initialize(const AnalyzerTrack& track,
     return true;
 }
 
+void AnalyzerWaveform::loadStoredResults(const AnalyzerTrack& track) {
+    const TrackPointer& pTrack = track.getTrack();
+    if (!pTrack->getId().isValid()) {
+        return;
+    }
+#ifdef __STEM__
+    // A waveform without stem data is replaced by shouldAnalyze() for a stem
+    // track. Publishing it first would only make the overview flicker.
+    const bool isStemTrack = !pTrack->getStemInfo().isEmpty();
+    const auto matchesStemLayout = [isStemTrack](const ConstWaveformPointer& pWaveform) {
+        return !isStemTrack || pWaveform->hasStem();
+    };
+#else
+    const auto matchesStemLayout = [](const ConstWaveformPointer&) {
+        return true;
+    };
+#endif
+    // The summary is small and needed by every overview, i.e. also by
+    // the library preview. Publish it before the (potentially huge) detailed
+    // waveform needs to be decompressed and parsed.
+    if (pTrack->getWaveformSummary().isNull()) {
+        ConstWaveformPointer pLoadedSummary = loadStored(
+                pTrack->getId(), AnalysisDao::TYPE_WAVESUMMARY);
+        if (pLoadedSummary && matchesStemLayout(pLoadedSummary)) {
+            pTrack->setWaveformSummary(pLoadedSummary);
+        }
+    }
+    if (pTrack->getWaveform().isNull()) {
+        ConstWaveformPointer pLoadedWaveform = loadStored(
+                pTrack->getId(), AnalysisDao::TYPE_WAVEFORM);
+        if (pLoadedWaveform && matchesStemLayout(pLoadedWaveform)) {
+            pTrack->setWaveform(pLoadedWaveform);
+        }
+    }
+}
+
+ConstWaveformPointer AnalyzerWaveform::loadStored(
+        TrackId trackId, AnalysisDao::AnalysisType type) const {
+    DEBUG_ASSERT(type == AnalysisDao::TYPE_WAVEFORM ||
+            type == AnalysisDao::TYPE_WAVESUMMARY);
+    ConstWaveformPointer pLoadedWaveform;
+    const QList<AnalysisDao::AnalysisInfo> analyses =
+            m_analysisDao.getAnalysesForTrackByType(trackId, type);
+    for (const auto& analysis : analyses) {
+        const WaveformFactory::VersionClass vc = type == AnalysisDao::TYPE_WAVEFORM
+                ? WaveformFactory::waveformVersionToVersionClass(analysis.version)
+                : WaveformFactory::waveformSummaryVersionToVersionClass(
+                          analysis.version);
+        if (!pLoadedWaveform && vc == WaveformFactory::VC_USE) {
+            pLoadedWaveform = ConstWaveformPointer(
+                    WaveformFactory::loadWaveformFromAnalysis(analysis));
+        } else if (vc != WaveformFactory::VC_KEEP) {
+            // remove all other Analysis except that one we should keep
+            m_analysisDao.deleteAnalysis(analysis.analysisId);
+        }
+    }
+    return pLoadedWaveform;
+}
+
 bool AnalyzerWaveform::shouldAnalyze(TrackPointer pTrack) const {
     ConstWaveformPointer pTrackWaveform = pTrack->getWaveform();
     ConstWaveformPointer pTrackWaveformSummary = pTrack->getWaveformSummary();
@@ -112,38 +191,15 @@ bool AnalyzerWaveform::shouldAnalyze(TrackPointer pTrack) const {
     bool missingWaveform = pTrackWaveform.isNull();
     bool missingWavesummary = pTrackWaveformSummary.isNull();
 
-    if (trackId.isValid() && (missingWaveform || missingWavesummary)) {
-        QList<AnalysisDao::AnalysisInfo> analyses =
-                m_analysisDao.getAnalysesForTrack(trackId);
-
-        QListIterator<AnalysisDao::AnalysisInfo> it(analyses);
-        while (it.hasNext()) {
-            const AnalysisDao::AnalysisInfo& analysis = it.next();
-            WaveformFactory::VersionClass vc;
-
-            if (analysis.type == AnalysisDao::TYPE_WAVEFORM) {
-                vc = WaveformFactory::waveformVersionToVersionClass(analysis.version);
-                if (missingWaveform && vc == WaveformFactory::VC_USE) {
-                    pLoadedTrackWaveform = ConstWaveformPointer(
-                            WaveformFactory::loadWaveformFromAnalysis(analysis));
-                    missingWaveform = false;
-                } else if (vc != WaveformFactory::VC_KEEP) {
-                    // remove all other Analysis except that one we should keep
-                    m_analysisDao.deleteAnalysis(analysis.analysisId);
-                }
-            }
-            if (analysis.type == AnalysisDao::TYPE_WAVESUMMARY) {
-                vc = WaveformFactory::waveformSummaryVersionToVersionClass(analysis.version);
-                if (missingWavesummary && vc == WaveformFactory::VC_USE) {
-                    pLoadedTrackWaveformSummary = ConstWaveformPointer(
-                            WaveformFactory::loadWaveformFromAnalysis(analysis));
-                    missingWavesummary = false;
-                } else if (vc != WaveformFactory::VC_KEEP) {
-                    // remove all other Analysis except that one we should keep
-                    m_analysisDao.deleteAnalysis(analysis.analysisId);
-                }
-            }
-        }
+    // Stored waveforms are usually published by loadStoredResults() already.
+    // Only the ones that were not available at that time need to be loaded.
+    if (trackId.isValid() && missingWavesummary) {
+        pLoadedTrackWaveformSummary = loadStored(trackId, AnalysisDao::TYPE_WAVESUMMARY);
+        missingWavesummary = pLoadedTrackWaveformSummary.isNull();
+    }
+    if (trackId.isValid() && missingWaveform) {
+        pLoadedTrackWaveform = loadStored(trackId, AnalysisDao::TYPE_WAVEFORM);
+        missingWaveform = pLoadedTrackWaveform.isNull();
     }
 
 #ifdef __STEM__
@@ -172,26 +228,34 @@ bool AnalyzerWaveform::shouldAnalyze(TrackPointer pTrack) const {
     return true;
 }
 
-void AnalyzerWaveform::createFilters(mixxx::audio::SampleRate sampleRate) {
-    // m_filter[Low] = new EngineFilterButterworth8Low(sampleRate, kLowMidFreqHz);
-    // m_filter[Mid] = new EngineFilterButterworth8Band(sampleRate, kLowMidFreqHz, kMidHighFreqHz);
-    // m_filter[High] = new EngineFilterButterworth8High(sampleRate, kMidHighFreqHz);
-    m_filters = {
-            std::make_unique<EngineFilterBessel4Low>(sampleRate, kLowMidFreqHz),
-            std::make_unique<EngineFilterBessel4Band>(sampleRate, kLowMidFreqHz, kMidHighFreqHz),
-            std::make_unique<EngineFilterBessel4High>(sampleRate, kMidHighFreqHz)};
-
-    // settle filters for silence in preroll to avoids ramping (Issue #7776)
-    m_filters.low->assumeSettled();
-    m_filters.mid->assumeSettled();
-    m_filters.high->assumeSettled();
+// static
+std::unique_ptr<AnalyzerWaveform::Filters> AnalyzerWaveform::createFilters(
+        mixxx::audio::SampleRate sampleRate) {
+    // Same as EngineFilterBessel4Low, EngineFilterBessel4Band and
+    // EngineFilterBessel4High, but without ramping. The cascades start
+    // settled for silence in preroll (Issue #7776).
+    auto pFilters = std::make_unique<Filters>();
+    const double lowMidRatio = kLowMidFreqHz / sampleRate.toDouble();
+    const double midHighRatio = kMidHighFreqHz / sampleRate.toDouble();
+    designBessel4<4, IIR_LP>(&pFilters->low, mixxx::filterdesign::Pass::Low, lowMidRatio);
+    designBessel4<8, IIR_BP>(&pFilters->mid,
+            mixxx::filterdesign::Pass::Band,
+            lowMidRatio,
+            midHighRatio);
+    designBessel4<4, IIR_HP>(&pFilters->high, mixxx::filterdesign::Pass::High, midHighRatio);
+    return pFilters;
 }
 
 void AnalyzerWaveform::destroyFilters() {
-    m_filters = {};
+    m_filters.reset();
+    m_previewFilters.reset();
 }
 
 bool AnalyzerWaveform::processSamples(const CSAMPLE* pIn, SINT count) {
+    return processChunk(AnalyzerChunk(pIn, count, m_channelCount));
+}
+
+bool AnalyzerWaveform::processChunk(const AnalyzerChunk& chunk) {
     VERIFY_OR_DEBUG_ASSERT(m_waveform) {
         return false;
     }
@@ -199,67 +263,25 @@ bool AnalyzerWaveform::processSamples(const CSAMPLE* pIn, SINT count) {
         return false;
     }
 
-    SINT numFrames = count / m_channelCount;
-    count = numFrames * mixxx::audio::ChannelCount::stereo();
+    DEBUG_ASSERT(chunk.channelCount() == m_channelCount);
+    const CSAMPLE* pIn = chunk.samples();
+    const SINT count = chunk.stereoSampleCount();
     int stemCount = 0;
 
-    const CSAMPLE* pWaveformInput = pIn;
-    CSAMPLE* pMixedChannel = nullptr;
-
+    // The stereo mix of a stem file is shared with the other analyzers
+    const CSAMPLE* pWaveformInput = chunk.stereoMix();
     if (m_channelCount > mixxx::audio::ChannelCount::stereo()) {
         DEBUG_ASSERT(0 == m_channelCount % mixxx::audio::ChannelCount::stereo());
-
-        pMixedChannel = SampleUtil::alloc(count);
-        VERIFY_OR_DEBUG_ASSERT(pMixedChannel) {
-            return false;
-        }
-        SampleUtil::mixMultichannelToStereo(pMixedChannel, pIn, numFrames, m_channelCount);
         stemCount = m_channelCount / mixxx::audio::ChannelCount::stereo();
-        pWaveformInput = pMixedChannel;
     }
 
-    // This should only append once if count is constant
-    if (count > m_buffers.size) {
-        m_buffers.low.resize(count);
-        m_buffers.mid.resize(count);
-        m_buffers.high.resize(count);
-        m_buffers.size = count;
-    }
-
-    m_filters.low->process(pWaveformInput, &m_buffers.low[0], count);
-    m_filters.mid->process(pWaveformInput, &m_buffers.mid[0], count);
-    m_filters.high->process(pWaveformInput, &m_buffers.high[0], count);
+    filterChunk(m_filters.get(), pWaveformInput, count);
 
     m_waveform->setSaveState(Waveform::SaveState::NotSaved);
     m_waveformSummary->setSaveState(Waveform::SaveState::NotSaved);
 
     for (SINT i = 0; i < count; i += 2) {
-        // Take max value, not average of data
-        CSAMPLE cover[2] = {fabs(pWaveformInput[i]), fabs(pWaveformInput[i + 1])};
-        CSAMPLE clow[2] = {fabs(m_buffers.low[i]), fabs(m_buffers.low[i + 1])};
-        CSAMPLE cmid[2] = {fabs(m_buffers.mid[i]), fabs(m_buffers.mid[i + 1])};
-        CSAMPLE chigh[2] = {fabs(m_buffers.high[i]), fabs(m_buffers.high[i + 1])};
-
-        // This is for if you want to experiment with averaging instead of
-        // maxing.
-        // m_stride.m_overallData[Right] += buffer[i]*buffer[i];
-        // m_stride.m_overallData[Left] += buffer[i + 1]*buffer[i + 1];
-        // m_stride.m_filteredData[Right][Low] += m_buffers.low[i]*m_buffers.low[i];
-        // m_stride.m_filteredData[Left][Low] += m_buffers.low[i + 1]*m_buffers.low[i + 1];
-        // m_stride.m_filteredData[Right][Mid] += m_buffers.mid[i]*m_buffers.mid[i];
-        // m_stride.m_filteredData[Left][Mid] += m_buffers.mid[i + 1]*m_buffers.mid[i + 1];
-        // m_stride.m_filteredData[Right][High] += m_buffers.high[i]*m_buffers.high[i];
-        // m_stride.m_filteredData[Left][High] += m_buffers.high[i + 1]*m_buffers.high[i + 1];
-
-        // Record the max across this stride.
-        storeIfGreater(&m_stride.m_overallData[Left], cover[Left]);
-        storeIfGreater(&m_stride.m_overallData[Right], cover[Right]);
-        storeIfGreater(&m_stride.m_filteredData[Left][Low], clow[Left]);
-        storeIfGreater(&m_stride.m_filteredData[Right][Low], clow[Right]);
-        storeIfGreater(&m_stride.m_filteredData[Left][Mid], cmid[Left]);
-        storeIfGreater(&m_stride.m_filteredData[Right][Mid], cmid[Right]);
-        storeIfGreater(&m_stride.m_filteredData[Left][High], chigh[Left]);
-        storeIfGreater(&m_stride.m_filteredData[Right][High], chigh[Right]);
+        storeStrideMaxima(&m_stride, pWaveformInput, i);
 
         for (int s = 0; s < stemCount; s++) {
             CSAMPLE cstem[2] = {
@@ -306,12 +328,93 @@ bool AnalyzerWaveform::processSamples(const CSAMPLE* pIn, SINT count) {
 
     //kLogger.debug() << "process - m_waveform->getCompletion()" << m_waveform->getCompletion() << "off" << m_waveform->getDataSize();
     //kLogger.debug() << "process - m_waveformSummary->getCompletion()" << m_waveformSummary->getCompletion() << "off" << m_waveformSummary->getDataSize();
-    if (pMixedChannel) {
-        SampleUtil::free(pMixedChannel);
-    }
     return true;
 }
 
+void AnalyzerWaveform::processPreviewChunk(const AnalyzerChunk& chunk, SINT frameIndex) {
+    VERIFY_OR_DEBUG_ASSERT(m_waveform) {
+        return;
+    }
+    if (!m_previewFilters || frameIndex != m_previewNextFrameIndex) {
+        // Restart at the discontinuity
+        m_previewFilters = createFilters(m_sampleRate);
+        m_previewStride = WaveformStride(m_waveform->getAudioVisualRatio(),
+                m_waveformSummary->getAudioVisualRatio(),
+                0);
+        // The first stride is incomplete
+        m_previewStrideAligned = false;
+    }
+
+    const CSAMPLE* pWaveformInput = chunk.stereoMix();
+    const SINT count = chunk.stereoSampleCount();
+    filterChunk(m_previewFilters.get(), pWaveformInput, count);
+
+    // Only the detailed waveform is populated in advance. Stems and
+    // the completion are left untouched until processing all chunks.
+    for (SINT i = 0; i < count; i += 2) {
+        storeStrideMaxima(&m_previewStride, pWaveformInput, i);
+        // Strides are stored at the same positions as in processChunk()
+        const double position = static_cast<double>(frameIndex + i / 2 + 1);
+        if (fmod(position, m_previewStride.m_length) < 1) {
+            const int stride = static_cast<int>(position / m_previewStride.m_length) - 1;
+            if (m_previewStrideAligned && stride >= 0 &&
+                    (stride + 1) * ChannelCount <= m_waveform->getDataSize()) {
+                m_previewStride.store(m_waveformData + stride * ChannelCount);
+            } else {
+                m_previewStride.reset();
+            }
+            m_previewStrideAligned = true;
+        }
+    }
+    m_previewNextFrameIndex = frameIndex + count / 2;
+}
+
+void AnalyzerWaveform::filterChunk(
+        Filters* pFilters, const CSAMPLE* pInput, SINT count) {
+    // This should only append once if count is constant
+    if (count > m_buffers.size) {
+        m_buffers.low.resize(count);
+        m_buffers.mid.resize(count);
+        m_buffers.high.resize(count);
+        m_buffers.size = count;
+    }
+
+    const SINT frames = count / mixxx::audio::ChannelCount::stereo();
+    pFilters->low.process(pInput, &m_buffers.low[0], frames);
+    pFilters->mid.process(pInput, &m_buffers.mid[0], frames);
+    pFilters->high.process(pInput, &m_buffers.high[0], frames);
+}
+
+void AnalyzerWaveform::storeStrideMaxima(
+        WaveformStride* pStride, const CSAMPLE* pInput, SINT i) {
+    // Take max value, not average of data
+    CSAMPLE cover[2] = {fabs(pInput[i]), fabs(pInput[i + 1])};
+    CSAMPLE clow[2] = {fabs(m_buffers.low[i]), fabs(m_buffers.low[i + 1])};
+    CSAMPLE cmid[2] = {fabs(m_buffers.mid[i]), fabs(m_buffers.mid[i + 1])};
+    CSAMPLE chigh[2] = {fabs(m_buffers.high[i]), fabs(m_buffers.high[i + 1])};
+
+    // This is for if you want to experiment with averaging instead of
+    // maxing.
+    // pStride->m_overallData[Right] += buffer[i]*buffer[i];
+    // pStride->m_overallData[Left] += buffer[i + 1]*buffer[i + 1];
+    // pStride->m_filteredData[Right][Low] += m_buffers.low[i]*m_buffers.low[i];
+    // pStride->m_filteredData[Left][Low] += m_buffers.low[i + 1]*m_buffers.low[i + 1];
+    // pStride->m_filteredData[Right][Mid] += m_buffers.mid[i]*m_buffers.mid[i];
+    // pStride->m_filteredData[Left][Mid] += m_buffers.mid[i + 1]*m_buffers.mid[i + 1];
+    // pStride->m_filteredData[Right][High] += m_buffers.high[i]*m_buffers.high[i];
+    // pStride->m_filteredData[Left][High] += m_buffers.high[i + 1]*m_buffers.high[i + 1];
+
+    // Record the max across this stride.
+    storeIfGreater(&pStride->m_overallData[Left], cover[Left]);
+    storeIfGreater(&pStride->m_overallData[Right], cover[Right]);
+    storeIfGreater(&pStride->m_filteredData[Left][Low], clow[Left]);
+    storeIfGreater(&pStride->m_filteredData[Right][Low], clow[Right]);
+    storeIfGreater(&pStride->m_filteredData[Left][Mid], cmid[Left]);
+    storeIfGreater(&pStride->m_filteredData[Right][Mid], cmid[Right]);
+    storeIfGreater(&pStride->m_filteredData[Left][High], chigh[Left]);
+    storeIfGreater(&pStride->m_filteredData[Right][High], chigh[Right]);
+}
+
 void AnalyzerWaveform::cleanup() {
     m_waveform.clear();
     m_waveformData = nullptr;
@@ -358,6 +461,46 @@ void AnalyzerWaveform::storeResults(TrackPointer pTrack) {
                     << m_timer.elapsed().debugSecondsWithUnit();
 }
 
+bool AnalyzerWaveform::restoreCachedResults(
+        const mixxx::AnalysisCacheEntry& cacheEntry,
+        TrackPointer pTrack) {
+    VERIFY_OR_DEBUG_ASSERT(m_waveform && m_waveformSummary) {
+        return false;
+    }
+    if (cacheEntry.waveformVersion != WaveformFactory::currentWaveformVersion() ||
+            cacheEntry.waveformSummaryVersion !=
+                    WaveformFactory::currentWaveformSummaryVersion()) {
+        return false;
+    }
+    auto pWaveform = WaveformPointer(new Waveform(cacheEntry.waveform));
+    auto pWaveformSummary = WaveformPointer(new Waveform(cacheEntry.waveformSummary));
+    // The initialized waveforms have the expected layout
+    if (pWaveform->getDataSize() != m_waveform->getDataSize() ||
+            pWaveform->hasStem() != m_waveform->hasStem() ||
+            pWaveformSummary->getDataSize() != m_waveformSummary->getDataSize() ||
+            pWaveformSummary->hasStem() != m_waveformSummary->hasStem()) {
+        kLogger.warning() << "Discarding cached waveforms with a different layout";
+        return false;
+    }
+    m_waveform = pWaveform;
+    m_waveformSummary = pWaveformSummary;
+    storeResults(pTrack);
+    return true;
+}
+
+void AnalyzerWaveform::storeCachedResults(
+        mixxx::AnalysisCacheEntry* pCacheEntry,
+        TrackPointer pTrack) const {
+    Q_UNUSED(pTrack);
+    if (!m_waveform || !m_waveformSummary) {
+        return;
+    }
+    pCacheEntry->waveformVersion = m_waveform->getVersion();
+    pCacheEntry->waveform = m_waveform->toByteArray();
+    pCacheEntry->waveformSummaryVersion = m_waveformSummary->getVersion();
+    pCacheEntry->waveformSummary = m_waveformSummary->toByteArray();
+}
+
 void AnalyzerWaveform::storeIfGreater(float* pDest, float source) {
     if (*pDest < source) {
         *pDest = source;
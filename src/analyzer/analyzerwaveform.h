@@ -2,8 +2,10 @@
 
 #include <cmath>
 #include <limits>
+#include <memory>
 
 #include "analyzer/analyzer.h"
+#include "engine/filters/enginefiltercascade.h"
 #include "library/dao/analysisdao.h"
 #include "util/performancetimer.h"
 #include "util/sample.h"
@@ -15,7 +17,6 @@
 class QImage;
 #endif
 
-class EngineFilterIIRBase;
 class QSqlDatabase;
 
 struct WaveformStride {
@@ -145,18 +146,40 @@ class AnalyzerWaveform : public Analyzer {
             mixxx::audio::SampleRate sampleRate,
             mixxx::audio::ChannelCount channelCount,
             SINT frameLength) override;
+    void loadStoredResults(const AnalyzerTrack& track) override;
     bool processSamples(const CSAMPLE* buffer, SINT count) override;
+    bool processChunk(const AnalyzerChunk& chunk) override;
+    void processPreviewChunk(const AnalyzerChunk& chunk, SINT frameIndex) override;
     void storeResults(TrackPointer tio) override;
+    bool restoreCachedResults(
+            const mixxx::AnalysisCacheEntry& cacheEntry,
+            TrackPointer pTrack) override;
+    void storeCachedResults(
+            mixxx::AnalysisCacheEntry* pCacheEntry,
+            TrackPointer pTrack) const override;
     void cleanup() override;
 
   private:
+    // Bessel 4 filters splitting the stereo mix into the three bands.
+    // The low and the high pass are accurate enough with float, but the
+    // band pass sections at the low corner frequency need double.
+    struct Filters {
+        EngineFilterCascade<float, 2, mixxx::audio::ChannelCount::stereo()> low;
+        EngineFilterCascade<double, 4, mixxx::audio::ChannelCount::stereo()> mid;
+        EngineFilterCascade<float, 2, mixxx::audio::ChannelCount::stereo()> high;
+    };
+
     bool shouldAnalyze(TrackPointer tio) const;
+    ConstWaveformPointer loadStored(
+            TrackId trackId, AnalysisDao::AnalysisType type) const;
 
     void storeCurrentStridePower();
     void resetCurrentStride();
 
-    void createFilters(mixxx::audio::SampleRate sampleRate);
+    static std::unique_ptr<Filters> createFilters(mixxx::audio::SampleRate sampleRate);
     void destroyFilters();
+    void filterChunk(Filters* pFilters, const CSAMPLE* pInput, SINT count);
+    void storeStrideMaxima(WaveformStride* pStride, const CSAMPLE* pInput, SINT i);
     void storeIfGreater(float* pDest, float source);
 
     mutable AnalysisDao m_analysisDao;
@@ -172,13 +195,15 @@ class AnalyzerWaveform : public Analyzer {
     int m_currentSummaryStride;
     mixxx::audio::ChannelCount m_channelCount;
 
-    struct Filters {
-        std::unique_ptr<EngineFilterIIRBase> low;
-        std::unique_ptr<EngineFilterIIRBase> mid;
-        std::unique_ptr<EngineFilterIIRBase> high;
-    };
+    std::unique_ptr<Filters> m_filters;
 
-    Filters m_filters;
+    // Independent state for analyzing the region around the play
+    // position in advance
+    std::unique_ptr<Filters> m_previewFilters;
+    WaveformStride m_previewStride;
+    SINT m_previewNextFrameIndex;
+    bool m_previewStrideAligned;
+    mixxx::audio::SampleRate m_sampleRate;
 
     struct Buffers {
         std::vector<float> low;
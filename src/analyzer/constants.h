@@ -14,7 +14,13 @@ constexpr SINT kAnalysisFramesPerChunk = 4096;
 constexpr SINT kAnalysisSamplesPerChunk =
         kAnalysisFramesPerChunk * kAnalysisMaxChannels;
 
-// Only analyze the first minute in fast-analysis mode.
+// Only analyze a total of one minute in fast-analysis mode.
 constexpr SINT kFastAnalysisSecondsToAnalyze = 60;
 
+// Beats and key are detected in multiple windows that are spread across
+// the track in fast-analysis mode, see SampledAnalysisWindows.
+constexpr int kFastAnalysisWindowCount = 4;
+constexpr SINT kFastAnalysisSecondsPerWindow =
+        kFastAnalysisSecondsToAnalyze / kFastAnalysisWindowCount;
+
 }  // namespace mixxx
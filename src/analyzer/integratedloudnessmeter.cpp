@@ -0,0 +1,211 @@
+#include "analyzer/integratedloudnessmeter.h"
+
+#include <cfloat>
+#include <cmath>
+#include <limits>
+
+#include "util/assert.h"
+#include "util/math.h"
+
+namespace mixxx {
+
+namespace {
+
+// Absolute threshold of the gating blocks in LUFS
+constexpr double kAbsoluteGateLufs = -70.0;
+// Relative threshold of the gating blocks in LU
+constexpr double kRelativeGateLu = -10.0;
+
+double loudnessToEnergy(double loudness) {
+    return std::pow(10.0, (loudness + 0.691) / 10.0);
+}
+
+double energyToLoudness(double energy) {
+    return 10.0 * std::log10(energy) - 0.691;
+}
+
+double flushDenormal(double value) {
+    return std::fabs(value) < DBL_MIN ? 0.0 : value;
+}
+
+} // anonymous namespace
+
+IntegratedLoudnessMeter::IntegratedLoudnessMeter(
+        audio::SampleRate sampleRate,
+        audio::ChannelCount channelCount)
+        : m_channelCount(channelCount),
+          // Rounded like libebur128
+          m_segmentFrames((sampleRate + 5) / 10),
+          m_filter([sampleRate] {
+              // The coefficients of the K-weighting filter as specified for
+              // 48 kHz are derived for arbitrary sample rates. Both biquads
+              // are cascaded into a single 4th order filter.
+              double f0 = 1681.974450955533;
+              const double G = 3.999843853973347;
+              double Q = 0.7071752369554196;
+              double K = std::tan(M_PI * f0 / sampleRate.toDouble());
+              const double Vh = std::pow(10.0, G / 20.0);
+              const double Vb = std::pow(Vh, 0.4996667741545416);
+              const double a0 = 1.0 + K / Q + K * K;
+              const double pb[3] = {
+                      (Vh + Vb * K / Q + K * K) / a0,
+                      2.0 * (K * K - Vh) / a0,
+                      (Vh - Vb * K / Q + K * K) / a0};
+              const double pa[3] = {
+                      1.0,
+                      2.0 * (K * K - 1.0) / a0,
+                      (1.0 - K / Q + K * K) / a0};
+
+              f0 = 38.13547087602444;
+              Q = 0.5003270373238773;
+              K = std::tan(M_PI * f0 / sampleRate.toDouble());
+              const double rb[3] = {1.0, -2.0, 1.0};
+              const double ra[3] = {
+                      1.0,
+                      2.0 * (K * K - 1.0) / (1.0 + K / Q + K * K),
+                      (1.0 - K / Q + K * K) / (1.0 + K / Q + K * K)};
+
+              return Filter{
+                      {pb[0],
+                              pb[0] * rb[1] + pb[1] * rb[0],
+                              pb[0] * rb[2] + pb[1] * rb[1] + pb[2] * rb[0],
+                              pb[1] * rb[2] + pb[2] * rb[1],
+                              pb[2] * rb[2]},
+                      {pa[0] * ra[0],
+                              pa[0] * ra[1] + pa[1] * ra[0],
+                              pa[0] * ra[2] + pa[1] * ra[1] + pa[2] * ra[0],
+                              pa[1] * ra[2] + pa[2] * ra[1],
+                              pa[2] * ra[2]}};
+          }()),
+          m_segmentFrameCount(0),
+          m_segmentEnergies{},
+          m_segmentCount(0) {
+    DEBUG_ASSERT(m_channelCount >= 1 && m_channelCount <= kMaxChannels);
+    DEBUG_ASSERT(m_segmentFrames > 0);
+}
+
+template<int kChannels>
+void IntegratedLoudnessMeter::filterFrames(
+        const CSAMPLE* pSamples, SINT frameCount) {
+    const double b0 = m_filter.b[0];
+    const double b1 = m_filter.b[1];
+    const double b2 = m_filter.b[2];
+    const double b3 = m_filter.b[3];
+    const double b4 = m_filter.b[4];
+    const double a1 = m_filter.a[1];
+    const double a2 = m_filter.a[2];
+    const double a3 = m_filter.a[3];
+    const double a4 = m_filter.a[4];
+    // Local copies that are kept in registers
+    double v1[kChannels];
+    double v2[kChannels];
+    double v3[kChannels];
+    double v4[kChannels];
+    double sumOfSquares[kChannels];
+    for (int c = 0; c < kChannels; ++c) {
+        v1[c] = m_lanes.v1[c];
+        v2[c] = m_lanes.v2[c];
+        v3[c] = m_lanes.v3[c];
+        v4[c] = m_lanes.v4[c];
+        sumOfSquares[c] = m_lanes.sumOfSquares[c];
+    }
+    for (SINT i = 0; i < frameCount; ++i) {
+        // The recursion prevents processing consecutive frames in
+        // parallel, but the channels are independent and processed as
+        // lanes of a single vector.
+        for (int c = 0; c < kChannels; ++c) {
+            const double v0 = static_cast<double>(pSamples[i * kChannels + c]) -
+                    a1 * v1[c] - a2 * v2[c] - a3 * v3[c] - a4 * v4[c];
+            const double y = b0 * v0 + b1 * v1[c] + b2 * v2[c] + b3 * v3[c] + b4 * v4[c];
+            v4[c] = v3[c];
+            v3[c] = v2[c];
+            v2[c] = v1[c];
+            v1[c] = v0;
+            sumOfSquares[c] += y * y;
+        }
+    }
+    for (int c = 0; c < kChannels; ++c) {
+        m_lanes.v1[c] = flushDenormal(v1[c]);
+        m_lanes.v2[c] = flushDenormal(v2[c]);
+        m_lanes.v3[c] = flushDenormal(v3[c]);
+        m_lanes.v4[c] = flushDenormal(v4[c]);
+        m_lanes.sumOfSquares[c] = sumOfSquares[c];
+    }
+}
+
+void IntegratedLoudnessMeter::process(const CSAMPLE* pSamples, SINT frameCount) {
+    while (frameCount > 0) {
+        const SINT segmentFrameCount =
+                math_min(frameCount, m_segmentFrames - m_segmentFrameCount);
+        switch (m_channelCount) {
+        case 1:
+            filterFrames<1>(pSamples, segmentFrameCount);
+            break;
+        case 2:
+            filterFrames<2>(pSamples, segmentFrameCount);
+            break;
+        default:
+            DEBUG_ASSERT(!"unsupported channel count");
+            return;
+        }
+        pSamples += segmentFrameCount * m_channelCount;
+        frameCount -= segmentFrameCount;
+        m_segmentFrameCount += segmentFrameCount;
+        if (m_segmentFrameCount == m_segmentFrames) {
+            finishSegment();
+        }
+    }
+}
+
+void IntegratedLoudnessMeter::finishSegment() {
+    // All channels are front channels with a weight of 1.0
+    double energy = 0.0;
+    for (int c = 0; c < m_channelCount; ++c) {
+        energy += m_lanes.sumOfSquares[c];
+        m_lanes.sumOfSquares[c] = 0.0;
+    }
+    m_segmentEnergies[m_segmentCount % m_segmentEnergies.size()] = energy;
+    m_segmentFrameCount = 0;
+    ++m_segmentCount;
+
+    // The gating blocks of 400 ms overlap by 75%, i.e. a new block is
+    // complete after each segment.
+    if (m_segmentCount < static_cast<int>(m_segmentEnergies.size())) {
+        return;
+    }
+    double blockEnergy = 0.0;
+    for (double segmentEnergy : m_segmentEnergies) {
+        blockEnergy += segmentEnergy;
+    }
+    blockEnergy /= static_cast<double>(m_segmentFrames * m_segmentEnergies.size());
+    if (blockEnergy >= loudnessToEnergy(kAbsoluteGateLufs)) {
+        m_blockEnergies.push_back(blockEnergy);
+    }
+}
+
+double IntegratedLoudnessMeter::integratedLoudness() const {
+    if (m_blockEnergies.empty()) {
+        return -std::numeric_limits<double>::infinity();
+    }
+    double relativeThreshold = 0.0;
+    for (double blockEnergy : m_blockEnergies) {
+        relativeThreshold += blockEnergy;
+    }
+    relativeThreshold /= static_cast<double>(m_blockEnergies.size());
+    relativeThreshold *= std::pow(10.0, kRelativeGateLu / 10.0);
+
+    double gatedEnergy = 0.0;
+    std::size_t gatedBlockCount = 0;
+    for (double blockEnergy : m_blockEnergies) {
+        if (blockEnergy >= relativeThreshold) {
+            gatedEnergy += blockEnergy;
+            ++gatedBlockCount;
+        }
+    }
+    if (gatedBlockCount == 0) {
+        return -std::numeric_limits<double>::infinity();
+    }
+    return energyToLoudness(gatedEnergy / static_cast<double>(gatedBlockCount));
+}
+
+} // namespace mixxx
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "audio/types.h"
+#include "util/types.h"
+
+namespace mixxx {
+
+/// Measures the integrated (gated) loudness of a mono or stereo signal
+/// according to ITU-R BS.1770-4 / EBU R128.
+///
+/// The results match those of libebur128 in EBUR128_MODE_I. Instead of
+/// filtering one channel after another the K-weighting filter processes
+/// all channels of a frame at once as lanes of a vector, and the squared
+/// output is accumulated in 100 ms segments instead of buffering the
+/// filtered signal for calculating the gating blocks.
+class IntegratedLoudnessMeter {
+  public:
+    static constexpr int kMaxChannels = 2;
+
+    IntegratedLoudnessMeter(
+            audio::SampleRate sampleRate,
+            audio::ChannelCount channelCount);
+
+    /// Processes interleaved frames.
+    void process(const CSAMPLE* pSamples, SINT frameCount);
+
+    /// The integrated loudness in LUFS of all frames processed so far
+    /// or -infinity if none of the gating blocks is above the
+    /// absolute threshold.
+    double integratedLoudness() const;
+
+    /// The number of gating blocks above the absolute threshold.
+    std::size_t blockCount() const {
+        return m_blockEnergies.size();
+    }
+
+  private:
+    // Direct form II of the cascaded high shelf and high pass biquad
+    // filters, 4 delay elements per channel.
+    struct Filter {
+        std::array<double, 5> b;
+        std::array<double, 5> a;
+    };
+
+    // Structure of arrays: The delay elements of all channels are
+    // adjacent in memory and updated as a single vector.
+    struct Lanes {
+        std::array<double, kMaxChannels> v1{};
+        std::array<double, kMaxChannels> v2{};
+        std::array<double, kMaxChannels> v3{};
+        std::array<double, kMaxChannels> v4{};
+        std::array<double, kMaxChannels> sumOfSquares{};
+    };
+
+    template<int kChannels>
+    void filterFrames(const CSAMPLE* pSamples, SINT frameCount);
+
+    void finishSegment();
+
+    const int m_channelCount;
+    const SINT m_segmentFrames;
+    const Filter m_filter;
+
+    Lanes m_lanes;
+    SINT m_segmentFrameCount;
+
+    // The weighted energies of the last 4 segments of 100 ms
+    std::array<double, 4> m_segmentEnergies;
+    int m_segmentCount;
+
+    // The mean square of all 400 ms blocks above the absolute threshold
+    std::vector<double> m_blockEnergies;
+};
+
+} // namespace mixxx
@@ -22,6 +22,13 @@ constexpr float kStepSecs = 0.01161f;
 // results in 43 Hz @ 44.1 kHz / 47 Hz @ 48 kHz / 47 Hz @ 96 kHz
 constexpr int kMaximumBinSizeHz = 50; // Hz
 
+// ~12 s per segment @ 44.1 kHz
+constexpr size_t kSegmentWindowCount = 1024;
+// The complex spectral difference only depends on the magnitudes and
+// phases of the 2 preceding windows. Adaptive whitening that would
+// depend on all preceding windows is disabled.
+constexpr size_t kWarmUpWindowCount = 2;
+
 DFConfig makeDetectionFunctionConfig(int stepSizeFrames, int windowSize) {
     // These are the defaults for the VAMP beat tracker plugin we used in Mixxx
     // 2.0.
@@ -38,8 +45,10 @@ DFConfig makeDetectionFunctionConfig(int stepSizeFrames, int windowSize) {
 
 } // namespace
 
-AnalyzerQueenMaryBeats::AnalyzerQueenMaryBeats()
-        : m_windowSize(0),
+AnalyzerQueenMaryBeats::AnalyzerQueenMaryBeats(bool parallel)
+        : m_parallel(parallel),
+          m_initialized(false),
+          m_windowSize(0),
           m_stepSizeFrames(0) {
 }
 
@@ -47,38 +56,49 @@ AnalyzerQueenMaryBeats::~AnalyzerQueenMaryBeats() {
 }
 
 bool AnalyzerQueenMaryBeats::initialize(mixxx::audio::SampleRate sampleRate) {
-    m_detectionResults.clear();
+    m_resultBeats.clear();
     m_sampleRate = sampleRate;
     m_stepSizeFrames = static_cast<int>(m_sampleRate * kStepSecs);
     m_windowSize = MathUtilities::nextPowerOfTwo(m_sampleRate / kMaximumBinSizeHz);
-    m_pDetectionFunction = std::make_unique<DetectionFunction>(
-            makeDetectionFunctionConfig(m_stepSizeFrames, m_windowSize));
     qDebug() << "input sample rate is " << m_sampleRate << ", step size is " << m_stepSizeFrames;
 
-    m_helper.initialize(
-            m_windowSize, m_stepSizeFrames, [this](double* pWindow, size_t) {
-                // TODO(rryan) reserve?
-                m_detectionResults.push_back(
-                        m_pDetectionFunction->processTimeDomain(pWindow));
-                return true;
+    const DFConfig config = makeDetectionFunctionConfig(m_stepSizeFrames, m_windowSize);
+    m_initialized = m_processor.initialize(m_windowSize,
+            m_stepSizeFrames,
+            m_parallel ? kSegmentWindowCount : 0,
+            kWarmUpWindowCount,
+            [config]() {
+                // Shared, because std::function requires a copyable target
+                auto pDetectionFunction = std::make_shared<DetectionFunction>(config);
+                return [pDetectionFunction](double* pWindow) {
+                    return std::optional<double>(
+                            pDetectionFunction->processTimeDomain(pWindow));
+                };
             });
-    return true;
+    return m_initialized;
 }
 
 bool AnalyzerQueenMaryBeats::processSamples(const CSAMPLE* pIn, SINT iLen) {
     DEBUG_ASSERT(iLen % kAnalysisChannels == 0);
-    if (!m_pDetectionFunction) {
+    if (!m_initialized) {
         return false;
     }
 
-    return m_helper.processStereoSamples(pIn, iLen);
+    return m_processor.processStereoSamples(pIn, iLen);
 }
 
 bool AnalyzerQueenMaryBeats::finalize() {
-    m_helper.finalize();
+    if (!m_initialized) {
+        return false;
+    }
+    m_initialized = false;
+    const auto detectionResults = m_processor.finalize();
+    if (!detectionResults) {
+        return false;
+    }
 
-    int nonZeroCount = static_cast<int>(m_detectionResults.size());
-    while (nonZeroCount > 0 && m_detectionResults.at(nonZeroCount - 1) <= 0.0) {
+    int nonZeroCount = static_cast<int>(detectionResults->size());
+    while (nonZeroCount > 0 && detectionResults->at(nonZeroCount - 1) <= 0.0) {
         --nonZeroCount;
     }
 
@@ -91,7 +111,7 @@ bool AnalyzerQueenMaryBeats::finalize() {
     // skip first 2 results as it might have detect noise as onset
     // that's how vamp does and seems works best this way
     for (int i = 2; i < nonZeroCount; ++i) {
-        df.push_back(m_detectionResults.at(i));
+        df.push_back(detectionResults->at(i));
         beatPeriod.push_back(0.0);
     }
 
@@ -110,7 +130,6 @@ bool AnalyzerQueenMaryBeats::finalize() {
         m_resultBeats.push_back(result);
     }
 
-    m_pDetectionFunction.reset();
     return true;
 }
 
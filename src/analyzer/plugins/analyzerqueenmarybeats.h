@@ -1,13 +1,10 @@
 #pragma once
 
 #include <QObject>
-#include <memory>
 #include <vector>
 
 #include "analyzer/plugins/analyzerplugin.h"
-#include "analyzer/plugins/buffering_utils.h"
-
-class DetectionFunction;
+#include "analyzer/plugins/segmentedwindowprocessor.h"
 
 namespace mixxx {
 
@@ -23,7 +20,9 @@ class AnalyzerQueenMaryBeats : public AnalyzerBeatsPlugin {
                 true);
     }
 
-    AnalyzerQueenMaryBeats();
+    /// The onset detection function is calculated for consecutive
+    /// segments of the track in parallel unless disabled.
+    explicit AnalyzerQueenMaryBeats(bool parallel = true);
     ~AnalyzerQueenMaryBeats() override;
 
     AnalyzerPluginInfo info() const override {
@@ -43,12 +42,12 @@ class AnalyzerQueenMaryBeats : public AnalyzerBeatsPlugin {
     }
 
   private:
-    std::unique_ptr<DetectionFunction> m_pDetectionFunction;
-    DownmixAndOverlapHelper m_helper;
+    const bool m_parallel;
+    SegmentedWindowProcessor<double> m_processor;
+    bool m_initialized;
     mixxx::audio::SampleRate m_sampleRate;
     int m_windowSize;
     int m_stepSizeFrames;
-    std::vector<double> m_detectionResults;
     QVector<mixxx::audio::FramePos> m_resultBeats;
 };
 
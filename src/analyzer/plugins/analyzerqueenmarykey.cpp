@@ -1,5 +1,7 @@
 #include <dsp/keydetection/GetKeyMode.h>
 
+#include <cmath>
+
 // Class header comes after library includes here since our preprocessor
 // definitions interfere with qm-dsp's headers.
 #include "analyzer/plugins/analyzerqueenmarykey.h"
@@ -16,20 +18,37 @@ namespace {
 // Tuning frequency of concert A in Hertz. Default value from VAMP plugin.
 constexpr int kTuningFrequencyHertz = 440;
 
+// ~47 s per segment @ 44.1 kHz
+constexpr size_t kSegmentWindowCount = 64;
+
+size_t warmUpWindowCount(
+        const GetKeyMode::Config& config,
+        size_t windowSize) {
+    // The key of a window is the median of the keys estimated from the
+    // chromagram averages of the preceding windows. Both the chromagram
+    // average and the median filter need to be filled. The decimation
+    // filter of the preceding window has settled after one window.
+    const double windowSecs = windowSize / config.sampleRate;
+    return static_cast<size_t>(std::ceil(config.hpcpAverage / windowSecs)) +
+            static_cast<size_t>(std::ceil(config.medianAverage / windowSecs)) +
+            1;
+}
+
 } // namespace
 
-AnalyzerQueenMaryKey::AnalyzerQueenMaryKey()
-        : m_currentFrame(0),
-          m_prevKey(mixxx::track::io::key::INVALID) {
+AnalyzerQueenMaryKey::AnalyzerQueenMaryKey(bool parallel)
+        : m_parallel(parallel),
+          m_initialized(false),
+          m_currentFrame(0) {
 }
 
 AnalyzerQueenMaryKey::~AnalyzerQueenMaryKey() {
 }
 
 bool AnalyzerQueenMaryKey::initialize(mixxx::audio::SampleRate sampleRate) {
-    m_prevKey = mixxx::track::io::key::INVALID;
     m_resultKeys.clear();
     m_currentFrame = 0;
+    m_windowFrames.clear();
 
     struct Config {
         double sampleRate;
@@ -52,44 +71,69 @@ bool AnalyzerQueenMaryKey::initialize(mixxx::audio::SampleRate sampleRate) {
     };
 
     GetKeyMode::Config config(sampleRate, kTuningFrequencyHertz);
-    m_pKeyMode = std::make_unique<GetKeyMode>(config);
-    size_t windowSize = m_pKeyMode->getBlockSize();
-    size_t stepSize = m_pKeyMode->getHopSize();
-
-    return m_helper.initialize(
-            windowSize, stepSize, [this](double* pWindow, size_t) {
-                int iKey = m_pKeyMode->process(pWindow);
-
-                if (!ChromaticKey_IsValid(iKey)) {
-                    qWarning() << "No valid key detected in analyzed window:" << iKey;
-                    DEBUG_ASSERT(!"iKey is invalid");
-                    return false;
-                }
-                const auto key = static_cast<ChromaticKey>(iKey);
-                if (key != m_prevKey) {
-                    // TODO(rryan) reserve?
-                    m_resultKeys.push_back(qMakePair(
-                            key, static_cast<double>(m_currentFrame)));
-                    m_prevKey = key;
-                }
-                return true;
+    size_t windowSize;
+    size_t stepSize;
+    {
+        GetKeyMode keyMode(config);
+        windowSize = keyMode.getBlockSize();
+        stepSize = keyMode.getHopSize();
+    }
+
+    m_initialized = m_processor.initialize(windowSize,
+            stepSize,
+            m_parallel ? kSegmentWindowCount : 0,
+            warmUpWindowCount(config, windowSize),
+            [config]() {
+                // Shared, because std::function requires a copyable target
+                auto pKeyMode = std::make_shared<GetKeyMode>(config);
+                return [pKeyMode](double* pWindow) -> std::optional<int> {
+                    int iKey = pKeyMode->process(pWindow);
+                    if (!ChromaticKey_IsValid(iKey)) {
+                        qWarning() << "No valid key detected in analyzed window:" << iKey;
+                        DEBUG_ASSERT(!"iKey is invalid");
+                        return std::nullopt;
+                    }
+                    return iKey;
+                };
             });
+    return m_initialized;
 }
 
 bool AnalyzerQueenMaryKey::processSamples(const CSAMPLE* pIn, SINT iLen) {
     DEBUG_ASSERT(iLen % kAnalysisChannels == 0);
-    if (!m_pKeyMode) {
+    if (!m_initialized) {
         return false;
     }
 
     const size_t numInputFrames = iLen / kAnalysisChannels;
     m_currentFrame += numInputFrames;
-    return m_helper.processStereoSamples(pIn, iLen);
+    const bool result = m_processor.processStereoSamples(pIn, iLen);
+    m_windowFrames.resize(m_processor.windowCount(), m_currentFrame);
+    return result;
 }
 
 bool AnalyzerQueenMaryKey::finalize() {
-    m_helper.finalize();
-    m_pKeyMode.reset();
+    if (!m_initialized) {
+        return false;
+    }
+    m_initialized = false;
+    const auto keys = m_processor.finalize();
+    if (!keys) {
+        return false;
+    }
+    // The remaining windows are framed while finalizing
+    m_windowFrames.resize(keys->size(), m_currentFrame);
+
+    ChromaticKey prevKey = mixxx::track::io::key::INVALID;
+    for (size_t i = 0; i < keys->size(); ++i) {
+        const auto key = static_cast<ChromaticKey>(keys->at(i));
+        if (key != prevKey) {
+            m_resultKeys.push_back(qMakePair(
+                    key, static_cast<double>(m_windowFrames[i])));
+            prevKey = key;
+        }
+    }
+    m_windowFrames.clear();
     return true;
 }
 
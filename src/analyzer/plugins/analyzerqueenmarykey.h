@@ -1,14 +1,12 @@
 #pragma once
 
 #include <QObject>
-#include <memory>
+#include <vector>
 
 #include "analyzer/plugins/analyzerplugin.h"
-#include "analyzer/plugins/buffering_utils.h"
+#include "analyzer/plugins/segmentedwindowprocessor.h"
 #include "util/types.h"
 
-class GetKeyMode;
-
 namespace mixxx {
 
 class AnalyzerQueenMaryKey : public AnalyzerKeyPlugin {
@@ -23,7 +21,9 @@ class AnalyzerQueenMaryKey : public AnalyzerKeyPlugin {
                 false);
     }
 
-    AnalyzerQueenMaryKey();
+    /// The chromagram is calculated for consecutive segments of the
+    /// track in parallel unless disabled.
+    explicit AnalyzerQueenMaryKey(bool parallel = true);
     ~AnalyzerQueenMaryKey() override;
 
     AnalyzerPluginInfo info() const override {
@@ -39,11 +39,13 @@ class AnalyzerQueenMaryKey : public AnalyzerKeyPlugin {
     }
 
   private:
-    std::unique_ptr<GetKeyMode> m_pKeyMode;
-    DownmixAndOverlapHelper m_helper;
+    const bool m_parallel;
+    SegmentedWindowProcessor<int> m_processor;
+    bool m_initialized;
     size_t m_currentFrame;
+    // The current frame when each window has been framed
+    std::vector<size_t> m_windowFrames;
     KeyChangeList m_resultKeys;
-    mixxx::track::io::key::ChromaticKey m_prevKey;
 };
 
 } // namespace mixxx
@@ -0,0 +1,27 @@
+#include "analyzer/plugins/segmentedwindowprocessor.h"
+
+#include <QThread>
+
+namespace mixxx {
+
+namespace {
+
+/// The segments of all analyzer threads share this pool. It is separate
+/// from the global thread pool, so segments neither delay nor are delayed
+/// by other tasks like rendering the overview waveforms.
+class SegmentThreadPool : public QThreadPool {
+  public:
+    SegmentThreadPool() {
+        setObjectName(QStringLiteral("SegmentedWindowProcessor"));
+        setMaxThreadCount(std::max(1, QThread::idealThreadCount()));
+    }
+};
+
+} // anonymous namespace
+
+QThreadPool* segmentedWindowProcessorThreadPool() {
+    static SegmentThreadPool s_threadPool;
+    return &s_threadPool;
+}
+
+} // namespace mixxx
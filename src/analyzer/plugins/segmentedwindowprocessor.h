@@ -0,0 +1,269 @@
+#pragma once
+
+#include <QFuture>
+#include <QThreadPool>
+#include <QtConcurrentRun>
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "analyzer/plugins/buffering_utils.h"
+#include "util/assert.h"
+#include "util/types.h"
+
+namespace mixxx {
+
+/// The thread pool with a bounded number of threads that processes the
+/// segments of all SegmentedWindowProcessors.
+QThreadPool* segmentedWindowProcessorThreadPool();
+
+/// Frames a stereo signal into overlapping mono windows like
+/// DownmixAndOverlapHelper and processes consecutive segments of those
+/// windows concurrently on a dedicated thread pool.
+///
+/// The window function is stateful, e.g. an onset detection function
+/// compares the spectrum with the previous windows and a key detector
+/// averages the chromagram over the last seconds. Each segment is
+/// processed by a new window function that is obtained from the factory.
+/// Its state is built up by the trailing warm-up windows of the preceding
+/// segment. Results of warm-up windows are discarded. If the state of the
+/// window function only depends on a bounded number of preceding windows,
+/// the results are identical to sequential processing.
+///
+/// The results of all segments are concatenated in order at finalize(),
+/// independent of the order in which the segments have been completed.
+/// A segment size of 0 processes all windows sequentially on the
+/// calling thread.
+template<typename Result>
+class SegmentedWindowProcessor {
+  public:
+    /// Processes a window of the mono signal. The window must not be
+    /// modified, it overlaps with the following windows. Returns
+    /// std::nullopt to abort the analysis.
+    typedef std::function<std::optional<Result>(double* pWindow)> WindowFunction;
+    /// Creates a window function with its initial state. Invoked
+    /// concurrently on worker threads.
+    typedef std::function<WindowFunction()> WindowFunctionFactory;
+
+    SegmentedWindowProcessor() = default;
+    ~SegmentedWindowProcessor() {
+        // Don't leave any pending tasks behind that are still accessing
+        // the factory.
+        waitForSegments();
+    }
+
+    bool initialize(
+            size_t windowSize,
+            size_t stepSize,
+            size_t segmentWindowCount,
+            size_t warmUpWindowCount,
+            WindowFunctionFactory factory) {
+        waitForSegments();
+        m_results.clear();
+        m_windowCount = 0;
+        m_failed = false;
+        m_windowSize = windowSize;
+        m_stepSize = stepSize;
+        m_segmentWindowCount = segmentWindowCount;
+        m_warmUpWindowCount = warmUpWindowCount;
+        m_factory = std::move(factory);
+        m_segment = Segment{};
+        // Limit the number of segments that are buffered in memory
+        // while waiting for a worker thread.
+        m_maxPendingSegments = static_cast<size_t>(std::clamp(
+                segmentedWindowProcessorThreadPool()->maxThreadCount(),
+                1,
+                kMaxPendingSegments));
+        if (!m_factory) {
+            return false;
+        }
+        if (m_segmentWindowCount == 0) {
+            m_windowFunction = m_factory();
+        } else {
+            m_windowFunction = nullptr;
+        }
+        return m_helper.initialize(
+                windowSize, stepSize, [this](double* pWindow, size_t) {
+                    return processWindow(pWindow);
+                });
+    }
+
+    bool processStereoSamples(
+            const CSAMPLE* pInput,
+            size_t inputStereoSamples) {
+        if (m_failed) {
+            return false;
+        }
+        return m_helper.processStereoSamples(pInput, inputStereoSamples);
+    }
+
+    /// Waits until all segments have been processed. Returns the results
+    /// of all windows in order or std::nullopt if the window function
+    /// has aborted the analysis.
+    std::optional<std::vector<Result>> finalize() {
+        if (!m_failed) {
+            m_helper.finalize();
+        }
+        if (!m_failed && m_segment.windowCount > m_segment.warmUpWindowCount) {
+            submitSegment(std::move(m_segment));
+        }
+        m_segment = Segment{};
+        while (!m_pendingSegments.empty()) {
+            collectFrontSegment();
+        }
+        m_windowFunction = nullptr;
+        if (m_failed) {
+            m_results.clear();
+            return std::nullopt;
+        }
+        return std::move(m_results);
+    }
+
+    /// The number of windows that have been framed so far. This is the
+    /// number of results that finalize() will return.
+    size_t windowCount() const {
+        return m_windowCount;
+    }
+
+  private:
+    static constexpr int kMaxPendingSegments = 4;
+
+    struct Segment {
+        // The consecutive windows overlap, window i starts at
+        // sample i * stepSize.
+        std::vector<double> samples;
+        size_t windowCount = 0;
+        size_t warmUpWindowCount = 0;
+    };
+
+    typedef std::optional<std::vector<Result>> SegmentResults;
+
+    static SegmentResults processSegment(
+            const WindowFunctionFactory& factory,
+            const std::shared_ptr<Segment>& pSegment,
+            size_t stepSize) {
+        WindowFunction windowFunction = factory();
+        std::vector<Result> results;
+        results.reserve(pSegment->windowCount - pSegment->warmUpWindowCount);
+        for (size_t i = 0; i < pSegment->windowCount; ++i) {
+            auto result = windowFunction(pSegment->samples.data() + i * stepSize);
+            if (!result) {
+                return std::nullopt;
+            }
+            if (i >= pSegment->warmUpWindowCount) {
+                results.push_back(std::move(*result));
+            }
+        }
+        return results;
+    }
+
+    bool processWindow(double* pWindow) {
+        ++m_windowCount;
+        if (m_segmentWindowCount == 0) {
+            auto result = m_windowFunction(pWindow);
+            if (!result) {
+                m_failed = true;
+                return false;
+            }
+            m_results.push_back(std::move(*result));
+            return true;
+        }
+
+        // Only the new samples of overlapping windows are appended
+        if (m_segment.windowCount == 0) {
+            m_segment.samples.reserve(m_windowSize +
+                    (m_warmUpWindowCount + m_segmentWindowCount - 1) * m_stepSize);
+            m_segment.samples.assign(pWindow, pWindow + m_windowSize);
+        } else {
+            m_segment.samples.insert(m_segment.samples.end(),
+                    pWindow + m_windowSize - m_stepSize,
+                    pWindow + m_windowSize);
+        }
+        ++m_segment.windowCount;
+        if (m_segment.windowCount <
+                m_segment.warmUpWindowCount + m_segmentWindowCount) {
+            return true;
+        }
+
+        // The trailing windows of this segment are the warm-up
+        // windows of the next segment.
+        Segment nextSegment;
+        const size_t warmUpWindowCount =
+                std::min(m_warmUpWindowCount, m_segment.windowCount);
+        if (warmUpWindowCount > 0) {
+            const auto warmUpBegin = m_segment.samples.begin() +
+                    (m_segment.windowCount - warmUpWindowCount) * m_stepSize;
+            nextSegment.samples.assign(warmUpBegin, m_segment.samples.end());
+        }
+        nextSegment.windowCount = warmUpWindowCount;
+        nextSegment.warmUpWindowCount = warmUpWindowCount;
+        submitSegment(std::exchange(m_segment, std::move(nextSegment)));
+        return !m_failed;
+    }
+
+    void submitSegment(Segment segment) {
+        // Results are collected in order. Free the memory of completed
+        // segments and block when too many segments are pending.
+        while (!m_pendingSegments.empty() &&
+                (m_pendingSegments.front().isFinished() ||
+                        m_pendingSegments.size() >= m_maxPendingSegments)) {
+            collectFrontSegment();
+        }
+        if (m_failed) {
+            return;
+        }
+        m_pendingSegments.push_back(QtConcurrent::run(
+                segmentedWindowProcessorThreadPool(),
+                &SegmentedWindowProcessor::processSegment,
+                m_factory,
+                // Shared instead of copied by QtConcurrent
+                std::make_shared<Segment>(std::move(segment)),
+                m_stepSize));
+    }
+
+    void collectFrontSegment() {
+        DEBUG_ASSERT(!m_pendingSegments.empty());
+        QFuture<SegmentResults> future = std::move(m_pendingSegments.front());
+        m_pendingSegments.pop_front();
+        future.waitForFinished();
+        if (m_failed) {
+            return;
+        }
+        SegmentResults results = future.result();
+        if (!results) {
+            m_failed = true;
+            return;
+        }
+        m_results.insert(m_results.end(),
+                std::make_move_iterator(results->begin()),
+                std::make_move_iterator(results->end()));
+    }
+
+    void waitForSegments() {
+        for (auto& future : m_pendingSegments) {
+            future.waitForFinished();
+        }
+        m_pendingSegments.clear();
+    }
+
+    DownmixAndOverlapHelper m_helper;
+    size_t m_windowSize = 0;
+    size_t m_stepSize = 0;
+    size_t m_segmentWindowCount = 0;
+    size_t m_warmUpWindowCount = 0;
+    size_t m_maxPendingSegments = 1;
+    WindowFunctionFactory m_factory;
+    // Only used for sequential processing
+    WindowFunction m_windowFunction;
+    Segment m_segment;
+    std::deque<QFuture<SegmentResults>> m_pendingSegments;
+    std::vector<Result> m_results;
+    size_t m_windowCount = 0;
+    bool m_failed = false;
+};
+
+} // namespace mixxx
@@ -0,0 +1,173 @@
+#include "analyzer/sampledanalysis.h"
+
+#include <QMap>
+#include <cmath>
+#include <limits>
+
+#include "track/beatutils.h"
+#include "util/assert.h"
+#include "util/math.h"
+
+namespace mixxx {
+
+namespace {
+
+// Tolerance for beat intervals that match a tempo, which accounts
+// for the jitter of the beat detection.
+constexpr double kMaxSecsBeatIntervalError = 0.025;
+
+// Tempos of different windows that deviate by less than this
+// are considered to be the same.
+constexpr double kMaxRelativeBpmDeviation = 0.02;
+
+} // anonymous namespace
+
+SampledAnalysisWindows::SampledAnalysisWindows(
+        audio::SampleRate sampleRate,
+        SINT frameLength,
+        int windowCount,
+        SINT secondsPerWindow) {
+    DEBUG_ASSERT(sampleRate.isValid());
+    DEBUG_ASSERT(windowCount > 0);
+    DEBUG_ASSERT(secondsPerWindow > 0);
+    if (frameLength <= 0) {
+        return;
+    }
+    const SINT windowLength = secondsPerWindow * sampleRate;
+    if (frameLength < 2 * windowCount * windowLength) {
+        // Sampling would analyze at least half of the track, which
+        // does not save enough time to justify provisional results.
+        m_windows.push_back(IndexRange::forward(0, frameLength));
+        return;
+    }
+    const SINT sectionLength = frameLength / windowCount;
+    m_windows.reserve(windowCount);
+    for (int i = 0; i < windowCount; ++i) {
+        m_windows.push_back(IndexRange::forward(
+                i * sectionLength + (sectionLength - windowLength) / 2,
+                windowLength));
+    }
+}
+
+SINT SampledAnalysisWindows::framesToSkip(SINT frameIndex) const {
+    for (const auto& window : m_windows) {
+        if (frameIndex < window.start()) {
+            return window.start() - frameIndex;
+        }
+        if (frameIndex < window.end()) {
+            return 0;
+        }
+    }
+    return std::numeric_limits<SINT>::max();
+}
+
+SampledTempo estimateSampledTempo(
+        const QVector<audio::FramePos>& beats,
+        audio::SampleRate sampleRate) {
+    DEBUG_ASSERT(sampleRate.isValid());
+    const QVector<BeatUtils::ConstRegion> constantRegions =
+            BeatUtils::retrieveConstRegions(beats, sampleRate);
+    if (constantRegions.isEmpty()) {
+        return {};
+    }
+    audio::FramePos firstBeat = audio::kStartFramePos;
+    const Bpm bpm = BeatUtils::makeConstBpm(constantRegions, sampleRate, &firstBeat);
+    if (!bpm.isValid() || !firstBeat.isValid()) {
+        return {};
+    }
+    firstBeat = BeatUtils::adjustPhase(firstBeat, bpm, sampleRate, beats);
+
+    const audio::FrameDiff_t beatLength = 60.0 * sampleRate / bpm.value();
+    const audio::FrameDiff_t maxIntervalError = kMaxSecsBeatIntervalError * sampleRate;
+    int matchingIntervals = 0;
+    for (int i = 1; i < beats.size(); ++i) {
+        if (std::fabs(beats[i] - beats[i - 1] - beatLength) <= maxIntervalError) {
+            ++matchingIntervals;
+        }
+    }
+    DEBUG_ASSERT(beats.size() >= 2);
+    return {bpm,
+            firstBeat,
+            static_cast<double>(matchingIntervals) / (beats.size() - 1)};
+}
+
+std::optional<SampledTempo> combineSampledTempos(
+        const std::vector<SampledTempo>& tempos) {
+    std::optional<SampledTempo> result;
+    double resultSupport = 0.0;
+    for (const auto& candidate : tempos) {
+        if (!candidate.bpm.isValid() || candidate.confidence <= 0.0) {
+            continue;
+        }
+        double support = 0.0;
+        for (const auto& tempo : tempos) {
+            if (tempo.bpm.isValid() &&
+                    std::fabs(tempo.bpm.value() / candidate.bpm.value() - 1.0) <=
+                            kMaxRelativeBpmDeviation) {
+                support += tempo.confidence;
+            }
+        }
+        if (!result || support > resultSupport ||
+                (support == resultSupport && candidate.confidence > result->confidence)) {
+            result = candidate;
+            resultSupport = support;
+        }
+    }
+    if (result) {
+        result->confidence = resultSupport / tempos.size();
+    }
+    return result;
+}
+
+SampledKey estimateSampledKey(
+        const KeyChangeList& keyChanges,
+        SINT windowLength) {
+    QMap<track::io::key::ChromaticKey, double> keyHistogram;
+    double totalLength = 0.0;
+    for (int i = 0; i < keyChanges.size(); ++i) {
+        const double startFrame = math_clamp(
+                keyChanges[i].second, 0.0, static_cast<double>(windowLength));
+        const double endFrame = (i == keyChanges.size() - 1)
+                ? windowLength
+                : math_clamp(keyChanges[i + 1].second,
+                          startFrame,
+                          static_cast<double>(windowLength));
+        keyHistogram[keyChanges[i].first] += endFrame - startFrame;
+        totalLength += endFrame - startFrame;
+    }
+
+    SampledKey result;
+    double maxLength = 0.0;
+    for (auto it = keyHistogram.constBegin(); it != keyHistogram.constEnd(); ++it) {
+        if (it.key() != track::io::key::INVALID && it.value() > maxLength) {
+            result.key = it.key();
+            maxLength = it.value();
+        }
+    }
+    if (maxLength > 0.0) {
+        result.confidence = maxLength / totalLength;
+    }
+    return result;
+}
+
+track::io::key::ChromaticKey combineSampledKeys(
+        const std::vector<SampledKey>& keys) {
+    QMap<track::io::key::ChromaticKey, double> keyConfidences;
+    for (const auto& key : keys) {
+        if (key.key != track::io::key::INVALID) {
+            keyConfidences[key.key] += key.confidence;
+        }
+    }
+
+    track::io::key::ChromaticKey result = track::io::key::INVALID;
+    double maxConfidence = 0.0;
+    for (auto it = keyConfidences.constBegin(); it != keyConfidences.constEnd(); ++it) {
+        if (it.value() > maxConfidence) {
+            result = it.key();
+            maxConfidence = it.value();
+        }
+    }
+    return result;
+}
+
+} // namespace mixxx
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <QVector>
+#include <optional>
+#include <vector>
+
+#include "audio/frame.h"
+#include "audio/types.h"
+#include "track/bpm.h"
+#include "track/keys.h"
+#include "util/indexrange.h"
+
+namespace mixxx {
+
+/// The windows of a track that are analyzed in fast-analysis mode
+/// instead of the whole track.
+///
+/// The windows are centered in equally sized sections of the track,
+/// which avoids the intro and outro that often lack a clear beat or
+/// key. Tracks that are too short for sampling are covered by a single
+/// window.
+class SampledAnalysisWindows {
+  public:
+    SampledAnalysisWindows() = default;
+    SampledAnalysisWindows(
+            audio::SampleRate sampleRate,
+            SINT frameLength,
+            int windowCount,
+            SINT secondsPerWindow);
+
+    int size() const {
+        return static_cast<int>(m_windows.size());
+    }
+
+    const IndexRange& at(int index) const {
+        return m_windows.at(index);
+    }
+
+    /// Returns the number of frames starting at the given index
+    /// that are not covered by any window. All remaining frames
+    /// after the last window can be skipped.
+    SINT framesToSkip(SINT frameIndex) const;
+
+  private:
+    std::vector<IndexRange> m_windows;
+};
+
+/// The tempo detected in a single window. The confidence ranges
+/// from 0 (unusable) to 1.
+struct SampledTempo {
+    Bpm bpm;
+    audio::FramePos firstBeat;
+    double confidence{};
+};
+
+/// Estimates a constant tempo from the beats that have been detected
+/// in a window. The confidence is the fraction of beat intervals that
+/// match the tempo.
+SampledTempo estimateSampledTempo(
+        const QVector<audio::FramePos>& beats,
+        audio::SampleRate sampleRate);
+
+/// Combines the tempos of all windows. Windows with a similar tempo
+/// support each other and the most confident window with the best
+/// support determines the result. The resulting confidence is the
+/// average support across all windows.
+std::optional<SampledTempo> combineSampledTempos(
+        const std::vector<SampledTempo>& tempos);
+
+/// The predominant key detected in a single window. The confidence
+/// ranges from 0 (unusable) to 1.
+struct SampledKey {
+    track::io::key::ChromaticKey key = track::io::key::INVALID;
+    double confidence{};
+};
+
+/// Estimates the predominant key from the key changes that have been
+/// detected in a window, starting at frame 0. The confidence is the
+/// fraction of the window in this key.
+SampledKey estimateSampledKey(
+        const KeyChangeList& keyChanges,
+        SINT windowLength);
+
+/// Combines the keys of all windows by summing up their confidence.
+track::io::key::ChromaticKey combineSampledKeys(
+        const std::vector<SampledKey>& keys);
+
+} // namespace mixxx
@@ -1,8 +1,15 @@
 #include "analyzer/trackanalysisscheduler.h"
 
+#include <algorithm>
+
+#include "analyzer/analyzerbeats.h"
+#include "analyzer/analyzerkey.h"
 #include "analyzer/analyzerscheduledtrack.h"
 #include "analyzer/analyzertrack.h"
 #include "moc_trackanalysisscheduler.cpp"
+#include "preferences/beatdetectionsettings.h"
+#include "preferences/keydetectionsettings.h"
+#include "track/track.h"
 #include "track/trackid.h"
 #include "util/logger.h"
 
@@ -53,6 +60,8 @@ TrackAnalysisScheduler::TrackAnalysisScheduler(
         const UserSettingsPointer& pConfig,
         AnalyzerModeFlags modeFlags)
         : m_pEnvironment(std::move(pEnvironment)),
+          m_pConfig(pConfig),
+          m_deferFullAnalysis(modeFlags & AnalyzerModeFlags::DeferFullAnalysis),
           m_currentTrackProgress(kAnalyzerProgressUnknown),
           m_currentTrackNumber(0),
           m_dequeuedTracksCount(0),
@@ -97,7 +106,7 @@ TrackAnalysisScheduler::~TrackAnalysisScheduler() {
 void TrackAnalysisScheduler::emitProgressOrFinished() {
     // The finished() signal is emitted regardless of when the last
     // signal has been emitted
-    if (allTracksFinished()) {
+    if (allTracksFinished() && allDeferredTracksFinished()) {
         m_currentTrackProgress = kAnalyzerProgressUnknown;
         m_currentTrackNumber = 0;
         m_dequeuedTracksCount = 0;
@@ -112,14 +121,17 @@ void TrackAnalysisScheduler::emitProgressOrFinished() {
     }
     m_lastProgressEmittedAt = now;
 
-    DEBUG_ASSERT(m_pendingTrackIds.size() <=
-            static_cast<size_t>(m_dequeuedTracksCount));
-    const int finishedTracksCount =
-            m_dequeuedTracksCount - static_cast<int>(m_pendingTrackIds.size());
+    const int pendingTracksCount = static_cast<int>(m_pendingTracks.size()) -
+            pendingDeferredTracksCount();
+    DEBUG_ASSERT(pendingTracksCount <= m_dequeuedTracksCount);
+    const int finishedTracksCount = m_dequeuedTracksCount - pendingTracksCount;
 
     AnalyzerProgress workerProgressSum = 0;
     int workerProgressCount = 0;
     for (const auto& worker: m_workers) {
+        if (worker.isDeferredTrackSubmitted()) {
+            continue;
+        }
         const AnalyzerProgress workerProgress = worker.analyzerProgress();
         if (workerProgress >= kAnalyzerProgressNone) {
             workerProgressSum += workerProgress;
@@ -169,8 +181,8 @@ void TrackAnalysisScheduler::emitProgressOrFinished() {
             m_currentTrackNumber = finishedTracksCount;
         }
     }
-    const int totalTracksCount =
-            m_dequeuedTracksCount + static_cast<int>(m_queuedTracks.size());
+    const int totalTracksCount = m_dequeuedTracksCount +
+            static_cast<int>(m_queuedTracks.size());
     DEBUG_ASSERT(m_currentTrackNumber <= m_dequeuedTracksCount);
     DEBUG_ASSERT(m_dequeuedTracksCount <= totalTracksCount);
     emit progress(
@@ -206,7 +218,7 @@ void TrackAnalysisScheduler::onWorkerThreadProgress(
     case AnalyzerThreadState::Busy:
         DEBUG_ASSERT(trackId.isValid());
         // Ignore delayed signals for tracks that are no longer pending
-        if (m_pendingTrackIds.find(trackId) != m_pendingTrackIds.end()) {
+        if (m_pendingTracks.find(trackId) != m_pendingTracks.end()) {
             DEBUG_ASSERT(analyzerProgress != kAnalyzerProgressUnknown);
             DEBUG_ASSERT(analyzerProgress < kAnalyzerProgressDone);
             worker.onAnalyzerProgress(analyzerProgress);
@@ -216,12 +228,16 @@ void TrackAnalysisScheduler::onWorkerThreadProgress(
     case AnalyzerThreadState::Done:
         DEBUG_ASSERT(trackId.isValid());
         // Ignore delayed signals for tracks that are no longer pending
-        if (m_pendingTrackIds.find(trackId) != m_pendingTrackIds.end()) {
+        if (const auto it = m_pendingTracks.find(trackId); it != m_pendingTracks.end()) {
             DEBUG_ASSERT((analyzerProgress == kAnalyzerProgressDone) // success
                     || (analyzerProgress == kAnalyzerProgressUnknown)); // failure
-            m_pendingTrackIds.erase(trackId);
+            const bool fullAnalysis = it->second.fullAnalysis;
+            m_pendingTracks.erase(it);
             worker.onAnalyzerProgress(analyzerProgress);
             emit trackProgress(trackId, analyzerProgress);
+            if (analyzerProgress == kAnalyzerProgressDone && !fullAnalysis) {
+                deferFullAnalysis(trackId);
+            }
         }
         break;
     case AnalyzerThreadState::Exit:
@@ -243,7 +259,12 @@ bool TrackAnalysisScheduler::scheduleTrack(AnalyzerScheduledTrack track) {
                 << track.getTrackId();
         return false;
     }
-    m_queuedTracks.push_back(track);
+    if (track.getOptions().highPriority) {
+        // Preempt all tracks that have been queued before
+        m_queuedTracks.push_front(track);
+    } else {
+        m_queuedTracks.push_back(track);
+    }
     // Don't wake up the suspended thread now to avoid race conditions
     // if multiple threads are added in a row by calling this function
     // multiple times. The caller is responsible to finish the scheduling
@@ -275,10 +296,44 @@ void TrackAnalysisScheduler::resume() {
     }
 }
 
+void TrackAnalysisScheduler::deferFullAnalysis(TrackId trackId) {
+    if (!m_deferFullAnalysis) {
+        return;
+    }
+    if (!BeatDetectionSettings(m_pConfig).getFastAnalysis() &&
+            !KeyDetectionSettings(m_pConfig).getFastAnalysis()) {
+        return;
+    }
+    // Tracks that have been analyzed fully, e.g. because their waveform
+    // has been generated, or whose results have been kept don't need a
+    // second pass.
+    const TrackPointer pTrack = m_pEnvironment->loadTrackById(trackId);
+    if (!pTrack ||
+            (!AnalyzerBeats::hasProvisionalResults(*pTrack) &&
+                    !AnalyzerKey::hasProvisionalResults(*pTrack))) {
+        return;
+    }
+    AnalyzerTrack::Options options;
+    options.fullAnalysis = true;
+    m_deferredTracks.emplace_back(trackId, options);
+}
+
+int TrackAnalysisScheduler::pendingDeferredTracksCount() const {
+    // Only deferred tracks are submitted for a full analysis
+    return static_cast<int>(std::count_if(m_pendingTracks.begin(),
+            m_pendingTracks.end(),
+            [](const auto& pendingTrack) {
+                return pendingTrack.second.fullAnalysis;
+            }));
+}
+
 bool TrackAnalysisScheduler::submitNextTrack(Worker* worker) {
     DEBUG_ASSERT(worker);
-    while (!m_queuedTracks.empty()) {
-        AnalyzerScheduledTrack nextScheduledTrack = m_queuedTracks.front();
+    while (!m_queuedTracks.empty() || !m_deferredTracks.empty()) {
+        // Deferred tracks are only submitted after all queued tracks
+        const bool deferred = m_queuedTracks.empty();
+        auto& tracks = deferred ? m_deferredTracks : m_queuedTracks;
+        AnalyzerScheduledTrack nextScheduledTrack = tracks.front();
         TrackId nextTrackId = nextScheduledTrack.getTrackId();
         DEBUG_ASSERT(nextTrackId.isValid());
         if (nextTrackId.isValid()) {
@@ -286,15 +341,18 @@ bool TrackAnalysisScheduler::submitNextTrack(Worker* worker) {
                     m_pEnvironment->loadTrackById(nextTrackId);
             if (nextTrackPtr) {
                 AnalyzerTrack nextTrack(nextTrackPtr, nextScheduledTrack.getOptions());
-                if (m_pendingTrackIds.insert(nextTrackId).second) {
+                if (m_pendingTracks.emplace(nextTrackId, nextScheduledTrack.getOptions())
+                                .second) {
                     if (worker->submitNextTrack(std::move(nextTrack))) {
-                        m_queuedTracks.pop_front();
-                        ++m_dequeuedTracksCount;
+                        tracks.pop_front();
+                        if (!deferred) {
+                            ++m_dequeuedTracksCount;
+                        }
                         return true;
                     } else {
                         // The worker may already have been assigned new tasks
                         // in the mean time, nothing to worry about.
-                        m_pendingTrackIds.erase(nextTrackId);
+                        m_pendingTracks.erase(nextTrackId);
                         kLogger.debug()
                                 << "Failed to submit next track - worker thread"
                                 << worker->thread()->id()
@@ -319,8 +377,10 @@ bool TrackAnalysisScheduler::submitNextTrack(Worker* worker) {
                     << nextTrackId;
         }
         // Skip this track
-        m_queuedTracks.pop_front();
-        ++m_dequeuedTracksCount;
+        tracks.pop_front();
+        if (!deferred) {
+            ++m_dequeuedTracksCount;
+        }
     }
     return false;
 }
@@ -333,6 +393,7 @@ void TrackAnalysisScheduler::stop() {
     // The worker threads are still running at this point
     // and m_workers must not be modified!
     m_queuedTracks.clear();
-    m_pendingTrackIds.clear();
-    DEBUG_ASSERT((allTracksFinished()));
+    m_deferredTracks.clear();
+    m_pendingTracks.clear();
+    DEBUG_ASSERT(allTracksFinished() && allDeferredTracksFinished());
 }
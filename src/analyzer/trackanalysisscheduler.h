@@ -2,8 +2,8 @@
 
 #include <QList>
 #include <deque>
+#include <map>
 #include <memory>
-#include <set>
 #include <vector>
 
 #include "analyzer/analyzerscheduledtrack.h"
@@ -82,7 +82,8 @@ class TrackAnalysisScheduler : public QObject {
       public:
         explicit Worker(AnalyzerThread::Pointer thread = AnalyzerThread::NullPointer())
             : m_thread(std::move(thread)),
-              m_analyzerProgress(kAnalyzerProgressUnknown) {
+              m_analyzerProgress(kAnalyzerProgressUnknown),
+              m_deferredTrackSubmitted(false) {
         }
         Worker(const Worker&) = delete;
         Worker(Worker&&) = default;
@@ -100,9 +101,18 @@ class TrackAnalysisScheduler : public QObject {
             return m_analyzerProgress;
         }
 
+        // Only deferred tracks are submitted for a full analysis
+        bool isDeferredTrackSubmitted() const {
+            return m_deferredTrackSubmitted;
+        }
+
         bool submitNextTrack(const AnalyzerTrack& track) {
             DEBUG_ASSERT(m_thread);
-            return m_thread->submitNextTrack(std::move(track));
+            if (!m_thread->submitNextTrack(track)) {
+                return false;
+            }
+            m_deferredTrackSubmitted = track.getOptions().fullAnalysis;
+            return true;
         }
 
         void suspendThread() {
@@ -132,30 +142,55 @@ class TrackAnalysisScheduler : public QObject {
             DEBUG_ASSERT(m_thread);
             m_thread.reset();
             m_analyzerProgress = kAnalyzerProgressUnknown;
+            m_deferredTrackSubmitted = false;
         }
 
       private:
         AnalyzerThread::Pointer m_thread;
         AnalyzerProgress m_analyzerProgress;
+        bool m_deferredTrackSubmitted;
     };
 
     bool submitNextTrack(Worker* worker);
     void emitProgressOrFinished();
 
+    // Defers the full analysis of a track that has received provisional
+    // results from a fast analysis.
+    void deferFullAnalysis(TrackId trackId);
+
+    int pendingDeferredTracksCount() const;
+
+    // Deferred tracks are not included, neither here nor in the
+    // progress, because they have not been scheduled by the caller.
     bool allTracksFinished() const {
         return m_queuedTracks.empty() &&
-                m_pendingTrackIds.empty();
+                m_pendingTracks.size() ==
+                static_cast<size_t>(pendingDeferredTracksCount());
+    }
+
+    bool allDeferredTracksFinished() const {
+        return m_deferredTracks.empty() &&
+                pendingDeferredTracksCount() == 0;
     }
 
     const std::unique_ptr<const TrackAnalysisSchedulerEnvironment> m_pEnvironment;
 
+    const UserSettingsPointer m_pConfig;
+
+    const bool m_deferFullAnalysis;
+
     std::vector<Worker> m_workers;
 
     std::deque<AnalyzerScheduledTrack> m_queuedTracks;
 
+    // Tracks for a full analysis with idle priority, i.e. they
+    // are only submitted if no other tracks are queued. Only used
+    // with AnalyzerModeFlags::DeferFullAnalysis.
+    std::deque<AnalyzerScheduledTrack> m_deferredTracks;
+
     // Tracks that have already been submitted to workers
     // and not yet reported back as finished.
-    std::set<TrackId> m_pendingTrackIds;
+    std::map<TrackId, AnalyzerTrack::Options> m_pendingTracks;
 
     AnalyzerProgress m_currentTrackProgress;
 
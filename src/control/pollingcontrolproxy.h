@@ -65,6 +65,11 @@ class PollingControlProxy {
     void set(double v) {
         m_pControl->set(v, nullptr);
     }
+    /// Sets the control value to v, even if the control is read-only.
+    /// Thread safe, non-blocking.
+    void setAndConfirm(double v) {
+        m_pControl->setAndConfirm(v, nullptr);
+    }
     /// Sets the control parameterized value to v. Thread safe, non-blocking.
     void setParameter(double v) {
         m_pControl->setParameter(v, nullptr);
@@ -8,6 +8,8 @@
 #include <QtGlobal>
 #include <gsl/pointers>
 
+#include "analyzer/analysiscache.h"
+
 #ifdef __BROADCAST__
 #include "broadcast/broadcastmanager.h"
 #endif
@@ -47,6 +49,8 @@
 #include "qml/qmlplayermanagerproxy.h"
 #endif
 #include "soundio/soundmanager.h"
+#include "sources/mp3seekindex.h"
+#include "sources/soundsourcepool.h"
 #include "sources/soundsourceproxy.h"
 #include "util/clipboard.h"
 #include "util/db/dbconnectionpooled.h"
@@ -480,6 +484,13 @@ void CoreServices::initialize(QApplication* pApp) {
 
     Sandbox::setPermissionsFilePath(QDir(pConfig->getSettingsPath()).filePath("sandbox.cfg"));
 
+    // Seek tables of MP3 files are stored next to the other analysis data
+    mixxx::Mp3SeekIndexStore::setStorageDirectory(
+            QDir(pConfig->getSettingsPath()).filePath(QStringLiteral("analysis/mp3seek")));
+    // Analysis results are shared by all tracks with identical audio content
+    mixxx::AnalysisCache::setStorageDirectory(
+            QDir(pConfig->getSettingsPath()).filePath(QStringLiteral("analysis/content")));
+
     QString resourcePath = pConfig->getResourcePath();
 
     emit initializationProgressUpdate(0, tr("fonts"));
@@ -932,6 +943,9 @@ void CoreServices::finalize() {
     // PlayerInfo in EngineRecord.
     PlayerInfo::destroy();
 
+    // Close all idle audio files while the decoders are still available
+    mixxx::SoundSourcePool::clear();
+
     qDebug() << t.elapsed(false).debugMillisWithUnit() << "deleting EffectsManager";
     CLEAR_AND_CHECK_DELETED(m_pEffectsManager);
 
@@ -49,6 +49,12 @@ class BalanceEffect : public EffectProcessorImpl<BalanceGroupState> {
             const EffectEnableState enableState,
             const GroupFeatureState& groupFeatures) override;
 
+    SINT getChannelTailFrames(const BalanceGroupState* pState,
+            const mixxx::EngineParameters& engineParameters) override {
+        Q_UNUSED(pState);
+        return filterTailFrames(engineParameters);
+    }
+
   private:
     QString debugString() const {
         return getId();
@@ -34,6 +34,12 @@ class Bessel4LVMixEQEffect : public EffectProcessorImpl<Bessel4LVMixEQEffectGrou
             const EffectEnableState enableState,
             const GroupFeatureState& groupFeatureState) override;
 
+    SINT getChannelTailFrames(const Bessel4LVMixEQEffectGroupState* pState,
+            const mixxx::EngineParameters& engineParameters) override {
+        Q_UNUSED(pState);
+        return filterTailFrames(engineParameters);
+    }
+
   private:
     QString debugString() const {
         return getId();
@@ -35,6 +35,12 @@ class Bessel8LVMixEQEffect : public EffectProcessorImpl<Bessel8LVMixEQEffectGrou
             const EffectEnableState enableState,
             const GroupFeatureState& groupFeatureState) override;
 
+    SINT getChannelTailFrames(const Bessel8LVMixEQEffectGroupState* pState,
+            const mixxx::EngineParameters& engineParameters) override {
+        Q_UNUSED(pState);
+        return filterTailFrames(engineParameters);
+    }
+
   private:
     QString debugString() const {
         return getId();
@@ -71,6 +71,12 @@ class BiquadFullKillEQEffect : public EffectProcessorImpl<BiquadFullKillEQEffect
             const EffectEnableState enableState,
             const GroupFeatureState& groupFeatureState) override;
 
+    SINT getChannelTailFrames(const BiquadFullKillEQEffectGroupState* pState,
+            const mixxx::EngineParameters& engineParameters) override {
+        Q_UNUSED(pState);
+        return filterTailFrames(engineParameters);
+    }
+
     void setFilters(mixxx::audio::SampleRate sampleRate,
             double lowFreqCorner,
             double highFreqCorner);
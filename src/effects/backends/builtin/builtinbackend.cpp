@@ -22,6 +22,7 @@
 #include "effects/backends/builtin/echoeffect.h"
 #include "effects/backends/builtin/glitcheffect.h"
 #include "effects/backends/builtin/loudnesscontoureffect.h"
+#include "effects/backends/builtin/metronomeclick.h"
 #include "effects/backends/builtin/metronomeeffect.h"
 #include "effects/backends/builtin/phasereffect.h"
 #ifdef __RUBBERBAND__
@@ -30,7 +31,12 @@
 #include "effects/backends/builtin/tremoloeffect.h"
 #include "effects/backends/builtin/whitenoiseeffect.h"
 
-BuiltInBackend::BuiltInBackend() {
+BuiltInBackend::BuiltInBackend(const QString& metronomeClickFile) {
+    if (!loadMetronomeClick(metronomeClickFile)) {
+        qWarning() << "Using the built-in metronome click instead of"
+                   << metronomeClickFile;
+    }
+
     // Keep this list in a reasonable order
     // Mixing EQs
     registerEffect<Bessel4LVMixEQEffect>();
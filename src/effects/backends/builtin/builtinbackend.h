@@ -6,7 +6,9 @@
 /// Refer to EffectsBackend for documentation
 class BuiltInBackend : public EffectsBackend {
   public:
-    BuiltInBackend();
+    /// The MetronomeEffect plays the sound of metronomeClickFile instead of
+    /// the built-in click, unless it is empty
+    explicit BuiltInBackend(const QString& metronomeClickFile = QString());
     virtual ~BuiltInBackend();
 
     EffectBackendType getType() const {
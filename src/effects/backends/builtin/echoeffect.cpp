@@ -251,3 +251,12 @@ void EchoEffect::processChannel(
     pGroupState->prev_feedback = feedback_current;
     pGroupState->prev_delay_samples = delay_samples;
 }
+
+SINT EchoEffect::getChannelTailFrames(const EchoGroupState* pState,
+        const mixxx::EngineParameters& engineParameters) {
+    // The delay buffer is fed back once per delay period
+    const SINT delayFrames = pState->prev_delay_samples / engineParameters.channelCount();
+    const double feedback = std::max(pState->prev_feedback,
+            static_cast<CSAMPLE_GAIN>(m_pFeedbackParameter->value()));
+    return feedbackTailFrames(feedback, delayFrames);
+}
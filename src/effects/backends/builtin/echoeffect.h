@@ -62,6 +62,9 @@ class EchoEffect : public EffectProcessorImpl<EchoGroupState> {
             const EffectEnableState enableState,
             const GroupFeatureState& groupFeatures) override;
 
+    SINT getChannelTailFrames(const EchoGroupState* pState,
+            const mixxx::EngineParameters& engineParameters) override;
+
   private:
     QString debugString() const {
         return getId();
@@ -42,6 +42,12 @@ class FilterEffect : public EffectProcessorImpl<FilterGroupState> {
             const EffectEnableState enableState,
             const GroupFeatureState& groupFeatures) override;
 
+    SINT getChannelTailFrames(const FilterGroupState* pState,
+            const mixxx::EngineParameters& engineParameters) override {
+        Q_UNUSED(pState);
+        return filterTailFrames(engineParameters);
+    }
+
   private:
     QString debugString() const {
         return getId();
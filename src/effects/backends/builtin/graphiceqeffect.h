@@ -46,6 +46,12 @@ class GraphicEQEffect : public EffectProcessorImpl<GraphicEQEffectGroupState> {
             const EffectEnableState enableState,
             const GroupFeatureState& groupFeatureState) override;
 
+    SINT getChannelTailFrames(const GraphicEQEffectGroupState* pState,
+            const mixxx::EngineParameters& engineParameters) override {
+        Q_UNUSED(pState);
+        return filterTailFrames(engineParameters);
+    }
+
   private:
     QString debugString() const {
         return getId();
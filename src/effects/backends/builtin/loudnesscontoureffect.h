@@ -46,6 +46,12 @@ class LoudnessContourEffect
             const EffectEnableState enableState,
             const GroupFeatureState& groupFeatureState) override;
 
+    SINT getChannelTailFrames(const LoudnessContourEffectGroupState* pState,
+            const mixxx::EngineParameters& engineParameters) override {
+        Q_UNUSED(pState);
+        return filterTailFrames(engineParameters);
+    }
+
     void setFilters(mixxx::audio::SampleRate sampleRate);
 
   private:
@@ -4379,18 +4379,36 @@ constexpr CSAMPLE kClick96000[] = {
         0.00132f,
         0.00085f,
         0.00021f};
+
+std::shared_ptr<const PreloadedSample>& currentClick() {
+    static std::shared_ptr<const PreloadedSample> s_pClick;
+    return s_pClick;
+}
+
 } // namespace
 
-std::span<const CSAMPLE> clickForSampleRate(mixxx::audio::SampleRate size) {
-    switch (size.value()) {
-    case 44100:
-        return kClick44100;
-    case 48000:
-        return kClick48000;
-    case 96000:
-        return kClick96000;
+std::shared_ptr<const PreloadedSample> metronomeClick() {
+    auto& pClick = currentClick();
+    if (!pClick) {
+        pClick = std::make_shared<const PreloadedSample>(
+                std::initializer_list<PreloadedSample::Recording>{
+                        {mixxx::audio::SampleRate(44100), kClick44100},
+                        {mixxx::audio::SampleRate(48000), kClick48000},
+                        {mixxx::audio::SampleRate(96000), kClick96000}});
+    }
+    return pClick;
+}
+
+bool loadMetronomeClick(const QString& fileName) {
+    if (fileName.isEmpty()) {
+        // Back to the built-in click
+        currentClick().reset();
+        return true;
+    }
+    auto pClick = PreloadedSample::fromFile(fileName);
+    if (!pClick) {
+        return false;
     }
-    DEBUG_ASSERT(!"Metronom click for this sample rate is missing");
-    // should not happen!
-    return {};
+    currentClick() = std::move(pClick);
+    return true;
 }
@@ -1,6 +1,16 @@
 #pragma once
 
-#include "audio/types.h"
-#include "util/span.h"
+#include <QString>
+#include <memory>
 
-std::span<const CSAMPLE> clickForSampleRate(mixxx::audio::SampleRate rate);
+#include "effects/backends/builtin/preloadedsample.h"
+
+/// Returns the click that MetronomeEffects play, prepared for all engine
+/// sample rates. Called from the main thread when a MetronomeEffect is created.
+std::shared_ptr<const PreloadedSample> metronomeClick();
+
+/// Replaces the built-in click with the sound of a file for the
+/// MetronomeEffects created from now on, or restores the built-in click if
+/// fileName is empty. Called from the main thread. Returns false and keeps
+/// the current click if the file could not be read.
+bool loadMetronomeClick(const QString& fileName);
@@ -18,15 +18,6 @@
 
 namespace {
 
-std::size_t playMonoSamplesWithGain(std::span<const CSAMPLE> monoSource,
-        std::span<CSAMPLE> output,
-        CSAMPLE_GAIN gain) {
-    const std::size_t outputBufferFrames = output.size() / mixxx::kEngineChannelOutputCount;
-    std::size_t framesPlayed = std::min(monoSource.size(), outputBufferFrames);
-    SampleUtil::addMonoToStereoWithGain(gain, output.data(), monoSource.data(), framesPlayed);
-    return framesPlayed;
-}
-
 template<class T>
 std::span<T> subspan_clamped(std::span<T> in, typename std::span<T>::size_type offset) {
     // TODO (Swiftb0y): should we instead create a wrapper type that implements
@@ -74,6 +65,10 @@ std::span<CSAMPLE> unsyncedClickOutput(mixxx::audio::SampleRate framesPerSecond,
 
 } // namespace
 
+MetronomeEffect::MetronomeEffect()
+        : m_pClick(metronomeClick()) {
+}
+
 // static
 QString MetronomeEffect::getId() {
     return QStringLiteral("org.mixxx.effects.metronome");
@@ -149,7 +144,7 @@ void MetronomeEffect::processChannel(
 
     MetronomeGroupState* gs = pGroupState;
 
-    const std::span<const CSAMPLE> click = clickForSampleRate(engineParameters.sampleRate());
+    const std::span<const CSAMPLE> click = m_pClick->forSampleRate(engineParameters.sampleRate());
 
     if (pOutput != pInput) {
         SampleUtil::copy(pOutput, pInput, engineParameters.samplesPerBuffer());
@@ -170,7 +165,8 @@ void MetronomeEffect::processChannel(
 
     const CSAMPLE_GAIN gain = db2ratio(static_cast<float>(m_pGainParameter->value()));
 
-    playMonoSamplesWithGain(subspan_clamped(click, gs->framesSinceLastClick), output, gain);
+    PreloadedSample::addToStereoWithGain(
+            subspan_clamped(click, gs->framesSinceLastClick), output, gain);
     gs->framesSinceLastClick += engineParameters.framesPerBuffer();
 
     std::span<CSAMPLE> outputBufferOffset = shouldSync && hasBeatInfo
@@ -186,6 +182,7 @@ void MetronomeEffect::processChannel(
                       output);
 
     if (!outputBufferOffset.empty()) {
-        gs->framesSinceLastClick = playMonoSamplesWithGain(click, outputBufferOffset, gain);
+        gs->framesSinceLastClick = PreloadedSample::addToStereoWithGain(
+                click, outputBufferOffset, gain);
     }
 }
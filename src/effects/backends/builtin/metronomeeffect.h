@@ -1,7 +1,9 @@
 #pragma once
 
 #include <QMap>
+#include <memory>
 
+#include "effects/backends/builtin/preloadedsample.h"
 #include "effects/backends/effectprocessor.h"
 #include "util/class.h"
 #include "util/types.h"
@@ -17,7 +19,7 @@ class MetronomeGroupState final : public EffectState {
 
 class MetronomeEffect : public EffectProcessorImpl<MetronomeGroupState> {
   public:
-    MetronomeEffect() = default;
+    MetronomeEffect();
     ~MetronomeEffect() override = default;
 
     static QString getId();
@@ -35,6 +37,7 @@ class MetronomeEffect : public EffectProcessorImpl<MetronomeGroupState> {
             const GroupFeatureState& groupFeatures) override;
 
   private:
+    const std::shared_ptr<const PreloadedSample> m_pClick;
     EngineEffectParameterPointer m_pBpmParameter;
     EngineEffectParameterPointer m_pSyncParameter;
     EngineEffectParameterPointer m_pGainParameter;
@@ -0,0 +1,192 @@
+#include "effects/backends/builtin/preloadedsample.h"
+
+#include <QUrl>
+#include <algorithm>
+#include <cmath>
+
+#include "engine/engine.h"
+#include "sources/soundsourcesndfile.h"
+#include "util/assert.h"
+#include "util/math.h"
+#include "util/sample.h"
+#include "util/samplebuffer.h"
+
+namespace {
+
+// All sample rates the engine may run at, including those only offered by
+// JACK. Other rates play the variant with the closest rate.
+constexpr mixxx::audio::SampleRate kEngineSampleRates[] = {
+        mixxx::audio::SampleRate(22050),
+        mixxx::audio::SampleRate(32000),
+        mixxx::audio::SampleRate(44100),
+        mixxx::audio::SampleRate(48000),
+        mixxx::audio::SampleRate(88200),
+        mixxx::audio::SampleRate(96000),
+        mixxx::audio::SampleRate(176400),
+        mixxx::audio::SampleRate(192000),
+};
+
+// Limits the memory of the variants of sounds loaded from a file
+constexpr double kMaxFileDurationSeconds = 2.0;
+
+// Half the length of the windowed sinc kernel in zero crossings
+constexpr double kSincZeroCrossings = 16.0;
+
+double sinc(double x) {
+    if (x == 0) {
+        return 1.0;
+    }
+    return std::sin(M_PI * x) / (M_PI * x);
+}
+
+/// Band limited resampling with a Blackman windowed sinc kernel. This is
+/// only done once in the main thread, so precision matters more than speed.
+std::vector<CSAMPLE> resample(std::span<const CSAMPLE> source,
+        mixxx::audio::SampleRate sourceRate,
+        mixxx::audio::SampleRate targetRate) {
+    const double ratio = targetRate.toDouble() / sourceRate.toDouble();
+    // Lower the cutoff below the target Nyquist frequency when downsampling
+    const double cutoff = std::min(1.0, ratio);
+    const double halfWidth = kSincZeroCrossings / cutoff;
+    const auto sourceSize = static_cast<SINT>(source.size());
+
+    std::vector<CSAMPLE> target(
+            (source.size() * targetRate.value() + sourceRate.value() - 1) /
+            sourceRate.value());
+    for (std::size_t i = 0; i < target.size(); ++i) {
+        const double center = i / ratio;
+        const auto first = std::max(SINT{0},
+                static_cast<SINT>(std::ceil(center - halfWidth)));
+        const auto last = std::min(sourceSize - 1,
+                static_cast<SINT>(std::floor(center + halfWidth)));
+        double sum = 0;
+        for (SINT j = first; j <= last; ++j) {
+            const double x = j - center;
+            const double window = 0.42 +
+                    0.5 * std::cos(M_PI * x / halfWidth) +
+                    0.08 * std::cos(2 * M_PI * x / halfWidth);
+            sum += source[static_cast<std::size_t>(j)] * cutoff * sinc(cutoff * x) * window;
+        }
+        target[i] = static_cast<CSAMPLE>(sum);
+    }
+    return target;
+}
+
+} // namespace
+
+PreloadedSample::PreloadedSample(std::initializer_list<Recording> recordings) {
+    VERIFY_OR_DEBUG_ASSERT(recordings.size() > 0) {
+        return;
+    }
+    m_variants.reserve(std::size(kEngineSampleRates) + recordings.size());
+    for (const auto& recording : recordings) {
+        m_variants.push_back(Variant{recording.sampleRate,
+                std::vector<CSAMPLE>(recording.samples.begin(), recording.samples.end())});
+    }
+    for (const auto sampleRate : kEngineSampleRates) {
+        const auto hasSampleRate = [sampleRate](const Recording& recording) {
+            return recording.sampleRate == sampleRate;
+        };
+        if (std::any_of(recordings.begin(), recordings.end(), hasSampleRate)) {
+            continue;
+        }
+        // Prefer downsampling the closest higher sample rate, which loses
+        // nothing, over upsampling a recording without high frequencies
+        const Recording* pHigher = nullptr;
+        const Recording* pLower = nullptr;
+        for (const auto& recording : recordings) {
+            if (recording.sampleRate > sampleRate) {
+                if (!pHigher || recording.sampleRate < pHigher->sampleRate) {
+                    pHigher = &recording;
+                }
+            } else if (!pLower || recording.sampleRate > pLower->sampleRate) {
+                pLower = &recording;
+            }
+        }
+        const Recording* pSource = pHigher ? pHigher : pLower;
+        m_variants.push_back(Variant{sampleRate,
+                resample(pSource->samples, pSource->sampleRate, sampleRate)});
+    }
+    std::sort(m_variants.begin(),
+            m_variants.end(),
+            [](const Variant& lhs, const Variant& rhs) {
+                return lhs.sampleRate < rhs.sampleRate;
+            });
+}
+
+// static
+std::shared_ptr<const PreloadedSample> PreloadedSample::fromFile(const QString& fileName) {
+    mixxx::SoundSourceSndFile soundSource(QUrl::fromLocalFile(fileName));
+    if (soundSource.open(mixxx::AudioSource::OpenMode::Strict) !=
+            mixxx::AudioSource::OpenResult::Succeeded) {
+        qWarning() << "Failed to open sample" << fileName;
+        return nullptr;
+    }
+    const mixxx::audio::SignalInfo signalInfo = soundSource.getSignalInfo();
+    const SINT maxFrames = static_cast<SINT>(
+            kMaxFileDurationSeconds * signalInfo.getSampleRate().toDouble());
+    if (soundSource.frameIndexRange().length() > maxFrames) {
+        qWarning() << "Only using the first" << kMaxFileDurationSeconds
+                   << "seconds of sample" << fileName;
+    }
+    const auto frameIndexRange = mixxx::IndexRange::forward(
+            soundSource.frameIndexRange().start(),
+            std::min(soundSource.frameIndexRange().length(), maxFrames));
+    mixxx::SampleBuffer sampleBuffer(signalInfo.frames2samples(frameIndexRange.length()));
+    const auto readableSampleFrames = soundSource.readSampleFrames(
+            mixxx::WritableSampleFrames(
+                    frameIndexRange,
+                    mixxx::SampleBuffer::WritableSlice(sampleBuffer)));
+    const SINT frames = readableSampleFrames.frameIndexRange().length();
+    if (frames == 0) {
+        qWarning() << "Failed to read sample" << fileName;
+        return nullptr;
+    }
+
+    const int channelCount = signalInfo.getChannelCount();
+    const CSAMPLE* pSamples = readableSampleFrames.readableData();
+    std::vector<CSAMPLE> mono(frames);
+    for (SINT i = 0; i < frames; ++i) {
+        CSAMPLE sum = CSAMPLE_ZERO;
+        for (int channel = 0; channel < channelCount; ++channel) {
+            sum += pSamples[i * channelCount + channel];
+        }
+        mono[i] = sum / channelCount;
+    }
+    return std::make_shared<const PreloadedSample>(
+            std::initializer_list<Recording>{
+                    Recording{signalInfo.getSampleRate(), mono}});
+}
+
+std::span<const CSAMPLE> PreloadedSample::forSampleRate(
+        mixxx::audio::SampleRate sampleRate) const {
+    const Variant* pClosest = nullptr;
+    for (const auto& variant : m_variants) {
+        if (variant.sampleRate == sampleRate) {
+            return variant.samples;
+        }
+        if (!pClosest ||
+                std::abs(static_cast<double>(variant.sampleRate) - sampleRate) <
+                        std::abs(static_cast<double>(pClosest->sampleRate) -
+                                sampleRate)) {
+            pClosest = &variant;
+        }
+    }
+    if (!pClosest) {
+        return {};
+    }
+    return pClosest->samples;
+}
+
+// static
+std::size_t PreloadedSample::addToStereoWithGain(std::span<const CSAMPLE> samples,
+        std::span<CSAMPLE> output,
+        CSAMPLE_GAIN gain) {
+    const std::size_t outputFrames = output.size() / mixxx::kEngineChannelOutputCount;
+    const std::size_t framesPlayed = std::min(samples.size(), outputFrames);
+    SampleUtil::addMonoToStereoWithGain(gain,
+            output.data(),
+            samples.data(),
+            static_cast<SINT>(framesPlayed));
+    return framesPlayed;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <QString>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+#include "audio/types.h"
+#include "util/span.h"
+#include "util/types.h"
+
+/// PreloadedSample holds a short mono sound that an effect plays into its
+/// output, like the click of the MetronomeEffect. It is prepared in the
+/// main thread for all sample rates the engine may run at, so the audio
+/// thread neither reads files nor resamples and only mixes the matching
+/// variant into its buffer.
+class PreloadedSample {
+  public:
+    /// The sound as recorded at a sample rate
+    struct Recording {
+        mixxx::audio::SampleRate sampleRate;
+        std::span<const CSAMPLE> samples;
+    };
+
+    /// Uses the recordings as they are for their sample rates and resamples
+    /// the closest recording for the other sample rates.
+    explicit PreloadedSample(std::initializer_list<Recording> recordings);
+
+    /// Called from the main thread. Decodes the file and mixes it down to
+    /// mono. Returns nullptr if the file could not be read.
+    static std::shared_ptr<const PreloadedSample> fromFile(const QString& fileName);
+
+    /// Called from the audio thread. Returns the variant for the sample
+    /// rate or, for an unusual sample rate, the one with the closest rate.
+    std::span<const CSAMPLE> forSampleRate(mixxx::audio::SampleRate sampleRate) const;
+
+    /// Called from the audio thread. Adds as much of the samples as fits
+    /// to both channels of the stereo output and returns the number of
+    /// frames that have been played.
+    static std::size_t addToStereoWithGain(std::span<const CSAMPLE> samples,
+            std::span<CSAMPLE> output,
+            CSAMPLE_GAIN gain);
+
+  private:
+    struct Variant {
+        mixxx::audio::SampleRate sampleRate;
+        std::vector<CSAMPLE> samples;
+    };
+
+    // Sorted by sample rate
+    std::vector<Variant> m_variants;
+};
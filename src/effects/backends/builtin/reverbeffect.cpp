@@ -66,6 +66,19 @@ EffectManifestPointer ReverbEffect::getManifest() {
     send->setDefaultLinkInversion(EffectManifestParameter::LinkInversion::NotInverted);
     send->setRange(0, 0, 1);
 
+    EffectManifestParameterPointer quality = pManifest->addParameter();
+    quality->setId("quality");
+    quality->setName(QObject::tr("Quality"));
+    quality->setShortName(QObject::tr("Quality"));
+    quality->setDescription(QObject::tr(
+            "High quality modulates the reverberations for a smoother sound.\n"
+            "Economy needs less CPU time."));
+    quality->setValueScaler(EffectManifestParameter::ValueScaler::Toggle);
+    quality->setUnitsHint(EffectManifestParameter::UnitsHint::Unknown);
+    quality->setRange(0, 1, 1);
+    quality->appendStep(qMakePair(QObject::tr("Economy"), 0.0));
+    quality->appendStep(qMakePair(QObject::tr("High"), 1.0));
+
     return pManifest;
 }
 
@@ -75,6 +88,7 @@ void ReverbEffect::loadEngineEffectParameters(
     m_pBandWidthParameter = parameters.value("bandwidth");
     m_pDampingParameter = parameters.value("damping");
     m_pSendParameter = parameters.value("send_amount");
+    m_pQualityParameter = parameters.value("quality");
 }
 
 void ReverbEffect::processChannel(
@@ -107,7 +121,8 @@ void ReverbEffect::processChannel(
             decay,
             damping,
             sendCurrent,
-            pState->sendPrevious);
+            pState->sendPrevious,
+            m_pQualityParameter->toBool());
 
     // The ramping of the send parameter handles ramping when enabling, so
     // this effect must handle ramping to dry when disabling itself (instead
@@ -119,3 +134,18 @@ void ReverbEffect::processChannel(
         pState->sendPrevious = sendCurrent;
     }
 }
+
+SINT ReverbEffect::getChannelTailFrames(const ReverbGroupState* pState,
+        const mixxx::EngineParameters& engineParameters) {
+    Q_UNUSED(pState);
+    // Each half of the plate tank delays by about 0.36 s and attenuates
+    // by the decay twice. The allpass diffusers smear the input over up to
+    // 2 s, even without decay.
+    constexpr double kTankHalfSeconds = 0.36;
+    constexpr double kDiffusionSeconds = 2;
+    // Scaled like in MixxxPlateX2::processBuffer()
+    const double decay = 0.89 * m_pDecayParameter->value();
+    return feedbackTailFrames(decay * decay,
+                   static_cast<SINT>(kTankHalfSeconds * engineParameters.sampleRate())) +
+            static_cast<SINT>(kDiffusionSeconds * engineParameters.sampleRate());
+}
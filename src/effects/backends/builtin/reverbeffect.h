@@ -49,6 +49,9 @@ class ReverbEffect : public EffectProcessorImpl<ReverbGroupState> {
             const EffectEnableState enableState,
             const GroupFeatureState& groupFeatures) override;
 
+    SINT getChannelTailFrames(const ReverbGroupState* pState,
+            const mixxx::EngineParameters& engineParameters) override;
+
   private:
     QString debugString() const {
         return getId();
@@ -58,6 +61,7 @@ class ReverbEffect : public EffectProcessorImpl<ReverbGroupState> {
     EngineEffectParameterPointer m_pBandWidthParameter;
     EngineEffectParameterPointer m_pDampingParameter;
     EngineEffectParameterPointer m_pSendParameter;
+    EngineEffectParameterPointer m_pQualityParameter;
 
     DISALLOW_COPY_AND_ASSIGN(ReverbEffect);
 };
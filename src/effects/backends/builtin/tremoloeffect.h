@@ -41,6 +41,14 @@ class TremoloEffect : public EffectProcessorImpl<TremoloState> {
             const EffectEnableState enableState,
             const GroupFeatureState& groupFeatures) override;
 
+    SINT getChannelTailFrames(const TremoloState* pState,
+            const mixxx::EngineParameters& engineParameters) override {
+        Q_UNUSED(pState);
+        Q_UNUSED(engineParameters);
+        // The input is only scaled by the modulated gain
+        return 0;
+    }
+
   private:
     QString debugString() const {
         return getId();
@@ -4,6 +4,8 @@
 #include <QHash>
 #include <QPair>
 #include <QString>
+#include <cmath>
+#include <limits>
 
 #include "effects/defs.h"
 #include "engine/channelhandle.h"
@@ -110,6 +112,46 @@ class EffectProcessor {
     /// the dry signal is delayed to overlap with the output wet signal
     /// after processing all effects in the effects chain.
     virtual SINT getGroupDelayFrames() = 0;
+
+    /// Returned by getTailFrames() if the output may not become silent
+    /// after the input became silent, e.g. for generators or effects with
+    /// unbounded feedback.
+    static constexpr SINT kInfiniteTailFrames = std::numeric_limits<SINT>::max();
+
+    /// Called from the audio thread
+    /// Returns the number of frames after which the output for the channel
+    /// has decayed to silence, when the input stays silent from now on.
+    /// The EngineEffectChain skips processing all its effects once its input
+    /// has been digital silence for longer than their summed up tails.
+    /// While skipped, the effect is neither processed nor informed.
+    virtual SINT getTailFrames(const ChannelHandle& inputHandle,
+            const ChannelHandle& outputHandle,
+            const mixxx::EngineParameters& engineParameters) = 0;
+
+  protected:
+    /// Level below which a decaying tail is considered silent (-100 dBFS)
+    static constexpr double kTailSilenceThreshold = 0.00001;
+
+    /// Returns the tail of a feedback loop, that delays its input by
+    /// loopFrames and attenuates it by loopGain on every round trip.
+    static SINT feedbackTailFrames(double loopGain, SINT loopFrames) {
+        if (loopGain >= 1) {
+            return kInfiniteTailFrames;
+        }
+        if (loopGain <= kTailSilenceThreshold) {
+            return loopFrames;
+        }
+        const auto roundTrips = static_cast<SINT>(
+                std::ceil(std::log(kTailSilenceThreshold) / std::log(loopGain)));
+        return (roundTrips + 1) * loopFrames;
+    }
+
+    /// Returns a tail, that covers the ringing of the IIRs of the EQ and
+    /// filter effects. The slowest one, the Filter effect at 13 Hz with a
+    /// resonance of 4, decays below kTailSilenceThreshold in about 1.3 s.
+    static SINT filterTailFrames(const mixxx::EngineParameters& engineParameters) {
+        return 2 * static_cast<SINT>(engineParameters.sampleRate().value());
+    }
 };
 
 /// EffectProcessorImpl manages a separate EffectState for every combination of
@@ -148,6 +190,27 @@ class EffectProcessorImpl : public EffectProcessor {
         return 0;
     }
 
+    /// By default, an effect is assumed to never become silent, so chains
+    /// with it are always processed. Effects with a bounded tail should
+    /// override this method and report it for the given channel state.
+    virtual SINT getChannelTailFrames(const EffectSpecificState* pState,
+            const mixxx::EngineParameters& engineParameters) {
+        Q_UNUSED(pState);
+        Q_UNUSED(engineParameters);
+        return kInfiniteTailFrames;
+    }
+
+    SINT getTailFrames(const ChannelHandle& inputHandle,
+            const ChannelHandle& outputHandle,
+            const mixxx::EngineParameters& engineParameters) final {
+        const EffectSpecificState* pState =
+                m_channelStateMatrix[inputHandle][outputHandle].get();
+        VERIFY_OR_DEBUG_ASSERT(pState != nullptr) {
+            return kInfiniteTailFrames;
+        }
+        return getChannelTailFrames(pState, engineParameters);
+    }
+
     void process(const ChannelHandle& inputHandle,
             const ChannelHandle& outputHandle,
             const CSAMPLE* pInput,
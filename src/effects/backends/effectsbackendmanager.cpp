@@ -12,17 +12,22 @@
 #endif
 #include "effects/presets/effectpreset.h"
 
-EffectsBackendManager::EffectsBackendManager() {
+EffectsBackendManager::EffectsBackendManager(UserSettingsPointer pConfig) {
     m_pNumEffectsAvailable = std::make_unique<ControlObject>(
             ConfigKey("[Master]", "num_effectsavailable"));
     m_pNumEffectsAvailable->setReadOnly();
 
-    addBackend(EffectsBackendPointer(new BuiltInBackend()));
+    // A custom click sound for the metronome, decoded here because the
+    // engine thread must not read files
+    addBackend(EffectsBackendPointer(new BuiltInBackend(pConfig->getValueString(
+            ConfigKey("[Effects]", "MetronomeClickFile")))));
 #ifdef __AU_EFFECTS__
     addBackend(createAudioUnitBackend());
 #endif
 #ifdef __LILV__
-    addBackend(EffectsBackendPointer(new LV2Backend()));
+    // Processing LV2 plugins outside of the engine callback requires a restart
+    addBackend(EffectsBackendPointer(new LV2Backend(pConfig->getValue(
+            ConfigKey("[Effects]", "LV2WorkerThread"), false))));
 #endif
 }
 
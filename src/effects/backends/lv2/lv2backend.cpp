@@ -3,9 +3,14 @@
 #include <lv2/units/units.h>
 
 #include "effects/backends/lv2/lv2effectprocessor.h"
+#include "effects/backends/lv2/lv2effectworker.h"
 #include "effects/backends/lv2/lv2manifest.h"
 
-LV2Backend::LV2Backend() {
+LV2Backend::LV2Backend(bool runOnWorkerThread) {
+    if (runOnWorkerThread) {
+        // Shared with the processors, which may outlive the backend
+        m_pWorker = std::make_shared<LV2EffectWorker>();
+    }
     m_pWorld = lilv_world_new();
     initializeProperties();
     lilv_world_load_all(m_pWorld);
@@ -92,7 +97,7 @@ std::unique_ptr<EffectProcessor> LV2Backend::createProcessor(
     VERIFY_OR_DEBUG_ASSERT(pLV2Manifest) {
         return nullptr;
     }
-    return std::make_unique<LV2EffectProcessor>(pLV2Manifest);
+    return std::make_unique<LV2EffectProcessor>(pLV2Manifest, m_pWorker);
 }
 
 LV2EffectManifestPointer LV2Backend::getLV2Manifest(const QString& effectId) const {
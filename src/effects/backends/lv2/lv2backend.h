@@ -2,14 +2,20 @@
 
 #include <lilv/lilv.h>
 
+#include <memory>
+
 #include "effects/backends/effectsbackend.h"
 #include "effects/backends/lv2/lv2manifest.h"
 #include "effects/defs.h"
 
+class LV2EffectWorker;
+
 /// Refer to EffectsBackend for documentation
 class LV2Backend : public EffectsBackend {
   public:
-    LV2Backend();
+    /// With runOnWorkerThread all LV2 plugins are processed on a shared
+    /// LV2EffectWorker at the cost of one buffer of latency.
+    explicit LV2Backend(bool runOnWorkerThread);
     virtual ~LV2Backend();
 
     EffectBackendType getType() const {
@@ -31,6 +37,7 @@ class LV2Backend : public EffectsBackend {
     LilvWorld* m_pWorld;
     QHash<QString, LilvNode*> m_properties;
     QHash<QString, LV2EffectManifestPointer> m_registeredEffects;
+    std::shared_ptr<LV2EffectWorker> m_pWorker;
 
     QString debugString() const {
         return "LV2Backend";
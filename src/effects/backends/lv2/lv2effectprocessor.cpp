@@ -2,13 +2,17 @@
 
 #include "engine/effects/engineeffectparameter.h"
 #include "util/defs.h"
+#include "util/sample.h"
 
-LV2EffectProcessor::LV2EffectProcessor(LV2EffectManifestPointer pManifest)
+LV2EffectProcessor::LV2EffectProcessor(LV2EffectManifestPointer pManifest,
+        std::shared_ptr<LV2EffectWorker> pWorker)
         : m_pManifest(pManifest),
           m_LV2parameters(nullptr),
           m_pPlugin(pManifest->getPlugin()),
           m_audioPortIndices(pManifest->getAudioPortIndices()),
-          m_controlPortIndices(pManifest->getControlPortIndices()) {
+          m_controlPortIndices(pManifest->getControlPortIndices()),
+          m_pWorker(std::move(pWorker)),
+          m_groupDelayFrames(0) {
     m_inputL = new float[kMaxEngineSamples];
     m_inputR = new float[kMaxEngineSamples];
     m_outputL = new float[kMaxEngineSamples];
@@ -48,6 +52,11 @@ void LV2EffectProcessor::processChannel(
         const GroupFeatureState& groupFeatures) {
     Q_UNUSED(groupFeatures);
 
+    if (m_pWorker) {
+        processChannelOnWorker(channelState, pInput, pOutput, engineParameters, enableState);
+        return;
+    }
+
     for (int i = 0; i < m_engineEffectParameters.size(); i++) {
         m_LV2parameters[i] = static_cast<float>(m_engineEffectParameters[i]->value());
     }
@@ -78,6 +87,35 @@ void LV2EffectProcessor::processChannel(
     }
 }
 
+void LV2EffectProcessor::processChannelOnWorker(
+        LV2EffectGroupState* channelState,
+        const CSAMPLE* pInput,
+        CSAMPLE* pOutput,
+        const mixxx::EngineParameters& engineParameters,
+        const EffectEnableState enableState) {
+    const SINT framesPerBuffer = engineParameters.framesPerBuffer();
+    // The output is the result of the previous callback
+    if (m_groupDelayFrames.load(std::memory_order_relaxed) != framesPerBuffer) {
+        m_groupDelayFrames.store(framesPerBuffer, std::memory_order_relaxed);
+    }
+
+    LV2EffectInstance* pInstance = channelState->workerInstance();
+    VERIFY_OR_DEBUG_ASSERT(pInstance) {
+        SampleUtil::clear(pOutput, engineParameters.samplesPerBuffer());
+        return;
+    }
+    for (int i = 0; i < m_engineEffectParameters.size(); i++) {
+        m_LV2parameters[i] = static_cast<float>(m_engineEffectParameters[i]->value());
+    }
+    pInstance->process(m_pWorker.get(),
+            pInput,
+            pOutput,
+            framesPerBuffer,
+            mixxx::spanutil::spanFromPtrLen(m_LV2parameters,
+                    m_engineEffectParameters.size()),
+            enableState);
+}
+
 LV2EffectGroupState* LV2EffectProcessor::createSpecificState(
         const mixxx::EngineParameters& engineParameters) {
     LV2EffectGroupState* pState = new LV2EffectGroupState(engineParameters);
@@ -90,7 +128,18 @@ LV2EffectGroupState* LV2EffectProcessor::createSpecificState(
         qDebug() << this << "LV2EffectProcessor creating LV2EffectGroupState" << pState;
     }
 
-    if (pInstance) {
+    if (m_pWorker) {
+        // Each state gets its own buffers, because the worker processes
+        // them concurrently to the audio thread. The worker connects the
+        // ports before running the instance.
+        pState->createWorkerInstance(m_audioPortIndices, m_controlPortIndices);
+        // Only before the first buffer has been processed, which
+        // reveals the actual buffer size
+        SINT noGroupDelayFrames = 0;
+        m_groupDelayFrames.compare_exchange_strong(noGroupDelayFrames,
+                engineParameters.framesPerBuffer(),
+                std::memory_order_relaxed);
+    } else if (pInstance) {
         for (int i = 0; i < m_engineEffectParameters.size(); i++) {
             m_LV2parameters[i] = static_cast<float>(m_engineEffectParameters[i]->value());
             lilv_instance_connect_port(pInstance,
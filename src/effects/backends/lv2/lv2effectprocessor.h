@@ -2,7 +2,11 @@
 
 #include <lilv/lilv.h>
 
+#include <atomic>
+#include <memory>
+
 #include "effects/backends/effectprocessor.h"
+#include "effects/backends/lv2/lv2effectworker.h"
 #include "effects/backends/lv2/lv2manifest.h"
 #include "effects/defs.h"
 #include "engine/engine.h"
@@ -16,8 +20,14 @@ class LV2EffectGroupState final : public EffectState {
     }
 
     ~LV2EffectGroupState() override {
-        if (m_pInstance) {
+        if (m_pWorkerInstance) {
+            // Waits for the worker and deactivates the instance if the
+            // worker has activated it
+            m_pWorkerInstance.reset();
+        } else if (m_pInstance) {
             lilv_instance_deactivate(m_pInstance);
+        }
+        if (m_pInstance) {
             lilv_instance_free(m_pInstance);
         }
     }
@@ -31,13 +41,27 @@ class LV2EffectGroupState final : public EffectState {
         return m_pInstance;
     }
 
+    /// Only for plugins that run on the LV2EffectWorker
+    void createWorkerInstance(const QList<int>& audioPortIndices,
+            const QList<int>& controlPortIndices) {
+        m_pWorkerInstance = std::make_unique<LV2EffectInstance>(
+                m_pInstance, audioPortIndices, controlPortIndices);
+    }
+
+    LV2EffectInstance* workerInstance() const {
+        return m_pWorkerInstance.get();
+    }
+
   private:
     LilvInstance* m_pInstance;
+    std::unique_ptr<LV2EffectInstance> m_pWorkerInstance;
 };
 
 class LV2EffectProcessor final : public EffectProcessorImpl<LV2EffectGroupState> {
   public:
-    LV2EffectProcessor(LV2EffectManifestPointer pManifest);
+    /// If pWorker is set, the plugin runs on the worker thread
+    LV2EffectProcessor(LV2EffectManifestPointer pManifest,
+            std::shared_ptr<LV2EffectWorker> pWorker);
     ~LV2EffectProcessor() override;
 
     void loadEngineEffectParameters(
@@ -51,10 +75,21 @@ class LV2EffectProcessor final : public EffectProcessorImpl<LV2EffectGroupState>
             const EffectEnableState enableState,
             const GroupFeatureState& groupFeatures) override;
 
+    SINT getGroupDelayFrames() override {
+        return m_groupDelayFrames.load(std::memory_order_relaxed);
+    }
+
   private:
     LV2EffectGroupState* createSpecificState(
             const mixxx::EngineParameters& engineParameters) override;
 
+    void processChannelOnWorker(
+            LV2EffectGroupState* channelState,
+            const CSAMPLE* pInput,
+            CSAMPLE* pOutput,
+            const mixxx::EngineParameters& engineParameters,
+            const EffectEnableState enableState);
+
     LV2EffectManifestPointer m_pManifest;
     QList<EngineEffectParameterPointer> m_engineEffectParameters;
     float* m_inputL;
@@ -65,4 +100,8 @@ class LV2EffectProcessor final : public EffectProcessorImpl<LV2EffectGroupState>
     const LilvPlugin* m_pPlugin;
     const QList<int> m_audioPortIndices;
     const QList<int> m_controlPortIndices;
+    const std::shared_ptr<LV2EffectWorker> m_pWorker;
+    // One buffer on the worker, set when creating the states and only
+    // updated if the engine processes buffers of a different size
+    std::atomic<SINT> m_groupDelayFrames;
 };
@@ -0,0 +1,245 @@
+#include "effects/backends/lv2/lv2effectworker.h"
+
+#ifdef __LINUX__
+#include <pthread.h>
+#endif
+
+#include <QtDebug>
+#include <algorithm>
+
+#include "moc_lv2effectworker.cpp"
+#include "util/assert.h"
+#include "util/counter.h"
+#include "util/defs.h"
+#include "util/sample.h"
+
+LV2EffectJob::LV2EffectJob(LV2EffectInstance* pInstance, int parameterCount)
+        : pInstance(pInstance),
+          inputL(kMaxEngineFrames),
+          inputR(kMaxEngineFrames),
+          outputL(kMaxEngineFrames),
+          outputR(kMaxEngineFrames),
+          parameters(parameterCount),
+          frames(0),
+          deactivate(false),
+          busy(false),
+          pNextSubmitted(nullptr) {
+}
+
+LV2EffectInstance::LV2EffectInstance(LilvInstance* pInstance,
+        const QList<int>& audioPortIndices,
+        const QList<int>& controlPortIndices)
+        : m_pInstance(pInstance),
+          m_audioPortIndices(audioPortIndices),
+          m_controlPortIndices(controlPortIndices),
+          m_nextJobIndex(0),
+          m_previousJobSubmitted(false),
+          m_pConnectedJob(nullptr),
+          m_active(false) {
+    DEBUG_ASSERT(m_pInstance);
+    DEBUG_ASSERT(m_audioPortIndices.size() >= 4);
+    for (auto& pJob : m_jobs) {
+        pJob = std::make_unique<LV2EffectJob>(this, m_controlPortIndices.size());
+    }
+}
+
+LV2EffectInstance::~LV2EffectInstance() {
+    waitForJobs();
+    // The worker is done with the instance, so it may be deactivated here
+    if (m_active) {
+        lilv_instance_deactivate(m_pInstance);
+        m_active = false;
+    }
+}
+
+void LV2EffectInstance::waitForJobs() const {
+    for (const auto& pJob : m_jobs) {
+        while (pJob->busy.load(std::memory_order_acquire)) {
+            QThread::yieldCurrentThread();
+        }
+    }
+}
+
+void LV2EffectInstance::process(LV2EffectWorker* pWorker,
+        const CSAMPLE* pInput,
+        CSAMPLE* pOutput,
+        SINT frames,
+        std::span<const float> parameters,
+        EffectEnableState enableState) {
+    LV2EffectJob* pPreviousJob = m_previousJobSubmitted
+            ? m_jobs[1 - m_nextJobIndex].get()
+            : nullptr;
+    if (pPreviousJob && pPreviousJob->busy.load(std::memory_order_acquire)) {
+        // The worker has missed the deadline. Its result must not be
+        // played one buffer late in the next callback.
+        static Counter s_deadlineMissedCounter(
+                QStringLiteral("LV2EffectWorker deadline missed"));
+        s_deadlineMissedCounter.increment();
+        pPreviousJob = nullptr;
+    }
+    // After enabling, the previous job contains the output from before
+    // disabling
+    if (pPreviousJob &&
+            pPreviousJob->frames == frames &&
+            enableState != EffectEnableState::Enabling) {
+        // note: LOOP VECTORIZED.
+        for (SINT i = 0; i < frames; ++i) {
+            pOutput[i * 2] = pPreviousJob->outputL[i];
+            pOutput[i * 2 + 1] = pPreviousJob->outputR[i];
+        }
+    } else {
+        SampleUtil::clear(pOutput, frames * 2);
+    }
+
+    // The next job is only still busy if the worker is more than a whole
+    // callback behind.
+    LV2EffectJob* pJob = m_jobs[m_nextJobIndex].get();
+    m_previousJobSubmitted = false;
+    if (pJob->busy.load(std::memory_order_acquire)) {
+        static Counter s_inputDroppedCounter(
+                QStringLiteral("LV2EffectWorker input dropped"));
+        s_inputDroppedCounter.increment();
+        return;
+    }
+    std::copy_n(parameters.begin(),
+            std::min(parameters.size(), pJob->parameters.size()),
+            pJob->parameters.begin());
+    // note: LOOP VECTORIZED.
+    for (SINT i = 0; i < frames; ++i) {
+        pJob->inputL[i] = pInput[i * 2];
+        pJob->inputR[i] = pInput[i * 2 + 1];
+    }
+    pJob->frames = frames;
+    pJob->deactivate = enableState == EffectEnableState::Disabling;
+    pWorker->submit(pJob);
+    m_previousJobSubmitted = true;
+    m_nextJobIndex = 1 - m_nextJobIndex;
+}
+
+void LV2EffectInstance::run(LV2EffectJob* pJob) {
+    if (m_pConnectedJob != pJob) {
+        for (int i = 0; i < m_controlPortIndices.size(); ++i) {
+            lilv_instance_connect_port(m_pInstance,
+                    m_controlPortIndices[i],
+                    &pJob->parameters[i]);
+        }
+        lilv_instance_connect_port(m_pInstance, m_audioPortIndices[0], pJob->inputL.data());
+        lilv_instance_connect_port(m_pInstance, m_audioPortIndices[1], pJob->inputR.data());
+        lilv_instance_connect_port(m_pInstance, m_audioPortIndices[2], pJob->outputL.data());
+        lilv_instance_connect_port(m_pInstance, m_audioPortIndices[3], pJob->outputR.data());
+        m_pConnectedJob = pJob;
+    }
+    // Activation must not run concurrently with lilv_instance_run(),
+    // so it is done here instead of in the audio thread.
+    if (!m_active) {
+        lilv_instance_activate(m_pInstance);
+        m_active = true;
+    }
+    lilv_instance_run(m_pInstance, static_cast<uint32_t>(pJob->frames));
+    if (pJob->deactivate) {
+        lilv_instance_deactivate(m_pInstance);
+        m_active = false;
+    }
+    pJob->busy.store(false, std::memory_order_release);
+}
+
+LV2EffectWorker::LV2EffectWorker()
+        : m_submittedJobs(nullptr),
+          m_submitCount(0),
+          m_stop(false),
+          m_submitterRealtimePriority(0),
+          m_realtimePriority(0) {
+    // Like the engine callback, the plugins are processed in real time
+    start(QThread::TimeCriticalPriority);
+}
+
+LV2EffectWorker::~LV2EffectWorker() {
+    m_stop.store(true, std::memory_order_release);
+    m_submitCount.fetch_add(1, std::memory_order_release);
+    m_submitCount.notify_one();
+    wait();
+}
+
+void LV2EffectWorker::submit(LV2EffectJob* pJob) {
+    DEBUG_ASSERT(!pJob->busy.load());
+#ifdef __LINUX__
+    // The SCHED_FIFO priority of the submitting thread or 0. The engine
+    // thread and the EngineEffectsWorkers submit jobs.
+    static thread_local int s_realtimePriority = -1;
+    if (s_realtimePriority < 0) {
+        int policy;
+        struct sched_param param;
+        s_realtimePriority = 0;
+        if (pthread_getschedparam(pthread_self(), &policy, &param) == 0 &&
+                (policy == SCHED_FIFO || policy == SCHED_RR)) {
+            s_realtimePriority = param.sched_priority;
+        }
+    }
+    int realtimePriority = m_submitterRealtimePriority.load(std::memory_order_relaxed);
+    while (s_realtimePriority > realtimePriority &&
+            !m_submitterRealtimePriority.compare_exchange_weak(realtimePriority,
+                    s_realtimePriority,
+                    std::memory_order_relaxed)) {
+    }
+#endif
+    pJob->busy.store(true, std::memory_order_relaxed);
+    LV2EffectJob* pSubmittedJobs = m_submittedJobs.load(std::memory_order_relaxed);
+    do {
+        pJob->pNextSubmitted = pSubmittedJobs;
+    } while (!m_submittedJobs.compare_exchange_weak(pSubmittedJobs,
+            pJob,
+            std::memory_order_release,
+            std::memory_order_relaxed));
+    m_submitCount.fetch_add(1, std::memory_order_release);
+    m_submitCount.notify_one();
+}
+
+void LV2EffectWorker::run() {
+    QThread::currentThread()->setObjectName(QStringLiteral("LV2EffectWorker"));
+    while (!m_stop.load(std::memory_order_acquire)) {
+        // Jobs that are submitted after reading the count are either
+        // taken below or change the count, so waiting returns immediately.
+        const int submitCount = m_submitCount.load(std::memory_order_acquire);
+        LV2EffectJob* pSubmittedJobs = m_submittedJobs.exchange(
+                nullptr, std::memory_order_acquire);
+        // Run the jobs in the order of submission, so the late job of an
+        // instance runs before its next one
+        LV2EffectJob* pJob = nullptr;
+        while (pSubmittedJobs) {
+            LV2EffectJob* pNextSubmitted = pSubmittedJobs->pNextSubmitted;
+            pSubmittedJobs->pNextSubmitted = pJob;
+            pJob = pSubmittedJobs;
+            pSubmittedJobs = pNextSubmitted;
+        }
+        if (pJob) {
+            adoptSubmitterPriority();
+        }
+        while (pJob) {
+            // The job may be submitted again once it has run
+            LV2EffectJob* pNextJob = pJob->pNextSubmitted;
+            pJob->pInstance->run(pJob);
+            pJob = pNextJob;
+        }
+        m_submitCount.wait(submitCount, std::memory_order_acquire);
+    }
+}
+
+void LV2EffectWorker::adoptSubmitterPriority() {
+#ifdef __LINUX__
+    // QThread::TimeCriticalPriority is only a nice level on Linux, so the
+    // worker would be preempted by the real-time threads waiting for it.
+    const int priority = m_submitterRealtimePriority.load(std::memory_order_relaxed);
+    if (priority == m_realtimePriority) {
+        return;
+    }
+    m_realtimePriority = priority;
+    struct sched_param param = {0};
+    param.sched_priority = priority;
+    if (pthread_setschedparam(pthread_self(),
+                priority > 0 ? SCHED_FIFO : SCHED_OTHER,
+                &param)) {
+        qWarning() << "LV2EffectWorker: Failed to set the real-time priority"
+                   << priority;
+    }
+#endif
+}
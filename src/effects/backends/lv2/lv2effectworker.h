@@ -0,0 +1,122 @@
+#pragma once
+
+#include <lilv/lilv.h>
+
+#include <QList>
+#include <QThread>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "effects/defs.h"
+#include "util/span.h"
+#include "util/types.h"
+
+class LV2EffectInstance;
+class LV2EffectWorker;
+
+/// The buffers that the ports of an LV2EffectInstance are connected to
+/// while it is run for one callback. While busy is set, the job belongs
+/// to the LV2EffectWorker and must not be touched by the audio thread.
+struct LV2EffectJob {
+    LV2EffectJob(LV2EffectInstance* pInstance, int parameterCount);
+
+    LV2EffectInstance* const pInstance;
+    std::vector<float> inputL;
+    std::vector<float> inputR;
+    std::vector<float> outputL;
+    std::vector<float> outputR;
+    std::vector<float> parameters;
+    SINT frames;
+    bool deactivate;
+    std::atomic<bool> busy;
+    // The job that was submitted before this one, until the worker takes them
+    LV2EffectJob* pNextSubmitted;
+};
+
+/// A LilvInstance that is run by the LV2EffectWorker instead of the
+/// engine callback.
+///
+/// Each callback submits its input and returns the output of the previous
+/// callback, which the worker had a whole callback period to compute. The
+/// input is double buffered in two jobs, so it is still submitted while
+/// the worker finishes the late job of the previous callback.
+class LV2EffectInstance {
+  public:
+    /// The audio ports are expected in the order input left, input right,
+    /// output left, output right.
+    LV2EffectInstance(LilvInstance* pInstance,
+            const QList<int>& audioPortIndices,
+            const QList<int>& controlPortIndices);
+    ~LV2EffectInstance();
+
+    /// Called from the audio thread. Writes the output of the previous
+    /// callback, or silence if the worker has missed its deadline, and
+    /// submits the input and the control port values of this callback.
+    void process(LV2EffectWorker* pWorker,
+            const CSAMPLE* pInput,
+            CSAMPLE* pOutput,
+            SINT frames,
+            std::span<const float> parameters,
+            EffectEnableState enableState);
+
+    /// Waits until the worker has finished all submitted jobs, e.g.
+    /// before the LilvInstance is freed
+    void waitForJobs() const;
+
+  private:
+    friend class LV2EffectWorker;
+
+    /// Called from the worker thread
+    void run(LV2EffectJob* pJob);
+
+    LilvInstance* const m_pInstance;
+    const QList<int> m_audioPortIndices;
+    const QList<int> m_controlPortIndices;
+
+    std::unique_ptr<LV2EffectJob> m_jobs[2];
+    // The job for the next callback, the other one has been submitted
+    // by the previous callback if m_previousJobSubmitted is set
+    int m_nextJobIndex;
+    bool m_previousJobSubmitted;
+
+    // Only touched by the worker
+    LV2EffectJob* m_pConnectedJob;
+    bool m_active;
+};
+
+/// LV2EffectWorker runs LV2EffectInstances on a dedicated thread instead
+/// of the engine callback, so a slow plugin does not cause an xrun.
+///
+/// The resulting delay of one buffer is reported as group delay by the
+/// LV2EffectProcessor and compensated by the EngineEffectChain. The worker
+/// adopts the real-time priority of the threads that submit jobs.
+class LV2EffectWorker : public QThread {
+    Q_OBJECT
+  public:
+    LV2EffectWorker();
+    ~LV2EffectWorker() override;
+
+    /// Called from the audio threads. Neither takes a lock nor allocates.
+    void submit(LV2EffectJob* pJob);
+
+  private:
+    void run() override;
+
+    /// Called from the worker thread
+    void adoptSubmitterPriority();
+
+    // The submitted jobs, latest first. The engine may process effect
+    // chains on several threads (see EngineEffectsWorkerPool), so they are
+    // pushed with compare-and-swap. The worker takes all of them at once.
+    std::atomic<LV2EffectJob*> m_submittedJobs;
+    // Incremented for every submitted job. The idle worker waits for it
+    // to change, which wakes it up without taking a lock in the audio
+    // thread.
+    std::atomic<int> m_submitCount;
+    std::atomic<bool> m_stop;
+    // The highest SCHED_FIFO priority of the submitting threads or 0
+    std::atomic<int> m_submitterRealtimePriority;
+    // Only touched by the worker
+    int m_realtimePriority;
+};
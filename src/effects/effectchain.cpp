@@ -143,6 +143,16 @@ EffectChain::EffectChain(const QString& group,
             true);
     m_pControlChainFocusedEffect->setButtonMode(mixxx::control::ButtonMode::Toggle);
 
+    m_pControlCpuUsageMin = std::make_unique<ControlObject>(
+            ConfigKey(m_group, QStringLiteral("cpu_usage_min")));
+    m_pControlCpuUsageMin->setReadOnly();
+    m_pControlCpuUsageAvg = std::make_unique<ControlObject>(
+            ConfigKey(m_group, QStringLiteral("cpu_usage_avg")));
+    m_pControlCpuUsageAvg->setReadOnly();
+    m_pControlCpuUsageMax = std::make_unique<ControlObject>(
+            ConfigKey(m_group, QStringLiteral("cpu_usage_max")));
+    m_pControlCpuUsageMax->setReadOnly();
+
     addToEngine();
 }
 
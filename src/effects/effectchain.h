@@ -140,6 +140,10 @@ class EffectChain : public QObject {
     std::unique_ptr<ControlEncoder> m_pControlChainPresetSelector;
     std::unique_ptr<ControlPushButton> m_pControlNextChainPreset;
     std::unique_ptr<ControlPushButton> m_pControlPrevChainPreset;
+    // Set by the EngineEffectChain
+    std::unique_ptr<ControlObject> m_pControlCpuUsageMin;
+    std::unique_ptr<ControlObject> m_pControlCpuUsageAvg;
+    std::unique_ptr<ControlObject> m_pControlCpuUsageMax;
 
     void setControlLoadedPresetIndex(int index);
 
@@ -68,10 +68,6 @@ void EffectParameter::updateEngineState() {
     if (!m_pEngineEffect) {
         return;
     }
-    EffectsRequest* pRequest = new EffectsRequest();
-    pRequest->type = EffectsRequest::SET_PARAMETER_PARAMETERS;
-    pRequest->pTargetEffect = m_pEngineEffect;
-    pRequest->SetParameterParameters.iParameter = m_pParameterManifest->index();
-    pRequest->value = m_value;
-    m_pMessenger->writeRequest(pRequest);
+    m_pMessenger->writeParameterUpdate(
+            m_pEngineEffect, m_pParameterManifest->index(), m_value);
 }
@@ -131,6 +131,16 @@ EffectSlot::EffectSlot(const QString& group,
     m_pControlMetaParameter->set(0.0);
     m_pControlMetaParameter->setDefaultValue(0.0);
 
+    m_pControlCpuUsageMin = std::make_unique<ControlObject>(
+            ConfigKey(m_group, QStringLiteral("cpu_usage_min")));
+    m_pControlCpuUsageMin->setReadOnly();
+    m_pControlCpuUsageAvg = std::make_unique<ControlObject>(
+            ConfigKey(m_group, QStringLiteral("cpu_usage_avg")));
+    m_pControlCpuUsageAvg->setReadOnly();
+    m_pControlCpuUsageMax = std::make_unique<ControlObject>(
+            ConfigKey(m_group, QStringLiteral("cpu_usage_max")));
+    m_pControlCpuUsageMax->setReadOnly();
+
     m_pControlLoaded->forceSet(0.0);
 }
 
@@ -149,6 +159,7 @@ void EffectSlot::addToEngine() {
     }
 
     m_pEngineEffect = new EngineEffect(
+            m_group,
             m_pManifest,
             m_pBackendManager,
             m_pChain->getActiveChannels(),
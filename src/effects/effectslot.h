@@ -188,6 +188,10 @@ class EffectSlot : public QObject {
     std::unique_ptr<ControlEncoder> m_pControlEffectSelector;
     std::unique_ptr<ControlObject> m_pControlClear;
     std::unique_ptr<ControlPotmeter> m_pControlMetaParameter;
+    // Set by the EngineEffect
+    std::unique_ptr<ControlObject> m_pControlCpuUsageMin;
+    std::unique_ptr<ControlObject> m_pControlCpuUsageAvg;
+    std::unique_ptr<ControlObject> m_pControlCpuUsageMax;
 
     SoftTakeover m_metaknobSoftTakeover;
 
@@ -2,6 +2,8 @@
 
 #include <QDir>
 #include <QMetaType>
+#include <QThread>
+#include <algorithm>
 
 #include "effects/chains/equalizereffectchain.h"
 #include "effects/chains/outputeffectchain.h"
@@ -31,14 +33,21 @@ EffectsManager::EffectsManager(
           m_initializedFromEffectsXml(false) {
     qRegisterMetaType<EffectChainMixMode>("EffectChainMixMode");
 
-    m_pBackendManager = EffectsBackendManagerPointer(new EffectsBackendManager());
+    m_pBackendManager = EffectsBackendManagerPointer(new EffectsBackendManager(pConfig));
 
     auto [requestPipe, responsePipe] = makeTwoWayMessagePipe<EffectsRequest*,
             EffectsResponse>(kEffectMessagePipeFifoSize,
             kEffectMessagePipeFifoSize);
 
     m_pMessenger = EffectsMessengerPointer::create(std::move(requestPipe));
-    m_pEngineEffectsManager = std::make_unique<EngineEffectsManager>(std::move(responsePipe));
+    // Optionally process the effect chains of different channels on more
+    // cores. 4 decks are the most channels that usually have effects.
+    int parallelWorkerCount = 0;
+    if (pConfig->getValue(ConfigKey("[Effects]", "ParallelChains"), false)) {
+        parallelWorkerCount = std::clamp(QThread::idealThreadCount() - 1, 0, 3);
+    }
+    m_pEngineEffectsManager = std::make_unique<EngineEffectsManager>(
+            std::move(responsePipe), parallelWorkerCount);
 
     m_pEffectPresetManager = EffectPresetManagerPointer(
             new EffectPresetManager(pConfig, m_pBackendManager));
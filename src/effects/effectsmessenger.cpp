@@ -42,6 +42,24 @@ bool EffectsMessenger::writeRequest(EffectsRequest* request) {
     return false;
 }
 
+bool EffectsMessenger::writeParameterUpdate(
+        EngineEffect* pEffect, int iParameter, double value) {
+    if (m_bShuttingDown) {
+        return false;
+    }
+
+    EffectsRequest* pRequest = pEffect->prepareParameterUpdate(iParameter, value);
+    if (!pRequest) {
+        // The pending request applies the new value
+        return true;
+    }
+    if (m_requestPipe.writeMessage(pRequest)) {
+        return true;
+    }
+    pEffect->cancelParameterUpdate(iParameter);
+    return false;
+}
+
 void EffectsMessenger::processEffectsResponses() {
     EffectsResponse response;
     while (m_requestPipe.readMessage(&response)) {
@@ -20,6 +20,11 @@ class EffectsMessenger {
     /// Write an EffectsRequest to the EngineEffectsManager. EffectsMessenger takes
     /// ownership of request and deletes it once a response is received.
     bool writeRequest(EffectsRequest* request);
+    /// Sends the value of a parameter to the EngineEffect. Updates of the
+    /// same parameter are merged until the engine has applied the value,
+    /// so at most one update per parameter is processed per callback. The
+    /// requests are preallocated by the EngineEffect and never answered.
+    bool writeParameterUpdate(EngineEffect* pEffect, int iParameter, double value);
 
     void initiateShutdown();
     void processEffectsResponses();
@@ -67,32 +67,42 @@ void ChannelMixer::applyEffectsInPlaceAndMixChannels(
     // 2. Pass each channel's calculated gain and input buffer to pEngineEffectsManager, which then:
     //    A) Applies the calculated gain to the channel buffer, modifying the original input buffer
     //    B) Applies effects to the buffer, modifying the original input buffer
+    //    The channels may be processed in parallel.
     // 4. Mix the channel buffers together to make pOutput, overwriting the pOutput buffer from the last engine callback
     ScopedTimer t(QStringLiteral("EngineMixer::applyEffectsInPlaceAndMixChannels"));
     SampleUtil::clear(pOutput, bufferSize);
-    for (auto* pChannelInfo : activeChannels) {
+
+    QVarLengthArray<EngineEffectsManager::PostFaderChannel, kPreallocatedChannels>
+            postFaderChannels(activeChannels.size());
+    for (int i = 0; i < activeChannels.size(); ++i) {
+        EngineMixer::ChannelInfo* pChannelInfo = activeChannels[i];
         EngineMixer::GainCache& gainCache = (*channelGainCache)[pChannelInfo->m_index];
-        CSAMPLE_GAIN oldGain = gainCache.m_gain;
-        CSAMPLE_GAIN newGain;
-        bool fadeout = gainCache.m_fadeout ||
+        EngineEffectsManager::PostFaderChannel& channel = postFaderChannels[i];
+        channel.inputHandle = pChannelInfo->m_handle;
+        channel.pInOut = pChannelInfo->m_pBuffer.data();
+        channel.pGroupFeatures = &pChannelInfo->m_features;
+        channel.oldGain = gainCache.m_gain;
+        channel.fadeout = gainCache.m_fadeout ||
                 (pChannelInfo->m_pChannel &&
                         !pChannelInfo->m_pChannel->isActive());
-        if (fadeout) {
-            newGain = 0;
+        if (channel.fadeout) {
+            channel.newGain = 0;
             gainCache.m_fadeout = false;
         } else {
-            newGain = gainCalculator.getGain(pChannelInfo);
+            channel.newGain = gainCalculator.getGain(pChannelInfo);
         }
-        gainCache.m_gain = newGain;
-        pEngineEffectsManager->processPostFaderInPlace(pChannelInfo->m_handle,
-                outputHandle,
-                pChannelInfo->m_pBuffer.data(),
-                bufferSize,
-                sampleRate,
-                pChannelInfo->m_features,
-                oldGain,
-                newGain,
-                fadeout);
+        gainCache.m_gain = channel.newGain;
+    }
+
+    pEngineEffectsManager->processPostFaderInPlace(
+            mixxx::spanutil::spanFromPtrLen(
+                    postFaderChannels.constData(), postFaderChannels.size()),
+            outputHandle,
+            bufferSize,
+            sampleRate);
+
+    // Mixed in the same order as without parallel processing
+    for (auto* pChannelInfo : activeChannels) {
         SampleUtil::add(pOutput, pChannelInfo->m_pBuffer.data(), bufferSize);
     }
 }
@@ -13,20 +13,28 @@ constexpr auto kInitalSampleRate = mixxx::audio::SampleRate(96000);
 
 } // namespace
 
-EngineEffect::EngineEffect(EffectManifestPointer pManifest,
+EngineEffect::EngineEffect(const QString& group,
+        EffectManifestPointer pManifest,
         EffectsBackendManagerPointer pBackendManager,
         const QSet<ChannelHandleAndGroup>& activeInputChannels,
         const QSet<ChannelHandleAndGroup>& registeredInputChannels,
         const QSet<ChannelHandleAndGroup>& registeredOutputChannels)
         : m_pManifest(pManifest),
           m_pProcessor(pBackendManager->createProcessor(pManifest)),
-          m_parameters(pManifest->parameters().size()) {
+          m_parameters(pManifest->parameters().size()),
+          m_parameterUpdateRequests(pManifest->parameters().size()),
+          m_cpuUsage(group, QStringLiteral("EngineEffect::process %1").arg(pManifest->name())) {
     const QList<EffectManifestParameterPointer>& parameters = m_pManifest->parameters();
     for (int i = 0; i < parameters.size(); ++i) {
         EffectManifestParameterPointer param = parameters.at(i);
         EngineEffectParameterPointer pParameter(new EngineEffectParameter(param));
         m_parameters[i] = pParameter;
         m_parametersById[param->id()] = pParameter;
+
+        EffectsRequest& request = m_parameterUpdateRequests[i];
+        request.type = EffectsRequest::SET_PARAMETER_PARAMETERS;
+        request.pTargetEffect = this;
+        request.SetParameterParameters.iParameter = i;
     }
 
     for (const ChannelHandleAndGroup& inputChannel : registeredInputChannels) {
@@ -66,6 +74,23 @@ void EngineEffect::initalizeInputChannel(ChannelHandle inputChannel) {
     m_pProcessor->initializeInputChannel(inputChannel, engineParameters);
 }
 
+EffectsRequest* EngineEffect::prepareParameterUpdate(int iParameter, double value) {
+    VERIFY_OR_DEBUG_ASSERT(iParameter >= 0 && iParameter < m_parameters.size()) {
+        return nullptr;
+    }
+    if (!m_parameters[iParameter]->setPendingValue(value)) {
+        return nullptr;
+    }
+    return &m_parameterUpdateRequests[iParameter];
+}
+
+void EngineEffect::cancelParameterUpdate(int iParameter) {
+    VERIFY_OR_DEBUG_ASSERT(iParameter >= 0 && iParameter < m_parameters.size()) {
+        return;
+    }
+    m_parameters[iParameter]->cancelPendingValue();
+}
+
 bool EngineEffect::processEffectsRequest(EffectsRequest& message,
                                          EffectsResponsePipe* pResponsePipe) {
     EngineEffectParameterPointer pParameter;
@@ -101,21 +126,19 @@ bool EngineEffect::processEffectsRequest(EffectsRequest& message,
         return true;
         break;
     case EffectsRequest::SET_PARAMETER_PARAMETERS:
+        pParameter = m_parameters.value(
+                message.SetParameterParameters.iParameter, EngineEffectParameterPointer());
+        VERIFY_OR_DEBUG_ASSERT(pParameter) {
+            return true;
+        }
+        pParameter->applyPendingValue();
         if (kEffectDebugOutput) {
             qDebug() << debugString() << "SET_PARAMETER_PARAMETERS"
                      << "parameter" << message.SetParameterParameters.iParameter
-                     << "value" << message.value;
-        }
-        pParameter = m_parameters.value(
-                message.SetParameterParameters.iParameter, EngineEffectParameterPointer());
-        if (pParameter) {
-            pParameter->setValue(message.value);
-            response.success = true;
-        } else {
-            response.success = false;
-            response.status = EffectsResponse::NO_SUCH_PARAMETER;
+                     << "value" << pParameter->value();
         }
-        pResponsePipe->writeMessage(response);
+        // The preallocated request is reused for the next update of the
+        // parameter and not answered
         return true;
     default:
         break;
@@ -182,6 +205,7 @@ bool EngineEffect::process(const ChannelHandle& inputHandle,
                 sampleRate,
                 numSamples / mixxx::kEngineChannelOutputCount);
 
+        m_cpuUsage.startProcess();
         m_pProcessor->process(inputHandle,
                 outputHandle,
                 pInput,
@@ -189,6 +213,7 @@ bool EngineEffect::process(const ChannelHandle& inputHandle,
                 engineParameters,
                 effectiveEffectEnableState,
                 groupFeatures);
+        m_cpuUsage.finishProcess(numSamples, sampleRate);
 
         processingOccured = true;
 
@@ -225,3 +250,22 @@ bool EngineEffect::process(const ChannelHandle& inputHandle,
 
     return processingOccured;
 }
+
+SINT EngineEffect::getTailFrames(const ChannelHandle& inputHandle,
+        const ChannelHandle& outputHandle,
+        const std::size_t numSamples,
+        const mixxx::audio::SampleRate sampleRate) {
+    switch (m_effectEnableStateForChannelMatrix[inputHandle][outputHandle]) {
+    case EffectEnableState::Disabled:
+        // Not processed at all
+        return 0;
+    case EffectEnableState::Enabled: {
+        const mixxx::EngineParameters engineParameters(
+                sampleRate,
+                numSamples / mixxx::kEngineChannelOutputCount);
+        return m_pProcessor->getTailFrames(inputHandle, outputHandle, engineParameters);
+    }
+    default:
+        return EffectProcessor::kInfiniteTailFrames;
+    }
+}
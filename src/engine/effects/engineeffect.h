@@ -5,11 +5,13 @@
 #include <QString>
 #include <QVector>
 #include <memory>
+#include <vector>
 
 #include "audio/types.h"
 #include "effects/backends/effectmanifest.h"
 #include "effects/backends/effectprocessor.h"
 #include "engine/channelhandle.h"
+#include "engine/effects/engineeffectcpuusage.h"
 #include "engine/effects/message.h"
 #include "util/types.h"
 
@@ -20,7 +22,8 @@
 class EngineEffect final : public EffectsRequestHandler {
   public:
     /// Called in main thread by EffectSlot
-    EngineEffect(EffectManifestPointer pManifest,
+    EngineEffect(const QString& group,
+            EffectManifestPointer pManifest,
             EffectsBackendManagerPointer pBackendManager,
             const QSet<ChannelHandleAndGroup>& activeInputChannels,
             const QSet<ChannelHandleAndGroup>& registeredInputChannels,
@@ -32,11 +35,33 @@ class EngineEffect final : public EffectsRequestHandler {
     /// Called from the main thread to make sure that the channel already has states
     void initalizeInputChannel(ChannelHandle inputChannel);
 
+    /// Called in main thread by EffectsMessenger
+    /// Stores the value of the parameter for the engine. Returns the
+    /// preallocated request that notifies the engine about it, or nullptr
+    /// if the request is still pending and will apply the new value.
+    EffectsRequest* prepareParameterUpdate(int iParameter, double value);
+
+    /// Called in main thread by EffectsMessenger if the request returned by
+    /// prepareParameterUpdate() could not be sent, and in the audio thread by
+    /// EngineEffectsManager if it could not be delivered. Otherwise the
+    /// parameter would wait for a pending request forever.
+    void cancelParameterUpdate(int iParameter);
+
     /// Called in audio thread
     bool processEffectsRequest(
             EffectsRequest& message,
             EffectsResponsePipe* pResponsePipe) override;
 
+    /// Called in audio thread
+    void onCallbackStart() {
+        m_cpuUsage.onCallbackStart();
+    }
+
+    /// Called in audio thread when the effect is removed from its chain
+    void clearCpuUsage() {
+        m_cpuUsage.clear();
+    }
+
     /// Called in audio thread
     bool process(const ChannelHandle& inputHandle,
             const ChannelHandle& outputHandle,
@@ -59,6 +84,24 @@ class EngineEffect final : public EffectsRequestHandler {
         return m_pProcessor->getGroupDelayFrames();
     }
 
+    /// Called in audio thread
+    /// Returns the tail of the effect for the channel, or
+    /// EffectProcessor::kInfiniteTailFrames while enabling or disabling,
+    /// because these transitions must not be skipped.
+    SINT getTailFrames(const ChannelHandle& inputHandle,
+            const ChannelHandle& outputHandle,
+            const std::size_t numSamples,
+            const mixxx::audio::SampleRate sampleRate);
+
+    /// Called in audio thread
+    /// Whether the effect is fully enabled for the channel, i.e. neither
+    /// disabled nor in an enabling or disabling transition.
+    bool isEnabledForChannel(const ChannelHandle& inputHandle,
+            const ChannelHandle& outputHandle) {
+        return m_effectEnableStateForChannelMatrix[inputHandle][outputHandle] ==
+                EffectEnableState::Enabled;
+    }
+
   private:
     QString debugString() const {
         return QString("EngineEffect(%1)").arg(m_pManifest->name());
@@ -71,5 +114,8 @@ class EngineEffect final : public EffectsRequestHandler {
     // Must not be modified after construction.
     QVector<EngineEffectParameterPointer> m_parameters;
     QMap<QString, EngineEffectParameterPointer> m_parametersById;
-
+    // Reused for every update of the parameter with the same index.
+    // Must not be modified after construction.
+    std::vector<EffectsRequest> m_parameterUpdateRequests;
+    EngineEffectCpuUsage m_cpuUsage;
 };
@@ -12,9 +12,12 @@ EngineEffectChain::EngineEffectChain(const QString& group,
           m_mixMode(EffectChainMixMode::DrySlashWet),
           m_dMix(0),
           m_buffer1(kMaxEngineSamples),
-          m_buffer2(kMaxEngineSamples) {
+          m_buffer2(kMaxEngineSamples),
+          m_silence(kMaxEngineSamples),
+          m_cpuUsage(group, QStringLiteral("EngineEffectChain::process %1").arg(group)) {
     // Try to prevent memory allocation.
     m_effects.reserve(256);
+    m_silence.clear();
 
     for (const ChannelHandleAndGroup& inputChannel : registeredInputChannels) {
         ChannelHandleMap<ChannelStatus> outputChannelMap;
@@ -70,9 +73,19 @@ bool EngineEffectChain::removeEffect(EngineEffect* pEffect, int iIndex) {
     }
 
     m_effects.replace(iIndex, nullptr);
+    pEffect->clearCpuUsage();
     return true;
 }
 
+void EngineEffectChain::onCallbackStart() {
+    m_cpuUsage.onCallbackStart();
+    for (EngineEffect* pEffect : std::as_const(m_effects)) {
+        if (pEffect != nullptr) {
+            pEffect->onCallbackStart();
+        }
+    }
+}
+
 // this is called from the engine thread onCallbackStart()
 bool EngineEffectChain::updateParameters(const EffectsRequest& message) {
     // TODO(rryan): Parameter interpolation.
@@ -171,6 +184,77 @@ bool EngineEffectChain::disableForInputChannel(ChannelHandle inputHandle) {
     return true;
 }
 
+bool EngineEffectChain::isTailSilent(ChannelStatus* pChannelStatus,
+        const ChannelHandle& inputHandle,
+        const ChannelHandle& outputHandle,
+        const CSAMPLE* pIn,
+        const std::size_t numSamples,
+        const mixxx::audio::SampleRate sampleRate) {
+    if (SampleUtil::maxAbsAmplitude(pIn, static_cast<SINT>(numSamples)) != CSAMPLE_ZERO) {
+        pChannelStatus->silentInputFrames = 0;
+        return false;
+    }
+
+    // The effects are connected in series, so their tails add up
+    SINT tailFrames = 0;
+    for (EngineEffect* pEffect : std::as_const(m_effects)) {
+        if (pEffect != nullptr) {
+            const SINT effectTailFrames = pEffect->getTailFrames(
+                    inputHandle, outputHandle, numSamples, sampleRate);
+            if (effectTailFrames == EffectProcessor::kInfiniteTailFrames) {
+                // Only count the silence processed in a steady state
+                pChannelStatus->silentInputFrames = 0;
+                return false;
+            }
+            tailFrames += effectTailFrames + pEffect->getGroupDelayFrames();
+        }
+    }
+
+    if (pChannelStatus->silentInputFrames >= tailFrames) {
+        return true;
+    }
+    pChannelStatus->silentInputFrames +=
+            static_cast<SINT>(numSamples / mixxx::kEngineChannelOutputCount);
+    return false;
+}
+
+void EngineEffectChain::resumeAfterSilence(const ChannelHandle& inputHandle,
+        const ChannelHandle& outputHandle,
+        const std::size_t numSamples,
+        const mixxx::audio::SampleRate sampleRate,
+        const GroupFeatureState& groupFeatures) {
+    // The effects have not seen the parameter changes while they have been
+    // skipped. Processing one buffer of silence lets them adopt the current
+    // values, e.g. finish their parameter ramps or update their filter
+    // coefficients, before the first audible buffer. Their tails have
+    // decayed, so the discarded output is silent. Effects in an enabling or
+    // disabling transition are left alone, so they ramp the audible buffer.
+    for (EngineEffect* pEffect : std::as_const(m_effects)) {
+        if (pEffect != nullptr && pEffect->isEnabledForChannel(inputHandle, outputHandle)) {
+            pEffect->process(inputHandle,
+                    outputHandle,
+                    m_silence.data(),
+                    m_buffer1.data(),
+                    numSamples,
+                    sampleRate,
+                    EffectEnableState::Enabled,
+                    groupFeatures);
+        }
+    }
+}
+
+bool EngineEffectChain::processesSharedState(const ChannelHandle& inputHandle,
+        const ChannelHandle& outputHandle) {
+    if (m_enableState == EffectEnableState::Enabling ||
+            m_enableState == EffectEnableState::Disabling) {
+        return true;
+    }
+    // Also adds the status of a new channel, so process() does not
+    // modify the matrix itself
+    const ChannelStatus& channelStatus = m_chainStatusForChannelMatrix[inputHandle][outputHandle];
+    return channelStatus.enableState != EffectEnableState::Disabled;
+}
+
 bool EngineEffectChain::process(const ChannelHandle& inputHandle,
         const ChannelHandle& outputHandle,
         CSAMPLE* pIn,
@@ -211,8 +295,39 @@ bool EngineEffectChain::process(const ChannelHandle& inputHandle,
     CSAMPLE currentMixKnob = m_dMix;
     CSAMPLE lastCallbackMixKnob = channelStatus.oldMixKnob;
 
+    // Once the input has been digital silence for longer than the tails
+    // of all effects, their output is silent as well and the input can
+    // be passed through unprocessed. Enabling and disabling ramps are never
+    // skipped, so the effects see the same transitions as without skipping.
+    bool skipSilence = false;
+    if (effectiveChainEnableState == EffectEnableState::Enabled) {
+        skipSilence = isTailSilent(&channelStatus,
+                inputHandle,
+                outputHandle,
+                pIn,
+                numSamples,
+                sampleRate);
+    } else {
+        channelStatus.silentInputFrames = 0;
+    }
+    if (skipSilence) {
+        // Keep feeding the silent input into the delay line of the dry
+        // signal, so it does not replay stale samples when resuming
+        m_effectsDelay.process(pIn, numSamples);
+    } else if (channelStatus.silenceSkipped &&
+            effectiveChainEnableState == EffectEnableState::Enabled) {
+        resumeAfterSilence(inputHandle,
+                outputHandle,
+                numSamples,
+                sampleRate,
+                groupFeatures);
+    }
+    channelStatus.silenceSkipped = skipSilence;
+
     bool processingOccured = false;
-    if (effectiveChainEnableState != EffectEnableState::Disabled) {
+    if (effectiveChainEnableState != EffectEnableState::Disabled && !skipSilence) {
+        m_cpuUsage.startProcess();
+
         // Ramping code inside the effects need to access the original samples
         // after writing to the output buffer. This requires not to use the same buffer
         // for in and output: Also, ChannelMixer::applyEffectsAndMixChannels
@@ -301,6 +416,8 @@ bool EngineEffectChain::process(const ChannelHandle& inputHandle,
                         static_cast<int>(numSamples));
             }
         }
+
+        m_cpuUsage.finishProcess(numSamples, sampleRate);
     }
 
     channelStatus.oldMixKnob = currentMixKnob;
@@ -5,6 +5,7 @@
 
 #include "audio/types.h"
 #include "engine/channelhandle.h"
+#include "engine/effects/engineeffectcpuusage.h"
 #include "engine/effects/engineeffectsdelay.h"
 #include "engine/effects/message.h"
 #include "util/class.h"
@@ -35,6 +36,18 @@ class EngineEffectChain final : public EffectsRequestHandler {
             EffectsRequest& message,
             EffectsResponsePipe* pResponsePipe) override;
 
+    /// called from audio thread
+    void onCallbackStart();
+
+    /// called from audio thread
+    ///
+    /// Whether process() for this channel modifies state of the chain that
+    /// is shared by all channels: its effects, buffers and delay, or its
+    /// enable state while it is being enabled or disabled. process() calls
+    /// for different channels that return false here may run in parallel.
+    bool processesSharedState(const ChannelHandle& inputHandle,
+            const ChannelHandle& outputHandle);
+
     /// called from audio thread
     bool process(const ChannelHandle& inputHandle,
             const ChannelHandle& outputHandle,
@@ -49,10 +62,17 @@ class EngineEffectChain final : public EffectsRequestHandler {
     struct ChannelStatus {
         ChannelStatus()
                 : oldMixKnob(0),
-                  enableState(EffectEnableState::Disabled) {
+                  enableState(EffectEnableState::Disabled),
+                  silentInputFrames(0),
+                  silenceSkipped(false) {
         }
         CSAMPLE oldMixKnob;
         EffectEnableState enableState;
+        // Frames of digital silence the enabled effects have processed
+        // since the input became silent
+        SINT silentInputFrames;
+        // Whether the previous callback has skipped the effects
+        bool silenceSkipped;
     };
 
     QString debugString() const {
@@ -64,6 +84,17 @@ class EngineEffectChain final : public EffectsRequestHandler {
     bool removeEffect(EngineEffect* pEffect, int iIndex);
     bool enableForInputChannel(ChannelHandle inputHandle);
     bool disableForInputChannel(ChannelHandle inputHandle);
+    bool isTailSilent(ChannelStatus* pChannelStatus,
+            const ChannelHandle& inputHandle,
+            const ChannelHandle& outputHandle,
+            const CSAMPLE* pIn,
+            const std::size_t numSamples,
+            const mixxx::audio::SampleRate sampleRate);
+    void resumeAfterSilence(const ChannelHandle& inputHandle,
+            const ChannelHandle& outputHandle,
+            const std::size_t numSamples,
+            const mixxx::audio::SampleRate sampleRate,
+            const GroupFeatureState& groupFeatures);
 
     QString m_group;
     EffectEnableState m_enableState;
@@ -72,8 +103,11 @@ class EngineEffectChain final : public EffectsRequestHandler {
     QList<EngineEffect*> m_effects;
     mixxx::SampleBuffer m_buffer1;
     mixxx::SampleBuffer m_buffer2;
+    // Digital silence, the input of the effects when resuming after silence
+    mixxx::SampleBuffer m_silence;
     ChannelHandleMap<ChannelHandleMap<ChannelStatus>> m_chainStatusForChannelMatrix;
     EngineEffectsDelay m_effectsDelay;
+    EngineEffectCpuUsage m_cpuUsage;
 
     DISALLOW_COPY_AND_ASSIGN(EngineEffectChain);
 };
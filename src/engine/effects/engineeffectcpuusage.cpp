@@ -0,0 +1,78 @@
+#include "engine/effects/engineeffectcpuusage.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "engine/engine.h"
+#include "util/stat.h"
+#include "util/timer.h"
+
+namespace {
+
+constexpr double kUpdateRate = 30; // in 1/s, fits to display frame rate
+
+} // namespace
+
+EngineEffectCpuUsage::EngineEffectCpuUsage(const QString& group, const QString& statTag)
+        : m_statTag(statTag),
+          m_cpuUsageMin(group, QStringLiteral("cpu_usage_min")),
+          m_cpuUsageAvg(group, QStringLiteral("cpu_usage_avg")),
+          m_cpuUsageMax(group, QStringLiteral("cpu_usage_max")),
+          m_callbackSecs(0) {
+    resetWindow();
+}
+
+void EngineEffectCpuUsage::addProcessTime(mixxx::Duration duration,
+        std::size_t numSamples,
+        mixxx::audio::SampleRate sampleRate) {
+    m_callbackDuration += duration;
+    m_callbackSecs = numSamples / mixxx::kEngineChannelOutputCount / sampleRate.toDouble();
+}
+
+void EngineEffectCpuUsage::onCallbackStart() {
+    if (m_callbackSecs <= 0) {
+        // Never processed
+        return;
+    }
+
+    // Close the previous callback
+    if (m_callbackDuration > mixxx::Duration::empty()) {
+        Stat::track(m_statTag,
+                Stat::DURATION_NANOSEC,
+                kDefaultComputeFlags,
+                static_cast<double>(m_callbackDuration.toIntegerNanos()));
+    }
+    const double usage = m_callbackDuration.toDoubleSeconds() / m_callbackSecs;
+    m_callbackDuration = mixxx::Duration::empty();
+
+    m_windowUsageSum += usage;
+    m_windowUsageMin = std::min(m_windowUsageMin, usage);
+    m_windowUsageMax = std::max(m_windowUsageMax, usage);
+    ++m_windowCallbackCount;
+    m_windowSecs += m_callbackSecs;
+    if (m_windowSecs < 1 / kUpdateRate) {
+        return;
+    }
+
+    m_cpuUsageMin.setAndConfirm(m_windowUsageMin);
+    m_cpuUsageAvg.setAndConfirm(m_windowUsageSum / m_windowCallbackCount);
+    m_cpuUsageMax.setAndConfirm(m_windowUsageMax);
+    resetWindow();
+}
+
+void EngineEffectCpuUsage::clear() {
+    m_callbackDuration = mixxx::Duration::empty();
+    m_callbackSecs = 0;
+    resetWindow();
+    m_cpuUsageMin.setAndConfirm(0);
+    m_cpuUsageAvg.setAndConfirm(0);
+    m_cpuUsageMax.setAndConfirm(0);
+}
+
+void EngineEffectCpuUsage::resetWindow() {
+    m_windowSecs = 0;
+    m_windowCallbackCount = 0;
+    m_windowUsageSum = 0;
+    m_windowUsageMin = std::numeric_limits<double>::max();
+    m_windowUsageMax = 0;
+}
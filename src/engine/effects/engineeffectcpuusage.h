@@ -0,0 +1,68 @@
+#pragma once
+
+#include <QString>
+
+#include "audio/types.h"
+#include "control/pollingcontrolproxy.h"
+#include "util/duration.h"
+#include "util/performancetimer.h"
+
+/// EngineEffectCpuUsage accounts the time an EngineEffect or an
+/// EngineEffectChain spends processing in the audio thread.
+///
+/// The times of all process() calls during one engine callback are summed
+/// up and divided by the duration of the callback, so 1.0 means that the
+/// whole callback budget was used. The minimum, average and maximum of
+/// these per callback values are published to the read-only controls
+/// cpu_usage_min, cpu_usage_avg and cpu_usage_max of the group about
+/// 30 times per second. With --developer the per callback times are also
+/// reported to the StatsManager.
+///
+/// All members except the constructor are called from the audio thread and
+/// neither lock nor allocate.
+class EngineEffectCpuUsage {
+  public:
+    /// Called from main thread. The controls must have been created by
+    /// the EffectSlot or EffectChain of the group.
+    EngineEffectCpuUsage(const QString& group, const QString& statTag);
+
+    void onCallbackStart();
+
+    void startProcess() {
+        m_timer.start();
+    }
+
+    void finishProcess(std::size_t numSamples, mixxx::audio::SampleRate sampleRate) {
+        addProcessTime(m_timer.elapsed(), numSamples, sampleRate);
+    }
+
+    /// Accounts the duration of processing numSamples in the current callback
+    void addProcessTime(mixxx::Duration duration,
+            std::size_t numSamples,
+            mixxx::audio::SampleRate sampleRate);
+
+    /// Publishes zero usage, when the owner is no longer processed
+    void clear();
+
+  private:
+    void resetWindow();
+
+    const QString m_statTag;
+    PollingControlProxy m_cpuUsageMin;
+    PollingControlProxy m_cpuUsageAvg;
+    PollingControlProxy m_cpuUsageMax;
+
+    PerformanceTimer m_timer;
+    // Processing time in the current callback
+    mixxx::Duration m_callbackDuration;
+    // Duration of the last processed callback. Callbacks without
+    // processing are assumed to have the same duration.
+    double m_callbackSecs;
+
+    // Statistics of the callbacks since the controls have been published
+    double m_windowSecs;
+    int m_windowCallbackCount;
+    double m_windowUsageSum;
+    double m_windowUsageMin;
+    double m_windowUsageMax;
+};
@@ -2,6 +2,7 @@
 
 #include <QString>
 #include <QVariant>
+#include <atomic>
 
 #include "effects/backends/effectmanifestparameter.h"
 #include "util/class.h"
@@ -9,7 +10,9 @@
 class EngineEffectParameter {
   public:
     EngineEffectParameter(EffectManifestParameterPointer pParameterManifest)
-            : m_pParameterManifest(pParameterManifest) {
+            : m_pParameterManifest(pParameterManifest),
+              m_pendingValue(pParameterManifest->getDefault()),
+              m_updatePending(false) {
         m_value = m_pParameterManifest->getDefault();
     }
     virtual ~EngineEffectParameter() {
@@ -31,6 +34,28 @@ class EngineEffectParameter {
         }
         m_value = value;
     }
+
+    /// Called from the main thread. Returns false if an update is still
+    /// pending, which will apply this value instead of its own. Otherwise
+    /// the caller must send an update request to the engine.
+    bool setPendingValue(const double value) {
+        m_pendingValue.store(value);
+        return !m_updatePending.exchange(true);
+    }
+
+    /// Called from the main thread if the update request could not be sent
+    void cancelPendingValue() {
+        m_updatePending.store(false);
+    }
+
+    /// Called from the audio thread when processing the update request
+    void applyPendingValue() {
+        // Reset the flag first. A value that is set concurrently is then
+        // either applied right now or sends a new update request.
+        m_updatePending.store(false);
+        setValue(m_pendingValue.load());
+    }
+
     inline int toInt() const {
         return static_cast<int>(m_value);
     }
@@ -41,6 +66,8 @@ class EngineEffectParameter {
   private:
     EffectManifestParameterPointer m_pParameterManifest;
     double m_value;
+    std::atomic<double> m_pendingValue;
+    std::atomic<bool> m_updatePending;
 
     DISALLOW_COPY_AND_ASSIGN(EngineEffectParameter);
 };
@@ -1,13 +1,27 @@
 #include "engine/effects/engineeffectsmanager.h"
 
+#include <QVarLengthArray>
+#include <algorithm>
+
 #include "audio/types.h"
 #include "engine/effects/engineeffect.h"
 #include "engine/effects/engineeffectchain.h"
 #include "util/defs.h"
 #include "util/sample.h"
 
-EngineEffectsManager::EngineEffectsManager(EffectsResponsePipe&& responsePipe)
+namespace {
+
+// Channels that are processed in parallel without allocating memory
+constexpr int kPreallocatedParallelChannels = 64;
+
+} // namespace
+
+EngineEffectsManager::EngineEffectsManager(
+        EffectsResponsePipe&& responsePipe, int parallelWorkerCount)
         : m_responsePipe(std::move(responsePipe)),
+          m_pWorkerPool(parallelWorkerCount > 0
+                          ? std::make_unique<EngineEffectsWorkerPool>(parallelWorkerCount)
+                          : nullptr),
           m_buffer1(kMaxEngineSamples),
           m_buffer2(kMaxEngineSamples) {
     // Try to prevent memory allocation.
@@ -62,8 +76,20 @@ void EngineEffectsManager::onCallbackStart() {
             }
             break;
         }
-        case EffectsRequest::SET_EFFECT_PARAMETERS:
         case EffectsRequest::SET_PARAMETER_PARAMETERS:
+            // Preallocated requests of EngineEffect that are reused for
+            // every update of a parameter. They are never answered.
+            processed = true;
+            VERIFY_OR_DEBUG_ASSERT(m_effects.contains(request->pTargetEffect)) {
+                // The request is owned by the effect, so the effect still
+                // exists. Allow it to send the next update.
+                request->pTargetEffect->cancelParameterUpdate(
+                        request->SetParameterParameters.iParameter);
+                break;
+            }
+            request->pTargetEffect->processEffectsRequest(*request, &m_responsePipe);
+            break;
+        case EffectsRequest::SET_EFFECT_PARAMETERS:
             VERIFY_OR_DEBUG_ASSERT(m_effects.contains(request->pTargetEffect)) {
                 response.success = false;
                 response.status = EffectsResponse::NO_SUCH_EFFECT;
@@ -90,6 +116,12 @@ void EngineEffectsManager::onCallbackStart() {
             m_responsePipe.writeMessage(response);
         }
     }
+
+    for (const auto& chains : std::as_const(m_chainsByStage)) {
+        for (EngineEffectChain* pChain : chains) {
+            pChain->onCallbackStart();
+        }
+    }
 }
 
 void EngineEffectsManager::processPreFaderInPlace(const ChannelHandle& inputHandle,
@@ -133,6 +165,86 @@ void EngineEffectsManager::processPostFaderInPlace(
             fadeout);
 }
 
+void EngineEffectsManager::processPostFaderInPlace(
+        std::span<const PostFaderChannel> channels,
+        const ChannelHandle& outputHandle,
+        std::size_t numSamples,
+        mixxx::audio::SampleRate sampleRate) {
+    if (!m_pWorkerPool || channels.size() < 2) {
+        for (const auto& channel : channels) {
+            processPostFaderInPlace(channel.inputHandle,
+                    outputHandle,
+                    channel.pInOut,
+                    numSamples,
+                    sampleRate,
+                    *channel.pGroupFeatures,
+                    channel.oldGain,
+                    channel.newGain,
+                    channel.fadeout);
+        }
+        return;
+    }
+
+    const QList<EngineEffectChain*>& chains =
+            m_chainsByStage.value(SignalProcessingStage::Postfader);
+    const auto allChains = mixxx::spanutil::spanFromPtrLen(chains.constData(), chains.size());
+    const auto channelCount = static_cast<int>(channels.size());
+
+    // The index of the first chain that shares state between the channel
+    // and another channel
+    QVarLengthArray<int, kPreallocatedParallelChannels> firstSharedChains(channelCount);
+    std::fill(firstSharedChains.begin(), firstSharedChains.end(), static_cast<int>(chains.size()));
+    QVarLengthArray<bool, kPreallocatedParallelChannels> processesSharedState(channelCount);
+    for (int chainIndex = 0; chainIndex < chains.size(); ++chainIndex) {
+        EngineEffectChain* pChain = chains[chainIndex];
+        if (!pChain) {
+            continue;
+        }
+        int sharingChannels = 0;
+        for (int i = 0; i < channelCount; ++i) {
+            processesSharedState[i] = pChain->processesSharedState(
+                    channels[i].inputHandle, outputHandle);
+            if (processesSharedState[i]) {
+                ++sharingChannels;
+            }
+        }
+        if (sharingChannels < 2) {
+            continue;
+        }
+        for (int i = 0; i < channelCount; ++i) {
+            if (processesSharedState[i]) {
+                firstSharedChains[i] = std::min(firstSharedChains[i], chainIndex);
+            }
+        }
+    }
+
+    auto processUnsharedChains = [&](int i) {
+        const PostFaderChannel& channel = channels[i];
+        SampleUtil::applyRampingGain(channel.pInOut, channel.oldGain, channel.newGain, numSamples);
+        processChainsInPlace(allChains.first(static_cast<std::size_t>(firstSharedChains[i])),
+                channel.inputHandle,
+                outputHandle,
+                channel.pInOut,
+                numSamples,
+                sampleRate,
+                *channel.pGroupFeatures,
+                channel.fadeout);
+    };
+    m_pWorkerPool->processInParallel(channelCount, processUnsharedChains);
+
+    for (int i = 0; i < channelCount; ++i) {
+        const PostFaderChannel& channel = channels[i];
+        processChainsInPlace(allChains.subspan(static_cast<std::size_t>(firstSharedChains[i])),
+                channel.inputHandle,
+                outputHandle,
+                channel.pInOut,
+                numSamples,
+                sampleRate,
+                *channel.pGroupFeatures,
+                channel.fadeout);
+    }
+}
+
 void EngineEffectsManager::processPostFaderAndMix(
         const ChannelHandle& inputHandle,
         const ChannelHandle& outputHandle,
@@ -157,6 +269,30 @@ void EngineEffectsManager::processPostFaderAndMix(
             fadeout);
 }
 
+// static
+void EngineEffectsManager::processChainsInPlace(
+        std::span<EngineEffectChain* const> chains,
+        const ChannelHandle& inputHandle,
+        const ChannelHandle& outputHandle,
+        CSAMPLE* pInOut,
+        std::size_t numSamples,
+        mixxx::audio::SampleRate sampleRate,
+        const GroupFeatureState& groupFeatures,
+        bool fadeout) {
+    for (EngineEffectChain* pChain : chains) {
+        if (pChain) {
+            pChain->process(inputHandle,
+                    outputHandle,
+                    pInOut,
+                    pInOut,
+                    numSamples,
+                    sampleRate,
+                    groupFeatures,
+                    fadeout);
+        }
+    }
+}
+
 void EngineEffectsManager::processInner(
         const SignalProcessingStage stage,
         const ChannelHandle& inputHandle,
@@ -175,19 +311,14 @@ void EngineEffectsManager::processInner(
         // Gain and effects are applied to the buffer in place,
         // modifying the original input buffer
         SampleUtil::applyRampingGain(pIn, oldGain, newGain, numSamples);
-        for (EngineEffectChain* pChain : chains) {
-            if (pChain) {
-                if (pChain->process(inputHandle,
-                            outputHandle,
-                            pIn,
-                            pOut,
-                            numSamples,
-                            sampleRate,
-                            groupFeatures,
-                            fadeout)) {
-                }
-            }
-        }
+        processChainsInPlace(mixxx::spanutil::spanFromPtrLen(chains.constData(), chains.size()),
+                inputHandle,
+                outputHandle,
+                pIn,
+                numSamples,
+                sampleRate,
+                groupFeatures,
+                fadeout);
     } else {
         // Do not modify the input buffer.
         // 1. Copy input buffer to a temporary buffer
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <memory>
+
 #include "audio/types.h"
 #include "engine/channelhandle.h"
+#include "engine/effects/engineeffectsworkerpool.h"
 #include "engine/effects/message.h"
 #include "util/samplebuffer.h"
+#include "util/span.h"
 #include "util/types.h"
 
 class EngineEffectChain;
@@ -21,7 +25,10 @@ struct GroupFeatureState;
 class EngineEffectsManager final : public EffectsRequestHandler {
   public:
     // passing by rvalue-ref because we want to ensure we're the only on with access to that pipe
-    EngineEffectsManager(EffectsResponsePipe&& responsePipe);
+    /// With parallelWorkerCount > 0, processPostFaderInPlace() for several
+    /// channels distributes them across that many worker threads and the
+    /// engine thread.
+    EngineEffectsManager(EffectsResponsePipe&& responsePipe, int parallelWorkerCount = 0);
     ~EngineEffectsManager() override = default;
 
     void onCallbackStart();
@@ -48,6 +55,31 @@ class EngineEffectsManager final : public EffectsRequestHandler {
             CSAMPLE_GAIN newGain = CSAMPLE_GAIN_ONE,
             bool fadeout = false);
 
+    /// The arguments of processPostFaderInPlace() for one of several channels
+    struct PostFaderChannel {
+        ChannelHandle inputHandle;
+        CSAMPLE* pInOut;
+        const GroupFeatureState* pGroupFeatures;
+        CSAMPLE_GAIN oldGain;
+        CSAMPLE_GAIN newGain;
+        bool fadeout;
+    };
+
+    /// Process the postfader EngineEffectChains on the buffers of several
+    /// channels, like processPostFaderInPlace() for each of them in order.
+    ///
+    /// With worker threads, the channels are processed in parallel up to the
+    /// first chain that shares state with another channel, e.g. an effect
+    /// unit that is enabled for both. The remaining chains are processed
+    /// after all channels have reached that point, one channel after another.
+    /// Therefore each chain processes the channels in the same order and with
+    /// the same results as without worker threads.
+    void processPostFaderInPlace(
+            std::span<const PostFaderChannel> channels,
+            const ChannelHandle& outputHandle,
+            std::size_t numSamples,
+            mixxx::audio::SampleRate sampleRate);
+
     /// Process the postfader EngineEffectChains, leaving the pIn buffer unmodified
     /// and mixing the output into the pOut buffer. Using EngineEffectsManager's
     /// temporary buffers for this avoids the need for ChannelMixer to allocate a
@@ -77,6 +109,17 @@ class EngineEffectsManager final : public EffectsRequestHandler {
     bool addEffectChain(EngineEffectChain* pChain, SignalProcessingStage stage);
     bool removeEffectChain(EngineEffectChain* pChain, SignalProcessingStage stage);
 
+    // Apply the chains in place, in series
+    static void processChainsInPlace(
+            std::span<EngineEffectChain* const> chains,
+            const ChannelHandle& inputHandle,
+            const ChannelHandle& outputHandle,
+            CSAMPLE* pInOut,
+            std::size_t numSamples,
+            mixxx::audio::SampleRate sampleRate,
+            const GroupFeatureState& groupFeatures,
+            bool fadeout);
+
     // Take a buffer of numSamples samples of audio from a channel, provided as
     // pInput, and apply each EngineEffectChain enabled for this channel to it,
     // putting the resulting output in pOutput. If pInput is equal to pOutput,
@@ -97,6 +140,7 @@ class EngineEffectsManager final : public EffectsRequestHandler {
             bool fadeout = false);
 
     EffectsResponsePipe m_responsePipe;
+    const std::unique_ptr<EngineEffectsWorkerPool> m_pWorkerPool;
     QHash<SignalProcessingStage, QList<EngineEffectChain*>> m_chainsByStage;
     QList<EngineEffect*> m_effects;
 
@@ -0,0 +1,158 @@
+#include "engine/effects/engineeffectsworkerpool.h"
+
+#ifdef __LINUX__
+#include <pthread.h>
+#endif
+
+#include <QtDebug>
+#include <algorithm>
+
+#include "engine/engineworker.h"
+#include "util/assert.h"
+
+class EngineEffectsWorker : public EngineWorker {
+  public:
+    explicit EngineEffectsWorker(EngineEffectsWorkerPool* pPool)
+            : m_pPool(pPool),
+              m_wakeCount(0),
+              m_stop(false),
+              m_realtimePriority(0) {
+    }
+
+    ~EngineEffectsWorker() override {
+        m_stop.store(true, std::memory_order_release);
+        wake();
+        wait();
+    }
+
+    /// Called from the engine thread. Neither takes a lock nor allocates.
+    void wake() {
+        m_wakeCount.fetch_add(1, std::memory_order_release);
+        m_wakeCount.notify_one();
+    }
+
+    void run() override {
+        QThread::currentThread()->setObjectName(QStringLiteral("EngineEffectsWorker"));
+        int wakeCount = 0;
+        while (true) {
+            // The engine thread only wakes the worker again after it has
+            // finished, so each wake up is one pass.
+            m_wakeCount.wait(wakeCount, std::memory_order_acquire);
+            ++wakeCount;
+            if (m_stop.load(std::memory_order_acquire)) {
+                return;
+            }
+            adoptEngineThreadPriority();
+            // Process the effects with the same denormals and rounding
+            // modes as the engine thread
+            std::fesetenv(&m_pPool->m_engineFloatEnvironment);
+            m_pPool->processAvailable();
+            m_pPool->workerFinished();
+        }
+    }
+
+  private:
+    void adoptEngineThreadPriority() {
+#ifdef __LINUX__
+        // QThread::TimeCriticalPriority is only a nice level on Linux, so
+        // the engine thread would wait for a worker with a lower priority.
+        const int priority = m_pPool->m_engineRealtimePriority;
+        if (priority == m_realtimePriority) {
+            return;
+        }
+        m_realtimePriority = priority;
+        struct sched_param param = {0};
+        param.sched_priority = priority;
+        if (pthread_setschedparam(pthread_self(),
+                    priority > 0 ? SCHED_FIFO : SCHED_OTHER,
+                    &param)) {
+            qWarning() << "EngineEffectsWorker: Failed to set the real-time priority"
+                       << priority;
+        }
+#endif
+    }
+
+    EngineEffectsWorkerPool* const m_pPool;
+    std::atomic<int> m_wakeCount;
+    std::atomic<bool> m_stop;
+    int m_realtimePriority;
+};
+
+EngineEffectsWorkerPool::EngineEffectsWorkerPool(int workerCount)
+        : m_pProcessFunction(nullptr),
+          m_processCallback(nullptr),
+          m_count(0),
+          m_engineRealtimePriority(0),
+          m_nextIndex(0),
+          m_busyWorkers(0) {
+    DEBUG_ASSERT(workerCount > 0);
+    qDebug() << "Effect chains will be processed with" << workerCount
+             << "workers in addition to the engine thread";
+    std::fegetenv(&m_engineFloatEnvironment);
+
+    // Started now, so the engine thread never waits for a thread to start
+    m_workers.reserve(workerCount);
+    for (int i = 0; i < workerCount; ++i) {
+        auto pWorker = std::make_unique<EngineEffectsWorker>(this);
+        pWorker->start(QThread::TimeCriticalPriority);
+        m_workers.push_back(std::move(pWorker));
+    }
+}
+
+EngineEffectsWorkerPool::~EngineEffectsWorkerPool() {
+    // Stop the workers before the members they use are destroyed
+    m_workers.clear();
+}
+
+void EngineEffectsWorkerPool::dispatch(int count) {
+    m_count = count;
+    m_nextIndex.store(0, std::memory_order_relaxed);
+
+    // The engine thread processes a channel as well, so one worker
+    // less than channels is enough.
+    const int workerCount = std::clamp(count - 1, 0, static_cast<int>(m_workers.size()));
+    if (workerCount > 0) {
+        std::fegetenv(&m_engineFloatEnvironment);
+        const std::thread::id engineThreadId = std::this_thread::get_id();
+        if (engineThreadId != m_engineThreadId) {
+            // The engine thread changes with the sound device
+            m_engineThreadId = engineThreadId;
+#ifdef __LINUX__
+            int policy;
+            struct sched_param param;
+            if (pthread_getschedparam(pthread_self(), &policy, &param) == 0) {
+                m_engineRealtimePriority =
+                        (policy == SCHED_FIFO || policy == SCHED_RR)
+                        ? param.sched_priority
+                        : 0;
+            }
+#endif
+        }
+        m_busyWorkers.store(workerCount, std::memory_order_relaxed);
+        for (int i = 0; i < workerCount; ++i) {
+            m_workers[i]->wake();
+        }
+    }
+
+    processAvailable();
+
+    // Wait for the workers that are still processing a channel or have not
+    // woken up yet
+    int busyWorkers;
+    while ((busyWorkers = m_busyWorkers.load(std::memory_order_acquire)) > 0) {
+        m_busyWorkers.wait(busyWorkers, std::memory_order_acquire);
+    }
+}
+
+void EngineEffectsWorkerPool::processAvailable() {
+    int index;
+    while ((index = m_nextIndex.fetch_add(1, std::memory_order_relaxed)) < m_count) {
+        m_processCallback(m_pProcessFunction, index);
+    }
+}
+
+void EngineEffectsWorkerPool::workerFinished() {
+    if (m_busyWorkers.fetch_sub(1, std::memory_order_release) == 1) {
+        m_busyWorkers.notify_one();
+    }
+}
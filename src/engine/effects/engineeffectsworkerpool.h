@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <cfenv>
+#include <memory>
+#include <thread>
+#include <vector>
+
+class EngineEffectsWorker;
+
+/// EngineEffectsWorkerPool lets the engine thread process the effect chains
+/// of several channels in parallel. The engine thread takes part in the
+/// processing and only returns when all channels have been processed, so
+/// the results are ready for mixing.
+///
+/// The workers are EngineWorkers that are started with the pool and wait
+/// for work without a lock. Unlike the workers of the EngineWorkerScheduler,
+/// which run after the callback, they are woken by the engine thread
+/// directly, because the callback waits for them. They adopt the real-time
+/// priority and the floating point environment of the engine thread.
+class EngineEffectsWorkerPool {
+  public:
+    explicit EngineEffectsWorkerPool(int workerCount);
+    ~EngineEffectsWorkerPool();
+
+    /// Called from the engine thread. Calls process(i) for 0 <= i < count
+    /// from the engine thread and the workers, and returns once all calls
+    /// have returned.
+    template<typename Function>
+    void processInParallel(int count, Function& process) {
+        m_pProcessFunction = &process;
+        m_processCallback = [](void* pFunction, int index) {
+            (*static_cast<Function*>(pFunction))(index);
+        };
+        dispatch(count);
+    }
+
+  private:
+    friend class EngineEffectsWorker;
+
+    void dispatch(int count);
+    /// Called from the engine thread and the workers
+    void processAvailable();
+    /// Called from a worker when processAvailable() has returned
+    void workerFinished();
+
+    std::vector<std::unique_ptr<EngineEffectsWorker>> m_workers;
+
+    // Written by the engine thread before it wakes the workers
+    void* m_pProcessFunction;
+    void (*m_processCallback)(void*, int);
+    int m_count;
+    std::fenv_t m_engineFloatEnvironment;
+    std::thread::id m_engineThreadId;
+    // The SCHED_FIFO priority of the engine thread or 0
+    int m_engineRealtimePriority;
+
+    std::atomic<int> m_nextIndex;
+    // The workers that have been woken by dispatch() and are not finished
+    // yet. Afterwards they only notify the engine thread, so dispatch() may
+    // return.
+    std::atomic<int> m_busyWorkers;
+};
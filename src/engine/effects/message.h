@@ -93,6 +93,7 @@ struct EffectsRequest {
         struct {
             bool enabled;
         } SetEffectParameters;
+        // The value is stored in the EngineEffectParameter
         struct {
             int iParameter;
         } SetParameterParameters;
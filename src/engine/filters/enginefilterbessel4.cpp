@@ -3,12 +3,6 @@
 #include "moc_enginefilterbessel4.cpp"
 #include "util/math.h"
 
-namespace {
-constexpr char kFidSpecLowPassBessel4[] = "LpBe4";
-constexpr char kFidSpecBandPassBessel4[] = "BpBe4";
-constexpr char kFidSpecHighPassBessel4[] = "HpBe4";
-} // namespace
-
 EngineFilterBessel4Low::EngineFilterBessel4Low(mixxx::audio::SampleRate sampleRate,
         double freqCorner1) {
     setFrequencyCorners(sampleRate, freqCorner1);
@@ -16,8 +10,12 @@ EngineFilterBessel4Low::EngineFilterBessel4Low(mixxx::audio::SampleRate sampleRa
 
 void EngineFilterBessel4Low::setFrequencyCorners(mixxx::audio::SampleRate sampleRate,
         double freqCorner1) {
-    // Copy the old coefficients into m_oldCoef
-    setCoefs(kFidSpecLowPassBessel4, sizeof(kFidSpecLowPassBessel4), sampleRate, freqCorner1);
+    designCoefs([=](double* pCoef) {
+        return mixxx::filterdesign::bessel(pCoef,
+                4,
+                mixxx::filterdesign::Pass::Low,
+                freqCorner1 / sampleRate);
+    });
 }
 
 int EngineFilterBessel4Low::setFrequencyCornersForIntDelay(
@@ -60,7 +58,12 @@ int EngineFilterBessel4Low::setFrequencyCornersForIntDelay(
         quantizedRatio = delayRatioTable[iDelay];
     }
 
-    setCoefs(kFidSpecLowPassBessel4, sizeof(kFidSpecLowPassBessel4), 1, quantizedRatio);
+    designCoefs([=](double* pCoef) {
+        return mixxx::filterdesign::bessel(pCoef,
+                4,
+                mixxx::filterdesign::Pass::Low,
+                quantizedRatio);
+    });
     return iDelay;
 }
 
@@ -73,11 +76,13 @@ EngineFilterBessel4Band::EngineFilterBessel4Band(mixxx::audio::SampleRate sample
 void EngineFilterBessel4Band::setFrequencyCorners(mixxx::audio::SampleRate sampleRate,
         double freqCorner1,
         double freqCorner2) {
-    setCoefs(kFidSpecBandPassBessel4,
-            sizeof(kFidSpecBandPassBessel4),
-            sampleRate,
-            freqCorner1,
-            freqCorner2);
+    designCoefs([=](double* pCoef) {
+        return mixxx::filterdesign::bessel(pCoef,
+                4,
+                mixxx::filterdesign::Pass::Band,
+                freqCorner1 / sampleRate,
+                freqCorner2 / sampleRate);
+    });
 }
 
 EngineFilterBessel4High::EngineFilterBessel4High(mixxx::audio::SampleRate sampleRate,
@@ -87,5 +92,10 @@ EngineFilterBessel4High::EngineFilterBessel4High(mixxx::audio::SampleRate sample
 
 void EngineFilterBessel4High::setFrequencyCorners(mixxx::audio::SampleRate sampleRate,
         double freqCorner1) {
-    setCoefs(kFidSpecHighPassBessel4, sizeof(kFidSpecHighPassBessel4), sampleRate, freqCorner1);
+    designCoefs([=](double* pCoef) {
+        return mixxx::filterdesign::bessel(pCoef,
+                4,
+                mixxx::filterdesign::Pass::High,
+                freqCorner1 / sampleRate);
+    });
 }
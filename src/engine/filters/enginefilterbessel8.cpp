@@ -3,12 +3,6 @@
 #include "moc_enginefilterbessel8.cpp"
 #include "util/math.h"
 
-namespace {
-constexpr char kFidSpecLowPassBessel8[] = "LpBe8";
-constexpr char kFidSpecBandPassBessel8[] = "BpBe8";
-constexpr char kFidSpecHighPassBessel8[] = "HpBe8";
-} // namespace
-
 EngineFilterBessel8Low::EngineFilterBessel8Low(mixxx::audio::SampleRate sampleRate,
         double freqCorner1) {
     setFrequencyCorners(sampleRate, freqCorner1);
@@ -16,8 +10,12 @@ EngineFilterBessel8Low::EngineFilterBessel8Low(mixxx::audio::SampleRate sampleRa
 
 void EngineFilterBessel8Low::setFrequencyCorners(mixxx::audio::SampleRate sampleRate,
         double freqCorner1) {
-    // Copy the old coefficients into m_oldCoef
-    setCoefs(kFidSpecLowPassBessel8, sizeof(kFidSpecLowPassBessel8), sampleRate, freqCorner1);
+    designCoefs([=](double* pCoef) {
+        return mixxx::filterdesign::bessel(pCoef,
+                8,
+                mixxx::filterdesign::Pass::Low,
+                freqCorner1 / sampleRate);
+    });
 }
 
 int EngineFilterBessel8Low::setFrequencyCornersForIntDelay(
@@ -67,7 +65,12 @@ int EngineFilterBessel8Low::setFrequencyCornersForIntDelay(
         quantizedRatio = delayRatioTable[iDelay];
     }
 
-    setCoefs(kFidSpecLowPassBessel8, sizeof(kFidSpecLowPassBessel8), 1, quantizedRatio);
+    designCoefs([=](double* pCoef) {
+        return mixxx::filterdesign::bessel(pCoef,
+                8,
+                mixxx::filterdesign::Pass::Low,
+                quantizedRatio);
+    });
     return iDelay;
 }
 
@@ -80,11 +83,13 @@ EngineFilterBessel8Band::EngineFilterBessel8Band(mixxx::audio::SampleRate sample
 void EngineFilterBessel8Band::setFrequencyCorners(mixxx::audio::SampleRate sampleRate,
         double freqCorner1,
         double freqCorner2) {
-    setCoefs(kFidSpecBandPassBessel8,
-            sizeof(kFidSpecBandPassBessel8),
-            sampleRate,
-            freqCorner1,
-            freqCorner2);
+    designCoefs([=](double* pCoef) {
+        return mixxx::filterdesign::bessel(pCoef,
+                8,
+                mixxx::filterdesign::Pass::Band,
+                freqCorner1 / sampleRate,
+                freqCorner2 / sampleRate);
+    });
 }
 
 EngineFilterBessel8High::EngineFilterBessel8High(mixxx::audio::SampleRate sampleRate,
@@ -94,5 +99,10 @@ EngineFilterBessel8High::EngineFilterBessel8High(mixxx::audio::SampleRate sample
 
 void EngineFilterBessel8High::setFrequencyCorners(mixxx::audio::SampleRate sampleRate,
         double freqCorner1) {
-    setCoefs(kFidSpecHighPassBessel8, sizeof(kFidSpecHighPassBessel8), sampleRate, freqCorner1);
+    designCoefs([=](double* pCoef) {
+        return mixxx::filterdesign::bessel(pCoef,
+                8,
+                mixxx::filterdesign::Pass::High,
+                freqCorner1 / sampleRate);
+    });
 }
@@ -13,8 +13,9 @@ void EngineFilterBiquad1LowShelving::setFrequencyCorners(mixxx::audio::SampleRat
         double centerFreq,
         double Q,
         double dBgain) {
-    format_fidspec(m_spec, sizeof(m_spec), "LsBq/%.10f/%.10f", Q, dBgain);
-    setCoefs(m_spec, sizeof(m_spec), sampleRate, centerFreq);
+    designCoefs([=](double* pCoef) {
+        return mixxx::filterdesign::biquadLowShelving(pCoef, centerFreq / sampleRate, Q, dBgain);
+    });
 }
 
 EngineFilterBiquad1Peaking::EngineFilterBiquad1Peaking(mixxx::audio::SampleRate sampleRate,
@@ -28,8 +29,9 @@ void EngineFilterBiquad1Peaking::setFrequencyCorners(mixxx::audio::SampleRate sa
         double centerFreq,
         double Q,
         double dBgain) {
-    format_fidspec(m_spec, sizeof(m_spec), "PkBq/%.10f/%.10f", Q, dBgain);
-    setCoefs(m_spec, sizeof(m_spec), sampleRate, centerFreq);
+    designCoefs([=](double* pCoef) {
+        return mixxx::filterdesign::biquadPeaking(pCoef, centerFreq / sampleRate, Q, dBgain);
+    });
 }
 
 EngineFilterBiquad1HighShelving::EngineFilterBiquad1HighShelving(
@@ -42,8 +44,9 @@ void EngineFilterBiquad1HighShelving::setFrequencyCorners(mixxx::audio::SampleRa
         double centerFreq,
         double Q,
         double dBgain) {
-    format_fidspec(m_spec, sizeof(m_spec), "HsBq/%.10f/%.10f", Q, dBgain);
-    setCoefs(m_spec, sizeof(m_spec), sampleRate, centerFreq);
+    designCoefs([=](double* pCoef) {
+        return mixxx::filterdesign::biquadHighShelving(pCoef, centerFreq / sampleRate, Q, dBgain);
+    });
 }
 
 EngineFilterBiquad1Low::EngineFilterBiquad1Low(mixxx::audio::SampleRate sampleRate,
@@ -57,8 +60,9 @@ EngineFilterBiquad1Low::EngineFilterBiquad1Low(mixxx::audio::SampleRate sampleRa
 void EngineFilterBiquad1Low::setFrequencyCorners(mixxx::audio::SampleRate sampleRate,
         double centerFreq,
         double Q) {
-    format_fidspec(m_spec, sizeof(m_spec), "LpBq/%.10f", Q);
-    setCoefs(m_spec, sizeof(m_spec), sampleRate, centerFreq);
+    designCoefs([=](double* pCoef) {
+        return mixxx::filterdesign::biquadLowPass(pCoef, centerFreq / sampleRate, Q);
+    });
 }
 
 EngineFilterBiquad1Band::EngineFilterBiquad1Band(mixxx::audio::SampleRate sampleRate,
@@ -70,8 +74,9 @@ EngineFilterBiquad1Band::EngineFilterBiquad1Band(mixxx::audio::SampleRate sample
 void EngineFilterBiquad1Band::setFrequencyCorners(mixxx::audio::SampleRate sampleRate,
         double centerFreq,
         double Q) {
-    format_fidspec(m_spec, sizeof(m_spec), "BpBq/%.10f", Q);
-    setCoefs(m_spec, sizeof(m_spec), sampleRate, centerFreq);
+    designCoefs([=](double* pCoef) {
+        return mixxx::filterdesign::biquadBandPass(pCoef, centerFreq / sampleRate, Q);
+    });
 }
 
 EngineFilterBiquad1High::EngineFilterBiquad1High(mixxx::audio::SampleRate sampleRate,
@@ -85,6 +90,7 @@ EngineFilterBiquad1High::EngineFilterBiquad1High(mixxx::audio::SampleRate sample
 void EngineFilterBiquad1High::setFrequencyCorners(mixxx::audio::SampleRate sampleRate,
         double centerFreq,
         double Q) {
-    format_fidspec(m_spec, sizeof(m_spec), "HpBq/%.10f", Q);
-    setCoefs(m_spec, sizeof(m_spec), sampleRate, centerFreq);
+    designCoefs([=](double* pCoef) {
+        return mixxx::filterdesign::biquadHighPass(pCoef, centerFreq / sampleRate, Q);
+    });
 }
@@ -19,9 +19,6 @@ class EngineFilterBiquad1LowShelving : public EngineFilterIIR<5, IIR_BP> {
             double centerFreq,
             double Q,
             double dBgain);
-
-  private:
-    char m_spec[FIDSPEC_LENGTH];
 };
 
 class EngineFilterBiquad1Peaking : public EngineFilterIIR<5, IIR_BP> {
@@ -32,9 +29,6 @@ class EngineFilterBiquad1Peaking : public EngineFilterIIR<5, IIR_BP> {
             double centerFreq,
             double Q,
             double dBgain);
-
-  private:
-    char m_spec[FIDSPEC_LENGTH];
 };
 
 class EngineFilterBiquad1HighShelving : public EngineFilterIIR<5, IIR_BP> {
@@ -46,9 +40,6 @@ class EngineFilterBiquad1HighShelving : public EngineFilterIIR<5, IIR_BP> {
             double centerFreq,
             double Q,
             double dBgain);
-
-  private:
-    char m_spec[FIDSPEC_LENGTH];
 };
 
 class EngineFilterBiquad1Low : public EngineFilterIIR<2, IIR_LP> {
@@ -59,9 +50,6 @@ class EngineFilterBiquad1Low : public EngineFilterIIR<2, IIR_LP> {
             double Q,
             bool startFromDry);
     void setFrequencyCorners(mixxx::audio::SampleRate sampleRate, double centerFreq, double Q);
-
-  private:
-    char m_spec[FIDSPEC_LENGTH];
 };
 
 class EngineFilterBiquad1Band : public EngineFilterIIR<2, IIR_BP> {
@@ -69,9 +57,6 @@ class EngineFilterBiquad1Band : public EngineFilterIIR<2, IIR_BP> {
   public:
     EngineFilterBiquad1Band(mixxx::audio::SampleRate sampleRate, double centerFreq, double Q);
     void setFrequencyCorners(mixxx::audio::SampleRate sampleRate, double centerFreq, double Q);
-
-  private:
-    char m_spec[FIDSPEC_LENGTH];
 };
 
 class EngineFilterBiquad1High : public EngineFilterIIR<2, IIR_HP> {
@@ -82,7 +67,4 @@ class EngineFilterBiquad1High : public EngineFilterIIR<2, IIR_HP> {
             double Q,
             bool startFromDry);
     void setFrequencyCorners(mixxx::audio::SampleRate sampleRate, double centerFreq, double Q);
-
-  private:
-    char m_spec[FIDSPEC_LENGTH];
 };
@@ -2,12 +2,6 @@
 
 #include "moc_enginefilterbutterworth4.cpp"
 
-namespace {
-constexpr char kFidSpecLowPassButterworth4[] = "LpBu4";
-constexpr char kFidSpecBandPassButterworth4[] = "BpBu4";
-constexpr char kFidSpecHighPassButterworth4[] = "HpBu4";
-} // namespace
-
 EngineFilterButterworth4Low::EngineFilterButterworth4Low(
         mixxx::audio::SampleRate sampleRate, double freqCorner1) {
     setFrequencyCorners(sampleRate, freqCorner1);
@@ -15,11 +9,12 @@ EngineFilterButterworth4Low::EngineFilterButterworth4Low(
 
 void EngineFilterButterworth4Low::setFrequencyCorners(mixxx::audio::SampleRate sampleRate,
         double freqCorner1) {
-    // Copy the old coefficients into m_oldCoef
-    setCoefs(kFidSpecLowPassButterworth4,
-            sizeof(kFidSpecLowPassButterworth4),
-            sampleRate,
-            freqCorner1);
+    designCoefs([=](double* pCoef) {
+        return mixxx::filterdesign::butterworth(pCoef,
+                4,
+                mixxx::filterdesign::Pass::Low,
+                freqCorner1 / sampleRate);
+    });
 }
 
 EngineFilterButterworth4Band::EngineFilterButterworth4Band(
@@ -32,11 +27,13 @@ EngineFilterButterworth4Band::EngineFilterButterworth4Band(
 void EngineFilterButterworth4Band::setFrequencyCorners(mixxx::audio::SampleRate sampleRate,
         double freqCorner1,
         double freqCorner2) {
-    setCoefs(kFidSpecBandPassButterworth4,
-            sizeof(kFidSpecBandPassButterworth4),
-            sampleRate,
-            freqCorner1,
-            freqCorner2);
+    designCoefs([=](double* pCoef) {
+        return mixxx::filterdesign::butterworth(pCoef,
+                4,
+                mixxx::filterdesign::Pass::Band,
+                freqCorner1 / sampleRate,
+                freqCorner2 / sampleRate);
+    });
 }
 
 EngineFilterButterworth4High::EngineFilterButterworth4High(
@@ -46,8 +43,10 @@ EngineFilterButterworth4High::EngineFilterButterworth4High(
 
 void EngineFilterButterworth4High::setFrequencyCorners(mixxx::audio::SampleRate sampleRate,
         double freqCorner1) {
-    setCoefs(kFidSpecHighPassButterworth4,
-            sizeof(kFidSpecHighPassButterworth4),
-            sampleRate,
-            freqCorner1);
+    designCoefs([=](double* pCoef) {
+        return mixxx::filterdesign::butterworth(pCoef,
+                4,
+                mixxx::filterdesign::Pass::High,
+                freqCorner1 / sampleRate);
+    });
 }
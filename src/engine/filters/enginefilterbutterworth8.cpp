@@ -2,12 +2,6 @@
 
 #include "moc_enginefilterbutterworth8.cpp"
 
-namespace {
-constexpr char kFidSpecLowPassButterworth8[] = "LpBu8";
-constexpr char kFidSpecBandPassButterworth8[] = "BpBu8";
-constexpr char kFidSpecHighPassButterworth8[] = "HpBu8";
-} // namespace
-
 EngineFilterButterworth8Low::EngineFilterButterworth8Low(
         mixxx::audio::SampleRate sampleRate, double freqCorner1) {
     setFrequencyCorners(sampleRate, freqCorner1);
@@ -15,11 +9,12 @@ EngineFilterButterworth8Low::EngineFilterButterworth8Low(
 
 void EngineFilterButterworth8Low::setFrequencyCorners(mixxx::audio::SampleRate sampleRate,
         double freqCorner1) {
-    // Copy the old coefficients into m_oldCoef
-    setCoefs(kFidSpecLowPassButterworth8,
-            sizeof(kFidSpecLowPassButterworth8),
-            sampleRate,
-            freqCorner1);
+    designCoefs([=](double* pCoef) {
+        return mixxx::filterdesign::butterworth(pCoef,
+                8,
+                mixxx::filterdesign::Pass::Low,
+                freqCorner1 / sampleRate);
+    });
 }
 
 EngineFilterButterworth8Band::EngineFilterButterworth8Band(
@@ -32,11 +27,13 @@ EngineFilterButterworth8Band::EngineFilterButterworth8Band(
 void EngineFilterButterworth8Band::setFrequencyCorners(mixxx::audio::SampleRate sampleRate,
         double freqCorner1,
         double freqCorner2) {
-    setCoefs(kFidSpecBandPassButterworth8,
-            sizeof(kFidSpecBandPassButterworth8),
-            sampleRate,
-            freqCorner1,
-            freqCorner2);
+    designCoefs([=](double* pCoef) {
+        return mixxx::filterdesign::butterworth(pCoef,
+                8,
+                mixxx::filterdesign::Pass::Band,
+                freqCorner1 / sampleRate,
+                freqCorner2 / sampleRate);
+    });
 }
 
 EngineFilterButterworth8High::EngineFilterButterworth8High(
@@ -46,8 +43,10 @@ EngineFilterButterworth8High::EngineFilterButterworth8High(
 
 void EngineFilterButterworth8High::setFrequencyCorners(mixxx::audio::SampleRate sampleRate,
         double freqCorner1) {
-    setCoefs(kFidSpecHighPassButterworth8,
-            sizeof(kFidSpecHighPassButterworth8),
-            sampleRate,
-            freqCorner1);
+    designCoefs([=](double* pCoef) {
+        return mixxx::filterdesign::butterworth(pCoef,
+                8,
+                mixxx::filterdesign::Pass::High,
+                freqCorner1 / sampleRate);
+    });
 }
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstring>
+
+#include "util/types.h"
+
+// The coefficients of a second order section
+//   H(z) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2)
+// First order sections have b2 = a2 = 0.
+struct EngineFilterSection {
+    double b0;
+    double b1;
+    double b2;
+    double a1;
+    double a2;
+};
+
+// A cascade of second order sections in transposed direct form II that
+// filters all channels of an interleaved buffer at once.
+//
+// The channels are processed in the innermost loop over contiguous
+// arrays, which allows the compiler to process them in SIMD lanes:
+// both stereo channels in a single register with double precision, or
+// all 8 channels of a stem deck in two 128 bit registers with float.
+// For this the coefficients are replicated for every channel, so that
+// each lane only needs aligned loads and no broadcasts.
+//
+// T is the type of the coefficients and the filter state. float is
+// sufficient for filters that only feed an analysis like the waveform,
+// but higher order filters with low corner frequencies need double to
+// stay accurate.
+template<typename T, unsigned int SECTIONS, unsigned int CHANNELS>
+class EngineFilterCascade {
+  public:
+    static constexpr unsigned int kSectionCount = SECTIONS;
+
+    EngineFilterCascade() {
+        // Pass through until the sections are set
+        for (unsigned int s = 0; s < SECTIONS; ++s) {
+            for (unsigned int c = 0; c < CHANNELS; ++c) {
+                m_b0[s][c] = 1;
+                m_b1[s][c] = 0;
+                m_b2[s][c] = 0;
+                m_a1[s][c] = 0;
+                m_a2[s][c] = 0;
+            }
+        }
+        clear();
+    }
+
+    // Sets the coefficients of all SECTIONS sections without
+    // touching the filter state
+    void setSections(const EngineFilterSection* pSections) {
+        for (unsigned int s = 0; s < SECTIONS; ++s) {
+            for (unsigned int c = 0; c < CHANNELS; ++c) {
+                m_b0[s][c] = static_cast<T>(pSections[s].b0);
+                m_b1[s][c] = static_cast<T>(pSections[s].b1);
+                m_b2[s][c] = static_cast<T>(pSections[s].b2);
+                m_a1[s][c] = static_cast<T>(pSections[s].a1);
+                m_a2[s][c] = static_cast<T>(pSections[s].a2);
+            }
+        }
+    }
+
+    // Resets the filter state to silence
+    void clear() {
+        std::memset(m_state1, 0, sizeof(m_state1));
+        std::memset(m_state2, 0, sizeof(m_state2));
+    }
+
+    // pIn and pOutput may point to the same buffer
+    void process(const CSAMPLE* pIn, CSAMPLE* pOutput, SINT frames) {
+        // Work on a local copy of the state, the compiler does not keep
+        // the members in registers because they might alias the buffers
+        alignas(16) T state1[SECTIONS][CHANNELS];
+        alignas(16) T state2[SECTIONS][CHANNELS];
+        std::memcpy(state1, m_state1, sizeof(state1));
+        std::memcpy(state2, m_state2, sizeof(state2));
+        for (SINT frame = 0; frame < frames; ++frame) {
+            const SINT offset = frame * CHANNELS;
+            alignas(16) T value[CHANNELS];
+            for (unsigned int c = 0; c < CHANNELS; ++c) {
+                value[c] = pIn[offset + c];
+            }
+            for (unsigned int s = 0; s < SECTIONS; ++s) {
+                // note: LOOP VECTORIZED.
+                for (unsigned int c = 0; c < CHANNELS; ++c) {
+                    const T in = value[c];
+                    const T out = m_b0[s][c] * in + state1[s][c];
+                    state1[s][c] = m_b1[s][c] * in - m_a1[s][c] * out + state2[s][c];
+                    state2[s][c] = m_b2[s][c] * in - m_a2[s][c] * out;
+                    value[c] = out;
+                }
+            }
+            for (unsigned int c = 0; c < CHANNELS; ++c) {
+                pOutput[offset + c] = static_cast<CSAMPLE>(value[c]);
+            }
+        }
+        std::memcpy(m_state1, state1, sizeof(state1));
+        std::memcpy(m_state2, state2, sizeof(state2));
+    }
+
+  private:
+    alignas(16) T m_b0[SECTIONS][CHANNELS];
+    alignas(16) T m_b1[SECTIONS][CHANNELS];
+    alignas(16) T m_b2[SECTIONS][CHANNELS];
+    alignas(16) T m_a1[SECTIONS][CHANNELS];
+    alignas(16) T m_a2[SECTIONS][CHANNELS];
+
+    alignas(16) T m_state1[SECTIONS][CHANNELS];
+    alignas(16) T m_state2[SECTIONS][CHANNELS];
+};
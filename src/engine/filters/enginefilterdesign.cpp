@@ -0,0 +1,390 @@
+#include "engine/filters/enginefilterdesign.h"
+
+#include <array>
+#include <cmath>
+#include <complex>
+
+#include "util/assert.h"
+
+// The design follows the one of fidlib step by step, including the order
+// of the filter sections and the normalization of the gain, to produce
+// identical coefficients.
+
+namespace mixxx {
+
+namespace filterdesign {
+
+namespace {
+
+typedef std::complex<double> Complex;
+
+// The poles of the Bessel low pass prototypes as tabulated by fidlib.
+// Each complex pole is given by its real and imaginary part and stands
+// for a pair of conjugate poles. Odd orders end with a single real pole.
+constexpr double kBesselPoles1[] = {
+        -1.00000000000e+00};
+constexpr double kBesselPoles2[] = {
+        -1.10160133059e+00, 6.36009824757e-01};
+constexpr double kBesselPoles3[] = {
+        -1.04740916101e+00, 9.99264436281e-01,
+        -1.32267579991e+00};
+constexpr double kBesselPoles4[] = {
+        -9.95208764350e-01, 1.25710573945e+00,
+        -1.37006783055e+00, 4.10249717494e-01};
+constexpr double kBesselPoles5[] = {
+        -9.57676548563e-01, 1.47112432073e+00,
+        -1.38087732586e+00, 7.17909587627e-01,
+        -1.50231627145e+00};
+constexpr double kBesselPoles6[] = {
+        -9.30656522947e-01, 1.66186326894e+00,
+        -1.38185809760e+00, 9.71471890712e-01,
+        -1.57149040362e+00, 3.20896374221e-01};
+constexpr double kBesselPoles7[] = {
+        -9.09867780623e-01, 1.83645135304e+00,
+        -1.37890321680e+00, 1.19156677780e+00,
+        -1.61203876622e+00, 5.89244506931e-01,
+        -1.68436817927e+00};
+constexpr double kBesselPoles8[] = {
+        -8.92869718847e-01, 1.99832584364e+00,
+        -1.37384121764e+00, 1.38835657588e+00,
+        -1.63693941813e+00, 8.22795625139e-01,
+        -1.75740840040e+00, 2.72867575103e-01};
+
+constexpr const double* kBesselPoles[kMaxOrder] = {
+        kBesselPoles1,
+        kBesselPoles2,
+        kBesselPoles3,
+        kBesselPoles4,
+        kBesselPoles5,
+        kBesselPoles6,
+        kBesselPoles7,
+        kBesselPoles8,
+};
+
+// A real pole or a pair of conjugate complex poles
+struct Pole {
+    Complex value;
+    bool isReal;
+};
+
+// The poles of a filter. A band pass has twice as many poles as its
+// prototype, but a conjugate pair is stored as a single Pole.
+struct Poles {
+    std::array<Pole, kMaxOrder> poles;
+    int size = 0;
+    int order = 0;
+};
+
+// A first or second order section with the coefficients
+// ordered by increasing delay
+struct Section {
+    double iir[3];
+    double fir[3];
+    int length;
+};
+
+struct Sections {
+    std::array<Section, kMaxOrder> sections;
+    int size = 0;
+};
+
+Poles butterworthPrototype(int order) {
+    Poles poles;
+    poles.order = order;
+    int i = 0;
+    for (; i < order - 1; i += 2) {
+        poles.poles[poles.size++] = {
+                std::polar(1.0, M_PI - (order - i - 1) * 0.5 * M_PI / order),
+                false};
+    }
+    if (i < order) {
+        poles.poles[poles.size++] = {Complex(-1.0), true};
+    }
+    return poles;
+}
+
+Poles besselPrototype(int order) {
+    const double* pPoleValues = kBesselPoles[order - 1];
+    Poles poles;
+    poles.order = order;
+    int i = 0;
+    for (; i < order - 1; i += 2) {
+        poles.poles[poles.size++] = {
+                Complex(pPoleValues[i], pPoleValues[i + 1]),
+                false};
+    }
+    if (i < order) {
+        poles.poles[poles.size++] = {Complex(pPoleValues[i]), true};
+    }
+    return poles;
+}
+
+// Compensates the frequency warping of the bilinear transform
+double prewarp(double freq) {
+    return std::tan(freq * M_PI) / M_PI;
+}
+
+void transformLowPass(Poles* pPoles, double freq) {
+    const double omega = 2 * M_PI * freq;
+    for (int i = 0; i < pPoles->size; ++i) {
+        pPoles->poles[i].value *= omega;
+    }
+}
+
+void transformHighPass(Poles* pPoles, double freq) {
+    const double omega = 2 * M_PI * freq;
+    for (int i = 0; i < pPoles->size; ++i) {
+        pPoles->poles[i].value = omega / pPoles->poles[i].value;
+    }
+}
+
+void transformBandPass(Poles* pPoles, double freq0, double freq1) {
+    const double omega0 = 2 * M_PI * std::sqrt(freq0 * freq1);
+    const double bandwidth = 0.5 * 2 * M_PI * (freq1 - freq0);
+    Poles bandPass;
+    bandPass.order = 2 * pPoles->order;
+    for (int i = 0; i < pPoles->size; ++i) {
+        const Complex hba = pPoles->poles[i].value * bandwidth;
+        const Complex ratio = omega0 / hba;
+        const Complex temp = hba * std::sqrt(1.0 - ratio * ratio);
+        if (pPoles->poles[i].isReal) {
+            // The conjugate of the resulting complex pole
+            // is the second one
+            bandPass.poles[bandPass.size++] = {hba + temp, false};
+        } else {
+            bandPass.poles[bandPass.size++] = {hba + temp, false};
+            bandPass.poles[bandPass.size++] = {hba - temp, false};
+        }
+    }
+    *pPoles = bandPass;
+}
+
+void transformBilinear(Poles* pPoles) {
+    for (int i = 0; i < pPoles->size; ++i) {
+        const Complex s = pPoles->poles[i].value;
+        pPoles->poles[i].value = (2.0 + s) / (2.0 - s);
+    }
+}
+
+// All zeros are at z = 1 (high pass) or z = -1 (low pass). A band
+// pass has the high pass zeros first.
+double zeroAt(Pass pass, int index, int order) {
+    switch (pass) {
+    case Pass::Low:
+        return -1.0;
+    case Pass::High:
+        return 1.0;
+    case Pass::Band:
+        return index < order / 2 ? 1.0 : -1.0;
+    }
+    DEBUG_ASSERT(!"unreachable");
+    return 0.0;
+}
+
+Sections makeSections(const Poles& poles, Pass pass) {
+    Sections sections;
+    int zeroIndex = 0;
+    for (int i = 0; i < poles.size; ++i) {
+        const Pole& pole = poles.poles[i];
+        Section& section = sections.sections[sections.size++];
+        if (pole.isReal) {
+            // Only the last pole of an odd order low or high pass is real
+            DEBUG_ASSERT(i == poles.size - 1);
+            const double zero = zeroAt(pass, zeroIndex++, poles.order);
+            section.length = 2;
+            section.iir[0] = 1.0;
+            section.iir[1] = -pole.value.real();
+            section.fir[0] = 1.0;
+            section.fir[1] = -zero;
+        } else {
+            const double zero0 = zeroAt(pass, zeroIndex++, poles.order);
+            const double zero1 = zeroAt(pass, zeroIndex++, poles.order);
+            section.length = 3;
+            section.iir[0] = 1.0;
+            section.iir[1] = -2 * pole.value.real();
+            section.iir[2] = std::norm(pole.value);
+            section.fir[0] = 1.0;
+            section.fir[1] = -(zero0 + zero1);
+            section.fir[2] = zero0 * zero1;
+        }
+    }
+    return sections;
+}
+
+Complex evaluate(const double* pCoef, int length, Complex z) {
+    Complex result = pCoef[0];
+    Complex powerOfZ = 1.0;
+    for (int i = 1; i < length; ++i) {
+        powerOfZ *= z;
+        result += pCoef[i] * powerOfZ;
+    }
+    return result;
+}
+
+// The magnitude response at freq (as a ratio of the sample rate)
+double response(const Sections& sections, double freq) {
+    const Complex z = std::polar(1.0, 2 * M_PI * freq);
+    Complex top = 1.0;
+    Complex bottom = 1.0;
+    for (int i = 0; i < sections.size; ++i) {
+        const Section& section = sections.sections[i];
+        top *= evaluate(section.fir, section.length, z);
+        bottom *= evaluate(section.iir, section.length, z);
+    }
+    return std::abs(top / bottom);
+}
+
+// Searches the peak of a band pass between freq0 and freq3 with the
+// same fixed number of subdivisions as fidlib
+double searchPeak(const Sections& sections, double freq0, double freq3) {
+    for (int i = 0; i < 20; ++i) {
+        const double freq1 = 0.51 * freq0 + 0.49 * freq3;
+        const double freq2 = 0.49 * freq0 + 0.51 * freq3;
+        if (freq1 == freq2) {
+            break;
+        }
+        if (response(sections, freq1) > response(sections, freq2)) {
+            freq3 = freq2;
+        } else {
+            freq0 = freq1;
+        }
+    }
+    return (freq0 + freq3) * 0.5;
+}
+
+double design(double* pCoef, Poles poles, Pass pass, double freq0, double freq1) {
+    DEBUG_ASSERT(freq0 > 0.0 && freq0 < 0.5);
+    switch (pass) {
+    case Pass::Low:
+        transformLowPass(&poles, prewarp(freq0));
+        break;
+    case Pass::Band:
+        DEBUG_ASSERT(freq1 > freq0 && freq1 < 0.5);
+        transformBandPass(&poles, prewarp(freq0), prewarp(freq1));
+        break;
+    case Pass::High:
+        transformHighPass(&poles, prewarp(freq0));
+        break;
+    }
+    transformBilinear(&poles);
+    const Sections sections = makeSections(poles, pass);
+
+    for (int i = 0; i < sections.size; ++i) {
+        const Section& section = sections.sections[i];
+        for (int j = section.length - 1; j > 0; --j) {
+            *pCoef++ = section.iir[j];
+        }
+    }
+
+    switch (pass) {
+    case Pass::Low:
+        return 1.0 / response(sections, 0.0);
+    case Pass::Band:
+        return 1.0 / response(sections, searchPeak(sections, freq0, freq1));
+    case Pass::High:
+        return 1.0 / response(sections, 0.5);
+    }
+    DEBUG_ASSERT(!"unreachable");
+    return 1.0;
+}
+
+// Writes a biquad with variable feedforward coefficients
+double biquad(double* pCoef, const double (&iir)[3], const double (&fir)[3]) {
+    const double adj = 1.0 / iir[0];
+    pCoef[0] = adj * iir[2];
+    pCoef[1] = fir[2];
+    pCoef[2] = adj * iir[1];
+    pCoef[3] = fir[1];
+    pCoef[4] = fir[0];
+    return adj;
+}
+
+} // anonymous namespace
+
+double butterworth(double* pCoef, int order, Pass pass, double freq0, double freq1) {
+    VERIFY_OR_DEBUG_ASSERT(order > 0 && order <= kMaxOrder) {
+        return 0.0;
+    }
+    return design(pCoef, butterworthPrototype(order), pass, freq0, freq1);
+}
+
+double bessel(double* pCoef, int order, Pass pass, double freq0, double freq1) {
+    VERIFY_OR_DEBUG_ASSERT(order > 0 && order <= kMaxOrder) {
+        return 0.0;
+    }
+    return design(pCoef, besselPrototype(order), pass, freq0, freq1);
+}
+
+double biquadLowPass(double* pCoef, double freq0, double Q) {
+    const double omega = 2 * M_PI * freq0;
+    const double cosv = std::cos(omega);
+    const double alpha = std::sin(omega) / 2 / Q;
+    const double adj = 1.0 / (1 + alpha);
+    pCoef[0] = adj * (1 - alpha);
+    pCoef[1] = adj * (-2 * cosv);
+    return adj * ((1 - cosv) * 0.5);
+}
+
+double biquadBandPass(double* pCoef, double freq0, double Q) {
+    const double omega = 2 * M_PI * freq0;
+    const double cosv = std::cos(omega);
+    const double alpha = std::sin(omega) / 2 / Q;
+    const double adj = 1.0 / (1 + alpha);
+    pCoef[0] = adj * (1 - alpha);
+    pCoef[1] = adj * (-2 * cosv);
+    return adj * alpha;
+}
+
+double biquadHighPass(double* pCoef, double freq0, double Q) {
+    const double omega = 2 * M_PI * freq0;
+    const double cosv = std::cos(omega);
+    const double alpha = std::sin(omega) / 2 / Q;
+    const double adj = 1.0 / (1 + alpha);
+    pCoef[0] = adj * (1 - alpha);
+    pCoef[1] = adj * (-2 * cosv);
+    return adj * ((1 + cosv) * 0.5);
+}
+
+double biquadPeaking(double* pCoef, double freq0, double Q, double dBgain) {
+    const double omega = 2 * M_PI * freq0;
+    const double cosv = std::cos(omega);
+    const double alpha = std::sin(omega) / 2 / Q;
+    const double A = std::pow(10, dBgain / 40);
+    return biquad(pCoef,
+            {1 + alpha / A, -2 * cosv, 1 - alpha / A},
+            {1 + alpha * A, -2 * cosv, 1 - alpha * A});
+}
+
+double biquadLowShelving(double* pCoef, double freq0, double Q, double dBgain) {
+    const double omega = 2 * M_PI * freq0;
+    const double cosv = std::cos(omega);
+    const double sinv = std::sin(omega);
+    const double A = std::pow(10, dBgain / 40);
+    const double beta = std::sqrt((A * A + 1) / Q - (A - 1) * (A - 1));
+    return biquad(pCoef,
+            {(A + 1) + (A - 1) * cosv + beta * sinv,
+                    -2 * ((A - 1) + (A + 1) * cosv),
+                    (A + 1) + (A - 1) * cosv - beta * sinv},
+            {A * ((A + 1) - (A - 1) * cosv + beta * sinv),
+                    2 * A * ((A - 1) - (A + 1) * cosv),
+                    A * ((A + 1) - (A - 1) * cosv - beta * sinv)});
+}
+
+double biquadHighShelving(double* pCoef, double freq0, double Q, double dBgain) {
+    const double omega = 2 * M_PI * freq0;
+    const double cosv = std::cos(omega);
+    const double sinv = std::sin(omega);
+    const double A = std::pow(10, dBgain / 40);
+    const double beta = std::sqrt((A * A + 1) / Q - (A - 1) * (A - 1));
+    return biquad(pCoef,
+            {(A + 1) - (A - 1) * cosv + beta * sinv,
+                    2 * ((A - 1) - (A + 1) * cosv),
+                    (A + 1) - (A - 1) * cosv - beta * sinv},
+            {A * ((A + 1) + (A - 1) * cosv + beta * sinv),
+                    -2 * A * ((A - 1) + (A + 1) * cosv),
+                    A * ((A + 1) + (A - 1) * cosv - beta * sinv)});
+}
+
+} // namespace filterdesign
+
+} // namespace mixxx
@@ -0,0 +1,54 @@
+#pragma once
+
+// Realtime-safe design of the coefficients for EngineFilterIIR.
+//
+// The functions below produce the same coefficients as fid_design_coef()
+// in the layout expected by EngineFilterIIR::processSample(), but they
+// neither parse a spec string nor allocate memory and can therefore be
+// called from the engine thread whenever a filter frequency changes.
+//
+// All frequencies are given as a ratio of the sample rate (0 to 0.5).
+// Each function writes the coefficients to pCoef and returns the overall
+// gain that belongs into coef[0] of EngineFilterIIR.
+
+namespace mixxx {
+
+namespace filterdesign {
+
+enum class Pass {
+    Low,
+    Band,
+    High,
+};
+
+// Highest supported order of the Bessel and Butterworth prototypes.
+// A band pass doubles the order.
+constexpr int kMaxOrder = 8;
+
+// Writes order coefficients for a low or high pass and 2 * order
+// coefficients for a band pass from freq0 to freq1.
+// Same as fidlib "LpBu<order>", "BpBu<order>" and "HpBu<order>".
+double butterworth(double* pCoef, int order, Pass pass, double freq0, double freq1 = 0);
+
+// Writes order coefficients for a low or high pass and 2 * order
+// coefficients for a band pass from freq0 to freq1.
+// Same as fidlib "LpBe<order>", "BpBe<order>" and "HpBe<order>".
+double bessel(double* pCoef, int order, Pass pass, double freq0, double freq1 = 0);
+
+// The RBJ cookbook biquads. The low, band and high passes write the two
+// feedback coefficients, because their feedforward coefficients are
+// constant. Same as fidlib "LpBq/<Q>", "BpBq/<Q>" and "HpBq/<Q>".
+double biquadLowPass(double* pCoef, double freq0, double Q);
+double biquadBandPass(double* pCoef, double freq0, double Q);
+double biquadHighPass(double* pCoef, double freq0, double Q);
+
+// The RBJ cookbook biquads with a variable gain. These write the two
+// feedback and the three feedforward coefficients interleaved.
+// Same as fidlib "PkBq/<Q>/<dB>", "LsBq/<Q>/<dB>" and "HsBq/<Q>/<dB>".
+double biquadPeaking(double* pCoef, double freq0, double Q, double dBgain);
+double biquadLowShelving(double* pCoef, double freq0, double Q, double dBgain);
+double biquadHighShelving(double* pCoef, double freq0, double Q, double dBgain);
+
+} // namespace filterdesign
+
+} // namespace mixxx
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 
@@ -7,6 +8,8 @@
 #include <fidlib.h>
 
 #include "engine/engine.h"
+#include "engine/filters/enginefiltercascade.h"
+#include "engine/filters/enginefilterdesign.h"
 #include "engine/engineobject.h"
 #include "util/sample.h"
 
@@ -83,16 +86,79 @@ class EngineFilterIIR : public EngineFilterIIRBase {
         pauseFilterInner();
     }
 
+    // The number of first or second order sections of the cascade
+    static constexpr unsigned int kSectionCount =
+            (PASS == IIR_LPMO || PASS == IIR_HPMO || PASS == IIR_LP2 || PASS == IIR_HP2)
+            ? SIZE
+            : (SIZE == 5 ? 1 : SIZE / 2);
+
+    // Converts the gain and the SIZE coefficients in the layout of
+    // processSample() into the sections of an EngineFilterCascade.
+    // The gain is applied to the feed forward part of the first section.
+    static void coefsToSections(const double* coef, EngineFilterSection* pSections) {
+        double gain = coef[0];
+        if constexpr (SIZE == 5) {
+            pSections[0] = {coef[5], coef[4], coef[2], coef[3], coef[1]};
+        } else if constexpr (PASS == IIR_LPMO || PASS == IIR_LP2) {
+            for (unsigned int i = 0; i < kSectionCount; ++i) {
+                pSections[i] = {1, 1, 0, coef[i + 1], 0};
+            }
+        } else if constexpr (PASS == IIR_HPMO || PASS == IIR_HP2) {
+            if constexpr (PASS == IIR_HP2) {
+                // swap gain to be in phase with LP2
+                gain = -gain;
+            }
+            for (unsigned int i = 0; i < kSectionCount; ++i) {
+                pSections[i] = {1, -1, 0, coef[i + 1], 0};
+            }
+        } else {
+            for (unsigned int i = 0; i < kSectionCount; ++i) {
+                double b1;
+                double b2 = 1;
+                if constexpr (PASS == IIR_LP) {
+                    b1 = 2;
+                } else if constexpr (PASS == IIR_HP) {
+                    b1 = -2;
+                } else if constexpr (SIZE == 2) {
+                    // IIR_BP
+                    b1 = 0;
+                    b2 = -1;
+                } else {
+                    // IIR_BP: high pass sections followed by low pass sections
+                    b1 = i < kSectionCount / 2 ? -2 : 2;
+                }
+                pSections[i] = {1, b1, b2, coef[2 * i + 2], coef[2 * i + 1]};
+            }
+        }
+        pSections[0].b0 *= gain;
+        pSections[0].b1 *= gain;
+        pSections[0].b2 *= gain;
+    }
+
     void initBuffers() {
-        // Copy the current buffers into the old buffers
-        memcpy(m_oldBuf1, m_buf1, sizeof(m_buf1));
-        memcpy(m_oldBuf2, m_buf2, sizeof(m_buf2));
-        // Set the current buffers to 0
-        memset(m_buf1, 0, sizeof(m_buf1));
-        memset(m_buf2, 0, sizeof(m_buf2));
+        // Keep the current filter with its state for the cross fade
+        m_oldCascade = m_cascade;
+        // Start the new filter from silence
+        m_cascade.clear();
+        EngineFilterSection sections[kSectionCount];
+        coefsToSections(m_coef, sections);
+        m_cascade.setSections(sections);
         m_doRamping = true;
     }
 
+    // Replaces the coefficients by those of designFunction, which writes
+    // SIZE coefficients and returns the gain like the functions in
+    // engine/filters/enginefilterdesign.h. Unlike setCoefs() this is safe
+    // to call from the engine thread.
+    template<typename DesignFunction>
+    void designCoefs(DesignFunction designFunction) {
+        m_coef[0] = designFunction(m_coef + 1);
+
+        initBuffers();
+    }
+
+    // Designs the coefficients with fidlib, which parses the spec and
+    // allocates memory. Use designCoefs() in the engine thread instead.
     void setCoefs(const char* spec,
             std::size_t bufsize,
             double sampleRate,
@@ -106,9 +172,6 @@ class EngineFilterIIR : public EngineFilterIIRBase {
         // Copy to dynamic-ish memory to prevent fidlib API breakage.
         std::strncpy(spec_d, spec, bufsize);
 
-        // Copy the old coefficients into m_oldCoef
-        memcpy(m_oldCoef, m_coef, sizeof(m_coef));
-
         m_coef[0] = fid_design_coef(m_coef + 1, SIZE, spec_d, sampleRate, freq0, freq1, adj);
 
         initBuffers();
@@ -144,93 +207,6 @@ class EngineFilterIIR : public EngineFilterIIRBase {
 #endif
     }
 
-    void setCoefs2(double sampleRate,
-            int n_coef1,
-            const char* spec1,
-            size_t spec1size,
-            double freq01,
-            double freq11,
-            int adj1,
-            const char* spec2,
-            size_t spec2size,
-            double freq02,
-            double freq12,
-            int adj2) {
-        char spec1_d[FIDSPEC_LENGTH];
-        char spec2_d[FIDSPEC_LENGTH];
-        VERIFY_OR_DEBUG_ASSERT(spec1size <= sizeof(spec1_d) && spec2size <= sizeof(spec2_d)) {
-            return;
-        }
-
-        // Copy to dynamic-ish memory to prevent fidlib API breakage.
-        std::strncpy(spec1_d, spec1, spec1size);
-        std::strncpy(spec2_d, spec2, spec2size);
-        spec1_d[FIDSPEC_LENGTH - 1] = '\0';
-        spec2_d[FIDSPEC_LENGTH - 1] = '\0';
-
-        // Copy the old coefficients into m_oldCoef
-        memcpy(m_oldCoef, m_coef, sizeof(m_coef));
-        m_coef[0] = fid_design_coef(m_coef + 1,
-                            n_coef1,
-                            spec1,
-                            sampleRate,
-                            freq01,
-                            freq11,
-                            adj1) *
-                fid_design_coef(m_coef + 1 + n_coef1,
-                        SIZE - n_coef1,
-                        spec2,
-                        sampleRate,
-                        freq02,
-                        freq12,
-                        adj2);
-
-        initBuffers();
-
-#if(IIR_ANALYSIS)
-        char* desc1;
-        char* desc2;
-        FidFilter* filt1 = fid_design(spec1, sampleRate, freq01, freq11, adj1, &desc1);
-        FidFilter* filt2 = fid_design(spec2, sampleRate, freq02, freq12, adj2, &desc2);
-        FidFilter* filt = fid_cat(1, filt1, filt2, NULL);
-        int delay = fid_calc_delay(filt);
-        qDebug() << QString().fromLatin1(desc1) << "X"
-                 << QString().fromLatin1(desc2);
-        qDebug() << spec1 << "X" << spec2 << "delay:" << delay;
-        free(desc1);
-        free(desc2);
-
-        double resp0, phase0;
-        resp0 = fid_response_pha(filt, freq01 / sampleRate, &phase0);
-        qDebug() << "freq01:" << freq01 << resp0 << phase0;
-        resp0 = fid_response_pha(filt, freq01 / sampleRate, &phase0);
-        qDebug() << "freq02:" << freq02 << resp0 << phase0;
-        if (freq11) {
-            double resp1, phase1;
-            resp1 = fid_response_pha(filt, freq11 / sampleRate, &phase1);
-            qDebug() << "freq1:" << freq11 << resp1 << phase1;
-        }
-        if (freq12) {
-            double resp1, phase1;
-            resp1 = fid_response_pha(filt, freq12 / sampleRate, &phase1);
-            qDebug() << "freq1:" << freq12 << resp1 << phase1;
-        }
-        double resp2, phase2;
-        resp2 = fid_response_pha(filt, freq01 / sampleRate / 2, &phase2);
-        qDebug() << "freq2:" << freq01 / 2 << resp2 << phase2;
-        double resp3, phase3;
-        resp3 = fid_response_pha(filt, freq01 / sampleRate * 2, &phase3);
-        qDebug() << "freq3:" << freq01 * 2 << resp3 << phase3;
-        double resp4, phase4;
-        resp4 = fid_response_pha(filt, freq01 / sampleRate / 2.2, &phase4);
-        qDebug() << "freq4:" << freq01 / 2.2 << resp4 << phase4;
-        double resp5, phase5;
-        resp5 = fid_response_pha(filt, freq01 / sampleRate * 2.2, &phase5);
-        qDebug() << "freq5:" << freq01 * 2.2 << resp5 << phase5;
-        free(filt);
-#endif
-    }
-
     virtual void assumeSettled() {
         m_doRamping = false;
         m_doStart = false;
@@ -238,52 +214,57 @@ class EngineFilterIIR : public EngineFilterIIRBase {
 
     virtual void process(const CSAMPLE* pIn, CSAMPLE* pOutput, const std::size_t bufferSize) {
         if (!m_doRamping) {
-            for (std::size_t i = 0; i < bufferSize; i += 2) {
-                pOutput[i] = static_cast<CSAMPLE>(processSample(m_coef, m_buf1, pIn[i]));
-                pOutput[i + 1] = static_cast<CSAMPLE>(processSample(m_coef, m_buf2, pIn[i + 1]));
-            }
+            m_cascade.process(pIn,
+                    pOutput,
+                    static_cast<SINT>(bufferSize / mixxx::kEngineChannelOutputCount));
         } else {
+            // The old filter is processed in blocks into a buffer on the
+            // stack, to profit from the vectorized cascade during ramping.
+            CSAMPLE oldBuffer[kRampingBlockSize];
             double cross_mix = 0.0;
             double cross_inc = 4.0 / static_cast<double>(bufferSize);
-            for (std::size_t i = 0; i < bufferSize; i += 2) {
-                // Do a linear cross fade between the output of the old
-                // Filter and the new filter.
-                // The new filter is settled for Input = 0 and it sees
-                // all frequencies of the rectangular start impulse.
-                // Since the group delay, after which the start impulse
-                // has passed is unknown here, we just what the half
-                // bufferSize until we use the samples of the new filter.
-                // In one of the previous version we have faded the Input
-                // of the new filter but it turns out that this produces
-                // a gain drop due to the filter delay which is more
-                // conspicuous than the settling noise.
-                double old1;
-                double old2;
+            for (std::size_t blockStart = 0; blockStart < bufferSize;
+                    blockStart += kRampingBlockSize) {
+                const std::size_t blockSize = std::min(kRampingBlockSize, bufferSize - blockStart);
+                const SINT blockSamples = static_cast<SINT>(blockSize);
+                const SINT blockFrames = blockSamples / mixxx::kEngineChannelOutputCount;
+                const CSAMPLE* pBlockIn = pIn + blockStart;
+                CSAMPLE* pBlockOutput = pOutput + blockStart;
                 if (!m_doStart) {
                     // Process old filter, but only if we do not do a fresh start
-                    old1 = static_cast<CSAMPLE>(processSample(m_oldCoef, m_oldBuf1, pIn[i]));
-                    old2 = static_cast<CSAMPLE>(processSample(m_oldCoef, m_oldBuf2, pIn[i + 1]));
+                    m_oldCascade.process(pBlockIn, oldBuffer, blockFrames);
+                } else if (m_startFromDry) {
+                    SampleUtil::copy(oldBuffer, pBlockIn, blockSamples);
                 } else {
-                    if (m_startFromDry) {
-                        old1 = pIn[i];
-                        old2 = pIn[i + 1];
+                    SampleUtil::clear(oldBuffer, blockSamples);
+                }
+                // This may overwrite pBlockIn, which is no longer needed
+                m_cascade.process(pBlockIn, pBlockOutput, blockFrames);
+
+                for (std::size_t i = 0; i < blockSize; i += 2) {
+                    // Do a linear cross fade between the output of the old
+                    // Filter and the new filter.
+                    // The new filter is settled for Input = 0 and it sees
+                    // all frequencies of the rectangular start impulse.
+                    // Since the group delay, after which the start impulse
+                    // has passed is unknown here, we just what the half
+                    // bufferSize until we use the samples of the new filter.
+                    // In one of the previous version we have faded the Input
+                    // of the new filter but it turns out that this produces
+                    // a gain drop due to the filter delay which is more
+                    // conspicuous than the settling noise.
+                    if (blockStart + i < bufferSize / 2) {
+                        pBlockOutput[i] = oldBuffer[i];
+                        pBlockOutput[i + 1] = oldBuffer[i + 1];
                     } else {
-                        old1 = 0;
-                        old2 = 0;
+                        pBlockOutput[i] = static_cast<CSAMPLE>(pBlockOutput[i] * cross_mix +
+                                oldBuffer[i] * (1.0 - cross_mix));
+                        pBlockOutput[i + 1] = static_cast<CSAMPLE>(
+                                pBlockOutput[i + 1] * cross_mix +
+                                oldBuffer[i + 1] * (1.0 - cross_mix));
+                        cross_mix += cross_inc;
                     }
                 }
-                double new1 = static_cast<CSAMPLE>(processSample(m_coef, m_buf1, pIn[i]));
-                double new2 = static_cast<CSAMPLE>(processSample(m_coef, m_buf2, pIn[i + 1]));
-
-                if (i < bufferSize / 2) {
-                    pOutput[i] = static_cast<CSAMPLE>(old1);
-                    pOutput[i + 1] = static_cast<CSAMPLE>(old2);
-                } else {
-                    pOutput[i] = static_cast<CSAMPLE>(new1 * cross_mix + old1 * (1.0 - cross_mix));
-                    pOutput[i + 1] = static_cast<CSAMPLE>(
-                            new2 * cross_mix + old2 * (1.0 - cross_mix));
-                    cross_mix += cross_inc;
-                }
             }
             m_doRamping = false;
             m_doStart = false;
@@ -291,28 +272,26 @@ class EngineFilterIIR : public EngineFilterIIRBase {
     }
 
   protected:
-    inline double processSample(double* coef, double* buf, double val);
+    // The reference implementation of a single channel in direct form II,
+    // which documents the layout of the coefficients designed by fidlib.
+    // process() uses the equivalent m_cascade.
+    static inline double processSample(double* coef, double* buf, double val);
     inline void pauseFilterInner() {
-        // Set the current buffers to 0
-        memset(m_buf1, 0, sizeof(m_buf1));
-        memset(m_buf2, 0, sizeof(m_buf2));
+        // Set the current state to 0
+        m_cascade.clear();
         m_doRamping = true;
         m_doStart = true;
     }
 
+    // Samples of the old filter that are processed at once during ramping
+    static constexpr std::size_t kRampingBlockSize = 128;
+
     double m_coef[SIZE + 1];
-    // Old coefficients needed for ramping
-    double m_oldCoef[SIZE + 1];
-
-    // Channel 1 state
-    double m_buf1[SIZE];
-    // Old channel 1 buffer needed for ramping
-    double m_oldBuf1[SIZE];
-
-    // Channel 2 state
-    double m_buf2[SIZE];
-    // Old channel 2 buffer needed for ramping
-    double m_oldBuf2[SIZE];
+
+    // The filter for both channels
+    EngineFilterCascade<double, kSectionCount, mixxx::kEngineChannelOutputCount> m_cascade;
+    // Old filter needed for ramping
+    EngineFilterCascade<double, kSectionCount, mixxx::kEngineChannelOutputCount> m_oldCascade;
 
     // Flag set to true if ramping needs to be done
     bool m_doRamping;
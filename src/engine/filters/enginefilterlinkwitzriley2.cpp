@@ -2,11 +2,6 @@
 
 #include "moc_enginefilterlinkwitzriley2.cpp"
 
-namespace {
-constexpr char kFidSpecLowPassButterworth1[] = "LpBu1";
-constexpr char kFidSpecHighPassButterworth1[] = "HpBu1";
-} // namespace
-
 EngineFilterLinkwitzRiley2Low::EngineFilterLinkwitzRiley2Low(
         mixxx::audio::SampleRate sampleRate, double freqCorner1) {
     setFrequencyCorners(sampleRate, freqCorner1);
@@ -14,19 +9,14 @@ EngineFilterLinkwitzRiley2Low::EngineFilterLinkwitzRiley2Low(
 
 void EngineFilterLinkwitzRiley2Low::setFrequencyCorners(mixxx::audio::SampleRate sampleRate,
         double freqCorner1) {
-    // Copy the old coefficients into m_oldCoef
-    setCoefs2(sampleRate,
-            1,
-            kFidSpecLowPassButterworth1,
-            sizeof(kFidSpecLowPassButterworth1),
-            freqCorner1,
-            0,
-            0,
-            kFidSpecLowPassButterworth1,
-            sizeof(kFidSpecLowPassButterworth1),
-            freqCorner1,
-            0,
-            0);
+    // A Linkwitz-Riley filter is two cascaded Butterworth filters
+    designCoefs([=](double* pCoef) {
+        const double freq = freqCorner1 / sampleRate;
+        return mixxx::filterdesign::butterworth(
+                       pCoef, 1, mixxx::filterdesign::Pass::Low, freq) *
+                mixxx::filterdesign::butterworth(
+                        pCoef + 1, 1, mixxx::filterdesign::Pass::Low, freq);
+    });
 }
 
 EngineFilterLinkwitzRiley2High::EngineFilterLinkwitzRiley2High(
@@ -36,16 +26,11 @@ EngineFilterLinkwitzRiley2High::EngineFilterLinkwitzRiley2High(
 
 void EngineFilterLinkwitzRiley2High::setFrequencyCorners(mixxx::audio::SampleRate sampleRate,
         double freqCorner1) {
-    setCoefs2(sampleRate,
-            1,
-            kFidSpecHighPassButterworth1,
-            sizeof(kFidSpecHighPassButterworth1),
-            freqCorner1,
-            0,
-            0,
-            kFidSpecHighPassButterworth1,
-            sizeof(kFidSpecHighPassButterworth1),
-            freqCorner1,
-            0,
-            0);
+    designCoefs([=](double* pCoef) {
+        const double freq = freqCorner1 / sampleRate;
+        return mixxx::filterdesign::butterworth(
+                       pCoef, 1, mixxx::filterdesign::Pass::High, freq) *
+                mixxx::filterdesign::butterworth(
+                        pCoef + 1, 1, mixxx::filterdesign::Pass::High, freq);
+    });
 }
@@ -2,11 +2,6 @@
 
 #include "moc_enginefilterlinkwitzriley4.cpp"
 
-namespace {
-constexpr char kFidSpecLowPassButterworth2[] = "LpBu2";
-constexpr char kFidSpecHighPassButterworth2[] = "HpBu2";
-} // namespace
-
 EngineFilterLinkwitzRiley4Low::EngineFilterLinkwitzRiley4Low(
         mixxx::audio::SampleRate sampleRate, double freqCorner1) {
     setFrequencyCorners(sampleRate, freqCorner1);
@@ -14,19 +9,14 @@ EngineFilterLinkwitzRiley4Low::EngineFilterLinkwitzRiley4Low(
 
 void EngineFilterLinkwitzRiley4Low::setFrequencyCorners(mixxx::audio::SampleRate sampleRate,
         double freqCorner1) {
-    // Copy the old coefficients into m_oldCoef
-    setCoefs2(sampleRate,
-            2,
-            kFidSpecLowPassButterworth2,
-            sizeof(kFidSpecLowPassButterworth2),
-            freqCorner1,
-            0,
-            0,
-            kFidSpecLowPassButterworth2,
-            sizeof(kFidSpecLowPassButterworth2),
-            freqCorner1,
-            0,
-            0);
+    // A Linkwitz-Riley filter is two cascaded Butterworth filters
+    designCoefs([=](double* pCoef) {
+        const double freq = freqCorner1 / sampleRate;
+        return mixxx::filterdesign::butterworth(
+                       pCoef, 2, mixxx::filterdesign::Pass::Low, freq) *
+                mixxx::filterdesign::butterworth(
+                        pCoef + 2, 2, mixxx::filterdesign::Pass::Low, freq);
+    });
 }
 
 EngineFilterLinkwitzRiley4High::EngineFilterLinkwitzRiley4High(
@@ -36,16 +26,11 @@ EngineFilterLinkwitzRiley4High::EngineFilterLinkwitzRiley4High(
 
 void EngineFilterLinkwitzRiley4High::setFrequencyCorners(mixxx::audio::SampleRate sampleRate,
         double freqCorner1) {
-    setCoefs2(sampleRate,
-            2,
-            kFidSpecHighPassButterworth2,
-            sizeof(kFidSpecHighPassButterworth2),
-            freqCorner1,
-            0,
-            0,
-            kFidSpecHighPassButterworth2,
-            sizeof(kFidSpecHighPassButterworth2),
-            freqCorner1,
-            0,
-            0);
+    designCoefs([=](double* pCoef) {
+        const double freq = freqCorner1 / sampleRate;
+        return mixxx::filterdesign::butterworth(
+                       pCoef, 2, mixxx::filterdesign::Pass::High, freq) *
+                mixxx::filterdesign::butterworth(
+                        pCoef + 2, 2, mixxx::filterdesign::Pass::High, freq);
+    });
 }
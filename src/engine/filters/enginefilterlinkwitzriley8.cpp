@@ -2,11 +2,6 @@
 
 #include "moc_enginefilterlinkwitzriley8.cpp"
 
-namespace {
-constexpr char kFidSpecLowPassButterworth4[] = "LpBu4";
-constexpr char kFidSpecHighPassButterworth4[] = "HpBu4";
-} // namespace
-
 EngineFilterLinkwitzRiley8Low::EngineFilterLinkwitzRiley8Low(
         mixxx::audio::SampleRate sampleRate, double freqCorner1) {
     setFrequencyCorners(sampleRate, freqCorner1);
@@ -14,19 +9,14 @@ EngineFilterLinkwitzRiley8Low::EngineFilterLinkwitzRiley8Low(
 
 void EngineFilterLinkwitzRiley8Low::setFrequencyCorners(mixxx::audio::SampleRate sampleRate,
         double freqCorner1) {
-    // Copy the old coefficients into m_oldCoef
-    setCoefs2(sampleRate,
-            4,
-            kFidSpecLowPassButterworth4,
-            sizeof(kFidSpecLowPassButterworth4),
-            freqCorner1,
-            0,
-            0,
-            kFidSpecLowPassButterworth4,
-            sizeof(kFidSpecLowPassButterworth4),
-            freqCorner1,
-            0,
-            0);
+    // A Linkwitz-Riley filter is two cascaded Butterworth filters
+    designCoefs([=](double* pCoef) {
+        const double freq = freqCorner1 / sampleRate;
+        return mixxx::filterdesign::butterworth(
+                       pCoef, 4, mixxx::filterdesign::Pass::Low, freq) *
+                mixxx::filterdesign::butterworth(
+                        pCoef + 4, 4, mixxx::filterdesign::Pass::Low, freq);
+    });
 }
 
 EngineFilterLinkwitzRiley8High::EngineFilterLinkwitzRiley8High(
@@ -36,16 +26,11 @@ EngineFilterLinkwitzRiley8High::EngineFilterLinkwitzRiley8High(
 
 void EngineFilterLinkwitzRiley8High::setFrequencyCorners(mixxx::audio::SampleRate sampleRate,
         double freqCorner1) {
-    setCoefs2(sampleRate,
-            4,
-            kFidSpecHighPassButterworth4,
-            sizeof(kFidSpecHighPassButterworth4),
-            freqCorner1,
-            0,
-            0,
-            kFidSpecHighPassButterworth4,
-            sizeof(kFidSpecHighPassButterworth4),
-            freqCorner1,
-            0,
-            0);
+    designCoefs([=](double* pCoef) {
+        const double freq = freqCorner1 / sampleRate;
+        return mixxx::filterdesign::butterworth(
+                       pCoef, 4, mixxx::filterdesign::Pass::High, freq) *
+                mixxx::filterdesign::butterworth(
+                        pCoef + 4, 4, mixxx::filterdesign::Pass::High, freq);
+    });
 }
@@ -35,7 +35,8 @@ AnalyzerModeFlags getAnalyzerModeFlags(
     // NOTE(uklotzde, 2018-12-26): The previous comment just states the status-quo
     // of the existing code. We should rethink the configuration of analyzers when
     // refactoring/redesigning the analyzer framework.
-    int modeFlags = AnalyzerModeFlags::WithBeats | AnalyzerModeFlags::LowPriority;
+    int modeFlags = AnalyzerModeFlags::WithBeats | AnalyzerModeFlags::LowPriority |
+            AnalyzerModeFlags::DeferFullAnalysis;
     if (pConfig->getValue<bool>(ConfigKey("[Library]", "EnableWaveformGenerationWithAnalysis"), true)) {
         modeFlags |= AnalyzerModeFlags::WithWaveform;
     }
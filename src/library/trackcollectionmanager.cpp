@@ -8,6 +8,7 @@
 #include "library/scanner/libraryscanner.h"
 #include "library/trackcollection.h"
 #include "moc_trackcollectionmanager.cpp"
+#include "sources/soundsourcepool.h"
 #include "sources/soundsourceproxy.h"
 #include "track/track.h"
 #include "util/assert.h"
@@ -374,6 +375,7 @@ DirectoryDAO::RelocateResult TrackCollectionManager::relocateDirectory(
             << oldDir
             << "->"
             << newDir;
+    mixxx::SoundSourcePool::evictDirectory(QDir(oldDir));
     DirectoryDAO::RelocateResult result =
             m_pInternalCollection->relocateDirectory(oldDir, newDir);
 
@@ -422,6 +424,9 @@ void TrackCollectionManager::purgeTracks(const QList<TrackRef>& trackRefs) const
             << "trackRefs"
             << trackRefs.size()
             << "tracks from internal collection";
+    for (const auto& trackRef : trackRefs) {
+        mixxx::SoundSourcePool::evict(QUrl::fromLocalFile(trackRef.getLocation()));
+    }
     {
         QList<TrackId> trackIds;
         trackIds.reserve(trackRefs.size());
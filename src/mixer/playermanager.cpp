@@ -195,7 +195,7 @@ void PlayerManager::bindToLibrary(Library* pLibrary) {
     // Connect the player to the analyzer queue so that loaded tracks are
     // analyzed.
     foreach(Deck* pDeck, m_decks) {
-        connect(pDeck, &BaseTrackPlayer::newTrackLoaded, this, &PlayerManager::slotAnalyzeTrack);
+        connect(pDeck, &BaseTrackPlayer::newTrackLoaded, this, &PlayerManager::slotAnalyzeDeckTrack);
     }
 
     // Connect the player to the analyzer queue so that loaded tracks are
@@ -429,7 +429,7 @@ void PlayerManager::addDeckInner() {
         connect(pDeck,
                 &BaseTrackPlayer::newTrackLoaded,
                 this,
-                &PlayerManager::slotAnalyzeTrack);
+                &PlayerManager::slotAnalyzeDeckTrack);
     }
 
     m_players[handleGroup.handle()] = pDeck;
@@ -824,14 +824,32 @@ void PlayerManager::slotAnalyzeTrack(TrackPointer track) {
     VERIFY_OR_DEBUG_ASSERT(track) {
         return;
     }
+    scheduleTrackAnalysis(AnalyzerScheduledTrack(track->getId()));
+}
+
+void PlayerManager::slotAnalyzeDeckTrack(TrackPointer track) {
+    VERIFY_OR_DEBUG_ASSERT(track) {
+        return;
+    }
+    // Tracks in decks are about to be played and preempt tracks that
+    // have been loaded into samplers or preview decks before. The deck
+    // seeks to the main cue after loading the track, the waveform around
+    // this position is needed first.
+    AnalyzerTrack::Options options;
+    options.highPriority = true;
+    options.priorityPosition = track->getMainCuePosition();
+    scheduleTrackAnalysis(AnalyzerScheduledTrack(track->getId(), options));
+}
+
+void PlayerManager::scheduleTrackAnalysis(const AnalyzerScheduledTrack& track) {
     if (m_pTrackAnalysisScheduler) {
-        if (m_pTrackAnalysisScheduler->scheduleTrack(track->getId())) {
+        if (m_pTrackAnalysisScheduler->scheduleTrack(track)) {
             m_pTrackAnalysisScheduler->resume();
         }
         // The first progress signal will suspend a running batch analysis
         // until all loaded tracks have been analyzed. Emit it once just now
         // before any signals from the analyzer queue arrive.
-        emit trackAnalyzerProgress(track->getId(), kAnalyzerProgressUnknown);
+        emit trackAnalyzerProgress(track.getTrackId(), kAnalyzerProgressUnknown);
     }
 }
 
@@ -232,6 +232,7 @@ class PlayerManager : public QObject, public PlayerManagerInterface {
 
   private slots:
     void slotAnalyzeTrack(TrackPointer track);
+    void slotAnalyzeDeckTrack(TrackPointer track);
 
     void onTrackAnalysisProgress(TrackId trackId, AnalyzerProgress analyzerProgress);
     void onTrackAnalysisFinished();
@@ -280,6 +281,8 @@ class PlayerManager : public QObject, public PlayerManagerInterface {
     // creates a new auxiliary.
     void addAuxiliaryInner();
 
+    void scheduleTrackAnalysis(const AnalyzerScheduledTrack& track);
+
     // Used to protect access to PlayerManager state across threads.
     mutable QT_RECURSIVE_MUTEX m_mutex;
 
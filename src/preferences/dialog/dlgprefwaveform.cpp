@@ -2,11 +2,13 @@
 
 #include <QMetaEnum>
 
+#include "analyzer/analysiscache.h"
 #include "control/controlpushbutton.h"
 #include "library/dao/analysisdao.h"
 #include "library/library.h"
 #include "moc_dlgprefwaveform.cpp"
 #include "preferences/waveformsettings.h"
+#include "sources/mp3seekindex.h"
 #include "util/db/dbconnectionpooled.h"
 #include "waveform/overviewtype.h"
 #include "waveform/renderers/waveformwidgetrenderer.h"
@@ -181,6 +183,10 @@ DlgPrefWaveform::DlgPrefWaveform(
             &QCheckBox::toggled,
             this,
             &DlgPrefWaveform::slotSetOverviewMinuteMarkers);
+    connect(adaptiveQualityCheckBox,
+            &QCheckBox::toggled,
+            this,
+            &DlgPrefWaveform::slotSetAdaptiveQuality);
     connect(factory,
             &WaveformWidgetFactory::waveformMeasured,
             this,
@@ -302,6 +308,7 @@ void DlgPrefWaveform::slotUpdate() {
     midVisualGain->setValue(factory->getVisualGain(BandIndex::Mid));
     highVisualGain->setValue(factory->getVisualGain(BandIndex::High));
     normalizeOverviewCheckBox->setChecked(factory->isOverviewNormalized());
+    adaptiveQualityCheckBox->setChecked(factory->isAdaptiveQuality());
     // Round zoom to int to get a default zoom index.
     defaultZoomComboBox->setCurrentIndex(static_cast<int>(factory->getDefaultZoom()) - 1);
     playMarkerPositionSlider->setValue(static_cast<int>(factory->getPlayMarkerPosition() * 100));
@@ -396,6 +403,9 @@ void DlgPrefWaveform::slotResetToDefaults() {
     // Show minute markers.
     overviewMinuteMarkersCheckBox->setChecked(true);
 
+    // Always render waveforms with full detail.
+    adaptiveQualityCheckBox->setChecked(false);
+
     // 60FPS is the default
     frameRateSlider->setValue(60);
     endOfTrackWarningTimeSlider->setValue(30);
@@ -634,6 +644,10 @@ void DlgPrefWaveform::slotSetNormalizeOverview(bool normalize) {
     updateWaveformGainEnabled();
 }
 
+void DlgPrefWaveform::slotSetAdaptiveQuality(bool enabled) {
+    WaveformWidgetFactory::instance()->setAdaptiveQuality(enabled);
+}
+
 void DlgPrefWaveform::slotSetOverviewMinuteMarkers(bool draw) {
     m_pConfig->setValue(ConfigKey("[Waveform]", "draw_overview_minute_markers"), draw);
     m_pOverviewMinuteMarkersControl->forceSet(draw);
@@ -650,6 +664,10 @@ void DlgPrefWaveform::slotClearCachedWaveforms() {
     QSqlDatabase dbConnection = mixxx::DbConnectionPooled(m_pLibrary->dbConnectionPool());
     analysisDao.deleteAnalysesByType(dbConnection, AnalysisDao::TYPE_WAVEFORM);
     analysisDao.deleteAnalysesByType(dbConnection, AnalysisDao::TYPE_WAVESUMMARY);
+    // The analysis cache contains copies of the waveforms. The MP3 seek
+    // indices are stored and purged the same way.
+    mixxx::AnalysisCache::clear();
+    mixxx::Mp3SeekIndexStore::clear();
     calculateCachedWaveformDiskUsage();
 }
 
@@ -705,7 +723,9 @@ void DlgPrefWaveform::calculateCachedWaveformDiskUsage() {
     AnalysisDao analysisDao(m_pConfig);
     QSqlDatabase dbConnection = mixxx::DbConnectionPooled(m_pLibrary->dbConnectionPool());
     size_t numBytes = analysisDao.getDiskUsageInBytes(dbConnection, AnalysisDao::TYPE_WAVEFORM) +
-            analysisDao.getDiskUsageInBytes(dbConnection, AnalysisDao::TYPE_WAVESUMMARY);
+            analysisDao.getDiskUsageInBytes(dbConnection, AnalysisDao::TYPE_WAVESUMMARY) +
+            mixxx::AnalysisCache::diskUsageInBytes() +
+            mixxx::Mp3SeekIndexStore::diskUsageInBytes();
 
     // Display total cached waveform size in mebibytes with 2 decimals.
     QString sizeMebibytes = QString::number(
@@ -11,6 +11,7 @@
 #include <QtQuick/QSGTexture>
 #include <QtQuick/QSGTextureProvider>
 #include <cmath>
+#include <functional>
 
 #include "mixer/basetrackplayer.h"
 #include "moc_qmlwaveformdisplay.cpp"
@@ -23,6 +24,25 @@ using namespace allshader;
 
 namespace {
 constexpr int kDefaultSyncInternalMs = 100;
+
+// Root node of the waveform, which lets the display update the scene graph
+// for every rendered frame, including frames that the render thread renders
+// without synchronizing with the GUI thread.
+class PreprocessClipNode : public QSGClipNode {
+  public:
+    explicit PreprocessClipNode(std::function<void()> preprocessCallback)
+            : m_preprocessCallback(std::move(preprocessCallback)) {
+        setFlag(QSGNode::UsePreprocess, true);
+    }
+
+    void preprocess() override {
+        m_preprocessCallback();
+    }
+
+  private:
+    const std::function<void()> m_preprocessCallback;
+};
+
 } // namespace
 
 namespace mixxx {
@@ -59,7 +79,16 @@ void QmlWaveformDisplay::slotWindowChanged(QQuickWindow* window) {
 
     m_dirtyFlag.setFlag(DirtyFlag::Window, true);
     if (window) {
-        connect(window, &QQuickWindow::afterFrameEnd, this, &QmlWaveformDisplay::slotFrameSwapped);
+        // afterFrameEnd is emitted on the render thread, so it can request the
+        // next frame without a round trip through the GUI thread event loop.
+        connect(
+                window,
+                &QQuickWindow::afterFrameEnd,
+                this,
+                [this, window]() {
+                    slotFrameSwapped(window);
+                },
+                Qt::DirectConnection);
     }
     m_timer.restart();
 }
@@ -70,13 +99,41 @@ std::chrono::microseconds QmlWaveformDisplay::fromTimerToNextSync(const Performa
     return m_syncInterval + std::chrono::microseconds(m_timer.difference(timer).toIntegerMicros());
 }
 
-void QmlWaveformDisplay::slotFrameSwapped() {
+void QmlWaveformDisplay::slotFrameSwapped(QQuickWindow* window) {
     m_timer.restart();
 
     // continuous redraw
+    if (m_renderThreadUpdates.load()) {
+        // Calling update() on the window from the render thread renders the
+        // next frame without synchronizing with the GUI thread, so a busy
+        // GUI thread does not drop waveform frames.
+        window->update();
+    } else {
+        QMetaObject::invokeMethod(this, &QQuickItem::update, Qt::QueuedConnection);
+    }
+}
+
+void QmlWaveformDisplay::setRenderThreadUpdates(bool enabled) {
+    if (m_renderThreadUpdates.exchange(enabled) == enabled) {
+        return;
+    }
+    emit renderThreadUpdatesChanged();
     update();
 }
 
+void QmlWaveformDisplay::updateFrame() {
+    // Called on the render thread, either while the GUI thread is blocked in
+    // the sync step or from preprocess(). The play position is read lock-free
+    // from VisualPlayPosition, the lock only guards against concurrent track
+    // and mark changes made on the GUI thread.
+    const auto locker = lockRenderState();
+    onPreRender(this);
+
+    for (auto* pRenderer : std::as_const(m_rendererStack)) {
+        pRenderer->update();
+    }
+}
+
 void QmlWaveformDisplay::geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry) {
     m_dirtyFlag.setFlag(DirtyFlag::Geometry, true);
     update();
@@ -99,7 +156,11 @@ QSGNode* QmlWaveformDisplay::updatePaintNode(QSGNode* node, UpdatePaintNodeData*
         if (pClipNode) {
             delete pClipNode;
         }
-        pClipNode = new QSGClipNode();
+        pClipNode = new PreprocessClipNode([this]() {
+            if (m_renderThreadUpdates.load()) {
+                updateFrame();
+            }
+        });
         pBgNode = new QSGSimpleRectNode();
         m_dirtyFlag.setFlag(DirtyFlag::Background, true);
         m_dirtyFlag.setFlag(DirtyFlag::Geometry, true);
@@ -150,10 +211,10 @@ QSGNode* QmlWaveformDisplay::updatePaintNode(QSGNode* node, UpdatePaintNodeData*
                 window()->devicePixelRatio());
     }
 
-    onPreRender(this);
-
-    for (auto* pRenderer : std::as_const(m_rendererStack)) {
-        pRenderer->update();
+    // With render thread updates, the frame is updated in preprocess()
+    // instead, which is also invoked for frames rendered without sync.
+    if (!m_renderThreadUpdates.load()) {
+        updateFrame();
     }
 
     pBgNode->markDirty(QSGNode::DirtyForceUpdate);
@@ -200,7 +261,10 @@ void QmlWaveformDisplay::setGroup(const QString& group) {
         return;
     }
 
-    WaveformWidgetRenderer::setGroup(group);
+    {
+        const auto locker = lockRenderState();
+        WaveformWidgetRenderer::setGroup(group);
+    }
     emit groupChanged(group);
 }
 
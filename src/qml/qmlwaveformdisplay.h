@@ -5,6 +5,7 @@
 #include <QQuickWindow>
 #include <QSGNode>
 #include <QSGSimpleRectNode>
+#include <atomic>
 #include <chrono>
 
 #include "qml/qmlplayerproxy.h"
@@ -42,6 +43,8 @@ class QmlWaveformDisplay : public QQuickItem, VSyncTimeProvider, public Waveform
     Q_PROPERTY(double zoom READ getZoom WRITE setZoom NOTIFY zoomChanged)
     Q_PROPERTY(QColor backgroundColor READ getBackgroundColor WRITE
                     setBackgroundColor NOTIFY backgroundColorChanged)
+    Q_PROPERTY(bool renderThreadUpdates READ getRenderThreadUpdates WRITE
+                    setRenderThreadUpdates NOTIFY renderThreadUpdatesChanged)
     Q_CLASSINFO("DefaultProperty", "renderers")
     QML_NAMED_ELEMENT(WaveformDisplay)
 
@@ -63,10 +66,20 @@ class QmlWaveformDisplay : public QQuickItem, VSyncTimeProvider, public Waveform
 
     void setGroup(const QString& group) override;
     void setZoom(double zoom) {
-        WaveformWidgetRenderer::setZoom(zoom);
+        {
+            const auto locker = lockRenderState();
+            WaveformWidgetRenderer::setZoom(zoom);
+        }
         emit zoomChanged();
     }
 
+    // When enabled, the per-frame update of the waveform is done on the scene
+    // graph render thread, which keeps scrolling while the GUI thread is busy.
+    bool getRenderThreadUpdates() const {
+        return m_renderThreadUpdates.load();
+    }
+    void setRenderThreadUpdates(bool enabled);
+
     std::chrono::microseconds fromTimerToNextSync(const PerformanceTimer& timer) override;
     std::chrono::microseconds getSyncInterval() const override {
         return m_syncInterval;
@@ -92,22 +105,25 @@ class QmlWaveformDisplay : public QQuickItem, VSyncTimeProvider, public Waveform
     void slotTrackUnloaded();
     void slotWaveformUpdated();
 
-    void slotFrameSwapped();
+    void slotFrameSwapped(QQuickWindow* window);
     void slotWindowChanged(QQuickWindow* window);
   signals:
     void playerChanged();
     void zoomChanged();
     void groupChanged(const QString& group);
     void backgroundColorChanged();
+    void renderThreadUpdatesChanged();
 
   private:
     void setCurrentTrack(TrackPointer pTrack);
+    void updateFrame();
 
     // Properties
     QPointer<QmlPlayerProxy> m_pPlayer;
     QColor m_backgroundColor{QColor(0, 0, 0, 255)};
 
     PerformanceTimer m_timer;
+    std::atomic<bool> m_renderThreadUpdates{false};
 
     std::chrono::milliseconds m_syncInterval;
     enum class DirtyFlag : int {
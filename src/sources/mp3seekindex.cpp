@@ -0,0 +1,281 @@
+#include "sources/mp3seekindex.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QMutex>
+#include <QSaveFile>
+#include <atomic>
+
+#include "util/assert.h"
+#include "util/cachedirectory.h"
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("Mp3SeekIndex");
+
+constexpr quint32 kEncodingMagic = 0x4D503349; // "MP3I"
+constexpr quint16 kEncodingVersion = 1;
+
+// The analysis data of a single track is small, the default compression
+// level is sufficient. Consecutive MP3 frames usually have the same
+// length which results in long runs of identical deltas.
+constexpr int kCompressionLevel = -1;
+
+// The index of a long file occupies a few KB
+constexpr CacheDirectory::Limits kStorageLimits{
+        20000,              // maxFileCount
+        64 * 1024 * 1024LL, // maxTotalBytes
+        180,                // maxAgeDays
+};
+
+// Listing the directory is too expensive for every new entry
+constexpr int kPurgeIntervalSaves = 100;
+
+std::atomic<int> s_saveCount = 0;
+
+QMutex s_storageDirectoryMutex;
+QString s_storageDirectory;
+
+void appendVarUInt(QByteArray* pData, quint64 value) {
+    while (value >= 0x80) {
+        pData->append(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    pData->append(static_cast<char>(value));
+}
+
+bool readVarUInt(const QByteArray& data, int* pPos, quint64* pValue) {
+    quint64 value = 0;
+    int shift = 0;
+    while (*pPos < data.size() && shift < 64) {
+        const auto byte = static_cast<quint8>(data.at((*pPos)++));
+        value |= static_cast<quint64>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            *pValue = value;
+            return true;
+        }
+        shift += 7;
+    }
+    return false;
+}
+
+QString storageFilePath(const QString& storageDirectory, const QFileInfo& fileInfo) {
+    const QByteArray digest = QCryptographicHash::hash(
+            fileInfo.absoluteFilePath().toUtf8(),
+            QCryptographicHash::Sha1);
+    return QDir(storageDirectory).filePath(QString::fromLatin1(digest.toHex()));
+}
+
+} // anonymous namespace
+
+bool Mp3SeekIndex::isValid(quint64 fileSize) const {
+    if (!channelCount.isValid() || !sampleRate.isValid()) {
+        return false;
+    }
+    // At least one MP3 frame and the terminating entry
+    if (entries.size() < 2) {
+        return false;
+    }
+    if (entries.front().frameIndex != 0) {
+        return false;
+    }
+    for (std::size_t i = 1; i < entries.size(); ++i) {
+        if (entries[i].frameIndex <= entries[i - 1].frameIndex ||
+                entries[i].byteOffset <= entries[i - 1].byteOffset) {
+            return false;
+        }
+    }
+    return static_cast<quint64>(entries.back().byteOffset) <= fileSize;
+}
+
+QByteArray Mp3SeekIndex::encode() const {
+    QByteArray deltas;
+    // Most deltas fit into 2 bytes each
+    deltas.reserve(static_cast<int>(entries.size()) * 4);
+    Entry prevEntry{0, 0};
+    for (const auto& entry : entries) {
+        DEBUG_ASSERT(entry.frameIndex >= prevEntry.frameIndex);
+        DEBUG_ASSERT(entry.byteOffset >= prevEntry.byteOffset);
+        appendVarUInt(&deltas, static_cast<quint64>(entry.frameIndex - prevEntry.frameIndex));
+        appendVarUInt(&deltas, static_cast<quint64>(entry.byteOffset - prevEntry.byteOffset));
+        prevEntry = entry;
+    }
+
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << kEncodingMagic
+           << kEncodingVersion
+           << static_cast<quint8>(channelCount.value())
+           << static_cast<quint32>(sampleRate.value())
+           << static_cast<quint32>(bitrate.value())
+           << static_cast<quint32>(entries.size())
+           << deltas;
+    return qCompress(data, kCompressionLevel);
+}
+
+// static
+std::optional<Mp3SeekIndex> Mp3SeekIndex::decode(const QByteArray& compressedData) {
+    const QByteArray data = qUncompress(compressedData);
+    QDataStream stream(data);
+    quint32 magic = 0;
+    quint16 version = 0;
+    stream >> magic >> version;
+    if (stream.status() != QDataStream::Ok ||
+            magic != kEncodingMagic ||
+            version != kEncodingVersion) {
+        return std::nullopt;
+    }
+    quint8 channelCount = 0;
+    quint32 sampleRate = 0;
+    quint32 bitrate = 0;
+    quint32 entryCount = 0;
+    QByteArray deltas;
+    stream >> channelCount >> sampleRate >> bitrate >> entryCount >> deltas;
+    if (stream.status() != QDataStream::Ok) {
+        return std::nullopt;
+    }
+    // Each entry occupies at least 2 bytes
+    if (entryCount > static_cast<quint32>(deltas.size()) / 2) {
+        return std::nullopt;
+    }
+
+    Mp3SeekIndex seekIndex;
+    seekIndex.channelCount = audio::ChannelCount(channelCount);
+    seekIndex.sampleRate = audio::SampleRate(sampleRate);
+    seekIndex.bitrate = audio::Bitrate(bitrate);
+    seekIndex.entries.reserve(entryCount);
+    Entry entry{0, 0};
+    int pos = 0;
+    for (quint32 i = 0; i < entryCount; ++i) {
+        quint64 frameDelta;
+        quint64 byteDelta;
+        if (!readVarUInt(deltas, &pos, &frameDelta) ||
+                !readVarUInt(deltas, &pos, &byteDelta)) {
+            return std::nullopt;
+        }
+        entry.frameIndex += static_cast<SINT>(frameDelta);
+        entry.byteOffset += static_cast<SINT>(byteDelta);
+        seekIndex.entries.push_back(entry);
+    }
+    if (pos != deltas.size()) {
+        return std::nullopt;
+    }
+    return seekIndex;
+}
+
+// static
+void Mp3SeekIndexStore::setStorageDirectory(const QString& path) {
+    if (!path.isEmpty() && !QDir().mkpath(path)) {
+        kLogger.warning()
+                << "Failed to create storage directory"
+                << path;
+    }
+    const auto locker = lockMutex(&s_storageDirectoryMutex);
+    s_storageDirectory = path;
+}
+
+// static
+QString Mp3SeekIndexStore::storageDirectory() {
+    const auto locker = lockMutex(&s_storageDirectoryMutex);
+    return s_storageDirectory;
+}
+
+// static
+std::optional<Mp3SeekIndex> Mp3SeekIndexStore::load(
+        const QFileInfo& fileInfo) {
+    const QString directory = storageDirectory();
+    if (directory.isEmpty()) {
+        return std::nullopt;
+    }
+    QFile file(storageFilePath(directory, fileInfo));
+    if (!file.open(QIODevice::ReadOnly)) {
+        // Not stored yet
+        return std::nullopt;
+    }
+    QDataStream stream(&file);
+    QString filePath;
+    quint64 fileSize = 0;
+    qint64 lastModifiedMillis = 0;
+    QByteArray encoded;
+    stream >> filePath >> fileSize >> lastModifiedMillis >> encoded;
+    if (stream.status() != QDataStream::Ok) {
+        kLogger.warning()
+                << "Failed to read seek index"
+                << file.fileName();
+        return std::nullopt;
+    }
+    if (filePath != fileInfo.absoluteFilePath() ||
+            fileSize != static_cast<quint64>(fileInfo.size()) ||
+            lastModifiedMillis != fileInfo.lastModified().toMSecsSinceEpoch()) {
+        // Outdated, the file has been modified since
+        return std::nullopt;
+    }
+    auto seekIndex = Mp3SeekIndex::decode(encoded);
+    if (!seekIndex || !seekIndex->isValid(fileSize)) {
+        kLogger.warning()
+                << "Discarding invalid seek index"
+                << file.fileName();
+        return std::nullopt;
+    }
+    return seekIndex;
+}
+
+// static
+bool Mp3SeekIndexStore::save(
+        const QFileInfo& fileInfo,
+        const Mp3SeekIndex& seekIndex) {
+    const QString directory = storageDirectory();
+    if (directory.isEmpty()) {
+        return false;
+    }
+    DEBUG_ASSERT(seekIndex.isValid(fileInfo.size()));
+    if (s_saveCount.fetch_add(1) % kPurgeIntervalSaves == 0) {
+        // Also when saving the first entry after startup
+        CacheDirectory::purge(directory, kStorageLimits);
+    }
+    // Concurrent writers for the same file, e.g. a deck and the analyzer
+    // opening a new track simultaneously, must not corrupt each other.
+    QSaveFile file(storageFilePath(directory, fileInfo));
+    if (!file.open(QIODevice::WriteOnly)) {
+        kLogger.warning()
+                << "Failed to open seek index for writing"
+                << file.fileName();
+        return false;
+    }
+    QDataStream stream(&file);
+    stream << fileInfo.absoluteFilePath()
+           << static_cast<quint64>(fileInfo.size())
+           << static_cast<qint64>(fileInfo.lastModified().toMSecsSinceEpoch())
+           << seekIndex.encode();
+    if (stream.status() != QDataStream::Ok || !file.commit()) {
+        kLogger.warning()
+                << "Failed to write seek index"
+                << file.fileName();
+        return false;
+    }
+    return true;
+}
+
+// static
+void Mp3SeekIndexStore::purge() {
+    CacheDirectory::purge(storageDirectory(), kStorageLimits);
+}
+
+// static
+bool Mp3SeekIndexStore::clear() {
+    return CacheDirectory::clear(storageDirectory());
+}
+
+// static
+qint64 Mp3SeekIndexStore::diskUsageInBytes() {
+    return CacheDirectory::diskUsageInBytes(storageDirectory());
+}
+
+} // namespace mixxx
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFileInfo>
+#include <QString>
+#include <optional>
+#include <vector>
+
+#include "audio/types.h"
+#include "util/types.h"
+
+namespace mixxx {
+
+/// The seek table and stream properties of an MP3 file that are
+/// obtained by decoding all MAD frame headers when opening the file.
+///
+/// Scanning the headers of long files takes a noticeable amount of
+/// time. The index is persisted by Mp3SeekIndexStore and reused on
+/// subsequent opens until the file is modified.
+struct Mp3SeekIndex {
+    struct Entry {
+        SINT frameIndex;
+        /// Offset of the MP3 frame in the file. The terminating entry
+        /// contains the file size.
+        SINT byteOffset;
+
+        bool operator==(const Entry&) const = default;
+    };
+
+    audio::ChannelCount channelCount;
+    audio::SampleRate sampleRate;
+    audio::Bitrate bitrate;
+    /// Ordered by frame index, terminated by an entry at the end
+    /// of the audio stream.
+    std::vector<Entry> entries;
+
+    /// Checks that the entries are strictly ordered and fit into a file
+    /// with the given size.
+    bool isValid(quint64 fileSize) const;
+
+    /// Compact, compressed encoding. The frame indices and byte
+    /// offsets are delta-encoded as variable length integers.
+    QByteArray encode() const;
+    static std::optional<Mp3SeekIndex> decode(const QByteArray& data);
+};
+
+/// File based storage of Mp3SeekIndex below the analysis directory.
+///
+/// Entries are keyed by a hash of the file path and are only returned
+/// if both the size and the modification time of the file still match.
+/// Like the AnalysisCache the storage is limited and the least recently
+/// written entries are purged. All functions are thread-safe once the
+/// storage directory has been set during startup. Storage is disabled
+/// while no directory is set.
+class Mp3SeekIndexStore {
+  public:
+    static void setStorageDirectory(const QString& path);
+    static QString storageDirectory();
+
+    static std::optional<Mp3SeekIndex> load(
+            const QFileInfo& fileInfo);
+    static bool save(
+            const QFileInfo& fileInfo,
+            const Mp3SeekIndex& seekIndex);
+
+    /// Removes the least recently written entries exceeding the limits.
+    /// This is done regularly while saving new entries.
+    static void purge();
+    /// Removes all entries, e.g. together with the AnalysisCache
+    static bool clear();
+    static qint64 diskUsageInBytes();
+};
+
+} // namespace mixxx
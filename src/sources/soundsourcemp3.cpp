@@ -1,5 +1,6 @@
 #include "sources/soundsourcemp3.h"
 #include "sources/mp3decoding.h"
+#include "sources/mp3seekindex.h"
 
 #include "util/logger.h"
 #include "util/math.h"
@@ -197,7 +198,8 @@ SoundSourceMp3::SoundSourceMp3(const QUrl& url)
           m_avgSeekFrameCount(0),
           m_curFrameIndex(0),
           m_madSynthCount(0),
-          m_leftoverBuffer(kMaxBytesPerMp3Frame + MAD_BUFFER_GUARD) {
+          m_leftoverBuffer(kMaxBytesPerMp3Frame + MAD_BUFFER_GUARD),
+          m_leftoverFileOffset(0) {
     m_seekFrameList.reserve(kSeekFrameListCapacity);
     initDecoding();
 }
@@ -247,6 +249,17 @@ SoundSource::OpenResult SoundSourceMp3::tryOpen(
     DEBUG_ASSERT(m_seekFrameList.empty());
     m_avgSeekFrameCount = 0;
     m_curFrameIndex = 0;
+
+    const QFileInfo fileInfo(m_file);
+    if (const auto seekIndex = Mp3SeekIndexStore::load(fileInfo)) {
+        if (restoreSeekIndex(*seekIndex)) {
+            return OpenResult::Succeeded;
+        }
+        kLogger.warning()
+                << "Decoding all MP3 frame headers after failing to restore the seek index:"
+                << m_file.fileName();
+    }
+
     int headerPerSampleRate[kSampleRateCount];
     for (int i = 0; i < kSampleRateCount; ++i) {
         headerPerSampleRate[i] = 0;
@@ -484,9 +497,72 @@ SoundSource::OpenResult SoundSourceMp3::tryOpen(
         return OpenResult::Failed;
     }
 
+    storeSeekIndex(fileInfo);
+
     return OpenResult::Succeeded;
 }
 
+bool SoundSourceMp3::restoreSeekIndex(const Mp3SeekIndex& seekIndex) {
+    DEBUG_ASSERT(m_seekFrameList.empty());
+    if (!seekIndex.isValid(m_fileSize) ||
+            seekIndex.channelCount > kChannelCountMax) {
+        return false;
+    }
+
+    const auto& entries = seekIndex.entries;
+    for (std::size_t i = 0; i < entries.size() - 1; ++i) {
+        addSeekFrame(entries[i].frameIndex, m_pFileData + entries[i].byteOffset);
+    }
+    const SINT frameIndexEnd = entries.back().frameIndex;
+
+    initChannelCountOnce(seekIndex.channelCount);
+    initSampleRateOnce(seekIndex.sampleRate);
+    initFrameIndexRangeOnce(IndexRange::forward(0, frameIndexEnd));
+    m_avgSeekFrameCount = frameLength() / static_cast<SINT>(m_seekFrameList.size());
+    if (seekIndex.bitrate.isValid()) {
+        initBitrateOnce(seekIndex.bitrate);
+    }
+
+    // Terminate m_seekFrameList
+    addSeekFrame(frameIndexEnd, nullptr);
+    DEBUG_ASSERT(m_seekFrameList.back().frameIndex == frameIndexMax());
+
+    // Restart decoding at the beginning of the audio stream
+    restartDecoding(m_seekFrameList.front());
+    DEBUG_ASSERT(m_curFrameIndex == frameIndexMin());
+    return true;
+}
+
+void SoundSourceMp3::storeSeekIndex(const QFileInfo& fileInfo) const {
+    Mp3SeekIndex seekIndex;
+    seekIndex.channelCount = getSignalInfo().getChannelCount();
+    seekIndex.sampleRate = getSignalInfo().getSampleRate();
+    seekIndex.bitrate = getBitrate();
+    seekIndex.entries.reserve(m_seekFrameList.size());
+    const unsigned char* pLeftoverBuffer = &*m_leftoverBuffer.begin();
+    for (const auto& seekFrame : m_seekFrameList) {
+        SINT byteOffset;
+        if (!seekFrame.pInputData) {
+            // Terminating entry
+            byteOffset = static_cast<SINT>(m_fileSize);
+        } else if (seekFrame.pInputData >= pLeftoverBuffer &&
+                seekFrame.pInputData < pLeftoverBuffer + m_leftoverBuffer.size()) {
+            // The last MP3 frame is decoded from a padded copy
+            byteOffset = m_leftoverFileOffset + (seekFrame.pInputData - pLeftoverBuffer);
+        } else {
+            byteOffset = seekFrame.pInputData - m_pFileData;
+        }
+        seekIndex.entries.push_back(Mp3SeekIndex::Entry{seekFrame.frameIndex, byteOffset});
+    }
+    if (!seekIndex.isValid(m_fileSize)) {
+        kLogger.warning()
+                << "Not storing inconsistent seek index:"
+                << m_file.fileName();
+        return;
+    }
+    Mp3SeekIndexStore::save(fileInfo, seekIndex);
+}
+
 void SoundSourceMp3::close() {
     finishDecoding();
 
@@ -859,6 +935,7 @@ bool SoundSourceMp3::copyLeftoverFrame() {
         }
         const SINT remainingBytes = m_madStream.bufend - m_madStream.next_frame;
         DEBUG_ASSERT(remainingBytes <= kMaxBytesPerMp3Frame); // only last MP3 frame
+        m_leftoverFileOffset = m_madStream.next_frame - m_pFileData;
         const SINT leftoverBytes = remainingBytes + MAD_BUFFER_GUARD;
         if ((remainingBytes > 0) && (leftoverBytes <= SINT(m_leftoverBuffer.size()))) {
             // Copy the data of the last MP3 frame into the leftover buffer...
@@ -11,11 +11,14 @@
 #include <mad.h>
 
 #include <QFile>
+#include <QFileInfo>
 
 #include <vector>
 
 namespace mixxx {
 
+struct Mp3SeekIndex;
+
 class SoundSourceMp3 final : public SoundSource {
   public:
     explicit SoundSourceMp3(const QUrl& url);
@@ -56,6 +59,12 @@ class SoundSourceMp3 final : public SoundSource {
     /** Returns the position in m_seekFrameList of the requested frame index. */
     SINT findSeekFrameIndex(SINT frameIndex) const;
 
+    /// Restores the seek frames and audio properties that have been
+    /// stored when opening the file before instead of decoding all
+    /// MP3 frame headers again.
+    bool restoreSeekIndex(const Mp3SeekIndex& seekIndex);
+    void storeSeekIndex(const QFileInfo& fileInfo) const;
+
     bool copyLeftoverFrame();
 
     SINT m_curFrameIndex;
@@ -74,6 +83,8 @@ class SoundSourceMp3 final : public SoundSource {
     SINT m_madSynthCount; // left overs from the previous read
 
     std::vector<unsigned char> m_leftoverBuffer;
+    // File offset of the data that has been copied into m_leftoverBuffer
+    SINT m_leftoverFileOffset;
 };
 
 class SoundSourceProviderMp3 : public SoundSourceProvider {
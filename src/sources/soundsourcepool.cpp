@@ -0,0 +1,335 @@
+#include "sources/soundsourcepool.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QMutex>
+#include <QTimer>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include "sources/audiosourceproxy.h"
+#include "util/compatibility/qmutex.h"
+#include "util/counter.h"
+#include "util/logger.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("SoundSourcePool");
+
+struct Key {
+    QString location;
+    audio::SignalInfo signalInfo;
+#ifdef __STEM__
+    StemChannelSelection stemMask;
+#endif
+
+    bool operator==(const Key& other) const {
+        return location == other.location &&
+#ifdef __STEM__
+                stemMask == other.stemMask &&
+#endif
+                signalInfo == other.signalInfo;
+    }
+};
+
+Key keyFor(
+        const QUrl& url,
+        const AudioSource::OpenParams& params) {
+    return Key{
+            url.toLocalFile(),
+            params.getSignalInfo(),
+#ifdef __STEM__
+            params.stemMask(),
+#endif
+    };
+}
+
+struct PooledEntry {
+    Key key;
+    SoundSourcePool::Entry entry;
+    // Identifies the revision of the file that has been opened
+    qint64 fileSize = 0;
+    QDateTime fileLastModified;
+    // Started when put into the pool
+    QElapsedTimer idleTimer;
+
+    bool isFileUnmodified() const {
+        const QFileInfo fileInfo(key.location);
+        return fileInfo.exists() &&
+                fileInfo.size() == fileSize &&
+                fileInfo.lastModified() == fileLastModified;
+    }
+};
+
+QMutex s_mutex;
+int s_capacity = SoundSourcePool::kDefaultCapacity;
+std::chrono::milliseconds s_maxIdleDuration = SoundSourcePool::kDefaultMaxIdleDuration;
+// Ordered from least to most recently released
+std::vector<PooledEntry> s_entries;
+bool s_closeExpiredScheduled = false;
+
+void closeAll(const std::vector<SoundSourcePointer>& soundSources) {
+    // Closing might block while releasing file handles and decoder
+    // contexts and is done without holding the lock.
+    for (const auto& pSoundSource : soundSources) {
+        pSoundSource->close();
+    }
+}
+
+/// Trims the pool to its capacity and returns the SoundSources that
+/// need to be closed.
+std::vector<SoundSourcePointer> trimLocked() {
+    std::vector<SoundSourcePointer> evicted;
+    const auto capacity = static_cast<std::size_t>(std::max(s_capacity, 0));
+    while (s_entries.size() > capacity) {
+        evicted.push_back(std::move(s_entries.front().entry.pSoundSource));
+        s_entries.erase(s_entries.begin());
+    }
+    return evicted;
+}
+
+/// Schedules closeExpired() in the main thread for when the least
+/// recently released SoundSource expires.
+void scheduleCloseExpiredLocked() {
+    if (s_closeExpiredScheduled || s_entries.empty()) {
+        return;
+    }
+    QCoreApplication* pApp = QCoreApplication::instance();
+    if (!pApp) {
+        // Only bounded by the capacity
+        return;
+    }
+    const auto remainingIdleDuration = std::max(std::chrono::milliseconds(0),
+            s_maxIdleDuration -
+                    std::chrono::milliseconds(s_entries.front().idleTimer.elapsed()));
+    s_closeExpiredScheduled = true;
+    // SoundSources are released from the engine and analyzer threads
+    // that have no event loop.
+    QMetaObject::invokeMethod(
+            pApp,
+            [pApp, remainingIdleDuration] {
+                QTimer::singleShot(remainingIdleDuration,
+                        pApp,
+                        &SoundSourcePool::closeExpired);
+            },
+            Qt::QueuedConnection);
+}
+
+void release(PooledEntry&& pooledEntry) {
+    std::vector<SoundSourcePointer> evicted;
+    {
+        const auto locker = lockMutex(&s_mutex);
+        pooledEntry.idleTimer.start();
+        s_entries.push_back(std::move(pooledEntry));
+        evicted = trimLocked();
+        scheduleCloseExpiredLocked();
+    }
+    closeAll(evicted);
+}
+
+/// Puts the SoundSource back into the pool when closed or dropped
+/// instead of closing it.
+class PooledAudioSource final : public AudioSourceProxy {
+  public:
+    explicit PooledAudioSource(
+            PooledEntry&& pooledEntry)
+            : AudioSourceProxy(AudioSourcePointer(pooledEntry.entry.pSoundSource)),
+              m_pooledEntry(std::move(pooledEntry)),
+              m_released(false) {
+    }
+
+    ~PooledAudioSource() override {
+        // Callers like the AnalyzerThread drop the AudioSource without
+        // closing it explicitly
+        close();
+    }
+
+    void close() override {
+        if (m_released) {
+            return;
+        }
+        m_released = true;
+        release(std::move(m_pooledEntry));
+    }
+
+  private:
+    PooledEntry m_pooledEntry;
+    bool m_released;
+};
+
+} // anonymous namespace
+
+// static
+SoundSourcePool::Entry SoundSourcePool::acquire(
+        const QUrl& url,
+        const AudioSource::OpenParams& params) {
+    if (!url.isLocalFile()) {
+        return Entry{};
+    }
+    const Key key = keyFor(url, params);
+    PooledEntry pooledEntry;
+    {
+        const auto locker = lockMutex(&s_mutex);
+        // Prefer the most recently released SoundSource
+        auto i = s_entries.rbegin();
+        while (i != s_entries.rend() && !(i->key == key)) {
+            ++i;
+        }
+        if (i != s_entries.rend()) {
+            pooledEntry = std::move(*i);
+            s_entries.erase(std::next(i).base());
+        }
+    }
+    if (!pooledEntry.entry.pSoundSource) {
+        Counter(QStringLiteral("SoundSourcePool miss")).increment();
+        return Entry{};
+    }
+    if (!pooledEntry.isFileUnmodified()) {
+        kLogger.debug()
+                << "Discarding SoundSource of modified file"
+                << key.location;
+        pooledEntry.entry.pSoundSource->close();
+        return Entry{};
+    }
+    Counter(QStringLiteral("SoundSourcePool hit")).increment();
+    return std::move(pooledEntry.entry);
+}
+
+// static
+AudioSourcePointer SoundSourcePool::wrap(
+        Entry entry,
+        const AudioSource::OpenParams& params) {
+    VERIFY_OR_DEBUG_ASSERT(entry.pSoundSource) {
+        return nullptr;
+    }
+    const QUrl url = entry.pSoundSource->getUrl();
+    if (!url.isLocalFile() || capacity() <= 0) {
+        return entry.pSoundSource;
+    }
+    const QFileInfo fileInfo(url.toLocalFile());
+    return std::make_shared<PooledAudioSource>(PooledEntry{
+            keyFor(url, params),
+            std::move(entry),
+            fileInfo.size(),
+            fileInfo.lastModified()});
+}
+
+// static
+void SoundSourcePool::evict(const QUrl& url) {
+    const QString location = url.toLocalFile();
+    std::vector<SoundSourcePointer> evicted;
+    {
+        const auto locker = lockMutex(&s_mutex);
+        auto i = s_entries.begin();
+        while (i != s_entries.end()) {
+            if (i->key.location == location) {
+                evicted.push_back(std::move(i->entry.pSoundSource));
+                i = s_entries.erase(i);
+            } else {
+                ++i;
+            }
+        }
+    }
+    closeAll(evicted);
+}
+
+// static
+void SoundSourcePool::evictDirectory(const QDir& dir) {
+    const QString pathPrefix = dir.absolutePath() + QChar('/');
+    std::vector<SoundSourcePointer> evicted;
+    {
+        const auto locker = lockMutex(&s_mutex);
+        auto i = s_entries.begin();
+        while (i != s_entries.end()) {
+            if (i->key.location.startsWith(pathPrefix)) {
+                evicted.push_back(std::move(i->entry.pSoundSource));
+                i = s_entries.erase(i);
+            } else {
+                ++i;
+            }
+        }
+    }
+    closeAll(evicted);
+}
+
+// static
+void SoundSourcePool::closeExpired() {
+    std::vector<SoundSourcePointer> evicted;
+    {
+        const auto locker = lockMutex(&s_mutex);
+        s_closeExpiredScheduled = false;
+        // The least recently released SoundSources expire first
+        while (!s_entries.empty() &&
+                !(std::chrono::milliseconds(s_entries.front().idleTimer.elapsed()) <
+                        s_maxIdleDuration)) {
+            evicted.push_back(std::move(s_entries.front().entry.pSoundSource));
+            s_entries.erase(s_entries.begin());
+        }
+        scheduleCloseExpiredLocked();
+    }
+    if (!evicted.empty()) {
+        kLogger.debug()
+                << "Closing"
+                << evicted.size()
+                << "expired SoundSources";
+    }
+    closeAll(evicted);
+}
+
+// static
+void SoundSourcePool::clear() {
+    std::vector<SoundSourcePointer> evicted;
+    {
+        const auto locker = lockMutex(&s_mutex);
+        evicted.reserve(s_entries.size());
+        for (auto& pooledEntry : s_entries) {
+            evicted.push_back(std::move(pooledEntry.entry.pSoundSource));
+        }
+        s_entries.clear();
+    }
+    closeAll(evicted);
+}
+
+// static
+void SoundSourcePool::setCapacity(int capacity) {
+    DEBUG_ASSERT(capacity >= 0);
+    std::vector<SoundSourcePointer> evicted;
+    {
+        const auto locker = lockMutex(&s_mutex);
+        s_capacity = capacity;
+        evicted = trimLocked();
+    }
+    closeAll(evicted);
+}
+
+// static
+int SoundSourcePool::capacity() {
+    const auto locker = lockMutex(&s_mutex);
+    return s_capacity;
+}
+
+// static
+void SoundSourcePool::setMaxIdleDuration(std::chrono::milliseconds maxIdleDuration) {
+    DEBUG_ASSERT(maxIdleDuration >= std::chrono::milliseconds(0));
+    const auto locker = lockMutex(&s_mutex);
+    s_maxIdleDuration = maxIdleDuration;
+}
+
+// static
+std::chrono::milliseconds SoundSourcePool::maxIdleDuration() {
+    const auto locker = lockMutex(&s_mutex);
+    return s_maxIdleDuration;
+}
+
+// static
+int SoundSourcePool::size() {
+    const auto locker = lockMutex(&s_mutex);
+    return static_cast<int>(s_entries.size());
+}
+
+} // namespace mixxx
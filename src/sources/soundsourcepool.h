@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QDir>
+#include <QUrl>
+#include <chrono>
+
+#include "sources/soundsourceprovider.h"
+
+namespace mixxx {
+
+/// A bounded pool of opened SoundSources that are ready to be reused.
+///
+/// Opening a SoundSource might be expensive, e.g. when FFmpeg needs to
+/// probe the stream or when the MP3 decoder needs to index all frames.
+/// Tracks are often reopened shortly after they have been closed, e.g.
+/// when reloading a deck or sampler bank during preparation or when the
+/// analysis of a track that has just been loaded starts.
+///
+/// Instead of closing a SoundSource that has been opened through
+/// SoundSourceProxy, the AudioSource returned to the caller puts it
+/// back into the pool on close(). Only idle SoundSources are pooled,
+/// each pooled instance is handed out to a single caller at a time.
+/// The read position is restored by seeking implicitly on the next
+/// read.
+///
+/// Idle SoundSources are keyed by their file and outlive the Track
+/// object of the file, so reloading a track that has been unloaded in
+/// the meantime still finds them. They keep their file open, which
+/// prevents modifying, moving or deleting the file on some platforms.
+/// They are closed after a short idle time and when the file is about
+/// to be changed, i.e. before writing metadata into file tags, deleting,
+/// relocating or purging tracks.
+///
+/// All functions are thread-safe.
+class SoundSourcePool {
+  public:
+    static constexpr int kDefaultCapacity = 4;
+    static constexpr std::chrono::milliseconds kDefaultMaxIdleDuration =
+            std::chrono::seconds(30);
+
+    struct Entry {
+        SoundSourceProviderPointer pProvider;
+        SoundSourcePointer pSoundSource;
+    };
+
+    /// Takes an idle SoundSource for the file out of the pool that has
+    /// been opened with the same parameters. Returns an empty entry if
+    /// none is available or if the file has been modified since.
+    static Entry acquire(
+            const QUrl& url,
+            const AudioSource::OpenParams& params);
+
+    /// Wraps an opened SoundSource. Closing the returned AudioSource puts
+    /// the SoundSource back into the pool instead of closing the file.
+    static AudioSourcePointer wrap(
+            Entry entry,
+            const AudioSource::OpenParams& params);
+
+    /// Closes all idle SoundSources of a file, e.g. before modifying it.
+    static void evict(const QUrl& url);
+
+    /// Closes all idle SoundSources of files in the directory and its
+    /// subdirectories.
+    static void evictDirectory(const QDir& dir);
+
+    /// Closes all SoundSources that have been idle for longer than the
+    /// maximum idle duration. This is scheduled in the main thread
+    /// whenever a SoundSource is put into the pool.
+    static void closeExpired();
+
+    /// Closes all idle SoundSources.
+    static void clear();
+
+    /// The maximum number of idle SoundSources. Exceeding SoundSources
+    /// are closed in least recently used order. A capacity of 0 disables
+    /// pooling.
+    static void setCapacity(int capacity);
+    static int capacity();
+
+    static void setMaxIdleDuration(std::chrono::milliseconds maxIdleDuration);
+    static std::chrono::milliseconds maxIdleDuration();
+
+    /// The current number of idle SoundSources.
+    static int size();
+};
+
+} // namespace mixxx
@@ -6,6 +6,7 @@
 #include <QStandardPaths>
 
 #include "sources/audiosourcetrackproxy.h"
+#include "sources/soundsourcepool.h"
 
 #ifdef __MAD__
 #include "sources/soundsourcemp3.h"
@@ -192,6 +193,38 @@ QList<QMimeType> mimeTypesForFileType(const QString& fileType) {
     return mimeTypes;
 }
 
+/// Closes the idle SoundSources of the file right before writing
+/// file tags. Idle SoundSources would keep the file open and prevent
+/// writing, but they are kept if the tags are unmodified and the export
+/// is skipped.
+class EvictingMetadataSource : public mixxx::MetadataSource {
+  public:
+    EvictingMetadataSource(
+            const mixxx::MetadataSource& metadataSource,
+            QUrl url)
+            : m_metadataSource(metadataSource),
+              m_url(std::move(url)) {
+    }
+
+    std::pair<ImportResult, QDateTime> importTrackMetadataAndCoverImage(
+            mixxx::TrackMetadata* pTrackMetadata,
+            QImage* pCoverImage,
+            bool resetMissingTagMetadata) const override {
+        return m_metadataSource.importTrackMetadataAndCoverImage(
+                pTrackMetadata, pCoverImage, resetMissingTagMetadata);
+    }
+
+    std::pair<ExportResult, QDateTime> exportTrackMetadata(
+            const mixxx::TrackMetadata& trackMetadata) const override {
+        mixxx::SoundSourcePool::evict(m_url);
+        return m_metadataSource.exportTrackMetadata(trackMetadata);
+    }
+
+  private:
+    const mixxx::MetadataSource& m_metadataSource;
+    const QUrl m_url;
+};
+
 } // anonymous namespace
 
 // static
@@ -423,7 +456,9 @@ SoundSourceProxy::exportTrackMetadataBeforeSaving(
                 << fileInfo;
         return ExportTrackMetadataResult::Failed;
     }
-    return pTrack->exportMetadata(*pSoundSource, syncParams);
+    return pTrack->exportMetadata(
+            EvictingMetadataSource(*pSoundSource, fileInfo.toQUrl()),
+            syncParams);
 }
 
 // Used during tests only
@@ -854,17 +889,22 @@ SoundSourceProxy::UpdateTrackFromSourceResult SoundSourceProxy::updateTrackFromS
         // stream properties for finishing the pending import.
         kLogger.debug()
                 << "Opening audio source to finish import of beats/cues";
-        const auto pAudioSource = openAudioSource();
-        DEBUG_ASSERT(!pAudioSource ||
+        // The SoundSource is opened directly, bypassing SoundSourcePool.
+        // Files that are imported while scanning the library should not
+        // replace recently used SoundSources in the pool.
+        const bool opened = openSoundSource();
+        if (opened) {
+            m_pTrack->updateStreamInfoFromSource(
+                    m_pSoundSource->getStreamInfo());
+            // Close open file handles
+            m_pSoundSource->close();
+        }
+        DEBUG_ASSERT(!opened ||
                 m_pTrack->getBeatsImportStatus() ==
                         Track::ImportStatus::Complete);
-        DEBUG_ASSERT(!pAudioSource ||
+        DEBUG_ASSERT(!opened ||
                 m_pTrack->getCueImportStatus() ==
                         Track::ImportStatus::Complete);
-        if (pAudioSource) {
-            // Close open file handles
-            pAudioSource->close();
-        }
     }
 
     if (pCoverImg) {
@@ -952,11 +992,29 @@ mixxx::AudioSourcePointer SoundSourceProxy::openAudioSource(
     VERIFY_OR_DEBUG_ASSERT(m_pTrack) {
         return nullptr;
     }
-    if (!openSoundSource(params)) {
+    // A proxy that has been created with an explicit provider, e.g. for
+    // testing a particular decoder, has no provider registrations. It must
+    // neither reuse a pooled SoundSource of a different provider nor put
+    // its own SoundSource into the pool.
+    const bool usePool = !m_providerRegistrations.isEmpty();
+    auto pooled = usePool
+            ? mixxx::SoundSourcePool::acquire(m_url, params)
+            : mixxx::SoundSourcePool::Entry{};
+    if (pooled.pSoundSource) {
+        // Skip probing and opening the file again
+        m_pProvider = std::move(pooled.pProvider);
+        m_pSoundSource = std::move(pooled.pSoundSource);
+    } else if (!openSoundSource(params)) {
         return nullptr;
     }
     // Overwrite metadata with actual audio properties
     m_pTrack->updateStreamInfoFromSource(
             m_pSoundSource->getStreamInfo());
-    return mixxx::AudioSourceTrackProxy::create(m_pTrack, m_pSoundSource);
+    if (!usePool) {
+        return mixxx::AudioSourceTrackProxy::create(m_pTrack, m_pSoundSource);
+    }
+    return mixxx::AudioSourceTrackProxy::create(m_pTrack,
+            mixxx::SoundSourcePool::wrap(
+                    mixxx::SoundSourcePool::Entry{m_pProvider, m_pSoundSource},
+                    params));
 }
@@ -2,6 +2,7 @@
 
 #include <QDir>
 #include <QtDebug>
+#include <cmath>
 #include <vector>
 
 #include "analyzer/analyzertrack.h"
@@ -130,4 +131,59 @@ TEST_F(AnalyzerWaveformTest, canary) {
     EXPECT_DOUBLE_EQ(pWaveformSummary->getAudioVisualRatio(), 1.0);
 }
 
+TEST_F(AnalyzerWaveformTest, previewChunksAreReplaced) {
+    constexpr SINT kFrames = 2 * 44100;
+    constexpr SINT kChunkFrames = 4096;
+    constexpr SINT kPreviewStart = 44100;
+    std::vector<CSAMPLE> samples(kFrames * kChannelCount);
+    for (SINT i = 0; i < kFrames; ++i) {
+        samples[i * kChannelCount] = static_cast<CSAMPLE>(0.5 * std::sin(i * 0.05));
+        samples[i * kChannelCount + 1] = samples[i * kChannelCount];
+    }
+
+    ASSERT_TRUE(m_aw.initialize(AnalyzerTrack(m_pTrack),
+            m_pTrack->getSampleRate(),
+            m_pTrack->getChannels(),
+            kFrames));
+    ConstWaveformPointer pWaveform = m_pTrack->getWaveform();
+    ASSERT_NE(pWaveform, nullptr);
+
+    // Analyze consecutive chunks in the middle of the track in advance
+    for (SINT frame = kPreviewStart; frame < kPreviewStart + 2 * kChunkFrames;
+            frame += kChunkFrames) {
+        m_aw.processPreviewChunk(AnalyzerChunk(&samples[frame * kChannelCount],
+                                         kChunkFrames * kChannelCount,
+                                         m_pTrack->getChannels()),
+                frame);
+    }
+    EXPECT_EQ(pWaveform->getCompletion(), 0);
+    EXPECT_EQ(pWaveform->getAll(0), 0);
+    // The first and the last stride of the region are incomplete
+    const double strideLength = pWaveform->getAudioVisualRatio();
+    const int firstStride = static_cast<int>(std::ceil(kPreviewStart / strideLength)) + 1;
+    const int lastStride = static_cast<int>(
+                                   (kPreviewStart + 2 * kChunkFrames) / strideLength) -
+            2;
+    for (int stride = firstStride; stride <= lastStride; ++stride) {
+        EXPECT_GT(pWaveform->getAll(stride * kChannelCount), 0) << stride;
+    }
+
+    m_aw.processSamples(samples.data(), kFrames * kChannelCount);
+    m_aw.storeResults(m_pTrack);
+    m_aw.cleanup();
+
+    // The preliminary results have been replaced
+    TrackPointer pReferenceTrack = Track::newTemporary();
+    AnalyzerWaveform referenceAnalyzer(config(), QSqlDatabase());
+    ASSERT_TRUE(referenceAnalyzer.initialize(AnalyzerTrack(pReferenceTrack),
+            m_pTrack->getSampleRate(),
+            m_pTrack->getChannels(),
+            kFrames));
+    referenceAnalyzer.processSamples(samples.data(), kFrames * kChannelCount);
+    referenceAnalyzer.storeResults(pReferenceTrack);
+    referenceAnalyzer.cleanup();
+    EXPECT_EQ(pReferenceTrack->getWaveform()->toByteArray(),
+            m_pTrack->getWaveform()->toByteArray());
+}
+
 } // namespace
@@ -0,0 +1,173 @@
+#include "analyzer/analysiscache.h"
+
+#include <QTemporaryDir>
+
+#include "sources/soundsourceproxy.h"
+#include "test/mixxxtest.h"
+#include "test/soundsourceproviderregistration.h"
+#include "track/track.h"
+#include "util/math.h"
+
+namespace {
+
+class AnalysisCacheTest : public MixxxTest, SoundSourceProviderRegistration {
+  protected:
+    void SetUp() override {
+        ASSERT_TRUE(m_tempDir.isValid());
+        mixxx::AnalysisCache::setStorageDirectory(m_tempDir.path());
+    }
+
+    void TearDown() override {
+        mixxx::AnalysisCache::setStorageDirectory(QString());
+    }
+
+    mixxx::AudioSourcePointer openAudioSource(const QString& fileName) const {
+        mixxx::AudioSource::OpenParams openParams;
+        openParams.setChannelCount(mixxx::audio::ChannelCount::stereo());
+        const auto pAudioSource =
+                SoundSourceProxy(Track::newTemporary(
+                                         getTestDir().filePath(
+                                                 QStringLiteral("id3-test-data/") +
+                                                 fileName)))
+                        .openAudioSource(openParams);
+        EXPECT_TRUE(pAudioSource);
+        return pAudioSource;
+    }
+
+    mixxx::cache_key_t contentKey(const QString& fileName) const {
+        const auto pAudioSource = openAudioSource(fileName);
+        if (!pAudioSource) {
+            return mixxx::invalidCacheKey();
+        }
+        mixxx::SampleBuffer buffer(4096);
+        return mixxx::AnalysisCache::contentKey(
+                pAudioSource.get(), mixxx::SampleBuffer::WritableSlice(buffer));
+    }
+
+    // Decodes the whole file, or only the first half if partial
+    QByteArray contentDigest(const QString& fileName, bool partial = false) const {
+        const auto pAudioSource = openAudioSource(fileName);
+        if (!pAudioSource) {
+            return QByteArray();
+        }
+        mixxx::AnalysisContentDigest digest(
+                pAudioSource->getSignalInfo(),
+                pAudioSource->frameIndexRange().start());
+        mixxx::SampleBuffer buffer(4096);
+        auto remainingFrameRange = pAudioSource->frameIndexRange();
+        if (partial) {
+            remainingFrameRange.shrinkBack(remainingFrameRange.length() / 2);
+        }
+        while (!remainingFrameRange.empty()) {
+            const auto readableSampleFrames = pAudioSource->readSampleFrames(
+                    mixxx::WritableSampleFrames(
+                            remainingFrameRange.splitAndShrinkFront(math_min(
+                                    pAudioSource->getSignalInfo().samples2frames(
+                                            buffer.size()),
+                                    remainingFrameRange.length())),
+                            mixxx::SampleBuffer::WritableSlice(buffer)));
+            digest.addFrames(readableSampleFrames);
+        }
+        return digest.finish(pAudioSource->frameIndexRange());
+    }
+
+    static mixxx::AnalysisCacheEntry makeEntry() {
+        mixxx::AnalysisCacheEntry entry;
+        entry.contentDigest = QByteArray(32, 'd');
+        entry.waveformVersion = QStringLiteral("Waveform-1");
+        entry.waveform = QByteArray(1000, 'w');
+        entry.beatsVersion = QStringLiteral("BeatMap-1.0");
+        entry.beatsSubVersion = QStringLiteral("plugin=test");
+        entry.beats = QByteArray("beats");
+        entry.replayGain2Ratio = 0.5;
+        entry.firstSoundPosition = mixxx::audio::FramePos(1234);
+        entry.lastSoundPosition = mixxx::audio::FramePos(567890);
+        return entry;
+    }
+
+    static void expectEqual(
+            const mixxx::AnalysisCacheEntry& expected,
+            const mixxx::AnalysisCacheEntry& actual) {
+        EXPECT_EQ(expected.contentDigest, actual.contentDigest);
+        EXPECT_EQ(expected.waveformVersion, actual.waveformVersion);
+        EXPECT_EQ(expected.waveform, actual.waveform);
+        EXPECT_EQ(expected.waveformSummaryVersion, actual.waveformSummaryVersion);
+        EXPECT_EQ(expected.waveformSummary, actual.waveformSummary);
+        EXPECT_EQ(expected.beatsVersion, actual.beatsVersion);
+        EXPECT_EQ(expected.beatsSubVersion, actual.beatsSubVersion);
+        EXPECT_EQ(expected.beats, actual.beats);
+        EXPECT_EQ(expected.keysVersion, actual.keysVersion);
+        EXPECT_EQ(expected.keysSubVersion, actual.keysSubVersion);
+        EXPECT_EQ(expected.keys, actual.keys);
+        EXPECT_EQ(expected.replayGain1Ratio, actual.replayGain1Ratio);
+        EXPECT_EQ(expected.replayGain2Ratio, actual.replayGain2Ratio);
+        EXPECT_EQ(expected.firstSoundPosition, actual.firstSoundPosition);
+        EXPECT_EQ(expected.lastSoundPosition, actual.lastSoundPosition);
+    }
+
+    QTemporaryDir m_tempDir;
+};
+
+TEST_F(AnalysisCacheTest, EncodeDecode) {
+    const auto entry = makeEntry();
+    const auto decoded = mixxx::AnalysisCacheEntry::decode(entry.encode());
+    ASSERT_TRUE(decoded);
+    expectEqual(entry, *decoded);
+
+    // Missing results
+    const auto empty = mixxx::AnalysisCacheEntry::decode(
+            mixxx::AnalysisCacheEntry{}.encode());
+    ASSERT_TRUE(empty);
+    EXPECT_TRUE(empty->beats.isEmpty());
+    EXPECT_FALSE(empty->firstSoundPosition.isValid());
+    EXPECT_FALSE(mixxx::ReplayGain::isValidRatio(empty->replayGain1Ratio));
+
+    EXPECT_FALSE(mixxx::AnalysisCacheEntry::decode(QByteArray("garbage")));
+}
+
+TEST_F(AnalysisCacheTest, SaveAndLoad) {
+    constexpr mixxx::cache_key_t kContentKey = 0x0123456789abcdef;
+    EXPECT_FALSE(mixxx::AnalysisCache::load(kContentKey));
+
+    const auto entry = makeEntry();
+    ASSERT_TRUE(mixxx::AnalysisCache::save(kContentKey, entry));
+    const auto loaded = mixxx::AnalysisCache::load(kContentKey);
+    ASSERT_TRUE(loaded);
+    expectEqual(entry, *loaded);
+    EXPECT_FALSE(mixxx::AnalysisCache::load(kContentKey + 1));
+
+    mixxx::AnalysisCache::setStorageDirectory(QString());
+    EXPECT_FALSE(mixxx::AnalysisCache::isEnabled());
+    EXPECT_FALSE(mixxx::AnalysisCache::load(kContentKey));
+    EXPECT_FALSE(mixxx::AnalysisCache::save(kContentKey, entry));
+}
+
+TEST_F(AnalysisCacheTest, ContentKey) {
+    // Both files contain the same MPEG frames with different tags
+    const auto key = contentKey(QStringLiteral("cover-test-jpg.mp3"));
+    EXPECT_TRUE(mixxx::isValidCacheKey(key));
+    EXPECT_EQ(key, contentKey(QStringLiteral("cover-test-png.mp3")));
+    EXPECT_NE(key, contentKey(QStringLiteral("cover-test-vbr.mp3")));
+    EXPECT_NE(key, contentKey(QStringLiteral("cover-test.wav")));
+}
+
+TEST_F(AnalysisCacheTest, ContentDigest) {
+    const auto digest = contentDigest(QStringLiteral("cover-test-jpg.mp3"));
+    EXPECT_FALSE(digest.isEmpty());
+    EXPECT_EQ(digest, contentDigest(QStringLiteral("cover-test-png.mp3")));
+    EXPECT_NE(digest, contentDigest(QStringLiteral("cover-test-vbr.mp3")));
+    // Incomplete
+    EXPECT_TRUE(contentDigest(QStringLiteral("cover-test-jpg.mp3"), true).isEmpty());
+}
+
+TEST_F(AnalysisCacheTest, Clear) {
+    constexpr mixxx::cache_key_t kContentKey = 0x0123456789abcdef;
+    ASSERT_TRUE(mixxx::AnalysisCache::save(kContentKey, makeEntry()));
+    EXPECT_LT(0, mixxx::AnalysisCache::diskUsageInBytes());
+
+    EXPECT_TRUE(mixxx::AnalysisCache::clear());
+    EXPECT_EQ(0, mixxx::AnalysisCache::diskUsageInBytes());
+    EXPECT_FALSE(mixxx::AnalysisCache::load(kContentKey));
+}
+
+} // namespace
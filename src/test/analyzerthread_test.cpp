@@ -0,0 +1,108 @@
+#include "analyzer/analyzerthread.h"
+
+#include <QSemaphore>
+#include <QTemporaryDir>
+
+#include "analyzer/analysiscache.h"
+#include "analyzer/analyzertrack.h"
+#include "analyzer/constants.h"
+#include "test/mixxxtest.h"
+#include "test/soundsourceproviderregistration.h"
+#include "track/track.h"
+
+namespace {
+
+constexpr int kTimeoutMillis = 60000;
+
+class AnalyzerThreadTest : public MixxxTest, SoundSourceProviderRegistration {
+  protected:
+    AnalyzerThreadTest()
+            : m_filePath(getTestDir().filePath(
+                      QStringLiteral("id3-test-data/cover-test-jpg.mp3"))),
+              m_thread(0, nullptr, config(), AnalyzerModeFlags::WithBeats) {
+    }
+
+    void SetUp() override {
+        ASSERT_TRUE(m_tempDir.isValid());
+        mixxx::AnalysisCache::setStorageDirectory(m_tempDir.path());
+        connect(&m_thread,
+                &AnalyzerThread::progress,
+                &m_thread,
+                [this](int, AnalyzerThreadState threadState, TrackId, AnalyzerProgress) {
+                    if (threadState == AnalyzerThreadState::Idle) {
+                        m_idle.release();
+                    } else if (threadState == AnalyzerThreadState::Done) {
+                        m_done.release();
+                    }
+                },
+                Qt::DirectConnection);
+        m_thread.start();
+    }
+
+    void TearDown() override {
+        m_thread.stop();
+        m_thread.wait();
+        mixxx::AnalysisCache::setStorageDirectory(QString());
+    }
+
+    TrackPointer analyzeTrack() {
+        auto pTrack = Track::newTemporary(m_filePath);
+        EXPECT_TRUE(m_idle.tryAcquire(1, kTimeoutMillis));
+        EXPECT_TRUE(m_thread.submitNextTrack(AnalyzerTrack(pTrack)));
+        EXPECT_TRUE(m_done.tryAcquire(1, kTimeoutMillis));
+        return pTrack;
+    }
+
+    mixxx::cache_key_t contentKey() {
+        mixxx::AudioSource::OpenParams openParams;
+        openParams.setChannelCount(mixxx::audio::ChannelCount::stereo());
+        const auto pAudioSource =
+                SoundSourceProxy(Track::newTemporary(m_filePath))
+                        .openAudioSource(openParams);
+        EXPECT_TRUE(pAudioSource);
+        if (!pAudioSource) {
+            return mixxx::invalidCacheKey();
+        }
+        mixxx::SampleBuffer buffer(mixxx::kAnalysisSamplesPerChunk);
+        return mixxx::AnalysisCache::contentKey(
+                pAudioSource.get(), mixxx::SampleBuffer::WritableSlice(buffer));
+    }
+
+    const QString m_filePath;
+    QTemporaryDir m_tempDir;
+    AnalyzerThread m_thread;
+    QSemaphore m_idle;
+    QSemaphore m_done;
+};
+
+TEST_F(AnalyzerThreadTest, RestoreCachedResults) {
+    const auto pAnalyzedTrack = analyzeTrack();
+    const double analyzedRatio = pAnalyzedTrack->getReplayGain().getRatio();
+    ASSERT_TRUE(mixxx::ReplayGain::isValidRatio(analyzedRatio));
+
+    const auto key = contentKey();
+    auto entry = mixxx::AnalysisCache::load(key);
+    ASSERT_TRUE(entry);
+    EXPECT_FALSE(entry->contentDigest.isEmpty());
+    EXPECT_EQ(analyzedRatio, entry->replayGain2Ratio);
+
+    // Results are restored from an entry with the same content digest
+    constexpr double kCachedRatio = 0.25;
+    ASSERT_NE(kCachedRatio, analyzedRatio);
+    entry->replayGain2Ratio = kCachedRatio;
+    ASSERT_TRUE(mixxx::AnalysisCache::save(key, *entry));
+    EXPECT_EQ(kCachedRatio, analyzeTrack()->getReplayGain().getRatio());
+
+    // Entries of different audio content with the same content key are
+    // not restored and replaced after analyzing the track
+    const QByteArray contentDigest = entry->contentDigest;
+    entry->contentDigest = QByteArray(contentDigest.size(), '\0');
+    ASSERT_TRUE(mixxx::AnalysisCache::save(key, *entry));
+    EXPECT_EQ(analyzedRatio, analyzeTrack()->getReplayGain().getRatio());
+    entry = mixxx::AnalysisCache::load(key);
+    ASSERT_TRUE(entry);
+    EXPECT_EQ(contentDigest, entry->contentDigest);
+    EXPECT_EQ(analyzedRatio, entry->replayGain2Ratio);
+}
+
+} // namespace
@@ -1,6 +1,9 @@
+#include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
 
 #include <QtDebug>
+#include <algorithm>
+#include <cmath>
 #include <memory>
 
 #include "track/beats.h"
@@ -251,4 +254,63 @@ TEST_F(BeatMapTest, HasBeatInRangeWithFractionalPos) {
             mixxx::audio::kStartFramePos + 0.2));
 }
 
+// A beat map with a new marker for every beat, e.g. from the detected
+// beats of a track with a non-constant tempo.
+BeatsPointer createDenseBeatMap(mixxx::audio::SampleRate sampleRate, int numBeats) {
+    QVector<mixxx::audio::FramePos> beats;
+    mixxx::audio::FramePos beatPos = mixxx::audio::FramePos(1234);
+    for (int i = 0; i < numBeats; ++i) {
+        beats.append(beatPos);
+        beatPos += (i % 2 == 0) ? 5000 : 5020;
+    }
+    return Beats::fromBeatPositions(sampleRate, beats);
+}
+
+TEST_F(BeatMapTest, IteratorFromDenseBeatMap) {
+    const auto pMap = createDenseBeatMap(m_sampleRate, 1000);
+    ASSERT_GT(pMap->getMarkers().size(), 900u);
+
+    const auto firstMarkerPos = pMap->getMarkers().front().position();
+    const auto lastMarkerPos = pMap->getLastMarkerPosition();
+    for (auto position = firstMarkerPos; position <= lastMarkerPos; position += 37.5) {
+        const auto expected = std::lower_bound(
+                pMap->cfirstmarker(), pMap->clastmarker() + 1, position);
+        EXPECT_EQ(*expected, *pMap->iteratorFrom(position)) << position;
+    }
+    // Exactly on a beat
+    for (auto it = pMap->cfirstmarker(); it != pMap->clastmarker() + 1; ++it) {
+        EXPECT_EQ(*it, *pMap->iteratorFrom(*it));
+        EXPECT_EQ(*it, pMap->findNextBeat(*it));
+    }
+}
+
+void BM_BeatsIteratorFrom(benchmark::State& state) {
+    const auto pMap = createDenseBeatMap(
+            mixxx::audio::SampleRate(44100), static_cast<int>(state.range(0)));
+    const auto firstMarkerPos = pMap->getMarkers().front().position();
+    const auto length = pMap->getLastMarkerPosition() - firstMarkerPos;
+    int i = 0;
+    for (auto _ : state) {
+        // Pseudo-random positions across all markers
+        const auto position = firstMarkerPos + std::fmod(i++ * 7919.3, length);
+        benchmark::DoNotOptimize(*pMap->iteratorFrom(position));
+    }
+}
+BENCHMARK(BM_BeatsIteratorFrom)->Range(1 << 6, 1 << 14);
+
+// The binary search over all beats that was used before
+void BM_BeatsIteratorFromBinarySearch(benchmark::State& state) {
+    const auto pMap = createDenseBeatMap(
+            mixxx::audio::SampleRate(44100), static_cast<int>(state.range(0)));
+    const auto firstMarkerPos = pMap->getMarkers().front().position();
+    const auto length = pMap->getLastMarkerPosition() - firstMarkerPos;
+    int i = 0;
+    for (auto _ : state) {
+        const auto position = firstMarkerPos + std::fmod(i++ * 7919.3, length);
+        benchmark::DoNotOptimize(*std::lower_bound(
+                pMap->cfirstmarker(), pMap->clastmarker() + 1, position));
+    }
+}
+BENCHMARK(BM_BeatsIteratorFromBinarySearch)->Range(1 << 6, 1 << 14);
+
 }  // namespace
@@ -0,0 +1,67 @@
+#include "util/cachedirectory.h"
+
+#include <gtest/gtest.h>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+namespace {
+
+class CacheDirectoryTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        ASSERT_TRUE(m_tempDir.isValid());
+    }
+
+    // Writes a file that has been modified the given number of days ago
+    void writeFile(const QString& fileName, int size, int ageDays) {
+        QFile file(m_tempDir.filePath(fileName));
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        ASSERT_EQ(size, file.write(QByteArray(size, '\0')));
+        ASSERT_TRUE(file.setFileTime(
+                QDateTime::currentDateTimeUtc().addDays(-ageDays),
+                QFileDevice::FileModificationTime));
+    }
+
+    QStringList fileNames() const {
+        return QDir(m_tempDir.path()).entryList(QDir::Files, QDir::Name);
+    }
+
+    QTemporaryDir m_tempDir;
+};
+
+TEST_F(CacheDirectoryTest, PurgeByAge) {
+    writeFile(QStringLiteral("a"), 10, 1);
+    writeFile(QStringLiteral("b"), 10, 100);
+    EXPECT_EQ(1, mixxx::CacheDirectory::purge(m_tempDir.path(), {100, 1000, 30}));
+    EXPECT_EQ(QStringList{QStringLiteral("a")}, fileNames());
+}
+
+TEST_F(CacheDirectoryTest, PurgeByCount) {
+    writeFile(QStringLiteral("a"), 10, 3);
+    writeFile(QStringLiteral("b"), 10, 1);
+    writeFile(QStringLiteral("c"), 10, 2);
+    EXPECT_EQ(1, mixxx::CacheDirectory::purge(m_tempDir.path(), {2, 1000, 30}));
+    EXPECT_EQ(QStringList({QStringLiteral("b"), QStringLiteral("c")}), fileNames());
+}
+
+TEST_F(CacheDirectoryTest, PurgeBySize) {
+    writeFile(QStringLiteral("a"), 100, 1);
+    writeFile(QStringLiteral("b"), 100, 2);
+    writeFile(QStringLiteral("c"), 100, 3);
+    EXPECT_EQ(2, mixxx::CacheDirectory::purge(m_tempDir.path(), {100, 150, 30}));
+    EXPECT_EQ(QStringList{QStringLiteral("a")}, fileNames());
+    EXPECT_EQ(100, mixxx::CacheDirectory::diskUsageInBytes(m_tempDir.path()));
+}
+
+TEST_F(CacheDirectoryTest, Clear) {
+    writeFile(QStringLiteral("a"), 10, 1);
+    writeFile(QStringLiteral("b"), 10, 2);
+    EXPECT_TRUE(mixxx::CacheDirectory::clear(m_tempDir.path()));
+    EXPECT_TRUE(fileNames().isEmpty());
+    EXPECT_EQ(0, mixxx::CacheDirectory::diskUsageInBytes(m_tempDir.path()));
+}
+
+} // namespace
@@ -0,0 +1,432 @@
+#include "test/effectsrender.h"
+
+#include <sndfile.h>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "control/control.h"
+#include "control/controlobject.h"
+#include "effects/effectchain.h"
+#include "effects/effectsmanager.h"
+#include "effects/presets/effectchainpreset.h"
+#include "engine/effects/engineeffectsmanager.h"
+#include "engine/effects/groupfeaturestate.h"
+#include "engine/engine.h"
+#include "util/assert.h"
+#include "util/performancetimer.h"
+
+namespace {
+
+const QString kInputGroup = QStringLiteral("[Channel1]");
+const QString kOutputGroup = QStringLiteral("[Master]");
+const QString kAll = QStringLiteral("all");
+
+constexpr int kChannelCount = mixxx::kEngineChannelOutputCount.value();
+
+/// Stereo interleaved samples
+struct Audio {
+    SINT frames() const {
+        return static_cast<SINT>(samples.size()) / kChannelCount;
+    }
+
+    mixxx::audio::SampleRate sampleRate;
+    std::vector<CSAMPLE> samples;
+};
+
+/// Reads any format that is supported by libsndfile. Mono files are
+/// duplicated to both channels, further channels are ignored.
+bool readAudio(const QString& fileName, Audio* pAudio) {
+    SF_INFO info{};
+    SNDFILE* pFile = sf_open(QFile::encodeName(fileName).constData(), SFM_READ, &info);
+    if (!pFile) {
+        qWarning() << "Failed to open" << fileName << sf_strerror(nullptr);
+        return false;
+    }
+    std::vector<float> fileSamples(info.frames * info.channels);
+    const sf_count_t frames = sf_readf_float(pFile, fileSamples.data(), info.frames);
+    if (frames != info.frames) {
+        qWarning() << "Failed to read" << fileName << sf_strerror(pFile);
+        sf_close(pFile);
+        return false;
+    }
+    sf_close(pFile);
+
+    pAudio->sampleRate = mixxx::audio::SampleRate(info.samplerate);
+    pAudio->samples.resize(frames * kChannelCount);
+    for (sf_count_t frame = 0; frame < frames; ++frame) {
+        const float* pFrame = &fileSamples[frame * info.channels];
+        pAudio->samples[frame * kChannelCount] = pFrame[0];
+        pAudio->samples[frame * kChannelCount + 1] =
+                info.channels > 1 ? pFrame[1] : pFrame[0];
+    }
+    return true;
+}
+
+/// Writes 32 bit float WAV, so the output is not dithered or rounded
+bool writeAudio(const QString& fileName, const Audio& audio) {
+    SF_INFO info{};
+    info.samplerate = static_cast<int>(audio.sampleRate.value());
+    info.channels = kChannelCount;
+    info.format = SF_FORMAT_WAV | SF_FORMAT_FLOAT;
+    SNDFILE* pFile = sf_open(QFile::encodeName(fileName).constData(), SFM_WRITE, &info);
+    if (!pFile) {
+        qWarning() << "Failed to create" << fileName << sf_strerror(nullptr);
+        return false;
+    }
+    const sf_count_t frames = sf_writef_float(pFile, audio.samples.data(), audio.frames());
+    if (frames != audio.frames()) {
+        qWarning() << "Failed to write" << fileName << sf_strerror(pFile);
+        sf_close(pFile);
+        return false;
+    }
+    // Flushes the file
+    if (sf_close(pFile) != 0) {
+        qWarning() << "Failed to write" << fileName;
+        return false;
+    }
+    return true;
+}
+
+QString fileNameForRender(const QString& directory, QString name) {
+    for (auto& character : name) {
+        if (!character.isLetterOrNumber() && character != '.' && character != '-') {
+            character = '_';
+        }
+    }
+    return directory + QStringLiteral("/") + name + QStringLiteral(".wav");
+}
+
+struct RenderStats {
+    double minMicros = std::numeric_limits<double>::max();
+    double maxMicros = 0;
+    double totalMicros = 0;
+    int buffers = 0;
+};
+
+/// Processes the effects of the first StandardEffectChain on a single
+/// input channel, like the ChannelMixer does for a deck
+class EffectsRenderer {
+  public:
+    EffectsRenderer(UserSettingsPointer pConfig,
+            const mixxx::EngineParameters& engineParameters,
+            double mix,
+            double bpm)
+            : m_pChannelHandleFactory(std::make_shared<ChannelHandleFactory>()),
+              m_inputHandle(m_pChannelHandleFactory->getOrCreateHandle(kInputGroup)),
+              m_outputHandle(m_pChannelHandleFactory->getOrCreateHandle(kOutputGroup)),
+              m_engineParameters(engineParameters),
+              m_mix(mix),
+              m_bpm(bpm),
+              m_buffer(engineParameters.samplesPerBuffer()) {
+        m_pEffectsManager = std::make_unique<EffectsManager>(
+                pConfig, m_pChannelHandleFactory);
+        m_pEffectsManager->registerInputChannel(
+                ChannelHandleAndGroup(m_inputHandle, kInputGroup));
+        m_pEffectsManager->registerOutputChannel(
+                ChannelHandleAndGroup(m_outputHandle, kOutputGroup));
+        m_pEffectsManager->setup();
+        m_pChain = m_pEffectsManager->getStandardEffectChain(0);
+        m_enableKey = ConfigKey(m_pChain->group(),
+                QStringLiteral("group_%1_enable").arg(kInputGroup));
+    }
+
+    const EffectsManager& effectsManager() const {
+        return *m_pEffectsManager;
+    }
+
+    RenderStats render(EffectChainPresetPointer pPreset,
+            const Audio& input,
+            Audio* pOutput) {
+        load(pPreset);
+        pOutput->sampleRate = m_engineParameters.sampleRate();
+        pOutput->samples.clear();
+        pOutput->samples.reserve(input.samples.size());
+
+        RenderStats stats;
+        const SINT samplesPerBuffer = m_engineParameters.samplesPerBuffer();
+        const auto inputSamples = static_cast<SINT>(input.samples.size());
+        for (SINT offset = 0; offset < inputSamples; offset += samplesPerBuffer) {
+            // The last buffer is padded with silence, because the engine
+            // always processes buffers of the same size
+            const SINT count = std::min(samplesPerBuffer, inputSamples - offset);
+            std::copy_n(input.samples.begin() + offset, count, m_buffer.begin());
+            std::fill(m_buffer.begin() + count, m_buffer.end(), CSAMPLE_ZERO);
+
+            PerformanceTimer timer;
+            timer.start();
+            process(offset / kChannelCount);
+            const double micros = timer.elapsed().toDoubleMicros();
+
+            stats.minMicros = std::min(stats.minMicros, micros);
+            stats.maxMicros = std::max(stats.maxMicros, micros);
+            stats.totalMicros += micros;
+            stats.buffers++;
+            pOutput->samples.insert(pOutput->samples.end(),
+                    m_buffer.begin(),
+                    m_buffer.begin() + count);
+        }
+        return stats;
+    }
+
+  private:
+    void load(EffectChainPresetPointer pPreset) {
+        // Fade out the previous effects, so each render starts from the same
+        // state of the chain, independent of the renders before.
+        ControlObject::set(m_enableKey, 0);
+        std::fill(m_buffer.begin(), m_buffer.end(), CSAMPLE_ZERO);
+        process(0);
+
+        m_pChain->loadChainPreset(pPreset);
+        ControlObject::set(ConfigKey(m_pChain->group(), QStringLiteral("mix")), m_mix);
+        ControlObject::set(m_enableKey, 1);
+        // Add the effects to the engine before measuring the first buffer
+        m_pEffectsManager->getEngineEffectsManager()->onCallbackStart();
+    }
+
+    void process(SINT framePosition) {
+        GroupFeatureState features;
+        if (m_bpm > 0) {
+            const double beatFrames = m_engineParameters.sampleRate().toDouble() * 60 / m_bpm;
+            const double endFrames = framePosition + m_engineParameters.framesPerBuffer();
+            features.beat_length = GroupFeatureBeatLength{beatFrames, 1.0};
+            features.beat_fraction_buffer_end = std::fmod(endFrames / beatFrames, 1.0);
+        }
+        EngineEffectsManager* pEngineEffectsManager =
+                m_pEffectsManager->getEngineEffectsManager();
+        pEngineEffectsManager->onCallbackStart();
+        pEngineEffectsManager->processPostFaderInPlace(m_inputHandle,
+                m_outputHandle,
+                m_buffer.data(),
+                m_buffer.size(),
+                m_engineParameters.sampleRate(),
+                features);
+    }
+
+    const std::shared_ptr<ChannelHandleFactory> m_pChannelHandleFactory;
+    const ChannelHandle m_inputHandle;
+    const ChannelHandle m_outputHandle;
+    const mixxx::EngineParameters m_engineParameters;
+    const double m_mix;
+    const double m_bpm;
+    std::unique_ptr<EffectsManager> m_pEffectsManager;
+    EffectChainPointer m_pChain;
+    ConfigKey m_enableKey;
+    std::vector<CSAMPLE> m_buffer;
+};
+
+/// Returns the largest absolute difference or infinity if the lengths differ
+CSAMPLE compareAudio(const Audio& audio, const Audio& reference) {
+    if (audio.samples.size() != reference.samples.size()) {
+        return std::numeric_limits<CSAMPLE>::infinity();
+    }
+    CSAMPLE maxDifference = CSAMPLE_ZERO;
+    for (std::size_t i = 0; i < audio.samples.size(); ++i) {
+        maxDifference = std::max(maxDifference,
+                std::abs(audio.samples[i] - reference.samples[i]));
+    }
+    return maxDifference;
+}
+
+} // namespace
+
+namespace mixxxtest {
+
+int renderEffects(int argc, char** argv) {
+    QStringList arguments;
+    for (int i = 0; i < argc; ++i) {
+        arguments << QString::fromLocal8Bit(argv[i]);
+    }
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral(
+            "Renders an audio file through built-in effects and effect chain "
+            "presets and reports the time spent per buffer."));
+    parser.addHelpOption();
+    const QCommandLineOption renderOption(QStringLiteral("render-effects"),
+            QStringLiteral("Render effects instead of running the tests."));
+    const QCommandLineOption inputOption(QStringLiteral("input"),
+            QStringLiteral("The audio file to process."),
+            QStringLiteral("file"));
+    const QCommandLineOption outputOption(QStringLiteral("output"),
+            QStringLiteral("Write each render as <name>.wav into this directory."),
+            QStringLiteral("directory"));
+    const QCommandLineOption referenceOption(QStringLiteral("reference"),
+            QStringLiteral("Compare each render with <name>.wav from a previous "
+                           "--output directory and fail unless they are "
+                           "bit-exact."),
+            QStringLiteral("directory"));
+    const QCommandLineOption effectOption(QStringLiteral("effect"),
+            QStringLiteral("The id of a built-in effect or 'all'. Can be repeated."),
+            QStringLiteral("id"));
+    const QCommandLineOption presetOption(QStringLiteral("preset"),
+            QStringLiteral("The name of an effect chain preset or 'all'. "
+                           "Can be repeated."),
+            QStringLiteral("name"));
+    const QCommandLineOption rateOption(QStringLiteral("rate"),
+            QStringLiteral("The engine sample rate. The input is not resampled. "
+                           "Default: the sample rate of the input."),
+            QStringLiteral("Hz"));
+    const QCommandLineOption bufferOption(QStringLiteral("buffer"),
+            QStringLiteral("The number of frames per buffer."),
+            QStringLiteral("frames"),
+            QStringLiteral("1024"));
+    const QCommandLineOption mixOption(QStringLiteral("mix"),
+            QStringLiteral("The dry/wet mix of the chain."),
+            QStringLiteral("0..1"),
+            QStringLiteral("1"));
+    const QCommandLineOption bpmOption(QStringLiteral("bpm"),
+            QStringLiteral("The tempo reported to beat synced effects. "
+                           "Default: none, like a track without beats."),
+            QStringLiteral("bpm"),
+            QStringLiteral("0"));
+    parser.addOptions({renderOption,
+            inputOption,
+            outputOption,
+            referenceOption,
+            effectOption,
+            presetOption,
+            rateOption,
+            bufferOption,
+            mixOption,
+            bpmOption});
+    // Exits on --help and on errors
+    parser.process(arguments);
+
+    QTextStream out(stdout);
+    if (!parser.isSet(inputOption)) {
+        out << "Missing --input" << Qt::endl;
+        return 1;
+    }
+    Audio input;
+    if (!readAudio(parser.value(inputOption), &input)) {
+        return 1;
+    }
+    const mixxx::audio::SampleRate sampleRate = parser.isSet(rateOption)
+            ? mixxx::audio::SampleRate(parser.value(rateOption).toUInt())
+            : input.sampleRate;
+    const SINT framesPerBuffer = parser.value(bufferOption).toInt();
+    if (!sampleRate.isValid() || framesPerBuffer <= 0 ||
+            framesPerBuffer > static_cast<SINT>(kMaxEngineFrames)) {
+        out << "Invalid --rate or --buffer" << Qt::endl;
+        return 1;
+    }
+    const mixxx::EngineParameters engineParameters(sampleRate, framesPerBuffer);
+
+    // Don't touch the settings and presets of the user
+    QTemporaryDir settingsDir;
+    VERIFY_OR_DEBUG_ASSERT(settingsDir.isValid()) {
+        return 1;
+    }
+    const QString configFileName = settingsDir.filePath(QStringLiteral("mixxx.cfg"));
+    if (!QFile(configFileName).open(QIODevice::WriteOnly)) {
+        out << "Failed to create " << configFileName << Qt::endl;
+        return 1;
+    }
+    auto pConfig = UserSettingsPointer(new UserSettings(configFileName));
+    ControlDoublePrivate::setUserConfig(pConfig);
+
+    EffectsRenderer renderer(pConfig,
+            engineParameters,
+            parser.value(mixOption).toDouble(),
+            parser.value(bpmOption).toDouble());
+
+    // Renders the built-in effects with their default parameters and the
+    // chain presets as they are loaded into an effect unit
+    QList<QPair<QString, EffectChainPresetPointer>> renders;
+    QStringList effectIds = parser.values(effectOption);
+    QStringList presetNames = parser.values(presetOption);
+    if (effectIds.isEmpty() && presetNames.isEmpty()) {
+        effectIds << kAll;
+        presetNames << kAll;
+    }
+    const auto pBackendManager = renderer.effectsManager().getBackendManager();
+    for (const auto& effectId : std::as_const(effectIds)) {
+        if (effectId == kAll) {
+            for (const auto& pManifest : pBackendManager->getManifestsForBackend(
+                         EffectBackendType::BuiltIn)) {
+                renders.append({pManifest->id(), EffectChainPresetPointer::create(pManifest)});
+            }
+            continue;
+        }
+        const auto pManifest = pBackendManager->getManifest(
+                effectId, EffectBackendType::BuiltIn);
+        if (!pManifest) {
+            out << "Unknown effect " << effectId << Qt::endl;
+            return 1;
+        }
+        renders.append({effectId, EffectChainPresetPointer::create(pManifest)});
+    }
+    const auto pChainPresetManager = renderer.effectsManager().getChainPresetManager();
+    for (const auto& presetName : std::as_const(presetNames)) {
+        if (presetName == kAll) {
+            for (const auto& pPreset : pChainPresetManager->getPresetsSorted()) {
+                renders.append({pPreset->name(), pPreset});
+            }
+            continue;
+        }
+        const auto pPreset = pChainPresetManager->getPreset(presetName);
+        if (!pPreset) {
+            out << "Unknown preset " << presetName << Qt::endl;
+            return 1;
+        }
+        renders.append({presetName, pPreset});
+    }
+
+    out << QStringLiteral("%1 frames at %2 Hz, %3 frames per buffer")
+                    .arg(input.frames())
+                    .arg(sampleRate.value())
+                    .arg(framesPerBuffer)
+        << Qt::endl;
+    const double bufferMicros = 1e6 * framesPerBuffer / sampleRate.value();
+    int failures = 0;
+    for (const auto& [name, pPreset] : std::as_const(renders)) {
+        Audio output;
+        const RenderStats stats = renderer.render(pPreset, input, &output);
+        const double avgMicros = stats.buffers > 0 ? stats.totalMicros / stats.buffers : 0;
+        out << QStringLiteral("%1 avg %2 us min %3 us max %4 us per buffer (%5% of real time)")
+                        .arg(name, -40)
+                        .arg(avgMicros, 8, 'f', 1)
+                        .arg(stats.buffers > 0 ? stats.minMicros : 0, 8, 'f', 1)
+                        .arg(stats.maxMicros, 8, 'f', 1)
+                        .arg(100 * avgMicros / bufferMicros, 5, 'f', 2);
+
+        if (parser.isSet(outputOption)) {
+            if (!writeAudio(fileNameForRender(parser.value(outputOption), name), output)) {
+                out << " FAILED: not written";
+                failures++;
+            }
+        }
+        if (parser.isSet(referenceOption)) {
+            Audio reference;
+            if (!readAudio(fileNameForRender(parser.value(referenceOption), name),
+                        &reference)) {
+                out << " no reference";
+                failures++;
+            } else {
+                const CSAMPLE maxDifference = compareAudio(output, reference);
+                if (maxDifference == CSAMPLE_ZERO) {
+                    out << " bit-exact";
+                } else if (std::isinf(maxDifference)) {
+                    out << " FAILED: length differs";
+                    failures++;
+                } else {
+                    out << " FAILED: max difference " << maxDifference;
+                    failures++;
+                }
+            }
+        }
+        out << Qt::endl;
+    }
+    return failures > 0 ? 1 : 0;
+}
+
+} // namespace mixxxtest
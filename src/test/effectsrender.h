@@ -0,0 +1,19 @@
+#pragma once
+
+namespace mixxxtest {
+
+/// Pushes an audio file through built-in effects and effect chain presets
+/// offline at a fixed sample rate and buffer size:
+///
+///   mixxx-test --render-effects --input <file> [options]
+///
+/// The effects are loaded into a StandardEffectChain and processed by the
+/// EngineEffectsManager like in the engine, without any audio device. The
+/// time spent per buffer is reported for each effect or preset, which gives
+/// reproducible CPU measurements. The output is written as 32 bit float WAV
+/// and can be compared bit by bit with the output of a previous build.
+///
+/// Must be called with a QCoreApplication instance. Returns the exit code.
+int renderEffects(int argc, char** argv);
+
+} // namespace mixxxtest
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <QMap>
+#include <QSet>
+
+#include "effects/backends/builtin/echoeffect.h"
+#include "effects/backends/builtin/reverbeffect.h"
+#include "effects/backends/builtin/tremoloeffect.h"
+#include "effects/backends/effectmanifest.h"
+#include "engine/channelhandle.h"
+#include "engine/effects/engineeffectparameter.h"
+#include "test/mixxxtest.h"
+#include "util/sample.h"
+#include "util/samplebuffer.h"
+
+namespace {
+
+const QString kGroup = QStringLiteral("[Channel1]");
+
+constexpr auto kSampleRate = mixxx::audio::SampleRate(48000);
+constexpr SINT kFramesPerBuffer = 1024;
+// -100 dBFS, like EffectProcessor::kTailSilenceThreshold
+constexpr CSAMPLE kSilenceThreshold = 0.00001f;
+
+class EffectTailTest : public MixxxTest {
+  protected:
+    EffectTailTest()
+            : m_engineParameters(kSampleRate, kFramesPerBuffer),
+              m_channel(ChannelHandleFactory().getOrCreateHandle(kGroup)),
+              m_input(m_engineParameters.samplesPerBuffer()),
+              m_output(m_engineParameters.samplesPerBuffer()) {
+    }
+
+    template<class EffectType>
+    void initialize(EffectType* pEffect, const QMap<QString, double>& values) {
+        m_parameters.clear();
+        for (const auto& pManifestParameter : EffectType::getManifest()->parameters()) {
+            auto pParameter = EngineEffectParameterPointer::create(pManifestParameter);
+            if (values.contains(pManifestParameter->id())) {
+                pParameter->setValue(values.value(pManifestParameter->id()));
+            }
+            m_parameters.insert(pManifestParameter->id(), pParameter);
+        }
+        pEffect->loadEngineEffectParameters(m_parameters);
+        const QSet<ChannelHandleAndGroup> channels = {
+                ChannelHandleAndGroup(m_channel, kGroup)};
+        pEffect->initialize(channels, channels, m_engineParameters);
+    }
+
+    CSAMPLE process(EffectProcessor* pEffect, EffectEnableState enableState) {
+        pEffect->process(m_channel,
+                m_channel,
+                m_input.data(),
+                m_output.data(),
+                m_engineParameters,
+                enableState,
+                GroupFeatureState());
+        return SampleUtil::maxAbsAmplitude(m_output.data(), m_output.size());
+    }
+
+    // Feeds a full scale impulse and returns the peak of the output after
+    // the reported tail of silence.
+    CSAMPLE processImpulseAndTail(EffectProcessor* pEffect) {
+        m_input.clear();
+        process(pEffect, EffectEnableState::Enabling);
+        m_input[m_input.size() - 2] = 1;
+        m_input[m_input.size() - 1] = 1;
+        process(pEffect, EffectEnableState::Enabled);
+        m_input.clear();
+
+        const SINT tailFrames = pEffect->getTailFrames(
+                m_channel, m_channel, m_engineParameters);
+        EXPECT_NE(EffectProcessor::kInfiniteTailFrames, tailFrames);
+        for (SINT frames = 0; frames < tailFrames; frames += kFramesPerBuffer) {
+            process(pEffect, EffectEnableState::Enabled);
+        }
+        return process(pEffect, EffectEnableState::Enabled);
+    }
+
+    const mixxx::EngineParameters m_engineParameters;
+    const ChannelHandle m_channel;
+    QMap<QString, EngineEffectParameterPointer> m_parameters;
+    mixxx::SampleBuffer m_input;
+    mixxx::SampleBuffer m_output;
+};
+
+TEST_F(EffectTailTest, Echo) {
+    EchoEffect echo;
+    initialize(&echo, {{QStringLiteral("send_amount"), 1.0}});
+    EXPECT_GT(kSilenceThreshold, processImpulseAndTail(&echo));
+}
+
+TEST_F(EffectTailTest, EchoInfiniteFeedback) {
+    EchoEffect echo;
+    initialize(&echo, {{QStringLiteral("feedback_amount"), 1.0}});
+    process(&echo, EffectEnableState::Enabling);
+    EXPECT_EQ(EffectProcessor::kInfiniteTailFrames,
+            echo.getTailFrames(m_channel, m_channel, m_engineParameters));
+}
+
+TEST_F(EffectTailTest, Reverb) {
+    for (double decay : {0.0, 0.1, 0.5, 1.0}) {
+        ReverbEffect reverb;
+        initialize(&reverb,
+                {{QStringLiteral("decay"), decay},
+                        {QStringLiteral("send_amount"), 1.0}});
+        EXPECT_GT(kSilenceThreshold, processImpulseAndTail(&reverb)) << "decay " << decay;
+    }
+}
+
+TEST_F(EffectTailTest, Tremolo) {
+    TremoloEffect tremolo;
+    initialize(&tremolo, {});
+    EXPECT_EQ(0, processImpulseAndTail(&tremolo));
+}
+
+} // namespace
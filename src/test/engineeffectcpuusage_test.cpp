@@ -0,0 +1,95 @@
+#include "engine/effects/engineeffectcpuusage.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "control/controlobject.h"
+#include "test/mixxxtest.h"
+
+namespace {
+
+const QString kGroup = QStringLiteral("[EffectRack1_EffectUnit1_Effect1]");
+
+constexpr auto kSampleRate = mixxx::audio::SampleRate(48000);
+// 10 ms per callback
+constexpr std::size_t kNumSamples = 960;
+
+class EngineEffectCpuUsageTest : public MixxxTest {
+  protected:
+    EngineEffectCpuUsageTest()
+            : m_pCpuUsageMin(std::make_unique<ControlObject>(
+                      ConfigKey(kGroup, QStringLiteral("cpu_usage_min")))),
+              m_pCpuUsageAvg(std::make_unique<ControlObject>(
+                      ConfigKey(kGroup, QStringLiteral("cpu_usage_avg")))),
+              m_pCpuUsageMax(std::make_unique<ControlObject>(
+                      ConfigKey(kGroup, QStringLiteral("cpu_usage_max")))) {
+        m_pCpuUsageMin->setReadOnly();
+        m_pCpuUsageAvg->setReadOnly();
+        m_pCpuUsageMax->setReadOnly();
+    }
+
+    void processCallback(EngineEffectCpuUsage* pCpuUsage, int millis) {
+        pCpuUsage->onCallbackStart();
+        if (millis > 0) {
+            pCpuUsage->addProcessTime(
+                    mixxx::Duration::fromMillis(millis), kNumSamples, kSampleRate);
+        }
+    }
+
+    std::unique_ptr<ControlObject> m_pCpuUsageMin;
+    std::unique_ptr<ControlObject> m_pCpuUsageAvg;
+    std::unique_ptr<ControlObject> m_pCpuUsageMax;
+};
+
+TEST_F(EngineEffectCpuUsageTest, PublishMinAvgMax) {
+    EngineEffectCpuUsage cpuUsage(kGroup, QStringLiteral("EngineEffectCpuUsageTest"));
+
+    // Processing two channels in the first callback
+    cpuUsage.onCallbackStart();
+    cpuUsage.addProcessTime(mixxx::Duration::fromMillis(1), kNumSamples, kSampleRate);
+    cpuUsage.addProcessTime(mixxx::Duration::fromMillis(1), kNumSamples, kSampleRate);
+    processCallback(&cpuUsage, 1);
+    processCallback(&cpuUsage, 5);
+    // Not processed at all
+    processCallback(&cpuUsage, 0);
+    // 30 ms are not enough for an update
+    EXPECT_EQ(0.0, m_pCpuUsageMax->get());
+
+    cpuUsage.onCallbackStart();
+    EXPECT_NEAR(0.0, m_pCpuUsageMin->get(), 1e-9);
+    EXPECT_NEAR((0.2 + 0.1 + 0.5 + 0.0) / 4, m_pCpuUsageAvg->get(), 1e-9);
+    EXPECT_NEAR(0.5, m_pCpuUsageMax->get(), 1e-9);
+
+    // The next window starts from scratch with the current callback
+    cpuUsage.addProcessTime(mixxx::Duration::fromMillis(3), kNumSamples, kSampleRate);
+    for (int i = 0; i < 3; ++i) {
+        processCallback(&cpuUsage, 3);
+    }
+    cpuUsage.onCallbackStart();
+    EXPECT_NEAR(0.3, m_pCpuUsageMin->get(), 1e-9);
+    EXPECT_NEAR(0.3, m_pCpuUsageAvg->get(), 1e-9);
+    EXPECT_NEAR(0.3, m_pCpuUsageMax->get(), 1e-9);
+}
+
+TEST_F(EngineEffectCpuUsageTest, Clear) {
+    EngineEffectCpuUsage cpuUsage(kGroup, QStringLiteral("EngineEffectCpuUsageTest"));
+    for (int i = 0; i < 4; ++i) {
+        processCallback(&cpuUsage, 2);
+    }
+    cpuUsage.onCallbackStart();
+    EXPECT_NEAR(0.2, m_pCpuUsageAvg->get(), 1e-9);
+
+    cpuUsage.clear();
+    EXPECT_EQ(0.0, m_pCpuUsageMin->get());
+    EXPECT_EQ(0.0, m_pCpuUsageAvg->get());
+    EXPECT_EQ(0.0, m_pCpuUsageMax->get());
+
+    // Nothing is published until processing again
+    for (int i = 0; i < 8; ++i) {
+        cpuUsage.onCallbackStart();
+    }
+    EXPECT_EQ(0.0, m_pCpuUsageAvg->get());
+}
+
+} // namespace
@@ -0,0 +1,48 @@
+#include "engine/effects/engineeffectparameter.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+
+class EngineEffectParameterTest : public testing::Test {
+  protected:
+    EngineEffectParameterTest()
+            : m_pManifestParameter(EffectManifestParameterPointer::create()) {
+        m_pManifestParameter->setRange(0.0, 0.5, 1.0);
+    }
+
+    EffectManifestParameterPointer m_pManifestParameter;
+};
+
+TEST_F(EngineEffectParameterTest, MergePendingValues) {
+    EngineEffectParameter parameter(m_pManifestParameter);
+    EXPECT_EQ(0.5, parameter.value());
+
+    // Only the first value needs an update request
+    EXPECT_TRUE(parameter.setPendingValue(0.1));
+    EXPECT_FALSE(parameter.setPendingValue(0.2));
+    EXPECT_FALSE(parameter.setPendingValue(0.3));
+    EXPECT_EQ(0.5, parameter.value());
+
+    parameter.applyPendingValue();
+    EXPECT_EQ(0.3, parameter.value());
+
+    // The next value needs a new request
+    EXPECT_TRUE(parameter.setPendingValue(0.4));
+    parameter.applyPendingValue();
+    EXPECT_EQ(0.4, parameter.value());
+}
+
+TEST_F(EngineEffectParameterTest, CancelPendingValue) {
+    EngineEffectParameter parameter(m_pManifestParameter);
+    EXPECT_TRUE(parameter.setPendingValue(0.1));
+    // The request could not be sent
+    parameter.cancelPendingValue();
+    EXPECT_EQ(0.5, parameter.value());
+
+    EXPECT_TRUE(parameter.setPendingValue(0.2));
+    parameter.applyPendingValue();
+    EXPECT_EQ(0.2, parameter.value());
+}
+
+} // namespace
@@ -0,0 +1,136 @@
+#include "engine/effects/engineeffectsmanager.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "control/controlobject.h"
+#include "effects/effectchain.h"
+#include "effects/effectsmanager.h"
+#include "effects/presets/effectchainpreset.h"
+#include "engine/effects/groupfeaturestate.h"
+#include "test/mixxxtest.h"
+
+namespace {
+
+constexpr int kChannelCount = 4;
+constexpr SINT kSamplesPerBuffer = 512;
+constexpr int kBufferCount = 32;
+const mixxx::audio::SampleRate kSampleRate = mixxx::audio::SampleRate(44100);
+const QString kOutputGroup = QStringLiteral("[Master]");
+
+QString channelGroup(int channel) {
+    return QStringLiteral("[Channel%1]").arg(channel + 1);
+}
+
+class EngineEffectsManagerTest : public MixxxTest {
+  protected:
+    /// Returns the output of each channel after processing the postfader
+    /// effects of all channels in each callback
+    std::vector<std::vector<CSAMPLE>> processChannels(bool parallel) {
+        config()->setValue(ConfigKey("[Effects]", "ParallelChains"), parallel);
+        auto pChannelHandleFactory = std::make_shared<ChannelHandleFactory>();
+        auto pEffectsManager = std::make_unique<EffectsManager>(
+                config(), pChannelHandleFactory);
+        std::vector<ChannelHandleAndGroup> channels;
+        for (int channel = 0; channel < kChannelCount; ++channel) {
+            const QString group = channelGroup(channel);
+            channels.emplace_back(pChannelHandleFactory->getOrCreateHandle(group), group);
+            pEffectsManager->registerInputChannel(channels.back());
+        }
+        const ChannelHandle outputHandle =
+                pChannelHandleFactory->getOrCreateHandle(kOutputGroup);
+        pEffectsManager->registerOutputChannel(
+                ChannelHandleAndGroup(outputHandle, kOutputGroup));
+        pEffectsManager->setup();
+
+        // Unit 1 is shared by channels 1 to 3 and unit 3 by channels 2
+        // and 4. Units 2 and 4 are only enabled for one channel each.
+        const QString effectIds[kNumStandardEffectUnits] = {
+                QStringLiteral("org.mixxx.effects.echo"),
+                QStringLiteral("org.mixxx.effects.flanger"),
+                QStringLiteral("org.mixxx.effects.reverb"),
+                QStringLiteral("org.mixxx.effects.phaser"),
+        };
+        const std::vector<int> unitChannels[kNumStandardEffectUnits] = {
+                {0, 1, 2},
+                {3},
+                {1, 3},
+                {0},
+        };
+        std::vector<EffectChainPointer> chains;
+        for (int unit = 0; unit < kNumStandardEffectUnits; ++unit) {
+            EffectChainPointer pChain = pEffectsManager->getStandardEffectChain(unit);
+            const auto pManifest = pEffectsManager->getBackendManager()->getManifest(
+                    effectIds[unit], EffectBackendType::BuiltIn);
+            EXPECT_FALSE(pManifest.isNull());
+            pChain->loadChainPreset(EffectChainPresetPointer::create(pManifest));
+            ControlObject::set(ConfigKey(pChain->group(), QStringLiteral("mix")), 1);
+            for (int channel : unitChannels[unit]) {
+                ControlObject::set(enableKey(pChain, channel), 1);
+            }
+            chains.push_back(pChain);
+        }
+
+        EngineEffectsManager* pEngineEffectsManager =
+                pEffectsManager->getEngineEffectsManager();
+        const GroupFeatureState groupFeatures;
+        std::vector<std::vector<CSAMPLE>> buffers(
+                kChannelCount, std::vector<CSAMPLE>(kSamplesPerBuffer));
+        std::vector<std::vector<CSAMPLE>> outputs(kChannelCount);
+        for (int buffer = 0; buffer < kBufferCount; ++buffer) {
+            if (buffer == kBufferCount / 2) {
+                // Fade out the shared units while they are enabled for
+                // another channel
+                ControlObject::set(enableKey(chains[0], 1), 0);
+                ControlObject::set(enableKey(chains[2], 3), 0);
+            }
+            pEngineEffectsManager->onCallbackStart();
+
+            std::vector<EngineEffectsManager::PostFaderChannel> postFaderChannels;
+            for (int channel = 0; channel < kChannelCount; ++channel) {
+                // A different tone on each channel
+                for (SINT i = 0; i < kSamplesPerBuffer; ++i) {
+                    const SINT frame = (buffer * kSamplesPerBuffer + i) / 2;
+                    buffers[channel][i] = 0.5f *
+                            std::sin(0.01f * (channel + 1) * static_cast<float>(frame));
+                }
+                postFaderChannels.push_back({channels[channel].handle(),
+                        buffers[channel].data(),
+                        &groupFeatures,
+                        CSAMPLE_GAIN_ONE,
+                        CSAMPLE_GAIN_ONE,
+                        false});
+            }
+            pEngineEffectsManager->processPostFaderInPlace(
+                    postFaderChannels, outputHandle, kSamplesPerBuffer, kSampleRate);
+            for (int channel = 0; channel < kChannelCount; ++channel) {
+                outputs[channel].insert(outputs[channel].end(),
+                        buffers[channel].begin(),
+                        buffers[channel].end());
+            }
+        }
+        return outputs;
+    }
+
+    static ConfigKey enableKey(const EffectChainPointer& pChain, int channel) {
+        return ConfigKey(pChain->group(),
+                QStringLiteral("group_%1_enable").arg(channelGroup(channel)));
+    }
+};
+
+TEST_F(EngineEffectsManagerTest, ParallelProcessingOfSharedChains) {
+    const auto serialOutputs = processChannels(false);
+    const auto parallelOutputs = processChannels(true);
+    ASSERT_EQ(serialOutputs.size(), parallelOutputs.size());
+    for (int channel = 0; channel < kChannelCount; ++channel) {
+        // Bit-exact, because each chain processes the channels in the same
+        // order
+        EXPECT_TRUE(serialOutputs[channel] == parallelOutputs[channel])
+                << "channel " << channel;
+    }
+}
+
+} // namespace
@@ -0,0 +1,40 @@
+#include "engine/effects/engineeffectsworkerpool.h"
+
+#include <gtest/gtest.h>
+
+#include <QThread>
+#include <array>
+#include <atomic>
+
+namespace {
+
+constexpr int kWorkerCount = 3;
+constexpr int kMaxCount = 64;
+
+TEST(EngineEffectsWorkerPoolTest, ProcessEachIndexOnce) {
+    EngineEffectsWorkerPool pool(kWorkerCount);
+    for (int count = 0; count <= kMaxCount; ++count) {
+        std::array<std::atomic<int>, kMaxCount> calls{};
+        auto process = [&calls](int i) {
+            calls[i].fetch_add(1);
+        };
+        pool.processInParallel(count, process);
+        // All calls have returned
+        for (int i = 0; i < kMaxCount; ++i) {
+            EXPECT_EQ(i < count ? 1 : 0, calls[i].load()) << "count " << count;
+        }
+    }
+}
+
+TEST(EngineEffectsWorkerPoolTest, SingleIndexInEngineThread) {
+    EngineEffectsWorkerPool pool(kWorkerCount);
+    const QThread* pEngineThread = QThread::currentThread();
+    const QThread* pProcessThread = nullptr;
+    auto process = [&pProcessThread](int) {
+        pProcessThread = QThread::currentThread();
+    };
+    pool.processInParallel(1, process);
+    EXPECT_EQ(pEngineThread, pProcessThread);
+}
+
+} // namespace
@@ -0,0 +1,285 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "engine/filters/enginefiltercascade.h"
+#include "engine/filters/enginefilterdesign.h"
+#include "engine/filters/enginefilteriir.h"
+
+namespace {
+
+using mixxx::filterdesign::Pass;
+
+constexpr double kSampleRate = 44100;
+constexpr std::size_t kBufferSize = 1024;
+
+// Exposes the direct form II reference implementation
+template<unsigned int SIZE, enum IIRPass PASS>
+class EngineFilterIIRReference : public EngineFilterIIR<SIZE, PASS> {
+  public:
+    using EngineFilterIIR<SIZE, PASS>::processSample;
+
+    const double* coefs() const {
+        return this->m_coef;
+    }
+};
+
+std::vector<CSAMPLE> noise(std::size_t size) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<CSAMPLE> distribution(-1.0f, 1.0f);
+    std::vector<CSAMPLE> samples(size);
+    for (auto& sample : samples) {
+        sample = distribution(generator);
+    }
+    return samples;
+}
+
+class EngineFilterCascadeTest : public testing::Test {
+  protected:
+    // Compares EngineFilterIIR::process() with processSample() over a few
+    // buffers, including the cross fade from silence after the start and
+    // from the old filter after changing the coefficients.
+    template<unsigned int SIZE, enum IIRPass PASS, typename DesignFunction>
+    static void expectSameAsProcessSample(DesignFunction designFunction) {
+        EngineFilterIIRReference<SIZE, PASS> filter;
+        double coef[SIZE + 1] = {};
+        double oldCoef[SIZE + 1];
+        double buf[mixxx::kEngineChannelOutputCount][SIZE] = {};
+        double oldBuf[mixxx::kEngineChannelOutputCount][SIZE];
+
+        const std::vector<CSAMPLE> input = noise(kBufferSize);
+        for (int i = 0; i < 4; ++i) {
+            const bool doStart = i == 0;
+            std::memcpy(oldCoef, coef, sizeof(coef));
+            std::memcpy(oldBuf, buf, sizeof(buf));
+            std::memset(buf, 0, sizeof(buf));
+            // The corner frequency is changed for each buffer
+            filter.designCoefs([&](double* pCoef) {
+                return designFunction(pCoef, 1.0 + i);
+            });
+            std::memcpy(coef, filter.coefs(), sizeof(coef));
+
+            // In place
+            std::vector<CSAMPLE> output = input;
+            filter.process(output.data(), output.data(), kBufferSize);
+
+            double crossMix = 0.0;
+            for (std::size_t j = 0; j < kBufferSize; ++j) {
+                const std::size_t channel = j % mixxx::kEngineChannelOutputCount;
+                const double oldSample = doStart
+                        ? 0.0
+                        : static_cast<CSAMPLE>(filter.processSample(
+                                  oldCoef, oldBuf[channel], input[j]));
+                const double newSample = static_cast<CSAMPLE>(
+                        filter.processSample(coef, buf[channel], input[j]));
+                double expected = oldSample;
+                if (j >= kBufferSize / 2) {
+                    expected = newSample * crossMix + oldSample * (1.0 - crossMix);
+                    if (channel == mixxx::kEngineChannelOutputCount - 1) {
+                        crossMix += 4.0 / kBufferSize;
+                    }
+                }
+                ASSERT_NEAR(expected, output[j], 1e-5) << "buffer " << i << " sample " << j;
+            }
+        }
+
+        // Without ramping
+        filter.assumeSettled();
+        std::vector<CSAMPLE> output(kBufferSize);
+        filter.process(input.data(), output.data(), kBufferSize);
+        for (std::size_t j = 0; j < kBufferSize; ++j) {
+            const std::size_t channel = j % mixxx::kEngineChannelOutputCount;
+            ASSERT_NEAR(filter.processSample(coef, buf[channel], input[j]), output[j], 1e-5)
+                    << "sample " << j;
+        }
+    }
+};
+
+TEST_F(EngineFilterCascadeTest, SameAsProcessSample) {
+    // factor scales the corner frequencies
+    expectSameAsProcessSample<2, IIR_LP>([](double* pCoef, double factor) {
+        return mixxx::filterdesign::biquadLowPass(pCoef, factor * 200 / kSampleRate, 0.7);
+    });
+    expectSameAsProcessSample<2, IIR_BP>([](double* pCoef, double factor) {
+        return mixxx::filterdesign::biquadBandPass(pCoef, factor * 200 / kSampleRate, 1.75);
+    });
+    expectSameAsProcessSample<2, IIR_HP>([](double* pCoef, double factor) {
+        return mixxx::filterdesign::biquadHighPass(pCoef, factor * 200 / kSampleRate, 0.7);
+    });
+    expectSameAsProcessSample<5, IIR_BP>([](double* pCoef, double factor) {
+        return mixxx::filterdesign::biquadPeaking(pCoef, factor * 200 / kSampleRate, 1.75, 6);
+    });
+    expectSameAsProcessSample<4, IIR_LP>([](double* pCoef, double factor) {
+        return mixxx::filterdesign::bessel(pCoef, 4, Pass::Low, factor * 100 / kSampleRate);
+    });
+    expectSameAsProcessSample<8, IIR_BP>([](double* pCoef, double factor) {
+        return mixxx::filterdesign::bessel(pCoef,
+                4,
+                Pass::Band,
+                factor * 600 / kSampleRate,
+                factor * 4000 / kSampleRate);
+    });
+    expectSameAsProcessSample<4, IIR_HP>([](double* pCoef, double factor) {
+        return mixxx::filterdesign::bessel(pCoef, 4, Pass::High, factor * 1000 / kSampleRate);
+    });
+    expectSameAsProcessSample<8, IIR_LP>([](double* pCoef, double factor) {
+        return mixxx::filterdesign::butterworth(pCoef, 8, Pass::Low, factor * 100 / kSampleRate);
+    });
+    expectSameAsProcessSample<16, IIR_BP>([](double* pCoef, double factor) {
+        return mixxx::filterdesign::butterworth(pCoef,
+                8,
+                Pass::Band,
+                factor * 600 / kSampleRate,
+                factor * 4000 / kSampleRate);
+    });
+    expectSameAsProcessSample<8, IIR_HP>([](double* pCoef, double factor) {
+        return mixxx::filterdesign::butterworth(pCoef, 8, Pass::High, factor * 1000 / kSampleRate);
+    });
+    expectSameAsProcessSample<2, IIR_LP2>([](double* pCoef, double factor) {
+        const double gain = mixxx::filterdesign::butterworth(
+                pCoef, 1, Pass::Low, factor * 200 / kSampleRate);
+        return gain *
+                mixxx::filterdesign::butterworth(
+                        pCoef + 1, 1, Pass::Low, factor * 200 / kSampleRate);
+    });
+    expectSameAsProcessSample<2, IIR_HP2>([](double* pCoef, double factor) {
+        const double gain = mixxx::filterdesign::butterworth(
+                pCoef, 1, Pass::High, factor * 200 / kSampleRate);
+        return gain *
+                mixxx::filterdesign::butterworth(
+                        pCoef + 1, 1, Pass::High, factor * 200 / kSampleRate);
+    });
+    expectSameAsProcessSample<4, IIR_LPMO>([](double* pCoef, double factor) {
+        for (int i = 0; i < 4; ++i) {
+            pCoef[i] = -0.9 + 0.1 * i * factor;
+        }
+        return 0.01;
+    });
+    expectSameAsProcessSample<4, IIR_HPMO>([](double* pCoef, double factor) {
+        for (int i = 0; i < 4; ++i) {
+            pCoef[i] = -0.9 + 0.1 * i * factor;
+        }
+        return 0.5;
+    });
+}
+
+TEST_F(EngineFilterCascadeTest, FloatStemChannels) {
+    constexpr unsigned int kStemChannelCount = mixxx::audio::ChannelCount::stem();
+    constexpr unsigned int kStereoCount = kStemChannelCount / mixxx::kEngineChannelOutputCount;
+    constexpr SINT kFrames = kBufferSize / mixxx::kEngineChannelOutputCount;
+
+    double coef[5];
+    coef[0] = mixxx::filterdesign::bessel(&coef[1], 4, Pass::Low, 600 / kSampleRate);
+    EngineFilterSection sections[EngineFilterIIR<4, IIR_LP>::kSectionCount];
+    EngineFilterIIR<4, IIR_LP>::coefsToSections(coef, sections);
+
+    EngineFilterCascade<float, 2, kStemChannelCount> stemFilter;
+    stemFilter.setSections(sections);
+    EngineFilterCascade<double, 2, mixxx::kEngineChannelOutputCount> stereoFilters[kStereoCount];
+    for (auto& stereoFilter : stereoFilters) {
+        stereoFilter.setSections(sections);
+    }
+
+    // Different signals in every stereo channel
+    const std::vector<CSAMPLE> input = noise(kFrames * kStemChannelCount);
+    std::vector<CSAMPLE> output(input.size());
+    stemFilter.process(input.data(), output.data(), kFrames);
+
+    for (unsigned int stereo = 0; stereo < kStereoCount; ++stereo) {
+        std::vector<CSAMPLE> stereoInput(kBufferSize);
+        for (SINT frame = 0; frame < kFrames; ++frame) {
+            for (unsigned int c = 0; c < mixxx::kEngineChannelOutputCount; ++c) {
+                stereoInput[frame * mixxx::kEngineChannelOutputCount + c] =
+                        input[frame * kStemChannelCount +
+                                stereo * mixxx::kEngineChannelOutputCount + c];
+            }
+        }
+        std::vector<CSAMPLE> stereoOutput(kBufferSize);
+        stereoFilters[stereo].process(stereoInput.data(), stereoOutput.data(), kFrames);
+        for (SINT frame = 0; frame < kFrames; ++frame) {
+            for (unsigned int c = 0; c < mixxx::kEngineChannelOutputCount; ++c) {
+                ASSERT_NEAR(stereoOutput[frame * mixxx::kEngineChannelOutputCount + c],
+                        output[frame * kStemChannelCount +
+                                stereo * mixxx::kEngineChannelOutputCount + c],
+                        1e-4)
+                        << "stereo " << stereo << " frame " << frame;
+            }
+        }
+    }
+
+    // Silence after clear()
+    stemFilter.clear();
+    std::vector<CSAMPLE> silence(input.size(), 0.0f);
+    stemFilter.process(silence.data(), output.data(), kFrames);
+    for (const auto sample : output) {
+        ASSERT_EQ(0.0f, sample);
+    }
+}
+
+static void BM_EngineFilterIIRProcessSample(benchmark::State& state) {
+    const std::size_t bufferSize = static_cast<std::size_t>(state.range(0));
+    EngineFilterIIRReference<16, IIR_BP> filter;
+    filter.designCoefs([](double* pCoef) {
+        return mixxx::filterdesign::bessel(
+                pCoef, 8, Pass::Band, 600 / kSampleRate, 4000 / kSampleRate);
+    });
+    double coef[17];
+    std::memcpy(coef, filter.coefs(), sizeof(coef));
+    double buf1[16] = {};
+    double buf2[16] = {};
+    const std::vector<CSAMPLE> input = noise(bufferSize);
+    std::vector<CSAMPLE> output(bufferSize);
+
+    // The loop of EngineFilterIIR::process() before using the cascade
+    while (state.KeepRunning()) {
+        for (std::size_t i = 0; i < bufferSize; i += 2) {
+            output[i] = static_cast<CSAMPLE>(filter.processSample(coef, buf1, input[i]));
+            output[i + 1] = static_cast<CSAMPLE>(filter.processSample(coef, buf2, input[i + 1]));
+        }
+        benchmark::DoNotOptimize(output.data());
+    }
+}
+BENCHMARK(BM_EngineFilterIIRProcessSample)->Range(64, 4096);
+
+static void BM_EngineFilterIIRProcess(benchmark::State& state) {
+    const std::size_t bufferSize = static_cast<std::size_t>(state.range(0));
+    EngineFilterIIR<16, IIR_BP> filter;
+    filter.designCoefs([](double* pCoef) {
+        return mixxx::filterdesign::bessel(
+                pCoef, 8, Pass::Band, 600 / kSampleRate, 4000 / kSampleRate);
+    });
+    filter.assumeSettled();
+    const std::vector<CSAMPLE> input = noise(bufferSize);
+    std::vector<CSAMPLE> output(bufferSize);
+
+    while (state.KeepRunning()) {
+        filter.process(input.data(), output.data(), bufferSize);
+        benchmark::DoNotOptimize(output.data());
+    }
+}
+BENCHMARK(BM_EngineFilterIIRProcess)->Range(64, 4096);
+
+static void BM_EngineFilterCascadeFloatStem(benchmark::State& state) {
+    constexpr unsigned int kStemChannelCount = mixxx::audio::ChannelCount::stem();
+    const SINT frames = static_cast<SINT>(state.range(0));
+    double coef[17];
+    coef[0] = mixxx::filterdesign::bessel(
+            &coef[1], 8, Pass::Band, 600 / kSampleRate, 4000 / kSampleRate);
+    EngineFilterSection sections[EngineFilterIIR<16, IIR_BP>::kSectionCount];
+    EngineFilterIIR<16, IIR_BP>::coefsToSections(coef, sections);
+    EngineFilterCascade<float, 8, kStemChannelCount> filter;
+    filter.setSections(sections);
+    const std::vector<CSAMPLE> input = noise(frames * kStemChannelCount);
+    std::vector<CSAMPLE> output(input.size());
+
+    while (state.KeepRunning()) {
+        filter.process(input.data(), output.data(), frames);
+        benchmark::DoNotOptimize(output.data());
+    }
+}
+BENCHMARK(BM_EngineFilterCascadeFloatStem)->Range(32, 2048);
+
+} // namespace
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+
+#include <QString>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "engine/filters/enginefilterdesign.h"
+#include "engine/filters/enginefilteriir.h"
+
+namespace {
+
+using mixxx::filterdesign::Pass;
+
+constexpr double kSampleRates[] = {8000, 44100, 48000, 96000, 192000};
+
+// Coefficients may differ in the last digits, because the
+// complex arithmetic is not carried out in the same order.
+constexpr double kMaxRelativeError = 1e-8;
+
+class EngineFilterDesignTest : public testing::Test {
+  protected:
+    // Compares the gain and the coefficients with those
+    // designed by fidlib from the given spec
+    static void expectSameAsFidlib(const char* spec,
+            double sampleRate,
+            double freq0,
+            double freq1,
+            double gain,
+            const std::vector<double>& coefs) {
+        char spec_d[FIDSPEC_LENGTH];
+        std::strncpy(spec_d, spec, sizeof(spec_d) - 1);
+        spec_d[sizeof(spec_d) - 1] = '\0';
+        std::vector<double> expectedCoefs(coefs.size());
+        const double expectedGain = fid_design_coef(expectedCoefs.data(),
+                static_cast<int>(expectedCoefs.size()),
+                spec_d,
+                sampleRate,
+                freq0,
+                freq1,
+                0);
+
+        SCOPED_TRACE(testing::Message() << spec << " at " << freq0 << "-"
+                                        << freq1 << " Hz, " << sampleRate << " Hz");
+        EXPECT_NEAR(expectedGain, gain, std::abs(expectedGain) * kMaxRelativeError);
+        for (std::size_t i = 0; i < coefs.size(); ++i) {
+            EXPECT_NEAR(expectedCoefs[i],
+                    coefs[i],
+                    std::max(std::abs(expectedCoefs[i]), 1.0) * kMaxRelativeError);
+        }
+    }
+
+    // Designs the filter for a range of frequencies and sample rates
+    template<typename DesignFunction>
+    static void expectSameAsFidlibForAllFrequencies(const char* spec,
+            int coefCount,
+            DesignFunction designFunction,
+            bool band = false) {
+        for (const double sampleRate : kSampleRates) {
+            // From 20 Hz up to close to the Nyquist frequency in steps
+            // of about a third octave
+            for (double freq0 = 20; freq0 < sampleRate * 0.45; freq0 *= 1.26) {
+                const double freq1 = band ? std::min(freq0 * 3, sampleRate * 0.49) : 0;
+                std::vector<double> coefs(coefCount);
+                const double gain = designFunction(
+                        coefs.data(), freq0 / sampleRate, freq1 / sampleRate);
+                expectSameAsFidlib(spec, sampleRate, freq0, freq1, gain, coefs);
+            }
+        }
+    }
+};
+
+TEST_F(EngineFilterDesignTest, Butterworth) {
+    for (const int order : {1, 2, 4, 8}) {
+        const auto lowPass = [order](double* pCoef, double freq0, double) {
+            return mixxx::filterdesign::butterworth(pCoef, order, Pass::Low, freq0);
+        };
+        expectSameAsFidlibForAllFrequencies(
+                qPrintable(QStringLiteral("LpBu%1").arg(order)),
+                order,
+                lowPass);
+
+        const auto highPass = [order](double* pCoef, double freq0, double) {
+            return mixxx::filterdesign::butterworth(pCoef, order, Pass::High, freq0);
+        };
+        expectSameAsFidlibForAllFrequencies(
+                qPrintable(QStringLiteral("HpBu%1").arg(order)),
+                order,
+                highPass);
+    }
+    for (const int order : {4, 8}) {
+        const auto bandPass = [order](double* pCoef, double freq0, double freq1) {
+            return mixxx::filterdesign::butterworth(pCoef, order, Pass::Band, freq0, freq1);
+        };
+        expectSameAsFidlibForAllFrequencies(
+                qPrintable(QStringLiteral("BpBu%1").arg(order)),
+                2 * order,
+                bandPass,
+                true);
+    }
+}
+
+TEST_F(EngineFilterDesignTest, Bessel) {
+    for (const int order : {4, 8}) {
+        const auto lowPass = [order](double* pCoef, double freq0, double) {
+            return mixxx::filterdesign::bessel(pCoef, order, Pass::Low, freq0);
+        };
+        expectSameAsFidlibForAllFrequencies(
+                qPrintable(QStringLiteral("LpBe%1").arg(order)),
+                order,
+                lowPass);
+
+        const auto highPass = [order](double* pCoef, double freq0, double) {
+            return mixxx::filterdesign::bessel(pCoef, order, Pass::High, freq0);
+        };
+        expectSameAsFidlibForAllFrequencies(
+                qPrintable(QStringLiteral("HpBe%1").arg(order)),
+                order,
+                highPass);
+
+        const auto bandPass = [order](double* pCoef, double freq0, double freq1) {
+            return mixxx::filterdesign::bessel(pCoef, order, Pass::Band, freq0, freq1);
+        };
+        expectSameAsFidlibForAllFrequencies(
+                qPrintable(QStringLiteral("BpBe%1").arg(order)),
+                2 * order,
+                bandPass,
+                true);
+    }
+}
+
+TEST_F(EngineFilterDesignTest, Biquad) {
+    for (const double Q : {0.5, 0.707, 1.75, 4.0}) {
+        const auto lowPass = [Q](double* pCoef, double freq0, double) {
+            return mixxx::filterdesign::biquadLowPass(pCoef, freq0, Q);
+        };
+        expectSameAsFidlibForAllFrequencies(
+                qPrintable(QStringLiteral("LpBq/%1").arg(Q)),
+                2,
+                lowPass);
+
+        const auto bandPass = [Q](double* pCoef, double freq0, double) {
+            return mixxx::filterdesign::biquadBandPass(pCoef, freq0, Q);
+        };
+        expectSameAsFidlibForAllFrequencies(
+                qPrintable(QStringLiteral("BpBq/%1").arg(Q)),
+                2,
+                bandPass);
+
+        const auto highPass = [Q](double* pCoef, double freq0, double) {
+            return mixxx::filterdesign::biquadHighPass(pCoef, freq0, Q);
+        };
+        expectSameAsFidlibForAllFrequencies(
+                qPrintable(QStringLiteral("HpBq/%1").arg(Q)),
+                2,
+                highPass);
+
+        for (const double dBgain : {-24.0, -3.0, 0.0, 6.0}) {
+            const auto peaking = [Q, dBgain](double* pCoef, double freq0, double) {
+                return mixxx::filterdesign::biquadPeaking(pCoef, freq0, Q, dBgain);
+            };
+            expectSameAsFidlibForAllFrequencies(
+                    qPrintable(QStringLiteral("PkBq/%1/%2").arg(Q).arg(dBgain)),
+                    5,
+                    peaking);
+
+            const auto lowShelving = [Q, dBgain](double* pCoef, double freq0, double) {
+                return mixxx::filterdesign::biquadLowShelving(pCoef, freq0, Q, dBgain);
+            };
+            expectSameAsFidlibForAllFrequencies(
+                    qPrintable(QStringLiteral("LsBq/%1/%2").arg(Q).arg(dBgain)),
+                    5,
+                    lowShelving);
+
+            const auto highShelving = [Q, dBgain](double* pCoef, double freq0, double) {
+                return mixxx::filterdesign::biquadHighShelving(pCoef, freq0, Q, dBgain);
+            };
+            expectSameAsFidlibForAllFrequencies(
+                    qPrintable(QStringLiteral("HsBq/%1/%2").arg(Q).arg(dBgain)),
+                    5,
+                    highShelving);
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,200 @@
+#include "analyzer/integratedloudnessmeter.h"
+
+#include <benchmark/benchmark.h>
+#include <ebur128.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "util/math.h"
+
+namespace {
+
+using mixxx::IntegratedLoudnessMeter;
+
+/// Feeds the same signal in the given chunks to both IntegratedLoudnessMeter
+/// and libebur128 as the reference implementation.
+class IntegratedLoudnessMeterTest : public testing::Test {
+  protected:
+    static double referenceLoudness(
+            const std::vector<CSAMPLE>& samples,
+            mixxx::audio::SampleRate sampleRate,
+            mixxx::audio::ChannelCount channelCount,
+            SINT chunkFrames) {
+        ebur128_state* pState = ebur128_init(channelCount, sampleRate, EBUR128_MODE_I);
+        EXPECT_NE(nullptr, pState);
+        const SINT frameCount = samples.size() / channelCount;
+        for (SINT frame = 0; frame < frameCount; frame += chunkFrames) {
+            EXPECT_EQ(EBUR128_SUCCESS,
+                    ebur128_add_frames_float(pState,
+                            samples.data() + frame * channelCount,
+                            math_min(chunkFrames, frameCount - frame)));
+        }
+        double loudness;
+        EXPECT_EQ(EBUR128_SUCCESS, ebur128_loudness_global(pState, &loudness));
+        ebur128_destroy(&pState);
+        return loudness;
+    }
+
+    static double loudness(
+            const std::vector<CSAMPLE>& samples,
+            mixxx::audio::SampleRate sampleRate,
+            mixxx::audio::ChannelCount channelCount,
+            SINT chunkFrames) {
+        IntegratedLoudnessMeter meter(sampleRate, channelCount);
+        const SINT frameCount = samples.size() / channelCount;
+        for (SINT frame = 0; frame < frameCount; frame += chunkFrames) {
+            meter.process(samples.data() + frame * channelCount,
+                    math_min(chunkFrames, frameCount - frame));
+        }
+        return meter.integratedLoudness();
+    }
+
+    static void expectReferenceLoudness(
+            const std::vector<CSAMPLE>& samples,
+            mixxx::audio::SampleRate sampleRate,
+            mixxx::audio::ChannelCount channelCount,
+            SINT chunkFrames) {
+        const double expected = referenceLoudness(
+                samples, sampleRate, channelCount, chunkFrames);
+        ASSERT_TRUE(std::isfinite(expected));
+        EXPECT_NEAR(expected,
+                loudness(samples, sampleRate, channelCount, chunkFrames),
+                1e-6);
+    }
+};
+
+constexpr auto kMono = mixxx::audio::ChannelCount::mono();
+constexpr auto kStereo = mixxx::audio::ChannelCount::stereo();
+
+// Sine waves with a different frequency and amplitude per channel
+std::vector<CSAMPLE> makeSine(
+        mixxx::audio::SampleRate sampleRate,
+        mixxx::audio::ChannelCount channelCount,
+        double seconds,
+        double amplitude) {
+    const SINT frameCount = static_cast<SINT>(seconds * sampleRate.toDouble());
+    std::vector<CSAMPLE> samples(frameCount * channelCount);
+    for (SINT i = 0; i < frameCount; ++i) {
+        for (int c = 0; c < channelCount; ++c) {
+            samples[i * channelCount + c] = static_cast<CSAMPLE>(
+                    amplitude / (c + 1) *
+                    std::sin(2 * M_PI * 1000.0 * (c + 1) * i / sampleRate.toDouble()));
+        }
+    }
+    return samples;
+}
+
+// Bursts of noise with varying levels separated by silence, some blocks
+// are below the absolute and the relative threshold.
+std::vector<CSAMPLE> makeNoiseBursts(
+        mixxx::audio::SampleRate sampleRate,
+        mixxx::audio::ChannelCount channelCount) {
+    const SINT burstFrames = sampleRate.value() * 3 / 2;
+    std::vector<CSAMPLE> samples;
+    unsigned int seed = 12345;
+    for (double amplitude : {0.5, 0.0, 0.02, 0.0001, 0.8, 0.0, 0.1}) {
+        for (SINT i = 0; i < burstFrames * channelCount; ++i) {
+            // Linear congruential generator for reproducible results
+            seed = seed * 1103515245 + 12345;
+            const double noise = static_cast<double>(seed >> 8) / (1 << 24) * 2.0 - 1.0;
+            samples.push_back(static_cast<CSAMPLE>(amplitude * noise));
+        }
+    }
+    return samples;
+}
+
+TEST_F(IntegratedLoudnessMeterTest, StereoSine) {
+    const auto sampleRate = mixxx::audio::SampleRate(44100);
+    expectReferenceLoudness(makeSine(sampleRate, kStereo, 5.0, 0.5), sampleRate, kStereo, 4096);
+}
+
+TEST_F(IntegratedLoudnessMeterTest, ReferenceLevel) {
+    // EBU Tech 3341, test case 1: -23 dBFS per channel at 1 kHz
+    const auto sampleRate = mixxx::audio::SampleRate(48000);
+    const SINT frameCount = 20 * sampleRate.value();
+    const double amplitude = std::pow(10.0, -23.0 / 20.0);
+    std::vector<CSAMPLE> samples(frameCount * kStereo);
+    for (SINT i = 0; i < frameCount; ++i) {
+        samples[i * 2] = samples[i * 2 + 1] = static_cast<CSAMPLE>(
+                amplitude * std::sin(2 * M_PI * 1000.0 * i / sampleRate.toDouble()));
+    }
+    EXPECT_NEAR(-23.0, loudness(samples, sampleRate, kStereo, 1024), 0.1);
+}
+
+TEST_F(IntegratedLoudnessMeterTest, Gating) {
+    for (auto sampleRate : {mixxx::audio::SampleRate(44100),
+                 mixxx::audio::SampleRate(48000),
+                 mixxx::audio::SampleRate(96000)}) {
+        SCOPED_TRACE(sampleRate.value());
+        expectReferenceLoudness(
+                makeNoiseBursts(sampleRate, kStereo), sampleRate, kStereo, 4096);
+    }
+}
+
+TEST_F(IntegratedLoudnessMeterTest, Mono) {
+    const auto sampleRate = mixxx::audio::SampleRate(48000);
+    expectReferenceLoudness(makeNoiseBursts(sampleRate, kMono), sampleRate, kMono, 4096);
+}
+
+TEST_F(IntegratedLoudnessMeterTest, ChunkSizes) {
+    // Chunks that are not aligned with the 100 ms segments
+    const auto sampleRate = mixxx::audio::SampleRate(44100);
+    const auto samples = makeNoiseBursts(sampleRate, kStereo);
+    for (SINT chunkFrames : {1, 441, 1000, 4410, 100000}) {
+        SCOPED_TRACE(chunkFrames);
+        expectReferenceLoudness(samples, sampleRate, kStereo, chunkFrames);
+    }
+}
+
+TEST_F(IntegratedLoudnessMeterTest, Silence) {
+    const auto sampleRate = mixxx::audio::SampleRate(44100);
+    IntegratedLoudnessMeter meter(sampleRate, kStereo);
+    EXPECT_EQ(-std::numeric_limits<double>::infinity(), meter.integratedLoudness());
+    const std::vector<CSAMPLE> samples(sampleRate.value() * kStereo, CSAMPLE_ZERO);
+    meter.process(samples.data(), sampleRate.value());
+    EXPECT_EQ(0u, meter.blockCount());
+    EXPECT_EQ(-std::numeric_limits<double>::infinity(), meter.integratedLoudness());
+}
+
+static void BM_IntegratedLoudnessMeter(benchmark::State& state) {
+    const auto sampleRate = mixxx::audio::SampleRate(44100);
+    const auto samples = makeNoiseBursts(sampleRate, kStereo);
+    const SINT chunkFrames = static_cast<SINT>(state.range(0));
+    for (auto _ : state) {
+        IntegratedLoudnessMeter meter(sampleRate, kStereo);
+        for (SINT frame = 0; frame < static_cast<SINT>(samples.size()) / kStereo;
+                frame += chunkFrames) {
+            meter.process(samples.data() + frame * kStereo,
+                    math_min(chunkFrames,
+                            static_cast<SINT>(samples.size()) / kStereo - frame));
+        }
+        benchmark::DoNotOptimize(meter.integratedLoudness());
+    }
+}
+BENCHMARK(BM_IntegratedLoudnessMeter)->Range(512, 8192);
+
+static void BM_Ebur128(benchmark::State& state) {
+    const auto sampleRate = mixxx::audio::SampleRate(44100);
+    const auto samples = makeNoiseBursts(sampleRate, kStereo);
+    const SINT chunkFrames = static_cast<SINT>(state.range(0));
+    for (auto _ : state) {
+        ebur128_state* pState = ebur128_init(kStereo, sampleRate, EBUR128_MODE_I);
+        for (SINT frame = 0; frame < static_cast<SINT>(samples.size()) / kStereo;
+                frame += chunkFrames) {
+            ebur128_add_frames_float(pState,
+                    samples.data() + frame * kStereo,
+                    math_min(chunkFrames,
+                            static_cast<SINT>(samples.size()) / kStereo - frame));
+        }
+        double loudness;
+        ebur128_loudness_global(pState, &loudness);
+        benchmark::DoNotOptimize(loudness);
+        ebur128_destroy(&pState);
+    }
+}
+BENCHMARK(BM_Ebur128)->Range(512, 8192);
+
+} // namespace
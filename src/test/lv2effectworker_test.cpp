@@ -0,0 +1,182 @@
+#include "effects/backends/lv2/lv2effectworker.h"
+
+#include <gtest/gtest.h>
+
+#include <QSemaphore>
+#include <QThread>
+#include <vector>
+
+namespace {
+
+constexpr SINT kFrames = 64;
+
+enum Port : uint32_t {
+    kInputL,
+    kInputR,
+    kOutputL,
+    kOutputR,
+    kGain,
+    kPortCount,
+};
+
+/// A plugin that multiplies its input by the gain control port
+struct GainPlugin {
+    float* ports[kPortCount] = {};
+    int activateCount = 0;
+    int deactivateCount = 0;
+    QThread* pThread = nullptr;
+    // If set, each run waits until it may proceed
+    bool blocking = false;
+    QSemaphore proceed;
+};
+
+void connectPort(LV2_Handle handle, uint32_t port, void* pData) {
+    static_cast<GainPlugin*>(handle)->ports[port] = static_cast<float*>(pData);
+}
+
+void activate(LV2_Handle handle) {
+    ++static_cast<GainPlugin*>(handle)->activateCount;
+}
+
+void deactivate(LV2_Handle handle) {
+    ++static_cast<GainPlugin*>(handle)->deactivateCount;
+}
+
+void run(LV2_Handle handle, uint32_t frames) {
+    auto* pPlugin = static_cast<GainPlugin*>(handle);
+    if (pPlugin->blocking) {
+        pPlugin->proceed.acquire();
+    }
+    pPlugin->pThread = QThread::currentThread();
+    for (uint32_t i = 0; i < frames; ++i) {
+        pPlugin->ports[kOutputL][i] = pPlugin->ports[kInputL][i] * *pPlugin->ports[kGain];
+        pPlugin->ports[kOutputR][i] = pPlugin->ports[kInputR][i] * *pPlugin->ports[kGain];
+    }
+}
+
+const LV2_Descriptor kGainDescriptor = {
+        "urn:mixxx:test:gain",
+        nullptr,
+        connectPort,
+        activate,
+        run,
+        deactivate,
+        nullptr,
+        nullptr,
+};
+
+class LV2EffectWorkerTest : public testing::Test {
+  protected:
+    LV2EffectWorkerTest()
+            : m_lilvInstance{&kGainDescriptor, &m_plugin, nullptr},
+              m_instance(&m_lilvInstance,
+                      {kInputL, kInputR, kOutputL, kOutputR},
+                      {kGain}) {
+    }
+
+    std::vector<CSAMPLE> process(CSAMPLE input,
+            float gain,
+            EffectEnableState enableState = EffectEnableState::Enabled) {
+        const std::vector<CSAMPLE> inputBuffer(kFrames * 2, input);
+        std::vector<CSAMPLE> outputBuffer(kFrames * 2, -1);
+        const float parameters[] = {gain};
+        m_instance.process(&m_worker,
+                inputBuffer.data(),
+                outputBuffer.data(),
+                kFrames,
+                parameters,
+                enableState);
+        return outputBuffer;
+    }
+
+    void awaitWorker() {
+        m_instance.waitForJobs();
+    }
+
+    static std::vector<CSAMPLE> constant(CSAMPLE value) {
+        return std::vector<CSAMPLE>(kFrames * 2, value);
+    }
+
+    GainPlugin m_plugin;
+    LilvInstance m_lilvInstance;
+    LV2EffectInstance m_instance;
+    // Stopped before the instance is destroyed
+    LV2EffectWorker m_worker;
+};
+
+TEST_F(LV2EffectWorkerTest, OutputOfPreviousCallback) {
+    EXPECT_EQ(constant(0), process(1, 0.5, EffectEnableState::Enabling));
+    awaitWorker();
+    EXPECT_EQ(constant(0.5), process(2, 0.5));
+    awaitWorker();
+    EXPECT_EQ(constant(2), process(3, 2));
+    awaitWorker();
+    EXPECT_EQ(constant(6), process(0, 1, EffectEnableState::Disabling));
+    awaitWorker();
+
+    EXPECT_EQ(1, m_plugin.activateCount);
+    EXPECT_EQ(1, m_plugin.deactivateCount);
+    EXPECT_EQ(&m_worker, m_plugin.pThread);
+}
+
+TEST_F(LV2EffectWorkerTest, DeadlineMissed) {
+    m_plugin.blocking = true;
+    EXPECT_EQ(constant(0), process(1, 1, EffectEnableState::Enabling));
+    // The worker is still running the first callback, so its output is
+    // missing. The input is submitted anyway.
+    EXPECT_EQ(constant(0), process(2, 1));
+    m_plugin.proceed.release(2);
+    awaitWorker();
+    // The late output of the first callback is discarded
+    m_plugin.blocking = false;
+    EXPECT_EQ(constant(2), process(3, 1));
+    awaitWorker();
+    EXPECT_EQ(constant(3), process(4, 1));
+    awaitWorker();
+}
+
+TEST_F(LV2EffectWorkerTest, InputDroppedWhileWorkerIsBehind) {
+    m_plugin.blocking = true;
+    EXPECT_EQ(constant(0), process(1, 1, EffectEnableState::Enabling));
+    EXPECT_EQ(constant(0), process(2, 1));
+    // Both jobs are busy
+    EXPECT_EQ(constant(0), process(3, 1));
+    m_plugin.proceed.release(2);
+    awaitWorker();
+    // Nothing has been submitted by the previous callback
+    m_plugin.blocking = false;
+    EXPECT_EQ(constant(0), process(4, 1));
+    awaitWorker();
+    EXPECT_EQ(constant(4), process(5, 1));
+    awaitWorker();
+}
+
+TEST_F(LV2EffectWorkerTest, DeactivateOnDestructionOnlyIfActive) {
+    GainPlugin plugin;
+    LilvInstance lilvInstance{&kGainDescriptor, &plugin, nullptr};
+    const CSAMPLE input[kFrames * 2] = {};
+    CSAMPLE output[kFrames * 2];
+    const float parameters[] = {1};
+    {
+        // Never run by the worker
+        LV2EffectInstance instance(&lilvInstance,
+                {kInputL, kInputR, kOutputL, kOutputR},
+                {kGain});
+    }
+    EXPECT_EQ(0, plugin.deactivateCount);
+    {
+        LV2EffectInstance instance(&lilvInstance,
+                {kInputL, kInputR, kOutputL, kOutputR},
+                {kGain});
+        instance.process(&m_worker,
+                input,
+                output,
+                kFrames,
+                parameters,
+                EffectEnableState::Enabling);
+    }
+    EXPECT_EQ(1, plugin.activateCount);
+    EXPECT_EQ(1, plugin.deactivateCount);
+}
+
+} // namespace
@@ -4,12 +4,22 @@
 
 #include "errordialoghandler.h"
 #include "mixxxtest.h"
+#include "test/effectsrender.h"
 #include "util/logging.h"
 
 int main(int argc, char **argv) {
     // We never want to popup error dialogs when running tests.
     ErrorDialogHandler::setEnabled(false);
 
+    for (int i = 0; i < argc; ++i) {
+        if (strcmp(argv[i], "--render-effects") == 0) {
+            // The render options are unknown to the Mixxx command line parser
+            int applicationArgc = 1;
+            MixxxTest::ApplicationScope applicationScope(applicationArgc, argv);
+            return mixxxtest::renderEffects(argc, argv);
+        }
+    }
+
 #ifdef USE_BENCH
     bool run_benchmarks = false;
     for (int i = 0; i < argc; ++i) {
@@ -0,0 +1,210 @@
+#include "sources/mp3seekindex.h"
+
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QUrl>
+#include <algorithm>
+#include <vector>
+
+#ifdef __MAD__
+#include "sources/soundsourcemp3.h"
+#include "test/mixxxtest.h"
+#include "util/samplebuffer.h"
+#endif
+
+namespace {
+
+using namespace mixxx;
+
+Mp3SeekIndex makeSeekIndex(SINT frameCount) {
+    Mp3SeekIndex seekIndex;
+    seekIndex.channelCount = audio::ChannelCount::stereo();
+    seekIndex.sampleRate = audio::SampleRate(44100);
+    seekIndex.bitrate = audio::Bitrate(320);
+    SINT byteOffset = 1024; // ID3v2 tag
+    for (SINT i = 0; i < frameCount; ++i) {
+        seekIndex.entries.push_back(Mp3SeekIndex::Entry{i * 1152, byteOffset});
+        // Alternating padding of CBR frames
+        byteOffset += (i % 3 == 0) ? 1045 : 1044;
+    }
+    seekIndex.entries.push_back(Mp3SeekIndex::Entry{frameCount * 1152, byteOffset});
+    return seekIndex;
+}
+
+class Mp3SeekIndexTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        ASSERT_TRUE(m_tempDir.isValid());
+        Mp3SeekIndexStore::setStorageDirectory(m_tempDir.filePath("mp3seek"));
+    }
+
+    void TearDown() override {
+        Mp3SeekIndexStore::setStorageDirectory(QString());
+    }
+
+    QString writeFile(const QString& fileName, int size) {
+        const QString filePath = m_tempDir.filePath(fileName);
+        QFile file(filePath);
+        EXPECT_TRUE(file.open(QIODevice::WriteOnly));
+        EXPECT_EQ(size, file.write(QByteArray(size, '\0')));
+        return filePath;
+    }
+
+    QTemporaryDir m_tempDir;
+};
+
+TEST_F(Mp3SeekIndexTest, EncodeDecode) {
+    const auto seekIndex = makeSeekIndex(1000);
+    const QByteArray encoded = seekIndex.encode();
+    // Much smaller than 2 * 64 bits per entry
+    EXPECT_LT(encoded.size(), 1000);
+
+    const auto decoded = Mp3SeekIndex::decode(encoded);
+    ASSERT_TRUE(decoded);
+    EXPECT_EQ(seekIndex.channelCount, decoded->channelCount);
+    EXPECT_EQ(seekIndex.sampleRate, decoded->sampleRate);
+    EXPECT_EQ(seekIndex.bitrate, decoded->bitrate);
+    EXPECT_EQ(seekIndex.entries, decoded->entries);
+
+    EXPECT_FALSE(Mp3SeekIndex::decode(QByteArray("garbage")));
+    EXPECT_FALSE(Mp3SeekIndex::decode(encoded.left(encoded.size() / 2)));
+}
+
+TEST_F(Mp3SeekIndexTest, IsValid) {
+    auto seekIndex = makeSeekIndex(10);
+    const auto fileSize = static_cast<quint64>(seekIndex.entries.back().byteOffset);
+    EXPECT_TRUE(seekIndex.isValid(fileSize));
+    EXPECT_FALSE(seekIndex.isValid(fileSize - 1));
+
+    std::swap(seekIndex.entries[3], seekIndex.entries[4]);
+    EXPECT_FALSE(seekIndex.isValid(fileSize));
+}
+
+TEST_F(Mp3SeekIndexTest, StoreAndLoad) {
+    const auto seekIndex = makeSeekIndex(100);
+    const QString filePath = writeFile(
+            QStringLiteral("track.mp3"), seekIndex.entries.back().byteOffset);
+
+    EXPECT_FALSE(Mp3SeekIndexStore::load(QFileInfo(filePath)));
+    EXPECT_TRUE(Mp3SeekIndexStore::save(QFileInfo(filePath), seekIndex));
+    const auto loaded = Mp3SeekIndexStore::load(QFileInfo(filePath));
+    ASSERT_TRUE(loaded);
+    EXPECT_EQ(seekIndex.entries, loaded->entries);
+
+    // Modifying the file invalidates the stored index
+    writeFile(QStringLiteral("track.mp3"), seekIndex.entries.back().byteOffset + 100);
+    EXPECT_FALSE(Mp3SeekIndexStore::load(QFileInfo(filePath)));
+}
+
+TEST_F(Mp3SeekIndexTest, StorageDisabled) {
+    const auto seekIndex = makeSeekIndex(10);
+    const QString filePath = writeFile(
+            QStringLiteral("track.mp3"), seekIndex.entries.back().byteOffset);
+
+    Mp3SeekIndexStore::setStorageDirectory(QString());
+    EXPECT_FALSE(Mp3SeekIndexStore::save(QFileInfo(filePath), seekIndex));
+    EXPECT_FALSE(Mp3SeekIndexStore::load(QFileInfo(filePath)));
+}
+
+TEST_F(Mp3SeekIndexTest, Clear) {
+    const auto seekIndex = makeSeekIndex(10);
+    const QString filePath = writeFile(
+            QStringLiteral("track.mp3"), seekIndex.entries.back().byteOffset);
+    ASSERT_TRUE(Mp3SeekIndexStore::save(QFileInfo(filePath), seekIndex));
+    EXPECT_LT(0, Mp3SeekIndexStore::diskUsageInBytes());
+
+    EXPECT_TRUE(Mp3SeekIndexStore::clear());
+    EXPECT_EQ(0, Mp3SeekIndexStore::diskUsageInBytes());
+    EXPECT_FALSE(Mp3SeekIndexStore::load(QFileInfo(filePath)));
+}
+
+#ifdef __MAD__
+
+class SoundSourceMp3SeekIndexTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        ASSERT_TRUE(m_tempDir.isValid());
+        Mp3SeekIndexStore::setStorageDirectory(m_tempDir.filePath("mp3seek"));
+        // A VBR file with frames of different lengths
+        m_filePath = m_tempDir.filePath(QStringLiteral("track.mp3"));
+        mixxxtest::copyFile(
+                getTestDir().filePath(QStringLiteral("id3-test-data/cover-test-vbr.mp3")),
+                m_filePath);
+    }
+
+    void TearDown() override {
+        Mp3SeekIndexStore::setStorageDirectory(QString());
+    }
+
+    // Reads the frames in chunks after seeking to the start of the range
+    static std::vector<CSAMPLE> readFrames(
+            SoundSourceMp3* pSoundSource,
+            IndexRange frameIndexRange) {
+        frameIndexRange = intersect(frameIndexRange, pSoundSource->frameIndexRange());
+        const auto signalInfo = pSoundSource->getSignalInfo();
+        std::vector<CSAMPLE> samples;
+        SampleBuffer buffer(signalInfo.frames2samples(1000));
+        while (!frameIndexRange.empty()) {
+            const auto chunkFrameIndexRange = frameIndexRange.splitAndShrinkFront(
+                    std::min(frameIndexRange.length(), SINT{1000}));
+            const auto readableSampleFrames = pSoundSource->readSampleFrames(
+                    WritableSampleFrames(
+                            chunkFrameIndexRange,
+                            SampleBuffer::WritableSlice(buffer)));
+            EXPECT_EQ(chunkFrameIndexRange, readableSampleFrames.frameIndexRange());
+            samples.insert(samples.end(),
+                    readableSampleFrames.readableData(),
+                    readableSampleFrames.readableData() +
+                            readableSampleFrames.readableLength());
+        }
+        return samples;
+    }
+
+    QTemporaryDir m_tempDir;
+    QString m_filePath;
+};
+
+TEST_F(SoundSourceMp3SeekIndexTest, DecodeWithRestoredSeekIndex) {
+    // Opening the file for the first time decodes all MP3 frame headers
+    // and stores the seek index
+    ASSERT_FALSE(Mp3SeekIndexStore::load(QFileInfo(m_filePath)));
+    SoundSourceMp3 scanned(QUrl::fromLocalFile(m_filePath));
+    ASSERT_EQ(AudioSource::OpenResult::Succeeded,
+            scanned.open(AudioSource::OpenMode::Strict));
+    ASSERT_TRUE(Mp3SeekIndexStore::load(QFileInfo(m_filePath)));
+
+    SoundSourceMp3 restored(QUrl::fromLocalFile(m_filePath));
+    ASSERT_EQ(AudioSource::OpenResult::Succeeded,
+            restored.open(AudioSource::OpenMode::Strict));
+    EXPECT_EQ(scanned.getSignalInfo(), restored.getSignalInfo());
+    EXPECT_EQ(scanned.getBitrate(), restored.getBitrate());
+    ASSERT_EQ(scanned.frameIndexRange(), restored.frameIndexRange());
+
+    const IndexRange frameIndexRange = scanned.frameIndexRange();
+    ASSERT_LT(20000, frameIndexRange.length());
+    EXPECT_EQ(readFrames(&scanned, frameIndexRange),
+            readFrames(&restored, frameIndexRange));
+
+    // Seek backward and forward across MP3 frame boundaries,
+    // including the last MP3 frame
+    const SINT seekFrameIndices[] = {
+            frameIndexRange.start() + frameIndexRange.length() / 2,
+            frameIndexRange.start() + 1,
+            frameIndexRange.end() - 1500,
+            frameIndexRange.start() + frameIndexRange.length() / 3 + 577,
+            frameIndexRange.end() - 1,
+            frameIndexRange.start(),
+    };
+    for (const auto frameIndex : seekFrameIndices) {
+        const auto seekFrameIndexRange = IndexRange::forward(frameIndex, 5000);
+        EXPECT_EQ(readFrames(&scanned, seekFrameIndexRange),
+                readFrames(&restored, seekFrameIndexRange))
+                << "frame index " << frameIndex;
+    }
+}
+
+#endif // __MAD__
+
+} // namespace
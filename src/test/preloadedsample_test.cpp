@@ -0,0 +1,95 @@
+#include "effects/backends/builtin/preloadedsample.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "effects/backends/builtin/metronomeclick.h"
+#include "util/math.h"
+
+namespace {
+
+constexpr double kFrequency = 1000;
+
+std::vector<CSAMPLE> sine(mixxx::audio::SampleRate sampleRate, SINT frames) {
+    std::vector<CSAMPLE> samples(frames);
+    for (SINT i = 0; i < frames; ++i) {
+        samples[i] = static_cast<CSAMPLE>(
+                std::sin(2 * M_PI * kFrequency * i / sampleRate.toDouble()));
+    }
+    return samples;
+}
+
+// Compares the variant for the sample rate with the sine it should be,
+// away from the edges that are faded by the resampling kernel
+void expectSine(const PreloadedSample& sample,
+        mixxx::audio::SampleRate sampleRate,
+        SINT frames) {
+    const auto samples = sample.forSampleRate(sampleRate);
+    ASSERT_EQ(static_cast<std::size_t>(frames), samples.size());
+    const auto expected = sine(sampleRate, frames);
+    for (SINT i = frames / 4; i < frames * 3 / 4; ++i) {
+        ASSERT_NEAR(expected[i], samples[i], 0.001) << "frame " << i;
+    }
+}
+
+TEST(PreloadedSampleTest, KeepRecordings) {
+    const auto recording44100 = sine(mixxx::audio::SampleRate(44100), 100);
+    const auto recording48000 = sine(mixxx::audio::SampleRate(48000), 200);
+    const PreloadedSample sample({
+            {mixxx::audio::SampleRate(44100), recording44100},
+            {mixxx::audio::SampleRate(48000), recording48000},
+    });
+
+    const auto samples44100 = sample.forSampleRate(mixxx::audio::SampleRate(44100));
+    EXPECT_TRUE(std::equal(samples44100.begin(),
+            samples44100.end(),
+            recording44100.begin(),
+            recording44100.end()));
+    const auto samples48000 = sample.forSampleRate(mixxx::audio::SampleRate(48000));
+    EXPECT_TRUE(std::equal(samples48000.begin(),
+            samples48000.end(),
+            recording48000.begin(),
+            recording48000.end()));
+}
+
+TEST(PreloadedSampleTest, Resample) {
+    const PreloadedSample sample({
+            {mixxx::audio::SampleRate(48000), sine(mixxx::audio::SampleRate(48000), 4800)},
+    });
+    expectSine(sample, mixxx::audio::SampleRate(22050), 2205);
+    expectSine(sample, mixxx::audio::SampleRate(44100), 4410);
+    expectSine(sample, mixxx::audio::SampleRate(96000), 9600);
+    expectSine(sample, mixxx::audio::SampleRate(192000), 19200);
+}
+
+TEST(PreloadedSampleTest, ClosestSampleRate) {
+    const PreloadedSample sample({
+            {mixxx::audio::SampleRate(48000), sine(mixxx::audio::SampleRate(48000), 480)},
+    });
+    EXPECT_EQ(480u, sample.forSampleRate(mixxx::audio::SampleRate(47000)).size());
+    EXPECT_EQ(1920u, sample.forSampleRate(mixxx::audio::SampleRate(190000)).size());
+}
+
+TEST(PreloadedSampleTest, AddToStereoWithGain) {
+    const std::vector<CSAMPLE> samples = {1, 2, 3};
+    std::vector<CSAMPLE> output(4, 1);
+    EXPECT_EQ(2u, PreloadedSample::addToStereoWithGain(samples, output, 0.5));
+    EXPECT_EQ(std::vector<CSAMPLE>({1.5, 1.5, 2, 2}), output);
+
+    output.assign(8, 0);
+    EXPECT_EQ(3u, PreloadedSample::addToStereoWithGain(samples, output, 1));
+    EXPECT_EQ(std::vector<CSAMPLE>({1, 1, 2, 2, 3, 3, 0, 0}), output);
+}
+
+TEST(PreloadedSampleTest, MetronomeClickForAllSampleRates) {
+    const auto pClick = metronomeClick();
+    for (const auto sampleRate : {22050, 32000, 44100, 48000, 88200, 96000, 176400, 192000}) {
+        EXPECT_FALSE(pClick->forSampleRate(mixxx::audio::SampleRate(sampleRate)).empty())
+                << sampleRate;
+    }
+}
+
+} // namespace
@@ -0,0 +1,132 @@
+#include <Reverb.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "util/rampingvalue.h"
+
+namespace {
+
+constexpr sample_t kBandwidth = 0.9f;
+constexpr sample_t kDecay = 0.7f;
+constexpr sample_t kDamping = 0.3f;
+
+// The sample by sample implementation that MixxxPlateX2::processBuffer()
+// used before processing blocks
+class ReferencePlate : public MixxxPlateX2 {
+  public:
+    void processBufferReference(const sample_t* in,
+            sample_t* out,
+            const uint frames,
+            const sample_t bandwidthParam,
+            const sample_t decayParam,
+            const sample_t dampingParam,
+            const sample_t currentSend,
+            const sample_t previousSend) {
+        input.bandwidth.set(exp(-M_PI * (1. - (.005 + .994 * bandwidthParam))));
+        sample_t decay = .890 * decayParam;
+        double damp = exp(-M_PI * (.0005 + .9995 * dampingParam));
+        tank.damping[0].set(damp);
+        tank.damping[1].set(damp);
+        RampingValue<sample_t> send(pow(currentSend, 1.53), previousSend, frames);
+        for (uint i = 0; i + 1 < frames; i += 2) {
+            sample_t mono_sample = send.getNth(i / 2) * (in[i] + in[i + 1]) / 2;
+            PlateStub::process(mono_sample, decay, &out[i], &out[i + 1]);
+        }
+    }
+};
+
+class ReverbTest : public testing::TestWithParam<std::tuple<float, uint>> {
+  protected:
+    // Feeds a short burst of noise followed by silence
+    void fillInput(std::vector<sample_t>* pInput, int buffer) {
+        for (auto& sample : *pInput) {
+            sample = buffer < 4 ? m_noise(m_generator) : 0;
+        }
+    }
+
+    std::mt19937 m_generator;
+    std::uniform_real_distribution<sample_t> m_noise{-1, 1};
+};
+
+TEST_P(ReverbTest, BlockProcessingMatchesReference) {
+    const auto [sampleRate, samplesPerBuffer] = GetParam();
+    ReferencePlate reference;
+    reference.init(sampleRate);
+    MixxxPlateX2 plate;
+    plate.init(sampleRate);
+
+    std::vector<sample_t> input(samplesPerBuffer);
+    std::vector<sample_t> expected(samplesPerBuffer);
+    std::vector<sample_t> output(samplesPerBuffer);
+    const int buffers = static_cast<int>(2 * 2 * sampleRate / samplesPerBuffer);
+    sample_t previousSend = 0;
+    for (int buffer = 0; buffer < buffers; ++buffer) {
+        fillInput(&input, buffer);
+        // Also ramp the send and move the other parameters
+        const sample_t send = buffer < 2 ? 0.5f * buffer : 1.0f;
+        const sample_t decay = buffer < buffers / 2 ? kDecay : 1.0f;
+        reference.processBufferReference(input.data(),
+                expected.data(),
+                samplesPerBuffer,
+                kBandwidth,
+                decay,
+                kDamping,
+                send,
+                previousSend);
+        plate.processBuffer(input.data(),
+                output.data(),
+                samplesPerBuffer,
+                kBandwidth,
+                decay,
+                kDamping,
+                send,
+                previousSend);
+        previousSend = send;
+        // Only the rounding of the output taps differs
+        for (uint i = 0; i < samplesPerBuffer; ++i) {
+            ASSERT_NEAR(expected[i], output[i], 1e-6)
+                    << "buffer " << buffer << " sample " << i;
+        }
+    }
+}
+
+TEST_P(ReverbTest, WithoutModulation) {
+    const auto [sampleRate, samplesPerBuffer] = GetParam();
+    MixxxPlateX2 plate;
+    plate.init(sampleRate);
+
+    std::vector<sample_t> input(samplesPerBuffer);
+    std::vector<sample_t> output(samplesPerBuffer);
+    const int buffers = static_cast<int>(10 * 2 * sampleRate / samplesPerBuffer);
+    sample_t peak = 0;
+    for (int buffer = 0; buffer < buffers; ++buffer) {
+        fillInput(&input, buffer);
+        plate.processBuffer(input.data(),
+                output.data(),
+                samplesPerBuffer,
+                kBandwidth,
+                kDecay,
+                kDamping,
+                1,
+                1,
+                false);
+        peak = 0;
+        for (const auto sample : output) {
+            ASSERT_TRUE(std::isfinite(sample));
+            peak = std::max(peak, std::abs(sample));
+        }
+    }
+    // Still decays like the modulated tank
+    EXPECT_GT(1e-5, peak);
+}
+
+INSTANTIATE_TEST_SUITE_P(ReverbTest,
+        ReverbTest,
+        testing::Combine(
+                testing::Values(44100.0f, 48000.0f, 96000.0f),
+                // Including buffers that are not a multiple of a block
+                testing::Values(128u, 1000u, 4096u)));
+
+} // namespace
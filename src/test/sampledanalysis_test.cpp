@@ -0,0 +1,111 @@
+#include "analyzer/sampledanalysis.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr auto kSampleRate = mixxx::audio::SampleRate(44100);
+
+// Evenly spaced beats with the given tempo
+QVector<mixxx::audio::FramePos> makeBeats(
+        mixxx::audio::FramePos firstBeat, double bpm, int count) {
+    const double beatLength = 60.0 * kSampleRate / bpm;
+    QVector<mixxx::audio::FramePos> beats;
+    for (int i = 0; i < count; ++i) {
+        beats.append(firstBeat + i * beatLength);
+    }
+    return beats;
+}
+
+TEST(SampledAnalysisTest, WindowsOfShortTrack) {
+    const SINT frameLength = 90 * kSampleRate;
+    const mixxx::SampledAnalysisWindows windows(kSampleRate, frameLength, 4, 15);
+    ASSERT_EQ(1, windows.size());
+    EXPECT_EQ(mixxx::IndexRange::forward(0, frameLength), windows.at(0));
+    EXPECT_EQ(0, windows.framesToSkip(0));
+    EXPECT_EQ(std::numeric_limits<SINT>::max(), windows.framesToSkip(frameLength));
+}
+
+TEST(SampledAnalysisTest, WindowsOfLongTrack) {
+    const SINT frameLength = 600 * kSampleRate;
+    const SINT windowLength = 15 * kSampleRate;
+    const SINT sectionLength = frameLength / 4;
+    const mixxx::SampledAnalysisWindows windows(kSampleRate, frameLength, 4, 15);
+    ASSERT_EQ(4, windows.size());
+    for (int i = 0; i < windows.size(); ++i) {
+        // Centered within each section
+        EXPECT_EQ(windowLength, windows.at(i).length());
+        EXPECT_EQ(i * sectionLength + (sectionLength - windowLength) / 2,
+                windows.at(i).start());
+    }
+
+    EXPECT_EQ(windows.at(0).start(), windows.framesToSkip(0));
+    EXPECT_EQ(0, windows.framesToSkip(windows.at(0).start()));
+    EXPECT_EQ(0, windows.framesToSkip(windows.at(0).end() - 1));
+    EXPECT_EQ(windows.at(1).start() - windows.at(0).end(),
+            windows.framesToSkip(windows.at(0).end()));
+    EXPECT_EQ(std::numeric_limits<SINT>::max(),
+            windows.framesToSkip(windows.at(3).end()));
+}
+
+TEST(SampledAnalysisTest, EstimateTempo) {
+    const auto beats = makeBeats(mixxx::audio::FramePos(1000000), 120.0, 30);
+    const auto tempo = mixxx::estimateSampledTempo(beats, kSampleRate);
+    EXPECT_EQ(mixxx::Bpm(120.0), tempo.bpm);
+    EXPECT_DOUBLE_EQ(1.0, tempo.confidence);
+    // The first beat is moved to the start of the track
+    ASSERT_TRUE(tempo.firstBeat.isValid());
+    EXPECT_NEAR(std::fmod(1000000.0, 22050.0), tempo.firstBeat.value(), 1.0);
+
+    // Not enough beats
+    EXPECT_FALSE(mixxx::estimateSampledTempo(
+            makeBeats(mixxx::audio::FramePos(1000000), 120.0, 1), kSampleRate)
+                         .bpm.isValid());
+}
+
+TEST(SampledAnalysisTest, CombineTempos) {
+    EXPECT_FALSE(mixxx::combineSampledTempos({}));
+
+    const std::vector<mixxx::SampledTempo> tempos = {
+            {mixxx::Bpm(120.0), mixxx::audio::FramePos(100), 0.6},
+            {mixxx::Bpm(90.0), mixxx::audio::FramePos(200), 1.0},
+            {mixxx::Bpm(120.5), mixxx::audio::FramePos(300), 0.8},
+            {mixxx::Bpm(), mixxx::audio::FramePos(), 0.0},
+    };
+    // Both similar tempos together are more confident than the single
+    // most confident window, which is assumed to be a bridge.
+    const auto tempo = mixxx::combineSampledTempos(tempos);
+    ASSERT_TRUE(tempo);
+    EXPECT_EQ(mixxx::Bpm(120.5), tempo->bpm);
+    EXPECT_EQ(mixxx::audio::FramePos(300), tempo->firstBeat);
+    EXPECT_DOUBLE_EQ((0.6 + 0.8) / 4, tempo->confidence);
+}
+
+TEST(SampledAnalysisTest, EstimateKey) {
+    KeyChangeList keyChanges;
+    keyChanges.append(qMakePair(mixxx::track::io::key::C_MAJOR, 0.0));
+    keyChanges.append(qMakePair(mixxx::track::io::key::A_MINOR, 100.0));
+    const auto key = mixxx::estimateSampledKey(keyChanges, 400);
+    EXPECT_EQ(mixxx::track::io::key::A_MINOR, key.key);
+    EXPECT_DOUBLE_EQ(0.75, key.confidence);
+
+    EXPECT_EQ(mixxx::track::io::key::INVALID,
+            mixxx::estimateSampledKey(KeyChangeList(), 400).key);
+}
+
+TEST(SampledAnalysisTest, CombineKeys) {
+    EXPECT_EQ(mixxx::track::io::key::INVALID, mixxx::combineSampledKeys({}));
+
+    const std::vector<mixxx::SampledKey> keys = {
+            {mixxx::track::io::key::C_MAJOR, 0.9},
+            {mixxx::track::io::key::A_MINOR, 0.6},
+            {mixxx::track::io::key::A_MINOR, 0.5},
+            {mixxx::track::io::key::INVALID, 0.0},
+    };
+    EXPECT_EQ(mixxx::track::io::key::A_MINOR, mixxx::combineSampledKeys(keys));
+}
+
+} // namespace
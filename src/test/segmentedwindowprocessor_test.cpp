@@ -0,0 +1,198 @@
+#include "analyzer/plugins/segmentedwindowprocessor.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "analyzer/plugins/analyzerqueenmarybeats.h"
+#include "analyzer/plugins/analyzerqueenmarykey.h"
+#include "util/math.h"
+
+namespace {
+
+using mixxx::SegmentedWindowProcessor;
+
+constexpr size_t kWindowSize = 64;
+constexpr size_t kStepSize = 16;
+
+// Deterministic, non-periodic stereo test signal
+std::vector<CSAMPLE> makeSignal(size_t frames) {
+    std::vector<CSAMPLE> samples(frames * 2);
+    for (size_t i = 0; i < frames; ++i) {
+        samples[i * 2] = static_cast<CSAMPLE>(std::sin(i * 0.01) * std::cos(i * 0.0007));
+        samples[i * 2 + 1] = static_cast<CSAMPLE>(std::sin(i * 0.013));
+    }
+    return samples;
+}
+
+// The difference between the energy of the current and the previous window
+SegmentedWindowProcessor<double>::WindowFunction makeEnergyDifference() {
+    auto pPrevEnergy = std::make_shared<double>(0.0);
+    return [pPrevEnergy](double* pWindow) {
+        double energy = 0.0;
+        for (size_t i = 0; i < kWindowSize; ++i) {
+            energy += pWindow[i] * pWindow[i];
+        }
+        const double difference = energy - *pPrevEnergy;
+        *pPrevEnergy = energy;
+        return std::optional<double>(difference);
+    };
+}
+
+// Exponential moving average of the window energy that depends on all
+// preceding windows
+SegmentedWindowProcessor<double>::WindowFunction makeEnergyAverage() {
+    auto pAverage = std::make_shared<double>(0.0);
+    return [pAverage](double* pWindow) {
+        double energy = 0.0;
+        for (size_t i = 0; i < kWindowSize; ++i) {
+            energy += pWindow[i] * pWindow[i];
+        }
+        *pAverage = 0.5 * *pAverage + 0.5 * energy;
+        return std::optional<double>(*pAverage);
+    };
+}
+
+std::vector<double> process(
+        const std::vector<CSAMPLE>& samples,
+        size_t segmentWindowCount,
+        size_t warmUpWindowCount,
+        const SegmentedWindowProcessor<double>::WindowFunctionFactory& factory) {
+    SegmentedWindowProcessor<double> processor;
+    EXPECT_TRUE(processor.initialize(
+            kWindowSize, kStepSize, segmentWindowCount, warmUpWindowCount, factory));
+    // Feed the signal in chunks that are not aligned with the windows
+    constexpr size_t kChunkSamples = 2 * 100;
+    for (size_t i = 0; i < samples.size(); i += kChunkSamples) {
+        EXPECT_TRUE(processor.processStereoSamples(
+                samples.data() + i, math_min(kChunkSamples, samples.size() - i)));
+    }
+    const size_t windowCount = processor.windowCount();
+    auto results = processor.finalize();
+    EXPECT_TRUE(results);
+    if (!results) {
+        return {};
+    }
+    EXPECT_GE(results->size(), windowCount);
+    return *results;
+}
+
+TEST(SegmentedWindowProcessorTest, BoundedStateMatchesSequential) {
+    const auto samples = makeSignal(10000);
+    const auto expected = process(samples, 0, 0, makeEnergyDifference);
+    ASSERT_FALSE(expected.empty());
+    for (size_t segmentWindowCount : {1, 7, 64, 1000}) {
+        SCOPED_TRACE(segmentWindowCount);
+        EXPECT_EQ(expected, process(samples, segmentWindowCount, 1, makeEnergyDifference));
+    }
+}
+
+TEST(SegmentedWindowProcessorTest, ConvergingStateMatchesSequential) {
+    const auto samples = makeSignal(10000);
+    const auto expected = process(samples, 0, 0, makeEnergyAverage);
+    // The influence of the initial state is halved with every warm-up window
+    const auto actual = process(samples, 16, 48, makeEnergyAverage);
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_NEAR(expected[i], actual[i], 1e-9) << i;
+    }
+}
+
+TEST(SegmentedWindowProcessorTest, Abort) {
+    const auto samples = makeSignal(10000);
+    for (size_t segmentWindowCount : {0, 16}) {
+        SCOPED_TRACE(segmentWindowCount);
+        SegmentedWindowProcessor<double> processor;
+        ASSERT_TRUE(processor.initialize(kWindowSize,
+                kStepSize,
+                segmentWindowCount,
+                2,
+                []() {
+                    auto pCount = std::make_shared<int>(0);
+                    return [pCount](double*) -> std::optional<double> {
+                        if (++*pCount > 20) {
+                            return std::nullopt;
+                        }
+                        return 0.0;
+                    };
+                }));
+        processor.processStereoSamples(samples.data(), samples.size());
+        EXPECT_FALSE(processor.finalize());
+    }
+}
+
+class AnalyzerQueenMaryParallelTest : public testing::Test {
+  protected:
+    static constexpr mixxx::audio::SampleRate kSampleRate =
+            mixxx::audio::SampleRate(22050);
+
+    // Generates the signal in chunks and passes it to all plugins
+    template<typename Generator>
+    static void analyze(
+            std::initializer_list<mixxx::AnalyzerPlugin*> plugins,
+            SINT frames,
+            Generator generator) {
+        for (auto* pPlugin : plugins) {
+            ASSERT_TRUE(pPlugin->initialize(kSampleRate));
+        }
+        constexpr SINT kChunkFrames = 4096;
+        std::vector<CSAMPLE> chunk(kChunkFrames * 2);
+        for (SINT frame = 0; frame < frames; frame += kChunkFrames) {
+            const SINT chunkFrames = math_min(kChunkFrames, frames - frame);
+            for (SINT i = 0; i < chunkFrames; ++i) {
+                chunk[i * 2] = chunk[i * 2 + 1] = generator(frame + i);
+            }
+            for (auto* pPlugin : plugins) {
+                ASSERT_TRUE(pPlugin->processSamples(chunk.data(), chunkFrames * 2));
+            }
+        }
+        for (auto* pPlugin : plugins) {
+            ASSERT_TRUE(pPlugin->finalize());
+        }
+    }
+};
+
+TEST_F(AnalyzerQueenMaryParallelTest, Beats) {
+    // 60 s of clicks at 125 BPM
+    const SINT frames = 60 * kSampleRate.value();
+    const SINT beatLength = static_cast<SINT>(kSampleRate.value() * 60 / 125.0);
+    mixxx::AnalyzerQueenMaryBeats sequential(false);
+    mixxx::AnalyzerQueenMaryBeats parallel(true);
+    analyze({&sequential, &parallel}, frames, [beatLength](SINT frame) {
+        const SINT offset = frame % beatLength;
+        return offset < 200
+                ? static_cast<CSAMPLE>(std::sin(offset * 0.3) * (1.0 - offset / 200.0))
+                : CSAMPLE_ZERO;
+    });
+    const auto expected = sequential.getBeats();
+    ASSERT_FALSE(expected.isEmpty());
+    EXPECT_EQ(expected, parallel.getBeats());
+}
+
+TEST_F(AnalyzerQueenMaryParallelTest, Key) {
+    // C major and F# major triads alternating every 50 s
+    const SINT frames = 150 * kSampleRate.value();
+    const SINT sectionLength = 50 * kSampleRate.value();
+    mixxx::AnalyzerQueenMaryKey sequential(false);
+    mixxx::AnalyzerQueenMaryKey parallel(true);
+    analyze({&sequential, &parallel}, frames, [sectionLength](SINT frame) {
+        const double root = (frame / sectionLength) % 2 == 0 ? 261.63 : 369.99;
+        const double t = static_cast<double>(frame) / kSampleRate.value();
+        double sample = 0.0;
+        for (double ratio : {1.0, 1.25, 1.5}) {
+            sample += std::sin(2 * M_PI * root * ratio * t);
+        }
+        return static_cast<CSAMPLE>(sample / 3);
+    });
+    const auto expected = sequential.getKeyChanges();
+    const auto actual = parallel.getKeyChanges();
+    ASSERT_FALSE(expected.isEmpty());
+    ASSERT_EQ(expected.size(), actual.size());
+    for (int i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i].first, actual[i].first) << i;
+        EXPECT_EQ(expected[i].second, actual[i].second) << i;
+    }
+}
+
+} // namespace
@@ -0,0 +1,192 @@
+#include "sources/soundsourcepool.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "sources/soundsourceproxy.h"
+#include "test/mixxxtest.h"
+#include "test/soundsourceproviderregistration.h"
+#include "track/track.h"
+#include "util/samplebuffer.h"
+
+namespace {
+
+constexpr SINT kReadFrameCount = 1024;
+
+class SoundSourcePoolTest : public MixxxTest, SoundSourceProviderRegistration {
+  protected:
+    void SetUp() override {
+        ASSERT_TRUE(m_tempDir.isValid());
+        m_filePath = m_tempDir.filePath(QStringLiteral("cover-test.wav"));
+        ASSERT_TRUE(QFile::copy(
+                getTestDir().filePath(QStringLiteral("id3-test-data/cover-test.wav")),
+                m_filePath));
+        mixxx::SoundSourcePool::clear();
+        mixxx::SoundSourcePool::setCapacity(mixxx::SoundSourcePool::kDefaultCapacity);
+        mixxx::SoundSourcePool::setMaxIdleDuration(
+                mixxx::SoundSourcePool::kDefaultMaxIdleDuration);
+    }
+
+    void TearDown() override {
+        mixxx::SoundSourcePool::clear();
+        mixxx::SoundSourcePool::setCapacity(mixxx::SoundSourcePool::kDefaultCapacity);
+        mixxx::SoundSourcePool::setMaxIdleDuration(
+                mixxx::SoundSourcePool::kDefaultMaxIdleDuration);
+    }
+
+    mixxx::AudioSourcePointer openAudioSource() const {
+        mixxx::AudioSource::OpenParams openParams;
+        openParams.setChannelCount(mixxx::audio::ChannelCount::stereo());
+        return SoundSourceProxy(Track::newTemporary(m_filePath))
+                .openAudioSource(openParams);
+    }
+
+    static mixxx::SampleBuffer readSamples(
+            const mixxx::AudioSourcePointer& pAudioSource,
+            SINT firstFrameIndex) {
+        mixxx::SampleBuffer buffer(
+                pAudioSource->getSignalInfo().frames2samples(kReadFrameCount));
+        const auto readRange = pAudioSource->readSampleFrames(
+                mixxx::WritableSampleFrames(
+                        mixxx::IndexRange::forward(firstFrameIndex, kReadFrameCount),
+                        mixxx::SampleBuffer::WritableSlice(buffer)));
+        EXPECT_EQ(kReadFrameCount, readRange.frameLength());
+        return buffer;
+    }
+
+    QTemporaryDir m_tempDir;
+    QString m_filePath;
+};
+
+TEST_F(SoundSourcePoolTest, ReuseAfterClose) {
+    auto pAudioSource = openAudioSource();
+    ASSERT_TRUE(pAudioSource);
+    const auto signalInfo = pAudioSource->getSignalInfo();
+    const auto frameIndexRange = pAudioSource->frameIndexRange();
+    const auto expected = readSamples(pAudioSource, frameIndexRange.start());
+    // Move the read position away from the start
+    readSamples(pAudioSource, frameIndexRange.end() - kReadFrameCount);
+    pAudioSource->close();
+    pAudioSource.reset();
+    EXPECT_EQ(1, mixxx::SoundSourcePool::size());
+
+    pAudioSource = openAudioSource();
+    ASSERT_TRUE(pAudioSource);
+    EXPECT_EQ(0, mixxx::SoundSourcePool::size());
+    EXPECT_EQ(signalInfo, pAudioSource->getSignalInfo());
+    EXPECT_EQ(frameIndexRange, pAudioSource->frameIndexRange());
+    const auto actual = readSamples(pAudioSource, frameIndexRange.start());
+    for (SINT i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i], actual[i]);
+    }
+
+    // Closing twice must not pool the SoundSource twice
+    pAudioSource->close();
+    pAudioSource->close();
+    EXPECT_EQ(1, mixxx::SoundSourcePool::size());
+}
+
+TEST_F(SoundSourcePoolTest, DifferentOpenParams) {
+    auto pAudioSource = openAudioSource();
+    ASSERT_TRUE(pAudioSource);
+    pAudioSource->close();
+    EXPECT_EQ(1, mixxx::SoundSourcePool::size());
+
+    mixxx::AudioSource::OpenParams openParams;
+    openParams.setChannelCount(mixxx::audio::ChannelCount::mono());
+    EXPECT_FALSE(mixxx::SoundSourcePool::acquire(
+            QUrl::fromLocalFile(m_filePath), openParams)
+                         .pSoundSource);
+    EXPECT_EQ(1, mixxx::SoundSourcePool::size());
+}
+
+TEST_F(SoundSourcePoolTest, Evict) {
+    auto pAudioSource = openAudioSource();
+    ASSERT_TRUE(pAudioSource);
+    pAudioSource->close();
+    EXPECT_EQ(1, mixxx::SoundSourcePool::size());
+
+    mixxx::SoundSourcePool::evict(QUrl::fromLocalFile(m_filePath));
+    EXPECT_EQ(0, mixxx::SoundSourcePool::size());
+}
+
+TEST_F(SoundSourcePoolTest, EvictDirectory) {
+    auto pAudioSource = openAudioSource();
+    ASSERT_TRUE(pAudioSource);
+    pAudioSource->close();
+    EXPECT_EQ(1, mixxx::SoundSourcePool::size());
+
+    mixxx::SoundSourcePool::evictDirectory(QDir(m_tempDir.filePath(QStringLiteral("other"))));
+    EXPECT_EQ(1, mixxx::SoundSourcePool::size());
+    mixxx::SoundSourcePool::evictDirectory(QDir(m_tempDir.path()));
+    EXPECT_EQ(0, mixxx::SoundSourcePool::size());
+}
+
+TEST_F(SoundSourcePoolTest, ReleaseWhenDropped) {
+    auto pAudioSource = openAudioSource();
+    ASSERT_TRUE(pAudioSource);
+    pAudioSource.reset();
+    EXPECT_EQ(1, mixxx::SoundSourcePool::size());
+}
+
+TEST_F(SoundSourcePoolTest, KeepWhenExportingUnmodifiedMetadata) {
+    auto pTrack = Track::newTemporary(m_filePath);
+    ASSERT_EQ(SoundSourceProxy::UpdateTrackFromSourceResult::MetadataImportedAndUpdated,
+            SoundSourceProxy(pTrack).updateTrackFromSource(
+                    SoundSourceProxy::UpdateTrackFromSourceMode::Once,
+                    SyncTrackMetadataParams{}));
+    auto pAudioSource = openAudioSource();
+    ASSERT_TRUE(pAudioSource);
+    pAudioSource->close();
+    EXPECT_EQ(1, mixxx::SoundSourcePool::size());
+
+    // No file tags are written, so the file stays open
+    EXPECT_EQ(ExportTrackMetadataResult::Skipped,
+            SoundSourceProxy::exportTrackMetadataBeforeSaving(
+                    pTrack.get(), SyncTrackMetadataParams{}));
+    EXPECT_EQ(1, mixxx::SoundSourcePool::size());
+}
+
+TEST_F(SoundSourcePoolTest, CloseExpired) {
+    auto pAudioSource = openAudioSource();
+    ASSERT_TRUE(pAudioSource);
+    pAudioSource->close();
+    EXPECT_EQ(1, mixxx::SoundSourcePool::size());
+
+    mixxx::SoundSourcePool::closeExpired();
+    EXPECT_EQ(1, mixxx::SoundSourcePool::size());
+
+    mixxx::SoundSourcePool::setMaxIdleDuration(std::chrono::milliseconds(0));
+    mixxx::SoundSourcePool::closeExpired();
+    EXPECT_EQ(0, mixxx::SoundSourcePool::size());
+}
+
+TEST_F(SoundSourcePoolTest, ModifiedFileIsNotReused) {
+    auto pAudioSource = openAudioSource();
+    ASSERT_TRUE(pAudioSource);
+    pAudioSource->close();
+    EXPECT_EQ(1, mixxx::SoundSourcePool::size());
+
+    {
+        QFile file(m_filePath);
+        ASSERT_TRUE(file.open(QIODevice::Append));
+        file.write(QByteArray(16, '\0'));
+    }
+    mixxx::AudioSource::OpenParams openParams;
+    openParams.setChannelCount(mixxx::audio::ChannelCount::stereo());
+    EXPECT_FALSE(mixxx::SoundSourcePool::acquire(
+            QUrl::fromLocalFile(m_filePath), openParams)
+                         .pSoundSource);
+    EXPECT_EQ(0, mixxx::SoundSourcePool::size());
+}
+
+TEST_F(SoundSourcePoolTest, Capacity) {
+    mixxx::SoundSourcePool::setCapacity(0);
+    auto pAudioSource = openAudioSource();
+    ASSERT_TRUE(pAudioSource);
+    pAudioSource->close();
+    EXPECT_EQ(0, mixxx::SoundSourcePool::size());
+}
+
+} // namespace
@@ -0,0 +1,59 @@
+#include "waveform/renderers/waveformmarkimagecache.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+
+WaveformMarkImageKey makeKey(const QString& label, float breadth) {
+    return WaveformMarkImageKey{label,
+            QString(),
+            static_cast<int>(Qt::AlignBottom | Qt::AlignHCenter),
+            breadth,
+            0,
+            qRgba(255, 0, 0, 255),
+            qRgba(0, 0, 0, 255),
+            qRgba(255, 255, 255, 255),
+            1.f};
+}
+
+class WaveformMarkImageCacheTest : public testing::Test {
+  protected:
+    WaveformMarkImageCache::RenderFunction countingRender() {
+        return [this](const WaveformMarkImageKey& key) {
+            ++m_renderCount;
+            WaveformMarkImage image;
+            image.labelRect = QRectF(0, 0, key.label.size(), key.breadth);
+            image.offset = -1.f;
+            return image;
+        };
+    }
+
+    int m_renderCount = 0;
+};
+
+TEST_F(WaveformMarkImageCacheTest, EqualKeysShareImage) {
+    auto pFirst = WaveformMarkImageCache::getImage(makeKey("1: Drop", 100.f), countingRender());
+    auto pSecond = WaveformMarkImageCache::getImage(makeKey("1: Drop", 100.f), countingRender());
+    EXPECT_EQ(1, m_renderCount);
+    EXPECT_EQ(pFirst, pSecond);
+
+    auto pOther = WaveformMarkImageCache::getImage(makeKey("1: Drop", 50.f), countingRender());
+    EXPECT_EQ(2, m_renderCount);
+    EXPECT_NE(pFirst, pOther);
+    EXPECT_EQ(50.0, pOther->labelRect.height());
+}
+
+TEST_F(WaveformMarkImageCacheTest, UnusedImagesAreReleased) {
+    const int initialSize = WaveformMarkImageCache::size();
+    {
+        auto pImage = WaveformMarkImageCache::getImage(makeKey("Intro", 80.f), countingRender());
+        EXPECT_EQ(initialSize + 1, WaveformMarkImageCache::size());
+    }
+    EXPECT_EQ(initialSize, WaveformMarkImageCache::size());
+
+    // Once released, the image has to be rendered again
+    auto pImage = WaveformMarkImageCache::getImage(makeKey("Intro", 80.f), countingRender());
+    EXPECT_EQ(2, m_renderCount);
+}
+
+} // namespace
@@ -11,6 +11,7 @@
 #include "track/beatutils.h"
 #include "track/bpm.h"
 #include "util/assert.h"
+#include "util/math.h"
 
 namespace {
 
@@ -464,6 +465,9 @@ Beats::ConstIterator Beats::iteratorFrom(audio::FramePos position) const {
         }
         it -= static_cast<int>(n);
         it = previousIfNeeded(it, position);
+    } else if (!m_markerIndex.empty()) {
+        it = iteratorFromMarkerIndex(position);
+        it = previousIfNeeded(it, position);
     } else {
         it = std::lower_bound(cfirstmarker(), clastmarker() + 1, position);
     }
@@ -472,6 +476,63 @@ Beats::ConstIterator Beats::iteratorFrom(audio::FramePos position) const {
     return it;
 }
 
+void Beats::buildMarkerIndex() {
+    if (m_markers.empty()) {
+        return;
+    }
+    const audio::FramePos firstMarkerPosition = m_markers.front().position();
+    const int bucketCount = static_cast<int>(m_markers.size());
+    m_markerIndexBucketFrames = (m_lastMarkerPosition - firstMarkerPosition) / bucketCount;
+    VERIFY_OR_DEBUG_ASSERT(m_markerIndexBucketFrames > 0) {
+        // Fall back to a binary search
+        return;
+    }
+    m_markerIndex.reserve(bucketCount);
+    std::size_t markerIndex = 0;
+    for (int bucket = 0; bucket < bucketCount; ++bucket) {
+        const audio::FramePos bucketStart =
+                firstMarkerPosition + bucket * m_markerIndexBucketFrames;
+        while (markerIndex + 1 < m_markers.size() &&
+                m_markers[markerIndex + 1].position() <= bucketStart) {
+            ++markerIndex;
+        }
+        m_markerIndex.push_back(static_cast<int>(markerIndex));
+    }
+}
+
+// Find the next beat at or after a position between the first and the last marker
+Beats::ConstIterator Beats::iteratorFromMarkerIndex(audio::FramePos position) const {
+    DEBUG_ASSERT(!m_markerIndex.empty());
+    DEBUG_ASSERT(position >= m_markers.front().position());
+    DEBUG_ASSERT(position <= m_lastMarkerPosition);
+    const int bucket = math_clamp(
+            static_cast<int>((position - m_markers.front().position()) /
+                    m_markerIndexBucketFrames),
+            0,
+            static_cast<int>(m_markerIndex.size()) - 1);
+    auto markerIt = m_markers.cbegin() + m_markerIndex[bucket];
+    // Rounding errors of the bucket might require a step back
+    while (markerIt != m_markers.cbegin() && markerIt->position() > position) {
+        --markerIt;
+    }
+    // Usually only a few markers need to be skipped within a bucket
+    while (std::next(markerIt) != m_markers.cend() &&
+            std::next(markerIt)->position() <= position) {
+        ++markerIt;
+    }
+
+    ConstIterator it(this, markerIt, 0);
+    if (*it < position) {
+        // The beat might be located at the next marker
+        const double n = std::ceil((position - *it) / it.beatLengthFrames());
+        it += static_cast<int>(n);
+        if (*it < position) {
+            ++it;
+        }
+    }
+    return it;
+}
+
 audio::FramePos Beats::findNthBeat(audio::FramePos position, int n) const {
     if (n == 0) {
         return audio::kInvalidFramePos;
@@ -167,6 +167,7 @@ class Beats : private std::enable_shared_from_this<Beats> {
         DEBUG_ASSERT(!m_lastMarkerPosition.isFractional());
         DEBUG_ASSERT(m_lastMarkerBpm.isValid());
         DEBUG_ASSERT(m_sampleRate.isValid());
+        buildMarkerIndex();
     }
 
     Beats(mixxx::audio::FramePos lastMarkerPosition,
@@ -436,11 +437,22 @@ class Beats : private std::enable_shared_from_this<Beats> {
     mixxx::audio::FrameDiff_t firstBeatLengthFrames() const;
     mixxx::audio::FrameDiff_t lastBeatLengthFrames() const;
 
+    void buildMarkerIndex();
+    ConstIterator iteratorFromMarkerIndex(audio::FramePos position) const;
+
     std::vector<BeatMarker> m_markers;
     mixxx::audio::FramePos m_lastMarkerPosition;
     mixxx::Bpm m_lastMarkerBpm;
     mixxx::audio::SampleRate m_sampleRate;
 
+    // Lookup of the marker at or before a position between the first and
+    // the last marker in constant time on average. The range is divided
+    // into buckets of equal length, one per marker, that store the index
+    // of the last marker at or before the start of the bucket. The index
+    // is built once, because all instances are immutable.
+    std::vector<int> m_markerIndex;
+    mixxx::audio::FrameDiff_t m_markerIndexBucketFrames = 0;
+
     // The sub-version of this beatgrid.
     const QString m_subVersion;
 };
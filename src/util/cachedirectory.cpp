@@ -0,0 +1,89 @@
+#include "util/cachedirectory.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+
+#include "util/logger.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("CacheDirectory");
+
+QFileInfoList cacheFiles(const QString& path) {
+    // Most recently written first
+    return QDir(path).entryInfoList(QDir::Files | QDir::NoDotAndDotDot, QDir::Time);
+}
+
+} // anonymous namespace
+
+// static
+int CacheDirectory::purge(const QString& path, const Limits& limits) {
+    if (path.isEmpty()) {
+        return 0;
+    }
+    const QDateTime minLastModified =
+            QDateTime::currentDateTimeUtc().addDays(-limits.maxAgeDays);
+    int fileCount = 0;
+    qint64 totalBytes = 0;
+    int removedCount = 0;
+    for (const auto& fileInfo : cacheFiles(path)) {
+        ++fileCount;
+        totalBytes += fileInfo.size();
+        if (fileCount <= limits.maxFileCount &&
+                totalBytes <= limits.maxTotalBytes &&
+                fileInfo.lastModified() >= minLastModified) {
+            continue;
+        }
+        if (QFile::remove(fileInfo.filePath())) {
+            ++removedCount;
+        } else {
+            kLogger.warning()
+                    << "Failed to remove"
+                    << fileInfo.filePath();
+        }
+        --fileCount;
+        totalBytes -= fileInfo.size();
+    }
+    if (removedCount > 0) {
+        kLogger.info()
+                << "Removed"
+                << removedCount
+                << "outdated files from"
+                << path;
+    }
+    return removedCount;
+}
+
+// static
+bool CacheDirectory::clear(const QString& path) {
+    if (path.isEmpty()) {
+        return true;
+    }
+    bool success = true;
+    for (const auto& fileInfo : cacheFiles(path)) {
+        if (!QFile::remove(fileInfo.filePath())) {
+            kLogger.warning()
+                    << "Failed to remove"
+                    << fileInfo.filePath();
+            success = false;
+        }
+    }
+    return success;
+}
+
+// static
+qint64 CacheDirectory::diskUsageInBytes(const QString& path) {
+    if (path.isEmpty()) {
+        return 0;
+    }
+    qint64 totalBytes = 0;
+    for (const auto& fileInfo : cacheFiles(path)) {
+        totalBytes += fileInfo.size();
+    }
+    return totalBytes;
+}
+
+} // namespace mixxx
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <QString>
+#include <QtGlobal>
+
+namespace mixxx {
+
+/// A directory with one file per entry of a persistent cache, e.g. the
+/// AnalysisCache and the Mp3SeekIndexStore. The entries can be recreated
+/// at any time, so the oldest ones are simply removed when exceeding the
+/// limits.
+///
+/// All functions only access the file system and are thread-safe. Files
+/// that are currently written are replaced atomically by QSaveFile and
+/// are not affected.
+class CacheDirectory {
+  public:
+    struct Limits {
+        int maxFileCount;
+        qint64 maxTotalBytes;
+        int maxAgeDays;
+    };
+
+    /// Removes files that have not been written for longer than the
+    /// maximum age, and the least recently written files until both
+    /// the number of files and their total size are within the limits.
+    /// Returns the number of removed files.
+    static int purge(const QString& path, const Limits& limits);
+
+    /// Removes all files. Returns false if some files could not be removed.
+    static bool clear(const QString& path);
+
+    static qint64 diskUsageInBytes(const QString& path);
+};
+
+} // namespace mixxx
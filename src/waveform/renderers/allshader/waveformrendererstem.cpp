@@ -141,7 +141,7 @@ bool WaveformRendererStem::preprocessInner() {
 
     uint selectedStems = m_waveformRenderer->getSelectedStems();
 
-    const float devicePixelRatio = m_waveformRenderer->getDevicePixelRatio();
+    const float devicePixelRatio = m_waveformRenderer->getSignalPixelRatio();
     const int length = static_cast<int>(m_waveformRenderer->getLength());
     const int pixelLength = static_cast<int>(m_waveformRenderer->getLength() * devicePixelRatio);
     const int stripLength = static_cast<int>(static_cast<float>(pixelLength) / kPixelPerStrip);
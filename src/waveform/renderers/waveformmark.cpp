@@ -5,6 +5,7 @@
 #include <QtDebug>
 
 #include "skin/legacy/skincontext.h"
+#include "waveform/renderers/waveformmarkimagecache.h"
 #include "waveform/renderers/waveformsignalcolors.h"
 #include "widget/wimagestore.h"
 #include "widget/wskincolor.h"
@@ -406,75 +407,35 @@ class MarkerGeometry {
     QSizeF m_imageSize;
 };
 
-QImage WaveformMark::generateImage(float devicePixelRatio) {
-    DEBUG_ASSERT(needsImageUpdate());
-
-    if (m_breadth == 0.0f) {
-        return {};
-    }
-
-    // Load the pixmap from file.
-    // If that succeeds loading the text and stroke is skipped.
-
-    if (!m_pixmapPath.isEmpty()) {
-        QString path = m_pixmapPath;
-        // Use devicePixelRatio to properly scale the image
-        QImage image = *WImageStore::getImage(path, devicePixelRatio);
-        // If loading the image didn't fail, then we're done. Otherwise fall
-        // through and render a label.
-        if (!image.isNull()) {
-            image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
-            // Set the pixel/device ratio AFTER loading the image in order to get
-            // a truly scaled source image.
-            // See https://doc.qt.io/qt-5/qimage.html#setDevicePixelRatio
-            // Also, without this some Qt-internal issue results in an offset
-            // image when calculating the center line of pixmaps in draw().
-            image.setDevicePixelRatio(devicePixelRatio);
-            // Calculate the offset
-            const float imgw = image.width();
-            const Qt::Alignment alignH = m_align & Qt::AlignHorizontal_Mask;
-            switch (alignH) {
-            case Qt::AlignHCenter:
-                m_offset = -(imgw - 1.f) / 2.f;
-                break;
-            case Qt::AlignLeft:
-                m_offset = -imgw + 2.f;
-                break;
-            case Qt::AlignRight:
-            default:
-                m_offset = -1.f;
-                break;
-            }
-            return image;
-        }
-    }
-
-    QString label = m_text;
+namespace {
 
-    // Determine mark text.
-    if (getHotCue() >= 0) {
-        if (!label.isEmpty()) {
-            label.prepend(": ");
-        }
-        label.prepend(QString::number(getHotCue() + 1));
-    }
+// Rasterizes the label image of a mark. The result only depends on the key,
+// so it can be shared by all marks with equal parameters.
+WaveformMarkImage renderLabelImage(const WaveformMarkImageKey& key) {
+    const QString& label = key.label;
+    const Qt::Alignment align = static_cast<Qt::Alignment>(key.align);
+    const float devicePixelRatio = key.devicePixelRatio;
+    const QColor fillColor = QColor::fromRgba(key.fillColor);
+    const QColor borderColor = QColor::fromRgba(key.borderColor);
+    const QColor labelColor = QColor::fromRgba(key.labelColor);
 
-    const bool useIcon = m_iconPath != "";
+    const bool useIcon = !key.iconPath.isEmpty();
 
     // Determine drawing geometries
-    const MarkerGeometry markerGeometry{label, useIcon, m_align, m_breadth, m_level};
+    const MarkerGeometry markerGeometry{label, useIcon, align, key.breadth, key.level};
 
-    m_label.setAreaRect(markerGeometry.labelRect());
+    WaveformMarkImage result;
+    result.labelRect = markerGeometry.labelRect();
 
     const QSize size{markerGeometry.getImageSize(devicePixelRatio)};
 
     if (size.width() <= 0 || size.height() <= 0) {
-        return QImage{};
+        return result;
     }
 
     QImage image{size, QImage::Format_ARGB32_Premultiplied};
     VERIFY_OR_DEBUG_ASSERT(!image.isNull()) {
-        return image;
+        return result;
     }
     image.setDevicePixelRatio(devicePixelRatio);
 
@@ -489,34 +450,34 @@ QImage WaveformMark::generateImage(float devicePixelRatio) {
 
     painter.setWorldMatrixEnabled(false);
 
-    const Qt::Alignment alignH = m_align & Qt::AlignHorizontal_Mask;
+    const Qt::Alignment alignH = align & Qt::AlignHorizontal_Mask;
     const float imgw = static_cast<float>(markerGeometry.imageSize().width());
     switch (alignH) {
     case Qt::AlignHCenter:
-        m_linePosition = imgw / 2.f;
-        m_offset = -(imgw - 1.f) / 2.f;
+        result.linePosition = imgw / 2.f;
+        result.offset = -(imgw - 1.f) / 2.f;
         break;
     case Qt::AlignLeft:
-        m_linePosition = imgw - 1.5f;
-        m_offset = -imgw + 2.f;
+        result.linePosition = imgw - 1.5f;
+        result.offset = -imgw + 2.f;
         break;
     case Qt::AlignRight:
     default:
-        m_linePosition = 1.5f;
-        m_offset = -1.f;
+        result.linePosition = 1.5f;
+        result.offset = -1.f;
         break;
     }
 
     // Note: linePos has to be at integer + 0.5 to draw correctly
-    const float linePos = m_linePosition;
+    const float linePos = result.linePosition;
     [[maybe_unused]] const float epsilon = 1e-6f;
     DEBUG_ASSERT(std::abs(linePos - std::floor(linePos) - 0.5) < epsilon);
 
     // Draw the center line
-    painter.setPen(fillColor());
+    painter.setPen(fillColor);
     painter.drawLine(QLineF(linePos, 0.f, linePos, markerGeometry.imageSize().height()));
 
-    painter.setPen(borderColor());
+    painter.setPen(borderColor);
     painter.drawLine(QLineF(linePos - 1.f,
             0.f,
             linePos - 1.f,
@@ -527,12 +488,12 @@ QImage WaveformMark::generateImage(float devicePixelRatio) {
             markerGeometry.imageSize().height()));
 
     if (useIcon || label.length() != 0) {
-        painter.setPen(borderColor());
+        painter.setPen(borderColor);
 
         // Draw the label rounded rect with border
         QPainterPath path;
         path.addRoundedRect(markerGeometry.labelRect(), 2.f, 2.f);
-        painter.fillPath(path, fillColor());
+        painter.fillPath(path, fillColor);
         painter.drawPath(path);
 
         // Center m_contentRect.width() and m_contentRect.height() inside m_labelRect
@@ -549,12 +510,12 @@ QImage WaveformMark::generateImage(float devicePixelRatio) {
                         markerGeometry.contentRect().y());
 
         if (useIcon) {
-            QSvgRenderer svgRenderer(m_iconPath);
+            QSvgRenderer svgRenderer(key.iconPath);
             svgRenderer.render(&painter, QRectF(pos, markerGeometry.contentRect().size()));
         } else {
             // Draw the text
             painter.setBrush(Qt::transparent);
-            painter.setPen(labelColor());
+            painter.setPen(labelColor);
             painter.setFont(markerGeometry.font());
 
             painter.drawText(pos, label);
@@ -563,5 +524,84 @@ QImage WaveformMark::generateImage(float devicePixelRatio) {
 
     painter.end();
 
-    return image;
+    result.image = image;
+    return result;
+}
+
+} // namespace
+
+QImage WaveformMark::generateImage(float devicePixelRatio) {
+    DEBUG_ASSERT(needsImageUpdate());
+
+    if (m_breadth == 0.0f) {
+        return {};
+    }
+
+    // Load the pixmap from file.
+    // If that succeeds loading the text and stroke is skipped.
+
+    if (!m_pixmapPath.isEmpty()) {
+        QString path = m_pixmapPath;
+        // Use devicePixelRatio to properly scale the image
+        QImage image = *WImageStore::getImage(path, devicePixelRatio);
+        // If loading the image didn't fail, then we're done. Otherwise fall
+        // through and render a label.
+        if (!image.isNull()) {
+            image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+            // Set the pixel/device ratio AFTER loading the image in order to get
+            // a truly scaled source image.
+            // See https://doc.qt.io/qt-5/qimage.html#setDevicePixelRatio
+            // Also, without this some Qt-internal issue results in an offset
+            // image when calculating the center line of pixmaps in draw().
+            image.setDevicePixelRatio(devicePixelRatio);
+            // Calculate the offset
+            const float imgw = image.width();
+            const Qt::Alignment alignH = m_align & Qt::AlignHorizontal_Mask;
+            switch (alignH) {
+            case Qt::AlignHCenter:
+                m_offset = -(imgw - 1.f) / 2.f;
+                break;
+            case Qt::AlignLeft:
+                m_offset = -imgw + 2.f;
+                break;
+            case Qt::AlignRight:
+            default:
+                m_offset = -1.f;
+                break;
+            }
+            return image;
+        }
+    }
+
+    QString label = m_text;
+
+    // Determine mark text.
+    if (getHotCue() >= 0) {
+        if (!label.isEmpty()) {
+            label.prepend(": ");
+        }
+        label.prepend(QString::number(getHotCue() + 1));
+    }
+
+    const WaveformMarkImageKey key{label,
+            m_iconPath,
+            static_cast<int>(m_align),
+            m_breadth,
+            m_level,
+            fillColor().rgba(),
+            borderColor().rgba(),
+            labelColor().rgba(),
+            devicePixelRatio};
+
+    // Drop our reference to the previous image first, so it is released if
+    // no other mark shares it.
+    m_pImage.reset();
+    m_pImage = WaveformMarkImageCache::getImage(key, &renderLabelImage);
+
+    m_label.setAreaRect(m_pImage->labelRect);
+    if (!m_pImage->image.isNull()) {
+        m_linePosition = m_pImage->linePosition;
+        m_offset = m_pImage->offset;
+    }
+    return m_pImage->image;
 }
@@ -9,6 +9,7 @@
 #include "waveform/waveformmarklabel.h"
 
 class SkinContext;
+struct WaveformMarkImage;
 class QOpenGLTexture;
 
 namespace allshader {
@@ -186,6 +187,9 @@ class WaveformMark {
 
     WaveformMarkLabel m_label;
 
+    // The rasterized label, shared with all marks that have equal parameters
+    std::shared_ptr<const WaveformMarkImage> m_pImage;
+
   private:
     std::unique_ptr<ControlProxy> m_pPositionCO;
     std::unique_ptr<ControlProxy> m_pEndPositionCO;
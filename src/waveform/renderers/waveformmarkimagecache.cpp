@@ -0,0 +1,53 @@
+#include "waveform/renderers/waveformmarkimagecache.h"
+
+#include "util/compatibility/qmutex.h"
+#include "util/counter.h"
+
+// static
+QMutex WaveformMarkImageCache::s_mutex;
+// static
+QHash<WaveformMarkImageKey, std::weak_ptr<const WaveformMarkImage>>
+        WaveformMarkImageCache::s_dictionary;
+
+// static
+std::shared_ptr<const WaveformMarkImage> WaveformMarkImageCache::getImage(
+        const WaveformMarkImageKey& key,
+        const RenderFunction& render) {
+    const auto locker = lockMutex(&s_mutex);
+
+    auto it = s_dictionary.constFind(key);
+    if (it != s_dictionary.constEnd()) {
+        auto pImage = it.value().lock();
+        if (pImage) {
+            return pImage;
+        }
+    }
+
+    Counter(QStringLiteral("WaveformMarkImageCache miss")).increment();
+    auto pImage = std::make_shared<const WaveformMarkImage>(render(key));
+    // Drop the entries of images that are no longer used by any mark before
+    // adding a new one, so the dictionary does not grow with every breadth
+    // or label change.
+    purgeExpired();
+    s_dictionary.insert(key, pImage);
+    return pImage;
+}
+
+// static
+int WaveformMarkImageCache::size() {
+    const auto locker = lockMutex(&s_mutex);
+    purgeExpired();
+    return static_cast<int>(s_dictionary.size());
+}
+
+// static
+void WaveformMarkImageCache::purgeExpired() {
+    auto it = s_dictionary.begin();
+    while (it != s_dictionary.end()) {
+        if (it.value().expired()) {
+            it = s_dictionary.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QRectF>
+#include <QString>
+#include <functional>
+#include <memory>
+
+// All the parameters that affect the rasterized image of a WaveformMark
+// label. Two marks with equal keys produce pixel-identical images.
+struct WaveformMarkImageKey {
+    QString label;
+    QString iconPath;
+    int align;
+    float breadth;
+    int level;
+    QRgb fillColor;
+    QRgb borderColor;
+    QRgb labelColor;
+    float devicePixelRatio;
+
+    bool operator==(const WaveformMarkImageKey& other) const = default;
+};
+
+template<>
+struct std::hash<WaveformMarkImageKey> {
+    size_t operator()(const WaveformMarkImageKey& key,
+            size_t seed = std::hash<int>{}(0)) const {
+        return std::hash<QString>()(key.label) ^
+                std::hash<QString>()(key.iconPath) ^
+                std::hash<int>()(key.align) ^
+                std::hash<float>()(key.breadth) ^
+                std::hash<int>()(key.level << 16) ^
+                std::hash<QRgb>()(key.fillColor) ^
+                std::hash<QRgb>()(key.borderColor) ^
+                std::hash<QRgb>()(key.labelColor) ^
+                std::hash<float>()(key.devicePixelRatio) ^ seed;
+    }
+};
+
+// A rasterized mark image together with the geometry that was computed
+// while drawing it.
+struct WaveformMarkImage {
+    QImage image;
+    QRectF labelRect;
+    float linePosition{};
+    float offset{};
+};
+
+// Process-wide store of rasterized mark images, shared by all waveform
+// renderers. Hotcue, intro/outro and loop marks are typically drawn with
+// identical parameters on every deck, by the slip renderer and again after
+// each resize or breadth toggle, so QPainter only has to draw each distinct
+// image once. Entries are reference counted: an image stays in the store as
+// long as at least one WaveformMark holds it.
+class WaveformMarkImageCache {
+  public:
+    using RenderFunction = std::function<WaveformMarkImage(const WaveformMarkImageKey&)>;
+
+    // Returns the cached image for key, invoking render to create it if no
+    // mark currently holds a matching image.
+    static std::shared_ptr<const WaveformMarkImage> getImage(
+            const WaveformMarkImageKey& key,
+            const RenderFunction& render);
+
+    // Number of images that are currently alive, for tests and diagnostics.
+    static int size();
+
+  private:
+    static void purgeExpired();
+
+    static QMutex s_mutex;
+    static QHash<WaveformMarkImageKey, std::weak_ptr<const WaveformMarkImage>> s_dictionary;
+};
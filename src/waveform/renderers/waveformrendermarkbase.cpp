@@ -55,6 +55,7 @@ void WaveformRenderMarkBase::slotCuesUpdated() {
 }
 
 void WaveformRenderMarkBase::updateMarksFromCues() {
+    const auto locker = m_waveformRenderer->lockRenderState();
     const TrackPointer pTrackInfo = m_waveformRenderer->getTrackInfo();
     if (!pTrackInfo) {
         return;
@@ -85,6 +86,7 @@ void WaveformRenderMarkBase::updateMarksFromCues() {
 }
 
 void WaveformRenderMarkBase::updateMarks() {
+    const auto locker = m_waveformRenderer->lockRenderState();
     m_marks.update();
     if (m_updateImagesImmediately) {
         updateMarkImages();
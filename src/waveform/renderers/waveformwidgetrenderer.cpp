@@ -47,7 +47,9 @@ WaveformWidgetRenderer::WaveformWidgetRenderer(const QString& group)
           m_scaleFactor(1.0),
           m_playMarkerPosition(s_defaultPlayMarkerPosition),
           m_pContext(nullptr),
-          m_passthroughEnabled(false) {
+          m_passthroughEnabled(false),
+          m_reducedSignalResolution(false),
+          m_renderStateMutex(QT_RECURSIVE_MUTEX_INIT) {
     //qDebug() << "WaveformWidgetRenderer";
     for (int type = ::WaveformRendererAbstract::Play;
             type <= ::WaveformRendererAbstract::Slip;
@@ -449,6 +451,7 @@ void WaveformWidgetRenderer::selectStem(mixxx::StemChannelSelection stemMask) {
 #endif
 
 void WaveformWidgetRenderer::setTrack(TrackPointer track) {
+    const auto locker = lockRenderState();
     m_pTrack = track;
     //used to postpone first display until track sample is actually available
     m_trackSamples = -1.0;
@@ -2,6 +2,7 @@
 
 #include "track/track_decl.h"
 #include "util/class.h"
+#include "util/compatibility/qmutex.h"
 #include "waveform/renderers/waveformmark.h"
 #include "waveform/renderers/waveformrendererabstract.h"
 #include "waveform/renderers/waveformsignalcolors.h"
@@ -166,6 +167,20 @@ class WaveformWidgetRenderer {
     float getDevicePixelRatio() const {
         return m_devicePixelRatio;
     }
+    /// The pixel ratio that the signal renderers use for sampling the
+    /// waveform. It equals the device pixel ratio unless the horizontal
+    /// resolution has been reduced to stay within the frame budget.
+    float getSignalPixelRatio() const {
+        return m_reducedSignalResolution ? m_devicePixelRatio / 2.0f : m_devicePixelRatio;
+    }
+    bool isSignalResolutionReduced() const {
+        return m_reducedSignalResolution;
+    }
+    /// Used by the adaptive quality mode of the WaveformWidgetFactory
+    /// to halve the horizontal resolution of the waveform signal.
+    void setSignalResolutionReduced(bool reduced) {
+        m_reducedSignalResolution = reduced;
+    }
     int getLength() const {
         return m_orientation == Qt::Horizontal ? m_width : m_height;
     }
@@ -227,6 +242,13 @@ class WaveformWidgetRenderer {
         return m_pContext;
     }
 
+    // Serializes changes of the track, marks and zoom made from the GUI
+    // thread with frames that are built on a dedicated render thread.
+    // The lock is uncontended when rendering happens on the GUI thread.
+    [[nodiscard]] QT_RECURSIVE_MUTEX_LOCKER lockRenderState() const {
+        return lockMutex(&m_renderStateMutex);
+    }
+
   protected:
     QString m_group;
     TrackPointer m_pTrack;
@@ -291,6 +313,8 @@ private:
     void drawPassthroughLabel(QPainter* painter);
 
     bool m_passthroughEnabled;
+    bool m_reducedSignalResolution;
+    mutable QT_RECURSIVE_MUTEX m_renderStateMutex;
     double m_pos[2];
     double m_truePosSample[2];
 };
@@ -19,6 +19,7 @@
 
 #include "moc_waveformwidgetfactory.cpp"
 #include "util/cmdlineargs.h"
+#include "util/counter.h"
 #include "util/math.h"
 #include "util/performancetimer.h"
 #include "util/timer.h"
@@ -60,6 +61,16 @@ bool shouldRenderWaveform(WaveformWidgetAbstract* pWaveformWidget) {
 }
 
 const QRegularExpression openGLVersionRegex(QStringLiteral("^(\\d+)\\.(\\d+).*$"));
+
+// The share of the frame interval that rendering the waveforms may take
+// in adaptive quality mode.
+constexpr qint64 kAdaptiveQualityBudgetPercent = 50;
+// Number of frames over budget until the resolution is reduced. A few
+// frames are tolerated to ignore single hiccups, e.g. when loading a track.
+constexpr int kAdaptiveQualityFramesUntilReduce = 10;
+// Number of frames well within the budget until the full resolution is
+// restored. This is intentionally longer to avoid toggling back and forth.
+constexpr int kAdaptiveQualityFramesUntilRestore = 300;
 }  // anonymous namespace
 
 ///////////////////////////////////////////
@@ -115,7 +126,11 @@ WaveformWidgetFactory::WaveformWidgetFactory()
           m_pVisualsManager(nullptr),
           m_frameCnt(0),
           m_actualFrameRate(0),
-          m_playMarkerPosition(WaveformWidgetRenderer::s_defaultPlayMarkerPosition) {
+          m_playMarkerPosition(WaveformWidgetRenderer::s_defaultPlayMarkerPosition),
+          m_adaptiveQuality(false),
+          m_signalResolutionReduced(false),
+          m_framesOverBudget(0),
+          m_framesWithinBudget(0) {
     m_visualGain[AllBand] = 1.0;
     m_visualGain[Low] = 1.0;
     m_visualGain[Mid] = 1.0;
@@ -434,6 +449,8 @@ bool WaveformWidgetFactory::setConfig(UserSettingsPointer config) {
             m_config->getValue(ConfigKey("[Waveform]", "stem_opacity"), 0.75)));
     setStemOutlineOpacity(static_cast<float>(m_config->getValue(
             ConfigKey("[Waveform]", "stem_outline_opacity"), 0.15)));
+    setAdaptiveQuality(m_config->getValue(
+            ConfigKey("[Waveform]", "AdaptiveQuality"), m_adaptiveQuality));
 
     return true;
 }
@@ -512,6 +529,7 @@ bool WaveformWidgetFactory::setWaveformWidget(WWaveformViewer* viewer,
     viewer->setZoom(m_defaultZoom);
     viewer->setDisplayBeatGridAlpha(m_beatGridAlpha);
     viewer->setPlayMarkerPosition(m_playMarkerPosition);
+    waveformWidget->setSignalResolutionReduced(m_signalResolutionReduced);
     waveformWidget->resize(viewer->width(), viewer->height());
     waveformWidget->getWidget()->show();
     viewer->update();
@@ -717,6 +735,60 @@ void WaveformWidgetFactory::setPlayMarkerPosition(double position) {
     }
 }
 
+void WaveformWidgetFactory::setAdaptiveQuality(bool enabled) {
+    m_adaptiveQuality = enabled;
+    if (m_config) {
+        m_config->setValue(ConfigKey("[Waveform]", "AdaptiveQuality"), m_adaptiveQuality);
+    }
+    m_framesOverBudget = 0;
+    m_framesWithinBudget = 0;
+    if (!m_adaptiveQuality) {
+        setSignalResolutionReduced(false);
+    }
+}
+
+void WaveformWidgetFactory::setSignalResolutionReduced(bool reduced) {
+    if (m_signalResolutionReduced == reduced) {
+        return;
+    }
+    qDebug() << "WaveformWidgetFactory:"
+             << (reduced ? "Reducing" : "Restoring")
+             << "the waveform signal resolution";
+    m_signalResolutionReduced = reduced;
+    for (const auto& holder : std::as_const(m_waveformWidgetHolders)) {
+        holder.m_waveformWidget->setSignalResolutionReduced(m_signalResolutionReduced);
+    }
+}
+
+void WaveformWidgetFactory::updateAdaptiveQuality(mixxx::Duration renderDuration) {
+    if (!m_adaptiveQuality) {
+        return;
+    }
+    // Rendering runs in the GUI thread, so it must leave enough time for
+    // all other GUI work within the interval between two frames.
+    const qint64 budgetMicros = m_vsyncThread->getSyncInterval().count() *
+            kAdaptiveQualityBudgetPercent / 100;
+    const qint64 renderMicros = renderDuration.toIntegerMicros();
+    if (renderMicros > budgetMicros) {
+        Counter(QStringLiteral("WaveformWidgetFactory::framesOverBudget")).increment();
+        m_framesWithinBudget = 0;
+        if (!m_signalResolutionReduced &&
+                ++m_framesOverBudget >= kAdaptiveQualityFramesUntilReduce) {
+            setSignalResolutionReduced(true);
+            m_framesOverBudget = 0;
+        }
+    } else if (renderMicros < budgetMicros / 2) {
+        // Only restore the full resolution if rendering would still fit
+        // into the budget when taking roughly twice as long.
+        m_framesOverBudget = 0;
+        if (m_signalResolutionReduced &&
+                ++m_framesWithinBudget >= kAdaptiveQualityFramesUntilRestore) {
+            setSignalResolutionReduced(false);
+            m_framesWithinBudget = 0;
+        }
+    }
+}
+
 void WaveformWidgetFactory::notifyZoomChange(WWaveformViewer* viewer) {
     WaveformWidgetAbstract* pWaveformWidget = viewer->getWaveformWidget();
     if (pWaveformWidget == nullptr || !isZoomSync()) {
@@ -737,6 +809,8 @@ void WaveformWidgetFactory::renderSelf() {
 
     if (!m_skipRender) {
         if (m_type) {   // no regular updates for an empty waveform
+            PerformanceTimer renderTimer;
+            renderTimer.start();
             // next rendered frame is displayed after next buffer swap and than after VSync
             QVarLengthArray<bool, 10> shouldRenderWaveforms(
                     static_cast<int>(m_waveformWidgetHolders.size()));
@@ -766,9 +840,12 @@ void WaveformWidgetFactory::renderSelf() {
                 if (!shouldRenderWaveforms[static_cast<int>(i)]) {
                     continue;
                 }
+                ScopedTimer widgetTimer(QStringLiteral("WaveformWidgetFactory::render() %1"),
+                        pWaveformWidget->getGroup());
                 pWaveformWidget->render();
                 //qDebug() << "render" << i << m_vsyncThread->elapsed();
             }
+            updateAdaptiveQuality(renderTimer.elapsed());
         }
 
         // WSpinnys are also double-buffered WGLWidgets, like all the waveform
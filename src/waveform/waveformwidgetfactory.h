@@ -228,6 +228,13 @@ class WaveformWidgetFactory : public QObject,
     void setPlayMarkerPosition(double position);
     double getPlayMarkerPosition() const { return m_playMarkerPosition; }
 
+    /// In adaptive quality mode the horizontal resolution of the waveform
+    /// signals is halved while rendering exceeds the frame budget.
+    void setAdaptiveQuality(bool enabled);
+    bool isAdaptiveQuality() const {
+        return m_adaptiveQuality;
+    }
+
     void notifyZoomChange(WWaveformViewer *viewer);
   signals:
     void waveformUpdateTick();
@@ -268,6 +275,8 @@ class WaveformWidgetFactory : public QObject,
   private:
     void renderSelf();
     void swapSelf();
+    void updateAdaptiveQuality(mixxx::Duration renderDuration);
+    void setSignalResolutionReduced(bool reduced);
 
     void addHandle(
             QHash<WaveformWidgetType::Type, QList<WaveformWidgetBackend>>&
@@ -346,4 +355,9 @@ class WaveformWidgetFactory : public QObject,
     double m_actualFrameRate;
     int m_vSyncType;
     double m_playMarkerPosition;
+
+    bool m_adaptiveQuality;
+    bool m_signalResolutionReduced;
+    int m_framesOverBudget;
+    int m_framesWithinBudget;
 };
@@ -4,6 +4,7 @@
 #include <QApplication>
 #include <QWheelEvent>
 
+#include "util/timer.h"
 #include "waveform/renderers/allshader/waveformrenderbackground.h"
 #include "waveform/renderers/allshader/waveformrenderbeat.h"
 #include "waveform/renderers/allshader/waveformrendererendoftrack.h"
@@ -150,10 +151,19 @@ void WaveformWidget::paintGL() {
     // opacity of 0.f effectively skips the subtree rendering
     m_pOpacityNode->setOpacity(shouldOnlyDrawBackground() ? 0.f : 1.f);
 
-    m_pWaveformRenderMark->update();
-    m_pWaveformRenderMarkRange->update();
-
-    m_pEngine->preprocess();
+    {
+        ScopedTimer t(QStringLiteral("allshader::WaveformWidget::paintGL() marks %1"),
+                getGroup());
+        m_pWaveformRenderMark->update();
+        m_pWaveformRenderMarkRange->update();
+    }
+    {
+        ScopedTimer t(QStringLiteral("allshader::WaveformWidget::paintGL() preprocess %1"),
+                getGroup());
+        m_pEngine->preprocess();
+    }
+    ScopedTimer t(QStringLiteral("allshader::WaveformWidget::paintGL() render %1"),
+            getGroup());
     m_pEngine->render();
 }
 
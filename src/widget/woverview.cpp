@@ -7,6 +7,7 @@
 #include <QPainter>
 #include <QPen>
 #include <QVBoxLayout>
+#include <QtConcurrentRun>
 
 #include "analyzer/analyzerprogress.h"
 #include "control/controlproxy.h"
@@ -65,6 +66,11 @@ WOverview::WOverview(
           m_trackLoaded(false),
           m_pHoveredMark(nullptr),
           m_scaleFactor(1.0),
+          m_waveformSourceImageVersion(0),
+          m_waveformImageScaledVersion(-1),
+          m_waveformImageRequestId(0),
+          m_waveformImageRendering(false),
+          m_waveformImageScaling(false),
           m_trackSampleRateControl(
                   m_group,
                   QStringLiteral("track_samplerate")),
@@ -312,27 +318,144 @@ void WOverview::slotWaveformSummaryUpdated() {
     if (!pTrack) {
         return;
     }
-    m_pWaveform = pTrack->getWaveformSummary();
+    ConstWaveformPointer pWaveform = pTrack->getWaveformSummary();
+    if (pWaveform != m_pWaveform) {
+        // The image and a pending render belong to the replaced waveform
+        resetWaveformImage();
+        m_pWaveform = pWaveform;
+    }
     if (m_pWaveform) {
-        // If the waveform is already complete, just draw it.
-        if (m_pWaveform->getCompletion() == m_pWaveform->getDataSize()) {
-            m_actualCompletion = 0;
-            if (drawNextPixmapPart()) {
-                update();
-            }
-        }
+        renderCompleteWaveformImageAsync();
     } else {
         // Null waveform pointer means waveform was cleared.
-        m_waveformSourceImage = QImage();
+        resetWaveformImage();
         m_analyzerProgress = kAnalyzerProgressUnknown;
-        m_actualCompletion = 0;
-        m_waveformPeak = -1.0;
-        m_pixmapDone = false;
 
         update();
     }
 }
 
+void WOverview::resetWaveformImage() {
+    m_waveformSourceImage = QImage();
+    m_waveformImageScaled = QImage();
+    ++m_waveformSourceImageVersion;
+    // Drop the result of a pending background render
+    ++m_waveformImageRequestId;
+    m_waveformImageRendering = false;
+    m_actualCompletion = 0;
+    m_waveformPeak = -1.0;
+    m_pixmapDone = false;
+}
+
+void WOverview::renderCompleteWaveformImageAsync() {
+    if (!m_pWaveform || m_waveformImageRendering || !m_waveformSourceImage.isNull()) {
+        // Already rendered or drawn incrementally
+        return;
+    }
+    if (m_pWaveform->getCompletion() != m_pWaveform->getDataSize()) {
+        // Still being analyzed, drawNextPixmapPart() draws it as it grows
+        return;
+    }
+    const double trackSamples = getTrackSamples();
+    if (trackSamples <= 0) {
+        // Called again from slotTrackLoaded()
+        return;
+    }
+    renderWaveformImageAsync(m_pWaveform, trackSamples);
+}
+
+void WOverview::renderWaveformImageAsync(ConstWaveformPointer pWaveform, double trackSamples) {
+    const int requestId = ++m_waveformImageRequestId;
+    m_waveformImageRendering = true;
+
+    // The watcher will be deleted in slotWaveformImageRendered()
+    auto* pWatcher = new QFutureWatcher<RenderedWaveformImage>(this);
+    connect(pWatcher,
+            &QFutureWatcher<RenderedWaveformImage>::finished,
+            this,
+            &WOverview::slotWaveformImageRendered);
+    pWatcher->setFuture(QtConcurrent::run(
+            &WOverview::renderWaveformImage,
+            requestId,
+            pWaveform,
+            trackSamples,
+            m_type,
+            m_signalColors));
+}
+
+// static
+WOverview::RenderedWaveformImage WOverview::renderWaveformImage(
+        int requestId,
+        ConstWaveformPointer pWaveform,
+        double trackSamples,
+        mixxx::OverviewType type,
+        const WaveformSignalColors& signalColors) {
+    RenderedWaveformImage result{requestId, QImage(), -1.0f, 0};
+    const int dataSize = pWaveform->getDataSize();
+    const double audioVisualRatio = pWaveform->getAudioVisualRatio();
+    if (dataSize <= 0 || audioVisualRatio <= 0 || trackSamples <= 0) {
+        return result;
+    }
+
+    // Same layout as the image that is drawn incrementally by
+    // drawNextPixmapPart(): twice the height of the viewport to be
+    // scalable by the total gain.
+    result.image = QImage(waveformImageWidth(trackSamples, audioVisualRatio),
+            2 * 255,
+            QImage::Format_ARGB32_Premultiplied);
+    result.image.fill(QColor(0, 0, 0, 0).value());
+
+    QPainter painter(&result.image);
+    painter.translate(0.0, static_cast<double>(result.image.height()) / 2.0);
+
+    for (int i = 0; i < dataSize; i += 2) {
+        result.peak = math_max3(
+                result.peak,
+                static_cast<float>(pWaveform->getAll(i)),
+                static_cast<float>(pWaveform->getAll(i + 1)));
+    }
+
+    if (type == mixxx::OverviewType::Filtered) {
+        waveformOverviewRenderer::drawWaveformPartLMH(
+                &painter, pWaveform, &result.completion, dataSize, signalColors);
+    } else if (type == mixxx::OverviewType::HSV) {
+        waveformOverviewRenderer::drawWaveformPartHSV(
+                &painter, pWaveform, &result.completion, dataSize, signalColors);
+    } else { // mixxx::OverviewType::RGB:
+        waveformOverviewRenderer::drawWaveformPartRGB(
+                &painter, pWaveform, &result.completion, dataSize, signalColors);
+    }
+    return result;
+}
+
+void WOverview::slotWaveformImageRendered() {
+    RenderedWaveformImage result;
+    {
+        auto* pWatcher = static_cast<QFutureWatcher<RenderedWaveformImage>*>(sender());
+        VERIFY_OR_DEBUG_ASSERT(pWatcher) {
+            return;
+        }
+        result = pWatcher->result();
+        pWatcher->deleteLater();
+    }
+
+    if (result.requestId != m_waveformImageRequestId) {
+        // The track, waveform or overview type has changed in the meantime
+        return;
+    }
+    m_waveformImageRendering = false;
+    if (result.image.isNull()) {
+        return;
+    }
+
+    m_waveformSourceImage = result.image;
+    ++m_waveformSourceImageVersion;
+    m_waveformPeak = result.peak;
+    m_actualCompletion = result.completion;
+    m_pixmapDone = true;
+    update();
+}
+
 void WOverview::onTrackAnalyzerProgress(TrackId trackId, AnalyzerProgress analyzerProgress) {
     if (!m_pCurrentTrack || (m_pCurrentTrack->getId() != trackId)) {
         return;
@@ -353,6 +476,8 @@ void WOverview::slotTrackLoaded(TrackPointer pTrack) {
     if (m_pCurrentTrack) {
         updateCues(m_pCurrentTrack->getCuePoints());
     }
+    // The image width depends on the track samples that are known now
+    renderCompleteWaveformImageAsync();
     update();
 }
 
@@ -371,11 +496,8 @@ void WOverview::slotLoadingTrack(TrackPointer pNewTrack, TrackPointer pOldTrack)
                 &WOverview::receiveCuesUpdated);
     }
 
-    m_waveformSourceImage = QImage();
+    resetWaveformImage();
     m_analyzerProgress = kAnalyzerProgressUnknown;
-    m_actualCompletion = 0;
-    m_waveformPeak = -1.0;
-    m_pixmapDone = false;
     // Note: Here we already have the new track, but the engine and it's
     // Control Objects may still have the old one until the slotTrackLoaded()
     // signal has been received.
@@ -450,7 +572,8 @@ void WOverview::slotTypeControlChanged(double v) {
     }
 
     m_type = type;
-    m_pWaveform.clear();
+    // Redraw the image of the same waveform with the new type
+    resetWaveformImage();
     slotWaveformSummaryUpdated();
 }
 
@@ -750,25 +873,94 @@ void WOverview::drawWaveformPixmap(QPainter* pPainter) {
             diffGain = 255.0f - (255.0f / visualGain);
         }
 
-        if (m_diffGain != diffGain || m_waveformImageScaled.isNull()) {
-            QRect sourceRect(0,
-                    static_cast<int>(diffGain),
-                    m_waveformSourceImage.width(),
-                    m_waveformSourceImage.height() -
-                            2 * static_cast<int>(diffGain));
-            QImage croppedImage = m_waveformSourceImage.copy(sourceRect);
-            if (m_orientation == Qt::Vertical) {
-                // Rotate pixmap
-                croppedImage = croppedImage.transformed(QTransform(0, 1, 1, 0, 0, 0));
-            }
-            m_waveformImageScaled = croppedImage.scaled(size() * m_devicePixelRatio,
+        if (m_diffGain != diffGain ||
+                m_waveformImageScaledVersion != m_waveformSourceImageVersion ||
+                m_waveformImageScaled.size() != size() * m_devicePixelRatio) {
+            scaleWaveformImageAsync(diffGain);
+        }
+
+        if (!m_waveformImageScaled.isNull()) {
+            pPainter->drawImage(rect(), m_waveformImageScaled);
+        }
+    }
+}
+
+void WOverview::scaleWaveformImageAsync(float diffGain) {
+    if (m_waveformImageScaling) {
+        // Only one scaling job at a time. Further gain changes are coalesced
+        // and picked up by the repaint after the pending job has finished.
+        return;
+    }
+    m_waveformImageScaling = true;
+
+    // The watcher will be deleted in slotScaledWaveformImageRendered().
+    // The source image is implicitly shared, so the worker keeps a
+    // consistent snapshot while drawNextPixmapPart() continues drawing.
+    auto* pWatcher = new QFutureWatcher<ScaledWaveformImage>(this);
+    connect(pWatcher,
+            &QFutureWatcher<ScaledWaveformImage>::finished,
+            this,
+            &WOverview::slotScaledWaveformImageRendered);
+    pWatcher->setFuture(QtConcurrent::run(
+            &WOverview::scaleWaveformImage,
+            m_waveformImageRequestId,
+            m_waveformSourceImageVersion,
+            m_waveformSourceImage,
+            diffGain,
+            size() * m_devicePixelRatio,
+            m_orientation));
+}
+
+// static
+WOverview::ScaledWaveformImage WOverview::scaleWaveformImage(
+        int requestId,
+        int sourceImageVersion,
+        const QImage& sourceImage,
+        float diffGain,
+        QSize size,
+        Qt::Orientation orientation) {
+    QRect sourceRect(0,
+            static_cast<int>(diffGain),
+            sourceImage.width(),
+            sourceImage.height() -
+                    2 * static_cast<int>(diffGain));
+    QImage croppedImage = sourceImage.copy(sourceRect);
+    if (orientation == Qt::Vertical) {
+        // Rotate pixmap
+        croppedImage = croppedImage.transformed(QTransform(0, 1, 1, 0, 0, 0));
+    }
+    return ScaledWaveformImage{requestId,
+            sourceImageVersion,
+            diffGain,
+            croppedImage.scaled(size,
                     Qt::IgnoreAspectRatio,
-                    Qt::SmoothTransformation);
-            m_diffGain = diffGain;
+                    Qt::SmoothTransformation)};
+}
+
+void WOverview::slotScaledWaveformImageRendered() {
+    ScaledWaveformImage result;
+    {
+        auto* pWatcher = static_cast<QFutureWatcher<ScaledWaveformImage>*>(sender());
+        VERIFY_OR_DEBUG_ASSERT(pWatcher) {
+            return;
         }
+        result = pWatcher->result();
+        pWatcher->deleteLater();
+    }
+    m_waveformImageScaling = false;
 
-        pPainter->drawImage(rect(), m_waveformImageScaled);
+    if (result.requestId != m_waveformImageRequestId || m_waveformSourceImage.isNull()) {
+        // The track has been replaced or unloaded in the meantime
+        update();
+        return;
     }
+    // Use the result even if it is already outdated, it is still closer to
+    // the current state than the previous one. The repaint requests a new
+    // scaling job if needed.
+    m_waveformImageScaled = result.image;
+    m_waveformImageScaledVersion = result.sourceImageVersion;
+    m_diffGain = result.diffGain;
+    update();
 }
 
 void WOverview::drawMinuteMarkers(QPainter* pPainter) {
@@ -1363,7 +1555,9 @@ void WOverview::drawPassthroughOverlay(QPainter* pPainter) {
 
 bool WOverview::drawNextPixmapPart() {
     ConstWaveformPointer pWaveform = getWaveform();
-    if (!pWaveform) {
+    if (!pWaveform || m_waveformImageRendering) {
+        // The complete waveform is rendered in the background. A waveform
+        // that is still being analyzed is never rendered that way.
         return false;
     }
 
@@ -1379,7 +1573,7 @@ bool WOverview::drawNextPixmapPart() {
         // by total_gain
         // We keep full range waveform data to scale it on paint
         m_waveformSourceImage = QImage(
-                static_cast<int>(trackSamples / audioVisualRatio / 2) + 1,
+                waveformImageWidth(trackSamples, audioVisualRatio),
                 2 * 255,
                 QImage::Format_ARGB32_Premultiplied);
         m_waveformSourceImage.fill(QColor(0, 0, 0, 0).value());
@@ -1445,8 +1639,7 @@ bool WOverview::drawNextPixmapPart() {
                 m_signalColors);
     }
 
-    m_waveformImageScaled = QImage();
-    m_diffGain = 0;
+    ++m_waveformSourceImageVersion;
 
     // Test if the complete waveform is done
     if (m_actualCompletion >= dataSize - 2) {
@@ -1500,8 +1693,6 @@ void WOverview::resizeEvent(QResizeEvent* pEvent) {
 
     m_devicePixelRatio = devicePixelRatioF();
 
-    m_waveformImageScaled = QImage();
-    m_diffGain = 0;
     Init();
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QColor>
+#include <QFutureWatcher>
 #include <QList>
 #include <QPixmap>
 
@@ -71,7 +72,51 @@ class WOverview : public WWidget, public TrackDropTarget {
     void slotMinuteMarkersChanged(bool v);
     void slotNormalizeOrVisualGainChanged();
 
+    void slotWaveformImageRendered();
+    void slotScaledWaveformImageRendered();
+
   private:
+    struct RenderedWaveformImage {
+        int requestId;
+        QImage image;
+        float peak;
+        int completion;
+    };
+    struct ScaledWaveformImage {
+        int requestId;
+        int sourceImageVersion;
+        float diffGain;
+        QImage image;
+    };
+
+    // Render the overview image of a completely analyzed waveform on a
+    // worker thread instead of drawing it on the GUI thread. A waveform
+    // that is still being analyzed is drawn by drawNextPixmapPart().
+    void renderCompleteWaveformImageAsync();
+    void renderWaveformImageAsync(ConstWaveformPointer pWaveform, double trackSamples);
+    static RenderedWaveformImage renderWaveformImage(
+            int requestId,
+            ConstWaveformPointer pWaveform,
+            double trackSamples,
+            mixxx::OverviewType type,
+            const WaveformSignalColors& signalColors);
+    // Crop and scale the source image on a worker thread. The previous
+    // scaled image is painted until the new one is ready.
+    void scaleWaveformImageAsync(float diffGain);
+    static ScaledWaveformImage scaleWaveformImage(
+            int requestId,
+            int sourceImageVersion,
+            const QImage& sourceImage,
+            float diffGain,
+            QSize size,
+            Qt::Orientation orientation);
+    void resetWaveformImage();
+    // The width of the source image, for both the background render and
+    // drawNextPixmapPart()
+    static int waveformImageWidth(double trackSamples, double audioVisualRatio) {
+        return static_cast<int>(trackSamples / audioVisualRatio / 2) + 1;
+    }
+
     // Append the waveform overview pixmap according to available data
     // in waveform
     bool drawNextPixmapPart();
@@ -185,6 +230,13 @@ class WOverview : public WWidget, public TrackDropTarget {
 
     QImage m_waveformSourceImage;
     QImage m_waveformImageScaled;
+    // Incremented whenever m_waveformSourceImage changes
+    int m_waveformSourceImageVersion;
+    int m_waveformImageScaledVersion;
+    // Identifies the pending background render, stale results are dropped
+    int m_waveformImageRequestId;
+    bool m_waveformImageRendering;
+    bool m_waveformImageScaling;
 
     WaveformSignalColors m_signalColors;
 
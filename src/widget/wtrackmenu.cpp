@@ -34,6 +34,7 @@
 #include "preferences/colorpalettesettings.h"
 #include "preferences/configobject.h"
 #include "preferences/dialog/dlgprefdeck.h"
+#include "sources/soundsourcepool.h"
 #include "sources/soundsourceproxy.h"
 #include "track/track.h"
 #include "util/defs.h"
@@ -2425,6 +2426,8 @@ class RemoveTrackFilesFromDiskTrackPointerOperation : public mixxx::TrackPointer
             return;
         }
         QString location = pTrack->getLocation();
+        // Idle SoundSources keep the file open and prevent deleting it
+        mixxx::SoundSourcePool::evict(pTrack->getFileInfo().toQUrl());
         QFile file(location);
 #if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
         if (file.exists() && !file.remove()) {